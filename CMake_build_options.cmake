@@ -62,6 +62,13 @@ option(BUILD_METAL "Build the metal package" on)
 option(BUILD_DEM "Build the dem package" on)
 option(BUILD_CGCMM "Build the cgcmm package" on)
 option(BUILD_MPCD "Build the mpcd package" on)
+option(ENABLE_MPCD_MIXED_PRECISION "Store MPCD solvent particle data in single precision" OFF)
+if (ENABLE_MPCD_MIXED_PRECISION)
+    if (ENABLE_CUDA)
+        message(FATAL_ERROR "ENABLE_MPCD_MIXED_PRECISION is only supported in CPU builds")
+    endif()
+    add_definitions(-DENABLE_MPCD_MIXED_PRECISION)
+endif()
 option(BUILD_JIT "Build the jit package" off)
 
 ###############################
@@ -8,9 +8,14 @@
 #include "VectorMath.h"
 #include <vector>
 #include <stack>
+#include <algorithm>
 
 #include "AABB.h"
 
+#if defined(ENABLE_TBB) && !defined(NVCC)
+#include <tbb/tbb.h>
+#endif
+
 #ifndef __AABB_TREE_H__
 #define __AABB_TREE_H__
 
@@ -38,6 +43,7 @@ namespace detail
 
 const unsigned int NODE_CAPACITY = 16;           //!< Maximum number of particles in a node
 const unsigned int INVALID_NODE = 0xffffffff;   //!< Invalid node index sentinel
+const unsigned int LBVH_TASK_LEAVES = 64;       //!< Subtrees with more leaves than this are processed in parallel
 
 #ifndef NVCC
 
@@ -77,6 +83,10 @@ struct PYBIND11_EXPORT AABBNode
                an update will only increase the volume of nodes. The tree should be rebuilt periodically instead of
                continually updated.
     - buildTree : build an efficiently arranged tree given a complete set of AABBs, one for each particle.
+    - buildTreeLBVH : build a linear BVH from Morton codes of the AABB centers. It is faster to build than buildTree()
+               and the construction is parallelized with TBB.
+    - refit : recompute the AABBs of all nodes from new particle AABBs while keeping the topology. This is cheaper
+               than a rebuild when the particles have moved only a little.
 
     **Implementation details**
 
@@ -161,6 +171,12 @@ class PYBIND11_EXPORT AABBTree
         //! Build a tree smartly from a list of AABBs
         inline void buildTree(AABB *aabbs, unsigned int N);
 
+        //! Build a linear BVH from a list of AABBs
+        inline void buildTreeLBVH(const AABB *aabbs, unsigned int N);
+
+        //! Recompute the node AABBs without changing the tree topology
+        inline void refit(const AABB *aabbs);
+
         //! Find all particles that overlap with the query AABB
         inline unsigned int query(std::vector<unsigned int>& hits, const AABB& aabb) const;
 
@@ -246,6 +262,7 @@ class PYBIND11_EXPORT AABBTree
         unsigned int m_node_capacity;       //!< Capacity of the nodes array
         unsigned int m_root;                //!< Index to the root node of the tree
         std::vector<unsigned int> m_mapping;//!< Reverse mapping to find node given a particle index
+        std::vector<unsigned long long> m_keys; //!< Sorted Morton codes (upper bits) and particle indices (lower bits)
 
         //! Initialize the tree to hold N particles
         inline void init(unsigned int N);
@@ -258,8 +275,31 @@ class PYBIND11_EXPORT AABBTree
 
         //! Update the skip value for a node
         inline unsigned int updateSkip(unsigned int idx);
+
+        //! Make room for exactly n nodes, discarding the current ones
+        inline void reserveNodes(unsigned int n);
+
+        //! Find the last leaf of the left child of a linear BVH node
+        inline unsigned int findSplit(unsigned int first, unsigned int last) const;
+
+        //! Build a linear BVH node and all nodes below it
+        inline void buildLBVHNode(const AABB *aabbs, unsigned int N, unsigned int first, unsigned int last,
+                                  unsigned int node_idx, unsigned int parent);
+
+        //! Refit a node and all nodes below it
+        inline void refitNode(const AABB *aabbs, unsigned int idx);
     };
 
+//! Spread the lower 10 bits of an integer so that there are two zero bits between each of them
+inline unsigned int expandMortonBits(unsigned int v)
+    {
+    v = (v * 0x00010001u) & 0xFF0000FFu;
+    v = (v * 0x00000101u) & 0x0F00F00Fu;
+    v = (v * 0x00000011u) & 0xC30C30C3u;
+    v = (v * 0x00000005u) & 0x49249249u;
+    return v;
+    }
+
 
 /*! \param N Number of particles to allocate space for
 
@@ -573,6 +613,243 @@ inline unsigned int AABBTree::updateSkip(unsigned int idx)
         }
     }
 
+/*! \param aabbs List of AABBs for each particle
+    \param N Number of AABBs in the list
+
+    Builds a linear BVH (LBVH). The centers of the AABBs are assigned 30-bit Morton codes within their bounding box and
+    sorted along the Morton curve. Consecutive runs of NODE_CAPACITY particles form the leaves, and the internal nodes
+    split their leaves where the highest bit of the Morton code changes. A subtree with l leaves always holds
+    2l-1 nodes, so the position of every node in the depth first order used by the stackless traversal is known
+    before its children are built. This lets independent subtrees be built concurrently.
+
+    Unlike buildTree(), \a aabbs is not modified.
+*/
+inline void AABBTree::buildTreeLBVH(const AABB *aabbs, unsigned int N)
+    {
+    init(N);
+
+    if (N == 0)
+        return;
+
+    // find the bounding box of the AABB centers
+    vec3<Scalar> lower = aabbs[0].getPosition();
+    vec3<Scalar> upper = lower;
+    for (unsigned int i = 1; i < N; i++)
+        {
+        vec3<Scalar> pos = aabbs[i].getPosition();
+        lower.x = std::min(lower.x, pos.x); upper.x = std::max(upper.x, pos.x);
+        lower.y = std::min(lower.y, pos.y); upper.y = std::max(upper.y, pos.y);
+        lower.z = std::min(lower.z, pos.z); upper.z = std::max(upper.z, pos.z);
+        }
+
+    // scale factors to map the centers onto a 1024^3 grid, degenerate dimensions collapse to 0
+    vec3<Scalar> extent = upper - lower;
+    vec3<Scalar> scale(extent.x > Scalar(0.0) ? Scalar(1023.0)/extent.x : Scalar(0.0),
+                       extent.y > Scalar(0.0) ? Scalar(1023.0)/extent.y : Scalar(0.0),
+                       extent.z > Scalar(0.0) ? Scalar(1023.0)/extent.z : Scalar(0.0));
+
+    // compute the Morton codes, keeping the particle index in the lower bits of the sort key
+    m_keys.resize(N);
+    auto compute_key = [&](unsigned int i)
+        {
+        vec3<Scalar> f = aabbs[i].getPosition() - lower;
+        unsigned int ix = std::min((unsigned int)(f.x*scale.x), 1023u);
+        unsigned int iy = std::min((unsigned int)(f.y*scale.y), 1023u);
+        unsigned int iz = std::min((unsigned int)(f.z*scale.z), 1023u);
+        unsigned int code = (expandMortonBits(ix) << 2) | (expandMortonBits(iy) << 1) | expandMortonBits(iz);
+        m_keys[i] = ((unsigned long long)code << 32) | i;
+        };
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, N, compute_key);
+    tbb::parallel_sort(m_keys.begin(), m_keys.end());
+    #else
+    for (unsigned int i = 0; i < N; i++)
+        compute_key(i);
+    std::sort(m_keys.begin(), m_keys.end());
+    #endif
+
+    // a binary tree with n_leaves leaves has 2*n_leaves-1 nodes
+    unsigned int n_leaves = (N + NODE_CAPACITY - 1) / NODE_CAPACITY;
+    reserveNodes(2*n_leaves - 1);
+
+    m_root = 0;
+    buildLBVHNode(aabbs, N, 0, n_leaves-1, m_root, INVALID_NODE);
+    }
+
+/*! \param first First leaf of the node
+    \param last Last leaf of the node (must be larger than \a first)
+    \returns The last leaf of the left child
+
+    The leaves are split where the highest bit of the Morton code of their first particle changes. Leaves with
+    identical codes are split in the middle.
+*/
+inline unsigned int AABBTree::findSplit(unsigned int first, unsigned int last) const
+    {
+    unsigned int first_code = (unsigned int)(m_keys[first*NODE_CAPACITY] >> 32);
+    unsigned int last_code = (unsigned int)(m_keys[last*NODE_CAPACITY] >> 32);
+
+    if (first_code == last_code)
+        return (first + last) >> 1;
+
+    // binary search for the last leaf that shares more leading bits with the first leaf than the last leaf does
+    int common_prefix = __builtin_clz(first_code ^ last_code);
+    unsigned int split = first;
+    unsigned int step = last - first;
+    do
+        {
+        step = (step + 1) >> 1;
+        unsigned int new_split = split + step;
+
+        if (new_split < last)
+            {
+            unsigned int split_code = (unsigned int)(m_keys[new_split*NODE_CAPACITY] >> 32);
+            if (__builtin_clz(first_code ^ split_code) > common_prefix)
+                split = new_split;
+            }
+        } while (step > 1);
+
+    return split;
+    }
+
+/*! \param aabbs List of AABBs for each particle
+    \param N Number of AABBs in the list
+    \param first First leaf of the node
+    \param last Last leaf of the node
+    \param node_idx Index of the node
+    \param parent Index of the parent node
+
+    The left child immediately follows its parent and the right child follows the whole left subtree.
+*/
+inline void AABBTree::buildLBVHNode(const AABB *aabbs,
+                                    unsigned int N,
+                                    unsigned int first,
+                                    unsigned int last,
+                                    unsigned int node_idx,
+                                    unsigned int parent)
+    {
+    AABBNode& node = m_nodes[node_idx];
+    node.parent = parent;
+
+    if (first == last)
+        {
+        // leaf node holding a run of particles along the Morton curve
+        unsigned int start = first*NODE_CAPACITY;
+        unsigned int end = std::min(start + NODE_CAPACITY, N);
+
+        AABB my_aabb = aabbs[m_keys[start] & 0xffffffff];
+        for (unsigned int i = start; i < end; i++)
+            {
+            unsigned int idx = (unsigned int)(m_keys[i] & 0xffffffff);
+            my_aabb = merge(my_aabb, aabbs[idx]);
+
+            node.particles[i-start] = idx;
+            node.particle_tags[i-start] = aabbs[idx].tag;
+            m_mapping[idx] = node_idx;
+            }
+
+        node.aabb = my_aabb;
+        node.left = node.right = INVALID_NODE;
+        node.num_particles = end - start;
+        node.skip = 0;
+        return;
+        }
+
+    unsigned int split = findSplit(first, last);
+    unsigned int left_idx = node_idx + 1;
+    unsigned int right_idx = node_idx + 2*(split - first + 1);
+
+    #ifdef ENABLE_TBB
+    if (last - first >= LBVH_TASK_LEAVES)
+        {
+        tbb::parallel_invoke([&] { buildLBVHNode(aabbs, N, first, split, left_idx, node_idx); },
+                             [&] { buildLBVHNode(aabbs, N, split+1, last, right_idx, node_idx); });
+        }
+    else
+    #endif
+        {
+        buildLBVHNode(aabbs, N, first, split, left_idx, node_idx);
+        buildLBVHNode(aabbs, N, split+1, last, right_idx, node_idx);
+        }
+
+    node.aabb = merge(m_nodes[left_idx].aabb, m_nodes[right_idx].aabb);
+    node.left = left_idx;
+    node.right = right_idx;
+    node.num_particles = 0;
+    node.skip = 2*(last - first + 1) - 2;
+    }
+
+/*! \param aabbs List of AABBs for each particle, in the order they were given at build time
+
+    refit() recomputes the leaf AABBs from \a aabbs and merges them up the tree. The tree topology and particle
+    assignment are unchanged, so the traversal remains correct but becomes less efficient as the particles move away
+    from where they were at build time. Works with trees from both buildTree() and buildTreeLBVH().
+*/
+inline void AABBTree::refit(const AABB *aabbs)
+    {
+    if (m_num_nodes == 0)
+        return;
+
+    refitNode(aabbs, m_root);
+    }
+
+/*! \param aabbs List of AABBs for each particle
+    \param idx Index of the node to refit
+*/
+inline void AABBTree::refitNode(const AABB *aabbs, unsigned int idx)
+    {
+    AABBNode& node = m_nodes[idx];
+
+    if (node.left == INVALID_NODE)
+        {
+        AABB my_aabb = aabbs[node.particles[0]];
+        for (unsigned int i = 1; i < node.num_particles; i++)
+            my_aabb = merge(my_aabb, aabbs[node.particles[i]]);
+        node.aabb = my_aabb;
+        return;
+        }
+
+    #ifdef ENABLE_TBB
+    if (node.skip >= 2*LBVH_TASK_LEAVES)
+        {
+        tbb::parallel_invoke([&] { refitNode(aabbs, node.left); },
+                             [&] { refitNode(aabbs, node.right); });
+        }
+    else
+    #endif
+        {
+        refitNode(aabbs, node.left);
+        refitNode(aabbs, node.right);
+        }
+
+    node.aabb = merge(m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+    }
+
+/*! \param n Number of nodes
+
+    The current nodes are discarded, their memory is reused when it is large enough.
+*/
+inline void AABBTree::reserveNodes(unsigned int n)
+    {
+    if (n > m_node_capacity)
+        {
+        AABBNode *new_nodes = NULL;
+        int retval = posix_memalign((void**)&new_nodes, 32, n*sizeof(AABBNode));
+        if (retval != 0)
+            {
+            throw std::runtime_error("Error allocating AABBTree memory");
+            }
+
+        if (m_nodes != NULL)
+            free(m_nodes);
+
+        m_nodes = new_nodes;
+        m_node_capacity = n;
+        }
+
+    m_num_nodes = n;
+    }
+
 /*! Allocates a new node in the tree
 */
 inline unsigned int AABBTree::allocateNode()
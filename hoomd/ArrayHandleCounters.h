@@ -0,0 +1,151 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: joaander
+
+#pragma once
+
+/*! \file ArrayHandleCounters.h
+    \brief Declares a class for counting ArrayHandle acquisitions and memory transfers
+*/
+
+#include "Messenger.h"
+
+#include <atomic>
+#include <memory>
+
+//! Counts ArrayHandle acquisitions and the implicit host<->device transfers they trigger
+/*! When counting is enabled in the ExecutionConfiguration, every acquire() of a GPUArray or GlobalArray reports to
+    this class. The counters are atomic, so handles may be acquired concurrently by TBB threads.
+
+    System resets the counters at the start of every run() and prints them, averaged per time step, at the end.
+*/
+class ArrayHandleCounters
+    {
+    public:
+        //! Constructor
+        ArrayHandleCounters()
+            {
+            reset();
+            }
+
+        //! Count a handle acquisition
+        /*! \param device True if the data was acquired on the device
+        */
+        void countAcquire(bool device)
+            {
+            if (device)
+                m_device_acquires.fetch_add(1, std::memory_order_relaxed);
+            else
+                m_host_acquires.fetch_add(1, std::memory_order_relaxed);
+            }
+
+        //! Count a memory transfer
+        /*! \param to_device True if the data was copied from the host to the device
+            \param nbytes Number of bytes copied
+        */
+        void countCopy(bool to_device, size_t nbytes)
+            {
+            if (to_device)
+                {
+                m_host_to_device_copies.fetch_add(1, std::memory_order_relaxed);
+                m_host_to_device_bytes.fetch_add(nbytes, std::memory_order_relaxed);
+                }
+            else
+                {
+                m_device_to_host_copies.fetch_add(1, std::memory_order_relaxed);
+                m_device_to_host_bytes.fetch_add(nbytes, std::memory_order_relaxed);
+                }
+            }
+
+        //! Count a synchronization with the device before host access to managed memory
+        void countSynchronize()
+            {
+            m_synchronizations.fetch_add(1, std::memory_order_relaxed);
+            }
+
+        //! Reset all counters to zero
+        void reset()
+            {
+            m_host_acquires = 0;
+            m_device_acquires = 0;
+            m_host_to_device_copies = 0;
+            m_device_to_host_copies = 0;
+            m_host_to_device_bytes = 0;
+            m_device_to_host_bytes = 0;
+            m_synchronizations = 0;
+            }
+
+        //! Get the number of handles acquired on the host
+        unsigned long long getHostAcquires() const
+            {
+            return m_host_acquires;
+            }
+
+        //! Get the number of handles acquired on the device
+        unsigned long long getDeviceAcquires() const
+            {
+            return m_device_acquires;
+            }
+
+        //! Get the number of host->device copies
+        unsigned long long getHostToDeviceCopies() const
+            {
+            return m_host_to_device_copies;
+            }
+
+        //! Get the number of device->host copies
+        unsigned long long getDeviceToHostCopies() const
+            {
+            return m_device_to_host_copies;
+            }
+
+        //! Get the number of bytes copied from the host to the device
+        unsigned long long getHostToDeviceBytes() const
+            {
+            return m_host_to_device_bytes;
+            }
+
+        //! Get the number of bytes copied from the device to the host
+        unsigned long long getDeviceToHostBytes() const
+            {
+            return m_device_to_host_bytes;
+            }
+
+        //! Get the number of device synchronizations before host access to managed memory
+        unsigned long long getSynchronizations() const
+            {
+            return m_synchronizations;
+            }
+
+        //! Print the counters
+        /*! \param msg Messenger to print to
+            \param nsteps Number of time steps the counts were accumulated over
+        */
+        void printStats(std::shared_ptr<Messenger> msg, unsigned int nsteps) const
+            {
+            // return early if the notice level is less than 1
+            if (msg->getNoticeLevel() < 1)
+                return;
+
+            double n = nsteps > 0 ? double(nsteps) : 1.0;
+
+            msg->notice(1) << "-- ArrayHandle stats (per step):" << std::endl;
+            msg->notice(1) << double(getHostAcquires())/n << " host acquires / "
+                           << double(getDeviceAcquires())/n << " device acquires" << std::endl;
+            msg->notice(1) << double(getHostToDeviceCopies())/n << " host->device copies ("
+                           << double(getHostToDeviceBytes())/n/1024.0/1024.0 << " MB) / "
+                           << double(getDeviceToHostCopies())/n << " device->host copies ("
+                           << double(getDeviceToHostBytes())/n/1024.0/1024.0 << " MB)" << std::endl;
+            msg->notice(1) << double(getSynchronizations())/n << " managed memory synchronizations" << std::endl;
+            }
+
+    private:
+        std::atomic<unsigned long long> m_host_acquires;          //!< Number of host acquisitions
+        std::atomic<unsigned long long> m_device_acquires;        //!< Number of device acquisitions
+        std::atomic<unsigned long long> m_host_to_device_copies;  //!< Number of host->device copies
+        std::atomic<unsigned long long> m_device_to_host_copies;  //!< Number of device->host copies
+        std::atomic<unsigned long long> m_host_to_device_bytes;   //!< Number of bytes copied host->device
+        std::atomic<unsigned long long> m_device_to_host_bytes;   //!< Number of bytes copied device->host
+        std::atomic<unsigned long long> m_synchronizations;       //!< Number of managed memory synchronizations
+    };
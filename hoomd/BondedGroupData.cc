@@ -303,6 +303,166 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromS
         }
     }
 
+/*! \param unit Snapshot of the bonded groups in the unit cell, identical on all ranks
+    \param n_replicas Number of replicas of the unit cell
+    \param n_unit_particles Number of particles in the unit cell
+
+    Initializes the groups that Snapshot::replicate() generates, without building the list of all groups on any
+    rank. The particle data must already be initialized with ParticleData::initializeReplicated(). Copy j of group g
+    has the group tag j*unit.size + g and member tags offset by j*n_unit_particles. Every rank visits only the unit
+    cell groups of its local particles.
+*/
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeReplicated(const Snapshot& unit,
+    unsigned int n_replicas, unsigned int n_unit_particles)
+    {
+    #ifdef ENABLE_MPI
+    if (!m_pdata->getDomainDecomposition())
+    #endif
+        {
+        // without domain decomposition, all groups are local
+        Snapshot snapshot(unit);
+        snapshot.replicate(n_replicas, n_unit_particles);
+        initializeFromSnapshot(snapshot);
+        return;
+        }
+
+    #ifdef ENABLE_MPI
+    // check that all fields in the snapshot have correct length
+    if (! unit.validate())
+        {
+        m_exec_conf->msg->error() << "init.*: invalid " << name << " data snapshot."
+                                << std::endl << std::endl;
+        throw std::runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+        }
+
+    // re-initialize data structures
+    initialize();
+
+    m_type_mapping = unit.type_mapping;
+
+    unsigned int n_unit_groups = unit.groups.size();
+    m_nglobal = n_unit_groups*n_replicas;
+
+    // check the unit cell groups once, with the same checks as addBondedGroup()
+    for (unsigned int g = 0; g < n_unit_groups; ++g)
+        {
+        const members_t& member_tags = unit.groups[g];
+
+        for (unsigned int i = 0; i < group_size; ++i)
+            if (member_tags.tag[i] >= n_unit_particles)
+                {
+                std::ostringstream oss;
+                oss << name << ".*: Particle tag out of bounds when attempting to add " << name << ": ";
+                for (unsigned int j = 0; j < group_size; ++j)
+                    oss << member_tags.tag[j] << ((j != group_size - 1) ? "," : "");
+                oss << std::endl;
+                m_exec_conf->msg->error() << oss.str();
+                throw runtime_error(std::string("Error adding ") + name);
+                }
+
+        for (unsigned int i = 0; i < group_size; ++i)
+            for (unsigned int j = 0; j < group_size; ++j)
+                if (i != j && member_tags.tag[i] == member_tags.tag[j])
+                    {
+                    std::ostringstream oss;
+                    oss << name << ".*: The same particle can only occur once in a " << name << ": ";
+                    for (unsigned int k = 0; k < group_size; ++k)
+                        oss << member_tags.tag[k] << ((k != group_size - 1) ? "," : "");
+                    oss << std::endl;
+                    m_exec_conf->msg->error() << oss.str();
+                    throw runtime_error(std::string("Error adding ") + name);
+                    }
+
+        if (has_type_mapping && unit.type_id[g] >= m_type_mapping.size())
+            {
+            m_exec_conf->msg->error() << name << ".*: Invalid " << name << " type " << unit.type_id[g]
+                << "! The number of types is " << m_type_mapping.size() << std::endl;
+            throw std::runtime_error(std::string("Error adding ") + name);
+            }
+        }
+
+    // the groups of every particle in the unit cell
+    std::vector< std::vector<unsigned int> > particle_groups(n_unit_particles);
+    for (unsigned int g = 0; g < n_unit_groups; ++g)
+        for (unsigned int k = 0; k < group_size; ++k)
+            particle_groups[unit.groups[g].tag[k]].push_back(g);
+
+    // collect the copies of the groups of all local particles
+    std::vector<unsigned int> group_rtag(m_nglobal, GROUP_NOT_LOCAL);
+    std::vector<members_t> groups;
+    std::vector<typeval_t> group_typeval;
+    std::vector<unsigned int> group_tag;
+
+        {
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+        for (unsigned int idx = 0; idx < m_pdata->getN(); ++idx)
+            {
+            unsigned int j = h_tag.data[idx] / n_unit_particles;
+            unsigned int i = h_tag.data[idx] % n_unit_particles;
+
+            for (unsigned int g : particle_groups[i])
+                {
+                unsigned int tag = j*n_unit_groups + g;
+
+                // a group is visited once for each local member
+                if (group_rtag[tag] != GROUP_NOT_LOCAL)
+                    continue;
+
+                members_t members;
+                for (unsigned int k = 0; k < group_size; ++k)
+                    members.tag[k] = unit.groups[g].tag[k] + j*n_unit_particles;
+
+                typeval_t t;
+                if (has_type_mapping)
+                    t.type = unit.type_id[g];
+                else
+                    t.val = unit.val[g];
+
+                group_rtag[tag] = groups.size();
+                groups.push_back(members);
+                group_typeval.push_back(t);
+                group_tag.push_back(tag);
+                }
+            }
+        }
+
+    m_n_groups = groups.size();
+    m_groups.resize(m_n_groups);
+    m_group_typeval.resize(m_n_groups);
+    m_group_tag.resize(m_n_groups);
+    m_group_ranks.resize(m_n_groups);
+    m_group_rtag.resize(m_nglobal);
+
+        {
+        ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::overwrite);
+        ArrayHandle<typeval_t> h_typeval(m_group_typeval, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_tag(m_group_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle<ranks_t> h_group_ranks(m_group_ranks, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_rtag(m_group_rtag, access_location::host, access_mode::overwrite);
+
+        for (unsigned int group_idx = 0; group_idx < m_n_groups; ++group_idx)
+            {
+            h_groups.data[group_idx] = groups[group_idx];
+            h_typeval.data[group_idx] = group_typeval[group_idx];
+            h_group_tag.data[group_idx] = group_tag[group_idx];
+            for (unsigned int k = 0; k < group_size; ++k)
+                h_group_ranks.data[group_idx].idx[k] = 0;
+            }
+        std::copy(group_rtag.begin(), group_rtag.end(), h_group_rtag.data);
+        }
+
+    for (unsigned int tag = 0; tag < m_nglobal; ++tag)
+        m_tag_set.insert(tag);
+    m_invalid_cached_tags = true;
+
+    // notify observers
+    m_group_num_change_signal.emit();
+    notifyGroupReorder();
+    #endif
+    }
+
 template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
 unsigned int BondedGroupData<group_size, Group, name, has_type_mapping>::addBondedGroup(Group g)
     {
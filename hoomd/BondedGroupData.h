@@ -246,6 +246,9 @@ class BondedGroupData
         //! Initialize from a snapshot
         virtual void initializeFromSnapshot(const Snapshot& snapshot);
 
+        //! Initialize with the groups of a unit cell replicated along with the particles
+        void initializeReplicated(const Snapshot& unit, unsigned int n_replicas, unsigned int n_unit_particles);
+
         //! Take a snapshot
         virtual std::map<unsigned int, unsigned int> takeSnapshot(Snapshot& snapshot) const;
 
@@ -27,6 +27,15 @@ using namespace std;
 #include "CachedAllocator.h"
 #endif
 
+#include "HostCachedAllocator.h"
+
+#if defined(ENABLE_TBB) && defined(__linux__)
+#include <sched.h>
+#include <pthread.h>
+#include <atomic>
+#include <iterator>
+#endif
+
 /*! \file ExecutionConfiguration.cc
     \brief Defines ExecutionConfiguration and related classes
 */
@@ -222,8 +231,11 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
         }
     #endif
 
+    m_host_cached_alloc.reset(new HostCachedAllocator());
+
     #ifdef ENABLE_TBB
     m_num_threads = tbb::task_scheduler_init::default_num_threads();
+    m_numa_first_touch = false;
 
     char *env;
     if ((env = getenv("OMP_NUM_THREADS")) != NULL)
@@ -249,6 +261,10 @@ ExecutionConfiguration::~ExecutionConfiguration()
     {
     msg->notice(5) << "Destroying ExecutionConfiguration" << endl;
 
+    #ifdef ENABLE_TBB
+    m_thread_pinning.reset();
+    #endif
+
     #ifdef ENABLE_CUDA
     for (int idev = m_gpu_id.size()-1; idev >= 0; --idev)
         {
@@ -821,6 +837,160 @@ int ExecutionConfiguration::guessLocalRank(bool &found)
     #endif
     }
 
+#ifdef ENABLE_TBB
+#ifdef __linux__
+namespace
+{
+//! Pins the threads that enter the TBB scheduler to the CPUs available to the process, one CPU per thread
+class ThreadPinningObserver : public tbb::task_scheduler_observer
+    {
+    public:
+        //! Constructor
+        /*! \param cpus The CPUs to pin threads to, in order
+        */
+        ThreadPinningObserver(const std::vector<int>& cpus)
+            : m_cpus(cpus), m_next(0)
+            {
+            observe(true);
+            }
+
+        //! Destructor
+        virtual ~ThreadPinningObserver()
+            {
+            observe(false);
+            }
+
+        //! Pin the calling thread to the next CPU
+        virtual void on_scheduler_entry(bool is_worker)
+            {
+            unsigned int idx = m_next++;
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            CPU_SET(m_cpus[idx % m_cpus.size()], &cpuset);
+            pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+            }
+
+    private:
+        std::vector<int> m_cpus;               //!< CPUs available to the process
+        std::atomic<unsigned int> m_next;      //!< Index of the CPU for the next thread
+    };
+}
+#endif
+
+/*! \param pin True to pin the TBB threads, false to let the operating system schedule them
+
+    The threads are pinned round robin to the CPUs in the affinity mask of the process at the time of the call, so
+    that a binding set by the MPI launcher is respected. Threads that already run are pinned the next time they enter
+    the scheduler. Unpinning stops pinning new threads but does not release threads that are already pinned.
+
+    In MPI runs, the launcher does not always give every rank its own CPUs (e.g. with --bind-to none, socket binding,
+    or no binding at all). Ranks on the same node with identical affinity masks therefore split the mask into
+    contiguous, disjoint subsets of CPUs, one per rank. If the masks of ranks on the same node overlap only partially,
+    the threads are not pinned.
+
+    This method is collective over all ranks.
+*/
+void ExecutionConfiguration::setThreadAffinity(bool pin)
+    {
+    if (!pin)
+        {
+        m_thread_pinning.reset();
+        m_pinned_cpus.clear();
+        return;
+        }
+
+    #ifdef __linux__
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &cpuset) != 0)
+        {
+        msg->error() << "Unable to query the CPU affinity of the process" << endl;
+        throw runtime_error("Error setting thread affinity");
+        }
+
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+        if (CPU_ISSET(cpu, &cpuset))
+            cpus.push_back(cpu);
+        }
+
+    #ifdef ENABLE_MPI
+    // find the ranks on the same node
+    const MPI_Comm mpi_comm = m_mpi_config->getHOOMDWorldCommunicator();
+    int rank;
+    MPI_Comm_rank(mpi_comm, &rank);
+
+    char procname[MPI_MAX_PROCESSOR_NAME];
+    int len;
+    MPI_Get_processor_name(procname, &len);
+    std::string node(procname, len);
+
+    std::vector<std::string> nodes;
+    std::vector< std::vector<int> > node_cpus;
+    all_gather_v(node, nodes, mpi_comm);
+    all_gather_v(cpus, node_cpus, mpi_comm);
+
+    // ranks with the same mask share its CPUs, ranks with partially overlapping masks cannot be pinned
+    unsigned int n_share = 0;
+    unsigned int share_idx = 0;
+    bool partial_overlap = false;
+    for (unsigned int r = 0; r < nodes.size(); ++r)
+        {
+        if (nodes[r] != node)
+            continue;
+
+        if (node_cpus[r] == cpus)
+            {
+            if (r < (unsigned int)rank)
+                share_idx++;
+            n_share++;
+            }
+        else
+            {
+            std::vector<int> common;
+            std::set_intersection(cpus.begin(), cpus.end(), node_cpus[r].begin(), node_cpus[r].end(),
+                std::back_inserter(common));
+            if (!common.empty())
+                partial_overlap = true;
+            }
+        }
+
+    if (partial_overlap || n_share > cpus.size())
+        {
+        if (partial_overlap)
+            msg->warning() << "The CPU affinity masks of the ranks on node " << node << " overlap partially, "
+                           << "not pinning TBB threads" << endl;
+        else
+            msg->warning() << n_share << " ranks on node " << node << " share " << cpus.size() << " CPUs, "
+                           << "not pinning TBB threads" << endl;
+        m_thread_pinning.reset();
+        m_pinned_cpus.clear();
+        return;
+        }
+
+    if (n_share > 1)
+        {
+        // take a contiguous subset of the mask
+        std::vector<int> subset(cpus.begin() + share_idx*cpus.size()/n_share,
+            cpus.begin() + (share_idx+1)*cpus.size()/n_share);
+        cpus.swap(subset);
+        }
+    #endif
+
+    if (cpus.size() < m_num_threads)
+        {
+        msg->warning() << "Pinning " << m_num_threads << " TBB threads to " << cpus.size() << " CPUs" << endl;
+        }
+
+    msg->notice(2) << "Pinning TBB threads to " << cpus.size() << " CPUs" << endl;
+    m_thread_pinning.reset(new ThreadPinningObserver(cpus));
+    m_pinned_cpus = cpus;
+    #else
+    msg->warning() << "Thread pinning is not supported on this platform, ignoring" << endl;
+    #endif
+    }
+#endif
 
 void export_ExecutionConfiguration(py::module& m)
     {
@@ -846,10 +1016,17 @@ void export_ExecutionConfiguration(py::module& m)
         .def("getRank", &ExecutionConfiguration::getRank)
 #ifdef ENABLE_TBB
         .def("setNumThreads", &ExecutionConfiguration::setNumThreads)
+        .def("setThreadAffinity", &ExecutionConfiguration::setThreadAffinity)
+        .def("setNUMAFirstTouch", &ExecutionConfiguration::setNUMAFirstTouch)
 #endif
         .def("getNumThreads", &ExecutionConfiguration::getNumThreads)
+        .def("getThreadAffinity", &ExecutionConfiguration::getThreadAffinity)
+        .def("getPinnedCPUs", &ExecutionConfiguration::getPinnedCPUs)
+        .def("getNUMAFirstTouch", &ExecutionConfiguration::getNUMAFirstTouch)
         .def("setMemoryTracing", &ExecutionConfiguration::setMemoryTracing)
-        .def("getMemoryTracer", &ExecutionConfiguration::getMemoryTracer);
+        .def("getMemoryTracer", &ExecutionConfiguration::getMemoryTracer)
+        .def("setArrayHandleCounting", &ExecutionConfiguration::setArrayHandleCounting)
+        .def("getArrayHandleCounters", &ExecutionConfiguration::getArrayHandleCounters, py::return_value_policy::reference);
     ;
 
     py::enum_<ExecutionConfiguration::executionMode>(executionconfiguration,"executionMode")
@@ -858,4 +1035,15 @@ void export_ExecutionConfiguration(py::module& m)
         .value("AUTO", ExecutionConfiguration::executionMode::AUTO)
         .export_values()
     ;
+
+    py::class_<ArrayHandleCounters>(m,"ArrayHandleCounters")
+        .def("reset", &ArrayHandleCounters::reset)
+        .def("getHostAcquires", &ArrayHandleCounters::getHostAcquires)
+        .def("getDeviceAcquires", &ArrayHandleCounters::getDeviceAcquires)
+        .def("getHostToDeviceCopies", &ArrayHandleCounters::getHostToDeviceCopies)
+        .def("getDeviceToHostCopies", &ArrayHandleCounters::getDeviceToHostCopies)
+        .def("getHostToDeviceBytes", &ArrayHandleCounters::getHostToDeviceBytes)
+        .def("getDeviceToHostBytes", &ArrayHandleCounters::getDeviceToHostBytes)
+        .def("getSynchronizations", &ArrayHandleCounters::getSynchronizations)
+    ;
     }
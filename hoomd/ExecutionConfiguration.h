@@ -31,6 +31,7 @@
 
 #include "Messenger.h"
 #include "MemoryTraceback.h"
+#include "ArrayHandleCounters.h"
 
 /*! \file ExecutionConfiguration.h
     \brief Declares ExecutionConfiguration and related classes
@@ -47,6 +48,9 @@
 class CachedAllocator;
 #endif
 
+//! Forward declaration
+class HostCachedAllocator;
+
 // values used in measuring hoomd launch timing
 extern unsigned int hoomd_launch_time, hoomd_start_time, hoomd_mpi_init_time;
 extern bool hoomd_launch_timing;
@@ -266,6 +270,19 @@ struct PYBIND11_EXPORT ExecutionConfiguration
         m_task_scheduler.reset(new tbb::task_scheduler_init(num_threads));
         m_num_threads = num_threads;
         }
+
+    //! Pin each TBB thread to one of the CPUs available to the process
+    void setThreadAffinity(bool pin);
+
+    //! Set whether host memory of GPUArray and GlobalArray is first touched in parallel
+    /*! With first touch, the operating system places each page on the NUMA node of the thread that first writes to
+        it. Clearing new arrays in parallel spreads them over the NUMA nodes the TBB threads run on, instead of putting
+        all of them on the node of the thread that allocates.
+    */
+    void setNUMAFirstTouch(bool first_touch)
+        {
+        m_numa_first_touch = first_touch;
+        }
     #endif
 
     //! Return the number of active threads
@@ -278,6 +295,36 @@ struct PYBIND11_EXPORT ExecutionConfiguration
         #endif
         }
 
+    //! Returns true if the TBB threads are pinned to CPUs
+    bool getThreadAffinity() const
+        {
+        #ifdef ENABLE_TBB
+        return bool(m_thread_pinning);
+        #else
+        return false;
+        #endif
+        }
+
+    //! Returns the CPUs the TBB threads of this rank are pinned to, empty if they are not pinned
+    std::vector<int> getPinnedCPUs() const
+        {
+        #ifdef ENABLE_TBB
+        return m_pinned_cpus;
+        #else
+        return std::vector<int>();
+        #endif
+        }
+
+    //! Returns true if host memory is first touched in parallel
+    bool getNUMAFirstTouch() const
+        {
+        #ifdef ENABLE_TBB
+        return m_numa_first_touch;
+        #else
+        return false;
+        #endif
+        }
+
 
     #ifdef ENABLE_CUDA
     //! Returns the cached allocator for temporary allocations
@@ -293,6 +340,12 @@ struct PYBIND11_EXPORT ExecutionConfiguration
         }
     #endif
 
+    //! Returns the cached allocator for temporary host buffers
+    HostCachedAllocator& getHostCachedAllocator() const
+        {
+        return *m_host_cached_alloc;
+        }
+
     //! Set up memory tracing
     void setMemoryTracing(bool enable)
         {
@@ -308,6 +361,21 @@ struct PYBIND11_EXPORT ExecutionConfiguration
         return m_memory_traceback.get();
         }
 
+    //! Set up counting of ArrayHandle acquisitions and memory transfers
+    void setArrayHandleCounting(bool enable)
+        {
+        if (enable)
+            m_array_handle_counters = std::unique_ptr<ArrayHandleCounters>(new ArrayHandleCounters);
+        else
+            m_array_handle_counters = std::unique_ptr<ArrayHandleCounters>();
+        }
+
+    //! Returns the ArrayHandle counters, or NULL if counting is disabled
+    ArrayHandleCounters *getArrayHandleCounters() const
+        {
+        return m_array_handle_counters.get();
+        }
+
     //! Returns true if we are in a multi-GPU block
     bool inMultiGPUBlock() const
         {
@@ -358,15 +426,21 @@ private:
     std::unique_ptr<CachedAllocator> m_cached_alloc_managed; //!< Cached allocator for temporary allocations in managed memory
     #endif
 
+    std::unique_ptr<HostCachedAllocator> m_host_cached_alloc; //!< Cached allocator for temporary host buffers
+
     #ifdef ENABLE_TBB
     std::unique_ptr<tbb::task_scheduler_init> m_task_scheduler; //!< The TBB task scheduler
     unsigned int m_num_threads;            //!<  The number of TBB threads used
+    std::unique_ptr<tbb::task_scheduler_observer> m_thread_pinning; //!< Pins threads entering the scheduler, if set
+    std::vector<int> m_pinned_cpus;        //!< CPUs the threads are pinned to
+    bool m_numa_first_touch;               //!< True if new host memory is first touched in parallel
     #endif
 
     //! Setup and print out stats on the chosen CPUs/GPUs
     void setupStats();
 
     std::unique_ptr<MemoryTraceback> m_memory_traceback;    //!< Keeps track of allocations
+    std::unique_ptr<ArrayHandleCounters> m_array_handle_counters; //!< Counts handle acquisitions and transfers
     };
 
 // Macro for easy checking of CUDA errors - enabled all the time
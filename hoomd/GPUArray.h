@@ -175,6 +175,37 @@ class host_deleter
         bool m_use_device;     //!< Whether to use hostMallocManaged
         unsigned int m_N;      //!< Number of elements in array
     };
+
+//! Clear newly allocated host memory
+/*! \param ptr Start of the memory to clear
+    \param bytes Number of bytes to clear
+    \param exec_conf Execution configuration, may be null
+
+    If the execution configuration requests NUMA first touch, the TBB threads clear the memory in parallel, each in
+    contiguous blocks of pages. The operating system then places every page on the NUMA node of the thread that
+    touched it first, instead of putting the whole array on the node of the allocating thread.
+*/
+inline void host_memclear(void *ptr, size_t bytes, const std::shared_ptr<const ExecutionConfiguration>& exec_conf)
+    {
+    #ifdef ENABLE_TBB
+    const size_t page_bytes = 4096;
+    if (exec_conf && exec_conf->getNUMAFirstTouch() && bytes > page_bytes)
+        {
+        char *p = (char *)ptr;
+        size_t n_pages = (bytes + page_bytes - 1) / page_bytes;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, n_pages),
+            [=](const tbb::blocked_range<size_t>& r)
+            {
+            size_t begin = r.begin()*page_bytes;
+            size_t end = std::min(r.end()*page_bytes, bytes);
+            memset(p + begin, 0, end - begin);
+            }, tbb::static_partitioner());
+        return;
+        }
+    #endif
+
+    memset(ptr, 0, bytes);
+    }
 } // end namespace detail
 
 } // end namespace hoomd
@@ -972,7 +1003,7 @@ template<class T> void GPUArray<T>::memclear(unsigned int first)
     assert(first < m_num_elements);
 
     // clear memory
-    memset((void *)(h_data.get()+first), 0, sizeof(T)*(m_num_elements-first));
+    hoomd::detail::host_memclear((void *)(h_data.get()+first), sizeof(T)*(m_num_elements-first), m_exec_conf);
 
 #ifdef ENABLE_CUDA
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
@@ -1003,6 +1034,8 @@ template<class T> void GPUArray<T>::memcpyDeviceToHost(bool async) const
     if (m_exec_conf)
         m_exec_conf->msg->notice(8) << "GPUArray: Copying " << float(m_num_elements*sizeof(T))/1024.0f/1024.0f << " MB device->host " <<
            (async ? std::string("async") : std::string()) << std::endl;
+    if (m_exec_conf && m_exec_conf->getArrayHandleCounters())
+        m_exec_conf->getArrayHandleCounters()->countCopy(false, sizeof(T)*m_num_elements);
     if (async)
         cudaMemcpyAsync(h_data.get(), d_data.get(), sizeof(T)*m_num_elements, cudaMemcpyDeviceToHost);
     else
@@ -1030,6 +1063,8 @@ template<class T> void GPUArray<T>::memcpyHostToDevice(bool async) const
     if (m_exec_conf)
         m_exec_conf->msg->notice(8) << "GPUArray: Copying " << float(m_num_elements*sizeof(T))/1024.0f/1024.0f << " MB host->device " <<
            (async ? std::string("async") : std::string()) << std::endl;
+    if (m_exec_conf && m_exec_conf->getArrayHandleCounters())
+        m_exec_conf->getArrayHandleCounters()->countCopy(true, sizeof(T)*m_num_elements);
     if (async)
         cudaMemcpyAsync(d_data.get(), h_data.get(), sizeof(T)*m_num_elements, cudaMemcpyHostToDevice);
     else
@@ -1061,6 +1096,22 @@ ArrayHandleDispatch<T> GPUArray<T>::acquire(const access_location::Enum location
     assert(!m_acquired);
     m_acquired = true;
 
+    if (m_exec_conf && m_exec_conf->getArrayHandleCounters())
+        m_exec_conf->getArrayHandleCounters()->countAcquire(location != access_location::host);
+
+    // fast path - host access to data that is only on the host involves no transfers, and the state stays on the
+    // host regardless of the access mode. Without CUDA, the data can never leave the host.
+#ifdef ENABLE_CUDA
+    if (location == access_location::host && m_data_location == data_location::host)
+#else
+    assert(m_data_location == data_location::host);
+    if (location == access_location::host)
+#endif
+        {
+        // h_data is NULL for a NULL GPUArray
+        return GPUArrayDispatch<T>(h_data.get(), *this);
+        }
+
     // base case - handle acquiring a NULL GPUArray by simply returning NULL to prevent any memcpys from being attempted
     if (isNull())
         return GPUArrayDispatch<T>(nullptr, *this);
@@ -1069,13 +1120,8 @@ ArrayHandleDispatch<T> GPUArray<T>::acquire(const access_location::Enum location
     if (location == access_location::host)
         {
         // then break down based on the current location of the data
-        if (m_data_location == data_location::host)
-            {
-            // the state stays on the host regardles of the access mode
-            return GPUArrayDispatch<T>(h_data.get(), *this);
-            }
 #ifdef ENABLE_CUDA
-        else if (m_data_location == data_location::hostdevice)
+        if (m_data_location == data_location::hostdevice)
             {
             // finally perform the action based on the access mode requested
             if (mode == access_mode::read)  // state stays on hostdevice
@@ -1125,8 +1171,8 @@ ArrayHandleDispatch<T> GPUArray<T>::acquire(const access_location::Enum location
 
             return GPUArrayDispatch<T>(h_data.get(),*this);
             }
-#endif
         else
+#endif
             {
             if (m_exec_conf)
                 m_exec_conf->msg->error() << "Invalid data location state" << std::endl;
@@ -1248,7 +1294,7 @@ template<class T> T* GPUArray<T>::resizeHostArray(unsigned int num_elements)
         }
 #endif
     // clear memory
-    memset((void *)h_tmp, 0, sizeof(T)*num_elements);
+    hoomd::detail::host_memclear((void *)h_tmp, sizeof(T)*num_elements, m_exec_conf);
 
     // copy over data
     unsigned int num_copy_elements = m_num_elements > num_elements ? num_elements : m_num_elements;
@@ -1304,7 +1350,7 @@ template<class T> T* GPUArray<T>::resize2DHostArray(unsigned int pitch, unsigned
 #endif
 
     // clear memory
-    memset((void *)h_tmp, 0, sizeof(T)*new_pitch*new_height);
+    hoomd::detail::host_memclear((void *)h_tmp, sizeof(T)*new_pitch*new_height, m_exec_conf);
 
     // copy over data
     // every column is copied separately such as to align with the new pitch
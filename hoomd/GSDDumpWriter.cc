@@ -11,6 +11,7 @@
 #include "GSDDumpWriter.h"
 #include "Filesystem.h"
 #include "HOOMDVersion.h"
+#include "HostCachedAllocator.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
@@ -178,7 +179,7 @@ void GSDDumpWriter::analyze(unsigned int timestep)
 
     // take particle data snapshot
     m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
-    SnapshotParticleData<float> snapshot;
+    SnapshotParticleData<float>& snapshot = m_snapshot;
     const std::map<unsigned int, unsigned int>& map = m_pdata->takeSnapshot<float>(snapshot);
 
 #ifdef ENABLE_MPI
@@ -337,10 +338,13 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
     int retval;
     uint64_t nframes = gsd_get_nframes(&m_handle);
 
+    // the per-chunk buffers are recycled between frames
+    HostCachedAllocator& alloc = m_exec_conf->getHostCachedAllocator();
+
     writeTypeMapping("particles/types", snapshot.type_mapping);
 
         {
-        std::vector<uint32_t> type(N);
+        cached_host_vector<uint32_t> type(N, uint32_t(0), alloc);
         type.reserve(1); //! make sure we allocate
         bool all_default = true;
 
@@ -369,7 +373,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         }
 
         {
-        std::vector<float> data(N);
+        cached_host_vector<float> data(N, float(0), alloc);
         data.reserve(1); //! make sure we allocate
         bool all_default = true;
 
@@ -447,7 +451,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         }
 
         {
-        std::vector<int32_t> body(N);
+        cached_host_vector<int32_t> body(N, int32_t(0), alloc);
         body.reserve(1); //! make sure we allocate
         bool all_default = true;
 
@@ -476,7 +480,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         }
 
         {
-        std::vector<float> data(uint64_t(N)*3);
+        cached_host_vector<float> data(uint64_t(N)*3, float(0), alloc);
         data.reserve(1); //! make sure we allocate
         bool all_default = true;
 
@@ -521,8 +525,10 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
     int retval;
     uint64_t nframes = gsd_get_nframes(&m_handle);
 
+    HostCachedAllocator& alloc = m_exec_conf->getHostCachedAllocator();
+
         {
-        std::vector<float> data(uint64_t(N)*3);
+        cached_host_vector<float> data(uint64_t(N)*3, float(0), alloc);
         data.reserve(1); //! make sure we allocate
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
@@ -544,7 +550,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
         }
 
         {
-        std::vector<float> data(uint64_t(N)*4);
+        cached_host_vector<float> data(uint64_t(N)*4, float(0), alloc);
         data.reserve(1); //! make sure we allocate
         bool all_default = true;
 
@@ -591,8 +597,10 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
     int retval;
     uint64_t nframes = gsd_get_nframes(&m_handle);
 
+    HostCachedAllocator& alloc = m_exec_conf->getHostCachedAllocator();
+
         {
-        std::vector<float> data(uint64_t(N)*3);
+        cached_host_vector<float> data(uint64_t(N)*3, float(0), alloc);
         data.reserve(1); //! make sure we allocate
         bool all_default = true;
 
@@ -627,7 +635,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         }
 
         {
-        std::vector<float> data(uint64_t(N)*4);
+        cached_host_vector<float> data(uint64_t(N)*4, float(0), alloc);
         data.reserve(1); //! make sure we allocate
         bool all_default = true;
 
@@ -664,7 +672,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         }
 
         {
-        std::vector<int32_t> data(uint64_t(N)*3);
+        cached_host_vector<int32_t> data(uint64_t(N)*3, int32_t(0), alloc);
         data.reserve(1); //! make sure we allocate
         bool all_default = true;
 
@@ -715,6 +723,8 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
                                   ConstraintData::Snapshot& constraint,
                                   PairData::Snapshot& pair)
     {
+    HostCachedAllocator& alloc = m_exec_conf->getHostCachedAllocator();
+
     if (bond.size > 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/N" << endl;
@@ -793,7 +803,7 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/value" << endl;
             {
-            std::vector<float> data(N);
+            cached_host_vector<float> data(N, float(0), alloc);
             data.reserve(1); //! make sure we allocate
             for (unsigned int i = 0; i < N; i++)
                 data[i] = float(constraint.val[i]);
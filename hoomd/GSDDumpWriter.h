@@ -89,6 +89,7 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         std::shared_ptr<ParticleGroup> m_group;   //!< Group to write out to the file
         std::map<std::string, bool> m_nondefault; //!< Map of quantities (true when non-default in frame 0)
         std::map<std::string, pybind11::function> m_user_log;   //!< Map of user-defined quantities to log
+        SnapshotParticleData<float> m_snapshot;    //!< Particle data snapshot, kept to reuse its storage between frames
 
         hoomd::detail::SharedSignal<int (gsd_handle&)> m_write_signal;
 
@@ -13,6 +13,7 @@
 #include "ExecutionConfiguration.h"
 #include "hoomd/extern/gsd.h"
 #include <string.h>
+#include <unistd.h>
 
 #include <stdexcept>
 using namespace std;
@@ -23,21 +24,27 @@ namespace py = pybind11;
     \param name File name to read
     \param frame Frame index to read from the file
     \param from_end Count frames back from the end of the file
+    \param distributed Read a stripe of the particles on every rank
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file into
-    memory (on the root rank).
+    memory (on the root rank). In a distributed read, all ranks open the file and read their stripe of the
+    particles. The distributed read has no effect on a single rank.
 */
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string &name,
                      const uint64_t frame,
-                     bool from_end)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     bool from_end,
+                     bool distributed)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame), m_distributed(false), m_n_global(0),
+      m_first(0)
     {
     m_snapshot = std::shared_ptr< SnapshotSystemData<float> >(new SnapshotSystemData<float>);
 
     #ifdef ENABLE_MPI
+    m_distributed = distributed && m_exec_conf->getNRanks() > 1;
+
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_distributed && !m_exec_conf->isRoot())
         {
         return;
         }
@@ -74,14 +81,17 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
 
     readHeader();
     readParticles();
-    readTopology();
+
+    // bonded groups are broadcast by the root rank during initialization
+    if (m_exec_conf->isRoot())
+        readTopology();
     }
 
 GSDReader::~GSDReader()
     {
     #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_distributed && !m_exec_conf->isRoot())
         {
         return;
         }
@@ -131,6 +141,59 @@ bool GSDReader::readChunk(void *data, uint64_t frame, const char *name, size_t e
         }
     }
 
+/*! \param data Pointer to data to read into
+    \param name Name of the data chunk
+    \param row_size Expected size of the data for one particle in bytes
+
+    Reads a per-particle chunk at the current frame with the same fallback rules as readChunk(). In a distributed
+    read, only the rows of the stripe of this rank are read from the file.
+
+    Return true if data is actually read from the file.
+*/
+bool GSDReader::readParticleChunk(void *data, const char *name, size_t row_size)
+    {
+    unsigned int N = m_snapshot->particle_data.size;
+    if (!m_distributed)
+        return readChunk(data, m_frame, name, N*row_size, N);
+
+    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, m_frame, name);
+    if (entry == NULL && m_frame != 0)
+        entry = gsd_find_chunk(&m_handle, 0, name);
+
+    if (entry == NULL || entry->N != m_n_global)
+        {
+        m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+        return false;
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading stripe of chunk " << name << endl;
+    size_t actual_row_size = entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_row_size != row_size)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting " << m_n_global*row_size << " bytes in "
+                                  << name << " but found " << m_n_global*actual_row_size << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    // read the rows directly from the file, pread may return fewer bytes than requested
+    char *ptr = (char *)data;
+    size_t count = N*row_size;
+    int64_t offset = entry->location + int64_t(m_first)*row_size;
+    size_t total_bytes_read = 0;
+    while (total_bytes_read < count)
+        {
+        ssize_t bytes_read = pread(m_handle.fd, ptr + total_bytes_read, count - total_bytes_read,
+                                   offset + total_bytes_read);
+        if (bytes_read == -1)
+            checkError(GSD_ERROR_IO);
+        if (bytes_read == 0)
+            checkError(GSD_ERROR_FILE_CORRUPT);
+        total_bytes_read += bytes_read;
+        }
+
+    return true;
+    }
+
 /*! \param frame Frame index to read from
     \param name Name of the data chunk
 
@@ -174,6 +237,8 @@ std::vector<std::string> GSDReader::readTypes(uint64_t frame, const char *name)
     }
 
 /*! Read the same data chunks written by GSDDumpWriter::writeFrameHeader
+
+    In a distributed read, the snapshot is sized for the stripe of this rank.
 */
 void GSDReader::readHeader()
     {
@@ -195,6 +260,16 @@ void GSDReader::readHeader()
         m_exec_conf->msg->error() << "data.gsd_snapshot: " << "cannot read a file with 0 particles" << endl;
         throw runtime_error("Error reading GSD file");
         }
+
+    m_n_global = N;
+    if (m_distributed)
+        {
+        // split the particles into contiguous stripes of nearly equal size, in rank order
+        uint64_t rank = m_exec_conf->getRank();
+        uint64_t n_ranks = m_exec_conf->getNRanks();
+        m_first = (uint64_t(N) * rank) / n_ranks;
+        N = (uint64_t(N) * (rank + 1)) / n_ranks - m_first;
+        }
     m_snapshot->particle_data.resize(N);
     }
 
@@ -202,22 +277,22 @@ void GSDReader::readHeader()
 */
 void GSDReader::readParticles()
     {
-    uint64_t N = m_snapshot->particle_data.size;
     m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
 
     // the snapshot already has default values, if a chunk is not found, the value
     // is already at the default, and the failed read is not a problem
-    readChunk(&m_snapshot->particle_data.type[0], m_frame, "particles/typeid", N*4, N);
-    readChunk(&m_snapshot->particle_data.mass[0], m_frame, "particles/mass", N*4, N);
-    readChunk(&m_snapshot->particle_data.charge[0], m_frame, "particles/charge", N*4, N);
-    readChunk(&m_snapshot->particle_data.diameter[0], m_frame, "particles/diameter", N*4, N);
-    readChunk(&m_snapshot->particle_data.body[0], m_frame, "particles/body", N*4, N);
-    readChunk(&m_snapshot->particle_data.inertia[0], m_frame, "particles/moment_inertia", N*12, N);
-    readChunk(&m_snapshot->particle_data.pos[0], m_frame, "particles/position", N*12, N);
-    readChunk(&m_snapshot->particle_data.orientation[0], m_frame, "particles/orientation", N*16, N);
-    readChunk(&m_snapshot->particle_data.vel[0], m_frame, "particles/velocity", N*12, N);
-    readChunk(&m_snapshot->particle_data.angmom[0], m_frame, "particles/angmom", N*16, N);
-    readChunk(&m_snapshot->particle_data.image[0], m_frame, "particles/image", N*12, N);
+    SnapshotParticleData<float>& pdata = m_snapshot->particle_data;
+    readParticleChunk(pdata.type.data(), "particles/typeid", 4);
+    readParticleChunk(pdata.mass.data(), "particles/mass", 4);
+    readParticleChunk(pdata.charge.data(), "particles/charge", 4);
+    readParticleChunk(pdata.diameter.data(), "particles/diameter", 4);
+    readParticleChunk(pdata.body.data(), "particles/body", 4);
+    readParticleChunk(pdata.inertia.data(), "particles/moment_inertia", 12);
+    readParticleChunk(pdata.pos.data(), "particles/position", 12);
+    readParticleChunk(pdata.orientation.data(), "particles/orientation", 16);
+    readParticleChunk(pdata.vel.data(), "particles/velocity", 12);
+    readParticleChunk(pdata.angmom.data(), "particles/angmom", 16);
+    readParticleChunk(pdata.image.data(), "particles/image", 12);
     }
 
 /*! Read the same data chunks for topology
@@ -360,9 +435,11 @@ void export_GSDReader(py::module& m)
     {
     py::class_< GSDReader, std::shared_ptr<GSDReader> >(m,"GSDReader")
     .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool>())
+    .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool, bool>())
     .def("getTimeStep", &GSDReader::getTimeStep)
     .def("getSnapshot", &GSDReader::getSnapshot)
     .def("clearSnapshot", &GSDReader::clearSnapshot)
+    .def("isDistributed", &GSDReader::isDistributed)
     .def("readTypeShapesPy", &GSDReader::readTypeShapesPy)
     ;
     }
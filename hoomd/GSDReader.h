@@ -30,6 +30,11 @@ template <class Real> struct SnapshotSystemData;
 /*! Read an input GSD file and generate a system snapshot. GSDReader can read any frame from a GSD
     file into the snapshot. For information on the GSD specification, see http://gsd.readthedocs.io/
 
+    By default, only the root rank reads the file. In a distributed read, every rank opens the file and reads a
+    contiguous stripe of the per-particle chunks into its snapshot. Such a snapshot initializes the system with
+    SystemDefinition(snapshot, exec_conf, decomposition, true), which never gathers the particles on one rank.
+    Bonded groups are still read on the root rank.
+
     \ingroup data_structs
 */
 class PYBIND11_EXPORT GSDReader
@@ -39,7 +44,8 @@ class PYBIND11_EXPORT GSDReader
         GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                   const std::string &name,
                   const uint64_t frame,
-                  bool from_end);
+                  bool from_end,
+                  bool distributed=false);
 
         //! Destructor
         ~GSDReader();
@@ -73,6 +79,12 @@ class PYBIND11_EXPORT GSDReader
         //! Helper function to read a quantity from the file
         bool readChunk(void *data, uint64_t frame, const char *name, size_t expected_size, unsigned int cur_n=0);
 
+        //! Returns true if every rank holds a stripe of the particles in its snapshot
+        bool isDistributed() const
+            {
+            return m_distributed;
+            }
+
         //! clears the snapshot object
         void clearSnapshot()
             {
@@ -94,6 +106,12 @@ class PYBIND11_EXPORT GSDReader
         uint64_t m_frame;                                            //!< Cached frame
         std::shared_ptr< SnapshotSystemData<float> > m_snapshot;   //!< The snapshot to read
         gsd_handle m_handle;                                         //!< Handle to the file
+        bool m_distributed;                                          //!< True if all ranks read a stripe of the file
+        unsigned int m_n_global;                                     //!< Number of particles in the frame
+        unsigned int m_first;                                        //!< First particle in the stripe of this rank
+
+        //! Helper function to read the stripe of a per-particle quantity from the file
+        bool readParticleChunk(void *data, const char *name, size_t row_size);
 
         //! Helper function to read a type list from the file
         std::vector<std::string> readTypes(uint64_t frame, const char *name);
@@ -391,6 +391,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
                 m_is_managed = std::move(other.m_is_managed);
                 #ifdef ENABLE_CUDA
                 m_event = std::move(other.m_event);
+                m_device_access = true;
                 #endif
                 }
 
@@ -451,6 +452,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
             std::swap(m_is_managed, from.m_is_managed);
             #ifdef ENABLE_CUDA
             std::swap(m_event, from.m_event);
+            std::swap(m_device_access, from.m_device_access);
             #endif
 
             #ifndef ALWAYS_USE_MANAGED_MEMORY
@@ -692,6 +694,9 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
 
         #ifdef ENABLE_CUDA
         std::unique_ptr<cudaEvent_t, hoomd::detail::event_deleter> m_event;   //! CUDA event for synchronization
+
+        //! True if kernels may have accessed the data since the last synchronization (used with concurrent managed access)
+        mutable bool m_device_access = true;
         #endif
 
         //! Allocate the managed array and construct the items
@@ -744,6 +749,10 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
                     }
                 allocation_bytes = m_num_elements*sizeof(T);
                 allocation_ptr = ptr;
+
+                // place the pages on the NUMA nodes of the threads
+                if (this->m_exec_conf && this->m_exec_conf->getNUMAFirstTouch())
+                    hoomd::detail::host_memclear(ptr, allocation_bytes, this->m_exec_conf);
                 }
 
             #ifdef ENABLE_CUDA
@@ -813,6 +822,11 @@ inline ArrayHandleDispatch<T> GlobalArray<T>::acquire(const access_location::Enu
                         ) const
 
     {
+    #if !defined(ENABLE_CUDA) && !defined(ALWAYS_USE_MANAGED_MEMORY)
+    // without CUDA there is no managed memory, always use the host-only path of the fallback
+    return m_fallback.acquire(location, mode);
+    #else
+
     #ifndef ALWAYS_USE_MANAGED_MEMORY
     if (!this->m_exec_conf || ! m_is_managed)
         return m_fallback.acquire(location, mode
@@ -825,6 +839,9 @@ inline ArrayHandleDispatch<T> GlobalArray<T>::acquire(const access_location::Enu
     checkAcquired(*this);
     m_acquired = true;
 
+    if (this->m_exec_conf && this->m_exec_conf->getArrayHandleCounters())
+        this->m_exec_conf->getArrayHandleCounters()->countAcquire(location != access_location::host);
+
     // make sure a null array can be acquired
     if (!this->m_exec_conf || isNull() )
         return GlobalArrayDispatch<T>(nullptr, *this);
@@ -837,15 +854,28 @@ inline ArrayHandleDispatch<T> GlobalArray<T>::acquire(const access_location::Enu
 
     #ifdef ENABLE_CUDA
     bool use_device = this->m_exec_conf && this->m_exec_conf->isCUDAEnabled();
-    if (!isNull() && use_device && location == access_location::host && !async)
+    if (location == access_location::device)
         {
-        // synchronize GPU 0
+        // kernels may access the data until the next synchronization
+        m_device_access = true;
+        }
+    else if (!isNull() && use_device && !async
+        && (m_device_access || !this->m_exec_conf->allConcurrentManagedAccess()))
+        {
+        // synchronize GPU 0. Without concurrent managed access, any host access to managed memory faults while a
+        // kernel is running, so the synchronization can only be skipped on devices that support it.
         cudaEventRecord(*m_event);
         cudaEventSynchronize(*m_event);
         if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
+
+        m_device_access = false;
+
+        if (this->m_exec_conf->getArrayHandleCounters())
+            this->m_exec_conf->getArrayHandleCounters()->countSynchronize();
         }
     #endif
 
     return GlobalArrayDispatch<T>(m_data.get(), *this);
+    #endif
     }
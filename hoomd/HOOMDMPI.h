@@ -12,6 +12,10 @@
 
     The functions provided here imitate some basic boost.MPI functionality.
 
+    Objects are serialized with cereal for transmission. Vectors of trivially copyable objects (e.g. the per-particle
+    arrays of the snapshots) are instead transmitted directly from and into their storage by dedicated overloads of
+    scatter_v(), gather_v() and all_gather_v().
+
     Usage of boost.Serialization is made as described in
     http://stackoverflow.com/questions/3015582/
 */
@@ -22,7 +26,9 @@
 
 #include <mpi.h>
 
+#include <cstring>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 #include <cereal/types/set.hpp>
@@ -416,6 +422,283 @@ void all_gather_v(const T& in_value, std::vector<T> & out_values, const MPI_Comm
     delete[] rbuf;
     }
 
+//! Type trait selecting the raw byte transfer in the MPI wrappers below
+/*! gcc 4.8 does not provide std::is_trivially_copyable, fall back to the compiler intrinsics there. The name
+    differs from the standard trait so that it stays unambiguous in files that use namespace std.
+*/
+template<typename T>
+struct is_trivially_copyable_compat
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ < 5)
+    : std::integral_constant<bool, __has_trivial_copy(T) && __has_trivial_assign(T) && __has_trivial_destructor(T)>
+#else
+    : std::is_trivially_copyable<T>
+#endif
+    {
+    };
+
+//! Create a contiguous MPI datatype spanning one object of a trivially copyable type
+/*! The caller is responsible for freeing the datatype with MPI_Type_free.
+
+    Counts and displacements of collectives using this type are in units of objects, not bytes, which
+    extends the range of the int arguments of MPI by a factor sizeof(T).
+*/
+template<typename T>
+MPI_Datatype create_mpi_bytes_type()
+    {
+    MPI_Datatype mpi_type;
+    MPI_Type_contiguous(sizeof(T), MPI_BYTE, &mpi_type);
+    MPI_Type_commit(&mpi_type);
+    return mpi_type;
+    }
+
+//! Compute displacements from counts and return the total count
+inline unsigned int counts_to_displs(const int *counts, int *displs, unsigned int n)
+    {
+    unsigned int len = 0;
+    for (unsigned int i = 0; i < n; i++)
+        {
+        displs[i] = len;
+        len += counts[i];
+        }
+    return len;
+    }
+
+//! Wrapper around MPI_Scatterv for vectors of trivially copyable objects
+/*! Unlike the generic scatter_v(), the vector elements are transmitted directly without serialization.
+    The receive buffer is the storage of \a out_values.
+*/
+template<typename T>
+typename std::enable_if<is_trivially_copyable_compat<T>::value>::type
+scatter_v(const std::vector< std::vector<T> >& in_values, std::vector<T>& out_values, unsigned int root,
+    const MPI_Comm mpi_comm)
+    {
+    int rank;
+    int size;
+    MPI_Comm_rank(mpi_comm, &rank);
+    MPI_Comm_size(mpi_comm, &size);
+
+    std::vector<int> send_counts;
+    std::vector<int> displs;
+    std::vector<T> sbuf;
+
+    if (rank == (int) root)
+        {
+        assert(in_values.size() == (unsigned int) size);
+        send_counts.resize(size);
+        displs.resize(size);
+
+        for (unsigned int i = 0; i < (unsigned int) size; i++)
+            send_counts[i] = in_values[i].size();
+        unsigned int len = counts_to_displs(send_counts.data(), displs.data(), size);
+
+        // pack vectors into one send buffer
+        sbuf.resize(len);
+        for (unsigned int i = 0; i < (unsigned int) size; i++)
+            if (send_counts[i])
+                memcpy(sbuf.data() + displs[i], in_values[i].data(), sizeof(T)*send_counts[i]);
+        }
+
+    // scatter the number of elements
+    int recv_count;
+    MPI_Scatter(send_counts.data(), 1, MPI_INT, &recv_count, 1, MPI_INT, root, mpi_comm);
+
+    out_values.resize(recv_count);
+
+    MPI_Datatype mpi_type = create_mpi_bytes_type<T>();
+    MPI_Scatterv(sbuf.data(), send_counts.data(), displs.data(), mpi_type,
+        out_values.data(), recv_count, mpi_type, root, mpi_comm);
+    MPI_Type_free(&mpi_type);
+    }
+
+//! Wrapper around MPI_Scatterv for trivially copyable objects stored contiguously on the root rank
+/*! \param in_values Elements to scatter, ordered by destination rank (only read on root)
+    \param counts Number of elements sent to each rank (only read on root)
+    \param out_values Elements received by this rank
+    \param root Rank that scatters the data
+    \param mpi_comm MPI communicator
+
+    Neither side copies the data, the send and receive buffers are the storage of the vectors.
+*/
+template<typename T>
+void scatter_v(const std::vector<T>& in_values, const std::vector<unsigned int>& counts,
+    std::vector<T>& out_values, unsigned int root, const MPI_Comm mpi_comm)
+    {
+    static_assert(is_trivially_copyable_compat<T>::value, "scatter_v with counts requires trivially copyable data");
+
+    int rank;
+    int size;
+    MPI_Comm_rank(mpi_comm, &rank);
+    MPI_Comm_size(mpi_comm, &size);
+
+    std::vector<int> send_counts;
+    std::vector<int> displs;
+    if (rank == (int) root)
+        {
+        assert(counts.size() == (unsigned int) size);
+        send_counts.assign(counts.begin(), counts.end());
+        displs.resize(size);
+        unsigned int len = counts_to_displs(send_counts.data(), displs.data(), size);
+        assert(len == in_values.size());
+        }
+
+    int recv_count;
+    MPI_Scatter(send_counts.data(), 1, MPI_INT, &recv_count, 1, MPI_INT, root, mpi_comm);
+
+    out_values.resize(recv_count);
+
+    MPI_Datatype mpi_type = create_mpi_bytes_type<T>();
+    MPI_Scatterv((void *) in_values.data(), send_counts.data(), displs.data(), mpi_type,
+        out_values.data(), recv_count, mpi_type, root, mpi_comm);
+    MPI_Type_free(&mpi_type);
+    }
+
+//! Wrapper around MPI_Gatherv for trivially copyable objects, concatenating the data on the root rank
+/*! \param in_values Elements sent by this rank
+    \param out_values Elements of all ranks, ordered by rank (only written on root)
+    \param counts Number of elements received from each rank (only written on root)
+    \param root Rank that gathers the data
+    \param mpi_comm MPI communicator
+
+    Neither side copies the data, the send and receive buffers are the storage of the vectors.
+*/
+template<typename T>
+void gather_v(const std::vector<T>& in_values, std::vector<T>& out_values, std::vector<unsigned int>& counts,
+    unsigned int root, const MPI_Comm mpi_comm)
+    {
+    static_assert(is_trivially_copyable_compat<T>::value, "gather_v with counts requires trivially copyable data");
+
+    int rank;
+    int size;
+    MPI_Comm_rank(mpi_comm, &rank);
+    MPI_Comm_size(mpi_comm, &size);
+
+    int send_count = in_values.size();
+
+    std::vector<int> recv_counts;
+    std::vector<int> displs;
+    if (rank == (int) root)
+        {
+        recv_counts.resize(size);
+        displs.resize(size);
+        }
+
+    // gather the number of elements
+    MPI_Gather(&send_count, 1, MPI_INT, recv_counts.data(), 1, MPI_INT, root, mpi_comm);
+
+    if (rank == (int) root)
+        {
+        unsigned int len = counts_to_displs(recv_counts.data(), displs.data(), size);
+        out_values.resize(len);
+        counts.assign(recv_counts.begin(), recv_counts.end());
+        }
+
+    MPI_Datatype mpi_type = create_mpi_bytes_type<T>();
+    MPI_Gatherv((void *) in_values.data(), send_count, mpi_type,
+        out_values.data(), recv_counts.data(), displs.data(), mpi_type, root, mpi_comm);
+    MPI_Type_free(&mpi_type);
+    }
+
+//! Wrapper around MPI_Gatherv for vectors of trivially copyable objects
+/*! Unlike the generic gather_v(), the vector elements are transmitted directly without serialization.
+    The send buffer is the storage of \a in_values.
+*/
+template<typename T>
+typename std::enable_if<is_trivially_copyable_compat<T>::value>::type
+gather_v(const std::vector<T>& in_values, std::vector< std::vector<T> >& out_values, unsigned int root,
+    const MPI_Comm mpi_comm)
+    {
+    int rank;
+    int size;
+    MPI_Comm_rank(mpi_comm, &rank);
+    MPI_Comm_size(mpi_comm, &size);
+
+    std::vector<T> rbuf;
+    std::vector<unsigned int> counts;
+    gather_v(in_values, rbuf, counts, root, mpi_comm);
+
+    if (rank == (int) root)
+        {
+        // unpack into one vector per rank
+        out_values.resize(size);
+        unsigned int offset = 0;
+        for (unsigned int i = 0; i < (unsigned int) size; i++)
+            {
+            out_values[i].assign(rbuf.begin() + offset, rbuf.begin() + offset + counts[i]);
+            offset += counts[i];
+            }
+        }
+    }
+
+//! Wrapper around MPI_Allgatherv for vectors of trivially copyable objects
+/*! Unlike the generic all_gather_v(), the vector elements are transmitted directly without serialization.
+*/
+template<typename T>
+typename std::enable_if<is_trivially_copyable_compat<T>::value>::type
+all_gather_v(const std::vector<T>& in_values, std::vector< std::vector<T> >& out_values, const MPI_Comm mpi_comm)
+    {
+    int size;
+    MPI_Comm_size(mpi_comm, &size);
+
+    int send_count = in_values.size();
+    std::vector<int> recv_counts(size);
+    std::vector<int> displs(size);
+
+    // gather the number of elements
+    MPI_Allgather(&send_count, 1, MPI_INT, recv_counts.data(), 1, MPI_INT, mpi_comm);
+    unsigned int len = counts_to_displs(recv_counts.data(), displs.data(), size);
+
+    std::vector<T> rbuf(len);
+    MPI_Datatype mpi_type = create_mpi_bytes_type<T>();
+    MPI_Allgatherv((void *) in_values.data(), send_count, mpi_type,
+        rbuf.data(), recv_counts.data(), displs.data(), mpi_type, mpi_comm);
+    MPI_Type_free(&mpi_type);
+
+    // unpack into one vector per rank
+    out_values.resize(size);
+    for (unsigned int i = 0; i < (unsigned int) size; i++)
+        out_values[i].assign(rbuf.begin() + displs[i], rbuf.begin() + displs[i] + recv_counts[i]);
+    }
+
+//! Wrapper around MPI_Alltoallv for trivially copyable objects
+/*! \param in_values Elements sent by this rank, ordered by destination rank
+    \param counts Number of elements sent to each rank
+    \param out_values Elements received by this rank, ordered by source rank
+    \param mpi_comm MPI communicator
+
+    The receive counts are exchanged with MPI_Alltoall first. Neither side copies the data, the send and receive
+    buffers are the storage of the vectors.
+*/
+template<typename T>
+void all_to_all_v(const std::vector<T>& in_values, const std::vector<unsigned int>& counts,
+    std::vector<T>& out_values, const MPI_Comm mpi_comm)
+    {
+    static_assert(is_trivially_copyable_compat<T>::value, "all_to_all_v requires trivially copyable data");
+
+    int size;
+    MPI_Comm_size(mpi_comm, &size);
+    assert(counts.size() == (unsigned int) size);
+
+    std::vector<int> send_counts(counts.begin(), counts.end());
+    std::vector<int> send_displs(size);
+    std::vector<int> recv_counts(size);
+    std::vector<int> recv_displs(size);
+
+    unsigned int send_len = counts_to_displs(send_counts.data(), send_displs.data(), size);
+    assert(send_len == in_values.size());
+    (void) send_len;
+
+    // exchange the number of elements
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, mpi_comm);
+    unsigned int recv_len = counts_to_displs(recv_counts.data(), recv_displs.data(), size);
+
+    out_values.resize(recv_len);
+
+    MPI_Datatype mpi_type = create_mpi_bytes_type<T>();
+    MPI_Alltoallv((void *) in_values.data(), send_counts.data(), send_displs.data(), mpi_type,
+        out_values.data(), recv_counts.data(), recv_displs.data(), mpi_type, mpi_comm);
+    MPI_Type_free(&mpi_type);
+    }
+
 //! Wrapper around MPI_Send that handles any serializable object
 template<typename T>
 void send(const T& val,const unsigned int dest, const MPI_Comm mpi_comm)
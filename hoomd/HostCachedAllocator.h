@@ -0,0 +1,273 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file HostCachedAllocator.h
+    \brief Declares a caching allocator for temporary host buffers
+
+    This is the host counterpart of CachedAllocator. Blocks are binned into power of two size classes, so that a
+    buffer released by one caller can be handed out again to the next request of a similar size without returning
+    the pages to the operating system in between.
+*/
+
+#ifndef __HOST_CACHED_ALLOCATOR_H__
+#define __HOST_CACHED_ALLOCATOR_H__
+
+#include <vector>
+#include <mutex>
+#include <new>
+#include <cstddef>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+//! HostCachedAllocator: a pool of aligned host memory blocks for transient buffers
+/*! Every request is rounded up to the next power of two (but at least one cache line). Released blocks are kept in
+    a free list per size class and reused by later requests of the same class. The total size of the blocks in the
+    free lists is bounded by the maximum cache size, blocks released beyond that are freed immediately.
+
+    Since the size class is a pure function of the requested size, deallocate() must be called with the same
+    number of bytes that was passed to allocate(). The STL adapter host_cached_allocator does this automatically.
+
+    All methods are thread safe.
+*/
+class HostCachedAllocator
+    {
+    public:
+        //! Constructor
+        /*! \param max_cached_bytes Maximum size of the free lists
+        */
+        HostCachedAllocator(size_t max_cached_bytes=size_t(256)*1024*1024)
+            : m_max_cached_bytes(max_cached_bytes),
+              m_cached_bytes(0),
+              m_num_hits(0),
+              m_num_misses(0),
+              m_free_blocks(num_classes)
+            { }
+
+        HostCachedAllocator(const HostCachedAllocator&) = delete;
+        HostCachedAllocator& operator=(const HostCachedAllocator&) = delete;
+
+        //! Destructor
+        ~HostCachedAllocator()
+            {
+            release();
+            }
+
+        //! Set maximum cache size
+        void setMaxCachedBytes(size_t max_cached_bytes)
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_max_cached_bytes = max_cached_bytes;
+            }
+
+        //! Get maximum cache size
+        size_t getMaxCachedBytes() const
+            {
+            return m_max_cached_bytes;
+            }
+
+        //! Get the number of bytes currently held in the free lists
+        size_t getCachedBytes()
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_cached_bytes;
+            }
+
+        //! Get the number of requests served from the free lists
+        unsigned long long getNumHits()
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_num_hits;
+            }
+
+        //! Get the number of requests that needed a new block
+        unsigned long long getNumMisses()
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_num_misses;
+            }
+
+        //! Allocate a block
+        /*! \param num_bytes Number of bytes to allocate
+            \returns a pointer to the block, aligned to a cache line
+        */
+        void *allocate(size_t num_bytes)
+            {
+            if (!num_bytes) return NULL;
+
+            unsigned int c = getSizeClass(num_bytes);
+
+                {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_free_blocks[c].empty())
+                    {
+                    void *ptr = m_free_blocks[c].back();
+                    m_free_blocks[c].pop_back();
+                    m_cached_bytes -= getClassBytes(c);
+                    m_num_hits++;
+                    return ptr;
+                    }
+                m_num_misses++;
+                }
+
+            void *ptr = alignedAlloc(getClassBytes(c));
+            if (!ptr)
+                {
+                // give the cached blocks back to the system and try again
+                release();
+                ptr = alignedAlloc(getClassBytes(c));
+                if (!ptr)
+                    throw std::bad_alloc();
+                }
+            return ptr;
+            }
+
+        //! Release a previously allocated block
+        /*! \param ptr Pointer returned by allocate()
+            \param num_bytes Number of bytes passed to allocate()
+        */
+        void deallocate(void *ptr, size_t num_bytes)
+            {
+            if (ptr == NULL) return;
+
+            unsigned int c = getSizeClass(num_bytes);
+            size_t class_bytes = getClassBytes(c);
+
+                {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_cached_bytes + class_bytes <= m_max_cached_bytes)
+                    {
+                    m_free_blocks[c].push_back(ptr);
+                    m_cached_bytes += class_bytes;
+                    return;
+                    }
+                }
+
+            // the cache is full
+            alignedFree(ptr);
+            }
+
+        //! Free all blocks in the free lists
+        void release()
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (unsigned int c = 0; c < num_classes; ++c)
+                {
+                for (std::vector<void *>::iterator it = m_free_blocks[c].begin(); it != m_free_blocks[c].end(); ++it)
+                    alignedFree(*it);
+                std::vector<void *>().swap(m_free_blocks[c]);
+                }
+            m_cached_bytes = 0;
+            }
+
+    private:
+        static const unsigned int min_class = 6;                     //!< Smallest block is 2^6 = 64 bytes
+        static const unsigned int num_classes = 8*sizeof(size_t);    //!< Number of size classes
+
+        size_t m_max_cached_bytes;          //!< Maximum size of the free lists
+        size_t m_cached_bytes;              //!< Current size of the free lists
+        unsigned long long m_num_hits;      //!< Number of requests served from the free lists
+        unsigned long long m_num_misses;    //!< Number of requests that allocated a new block
+
+        std::vector< std::vector<void *> > m_free_blocks; //!< Free list per size class
+        std::mutex m_mutex;                 //!< Protects the free lists and counters
+
+        //! Get the size class of a request
+        static unsigned int getSizeClass(size_t num_bytes)
+            {
+            unsigned int c = min_class;
+            while (c < num_classes-1 && getClassBytes(c) < num_bytes)
+                c++;
+            return c;
+            }
+
+        //! Get the size of the blocks in a given class
+        static size_t getClassBytes(unsigned int c)
+            {
+            return size_t(1) << c;
+            }
+
+        //! Allocate an aligned block, returns NULL on failure
+        static void *alignedAlloc(size_t num_bytes)
+            {
+            void *ptr = NULL;
+            #ifdef _WIN32
+            ptr = _aligned_malloc(num_bytes, size_t(1) << min_class);
+            #else
+            if (posix_memalign(&ptr, size_t(1) << min_class, num_bytes))
+                ptr = NULL;
+            #endif
+            return ptr;
+            }
+
+        //! Free an aligned block
+        static void alignedFree(void *ptr)
+            {
+            #ifdef _WIN32
+            _aligned_free(ptr);
+            #else
+            free(ptr);
+            #endif
+            }
+    };
+
+//! STL allocator that draws from a HostCachedAllocator
+/*! Use it for std::vector temporaries that are recreated frequently, e.g.
+    \code
+    cached_host_vector<float> data(N, 0.0f, host_cached_allocator<float>(m_exec_conf->getHostCachedAllocator()));
+    \endcode
+*/
+template<class T>
+class host_cached_allocator
+    {
+    public:
+        typedef T value_type;
+
+        //! Constructor
+        host_cached_allocator(HostCachedAllocator& alloc)
+            : m_alloc(&alloc)
+            { }
+
+        //! Rebind constructor
+        template<class U>
+        host_cached_allocator(const host_cached_allocator<U>& other)
+            : m_alloc(other.m_alloc)
+            { }
+
+        //! Allocate n elements
+        T *allocate(size_t n)
+            {
+            return (T *)m_alloc->allocate(n*sizeof(T));
+            }
+
+        //! Release n elements
+        void deallocate(T *ptr, size_t n)
+            {
+            m_alloc->deallocate((void *)ptr, n*sizeof(T));
+            }
+
+        HostCachedAllocator *m_alloc; //!< The pool
+    };
+
+template<class T, class U>
+bool operator==(const host_cached_allocator<T>& a, const host_cached_allocator<U>& b)
+    {
+    return a.m_alloc == b.m_alloc;
+    }
+
+template<class T, class U>
+bool operator!=(const host_cached_allocator<T>& a, const host_cached_allocator<U>& b)
+    {
+    return a.m_alloc != b.m_alloc;
+    }
+
+//! A std::vector whose storage is taken from a HostCachedAllocator
+template<class T>
+using cached_host_vector = std::vector<T, host_cached_allocator<T> >;
+
+#endif // __HOST_CACHED_ALLOCATOR_H__
@@ -9,6 +9,7 @@
  */
 #include "ParticleData.h"
 #include "Profiler.h"
+#include "HostCachedAllocator.h"
 
 #ifdef ENABLE_MPI
 #include "HOOMDMPI.h"
@@ -27,11 +28,77 @@
 #include <stdexcept>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 
 using namespace std;
 
 namespace py = pybind11;
 
+
+//! Compute the position of a copy of a particle in a replicated box
+/*! \param f Fractional coordinates of the unwrapped particle in the unit box
+    \param l Index of the replica along x
+    \param m Index of the replica along y
+    \param n Index of the replica along z
+    \param nx Number of replicas along x
+    \param ny Number of replicas along y
+    \param nz Number of replicas along z
+    \param new_box The replicated box
+    \param img Image flags of the copy (output)
+    \returns the position of the copy, wrapped into \a new_box
+*/
+template <class Real>
+static vec3<Real> replica_position(const vec3<Real>& f, unsigned int l, unsigned int m, unsigned int n,
+    unsigned int nx, unsigned int ny, unsigned int nz, const BoxDim& new_box, int3& img)
+    {
+    Scalar3 f_new;
+    f_new.x = f.x/(Real)nx + (Real)l/(Real)nx;
+    f_new.y = f.y/(Real)ny + (Real)m/(Real)ny;
+    f_new.z = f.z/(Real)nz + (Real)n/(Real)nz;
+
+    // coordinates in new box
+    Scalar3 q = new_box.makeCoordinates(f_new);
+
+    // wrap by multiple box vectors if necessary
+    img = new_box.getImage(q);
+    int3 negimg = make_int3(-img.x, -img.y, -img.z);
+    q = new_box.shift(q, negimg);
+
+    // rewrap using wrap so that rounding is consistent
+    new_box.wrap(q, img);
+
+    return vec3<Real>(q);
+    }
+
+#ifdef ENABLE_MPI
+//! List the replicas along one direction whose copy of a particle may fall into a range of fractions
+/*! \param f Fractional coordinate of the particle in the unit box, not necessarily in [0,1)
+    \param lo Lower bound of the range
+    \param hi Upper bound of the range
+    \param n Number of replicas
+    \param replicas The replica indices (output)
+
+    Replica l places its copy at the fraction (f+l)/n, wrapped into [0,1). The list has a margin of one replica on
+    either side of the range to tolerate round-off.
+*/
+static void local_replicas(Scalar f, Scalar lo, Scalar hi, unsigned int n, std::vector<unsigned int>& replicas)
+    {
+    replicas.clear();
+    int first = int(floor(lo*Scalar(n) - f)) - 1;
+    int last = int(ceil(hi*Scalar(n) - f)) + 1;
+
+    if (last - first + 1 >= int(n))
+        {
+        for (unsigned int l = 0; l < n; l++)
+            replicas.push_back(l);
+        return;
+        }
+
+    for (int a = first; a <= last; a++)
+        replicas.push_back(((a % int(n)) + int(n)) % int(n));
+    }
+#endif
+
 ////////////////////////////////////////////////////////////////////////////
 // ParticleData members
 
@@ -137,12 +204,14 @@ ParticleData::ParticleData(unsigned int N, const BoxDim &global_box, unsigned in
  * \param global_box The dimensions of the global simulation box
  * \param exec_conf The execution configuration
  * \param decomposition (optional) Domain decomposition layout
+ * \param distributed (optional) True if every rank holds a part of the snapshot
  */
 template <class Real>
 ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
                            const BoxDim& global_box,
                            std::shared_ptr<ExecutionConfiguration> exec_conf,
-                           std::shared_ptr<DomainDecomposition> decomposition
+                           std::shared_ptr<DomainDecomposition> decomposition,
+                           bool distributed
                           )
     : m_exec_conf(exec_conf),
       m_nparticles(0),
@@ -164,7 +233,7 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
     setGlobalBox(global_box);
 
     // it is an error for particles to be initialized outside of their box
-    if (!inBox(snapshot))
+    if (!inBox(snapshot, distributed))
         {
         m_exec_conf->msg->warning() << "Not all particles were found inside the given box" << endl;
         throw runtime_error("Error initializing ParticleData");
@@ -183,7 +252,7 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
     TAG_ALLOCATION(m_rtag);
 
     // initialize particle data with snapshot contents
-    initializeFromSnapshot(snapshot);
+    initializeFromSnapshot(snapshot, false, distributed);
 
     // reset external virial
     for (unsigned int i = 0; i < 6; i++)
@@ -274,6 +343,21 @@ void ParticleData::notifyParticleSort()
     m_sort_signal.emit();
     }
 
+/*! \param old_to_new New index of every particle that was local before the rearrangement (NOT_LOCAL if it was
+        removed), or NULL if the first \a old_N particles kept their indices
+    \param old_N Number of local particles before the rearrangement
+    \param first_new Index of the first newly added particle
+
+    Subscribers to the reorder signal are notified first, then the regular sort signal is triggered.
+    \note The call must be made after calling release()
+*/
+void ParticleData::notifyParticleReorder(const unsigned int *old_to_new, unsigned int old_N, unsigned int first_new)
+    {
+    m_reorder_signal.emit(old_to_new, old_N, first_new);
+
+    notifyParticleSort();
+    }
+
 /*! This function is called any time the ghost particles are removed
  *
  * The rationale is that a subscriber (i.e. the Communicator) can perform clean-up for ghost particles
@@ -782,10 +866,10 @@ void ParticleData::maybe_rebuild_tag_cache()
 /*! \return true If and only if all particles are in the simulation box
 */
 template <class Real>
-bool ParticleData::inBox(const SnapshotParticleData<Real> &snap)
+bool ParticleData::inBox(const SnapshotParticleData<Real> &snap, bool distributed)
     {
     bool in_box = true;
-    if (m_exec_conf->getRank() == 0)
+    if (distributed || m_exec_conf->getRank() == 0)
         {
         Scalar3 lo = m_global_box.getLo();
         Scalar3 hi = m_global_box.getHi();
@@ -809,7 +893,13 @@ bool ParticleData::inBox(const SnapshotParticleData<Real> &snap)
             }
         }
     #ifdef ENABLE_MPI
-    if (m_decomposition)
+    if (m_decomposition && distributed)
+        {
+        int all_in_box = in_box;
+        MPI_Allreduce(MPI_IN_PLACE, &all_in_box, 1, MPI_INT, MPI_LAND, m_exec_conf->getMPICommunicator());
+        in_box = all_in_box;
+        }
+    else if (m_decomposition)
         {
         bcast(in_box, 0, m_exec_conf->getMPICommunicator());
         }
@@ -817,16 +907,161 @@ bool ParticleData::inBox(const SnapshotParticleData<Real> &snap)
     return in_box;
     }
 
+#ifdef ENABLE_MPI
+/*! \param pos Position of the particle, wrapped into the global box on output
+    \param img Image flags of the particle, updated on output
+    \param cart_ranks Host pointer to the cartesian rank lookup table of the domain decomposition
+    \param idx Index of the particle, used in error messages
+    \returns the rank the particle is placed on
+*/
+unsigned int ParticleData::placeInitialParticle(Scalar3& pos, int3& img, const unsigned int *cart_ranks,
+    unsigned int idx)
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+
+    BoxDim global_box = m_global_box;
+
+    Scalar3 f = m_global_box.makeFraction(pos);
+    int i= f.x * ((Scalar)di.getW());
+    int j= f.y * ((Scalar)di.getH());
+    int k= f.z * ((Scalar)di.getD());
+
+    // wrap particles that are exactly on a boundary
+    // we only need to wrap in the negative direction, since
+    // processor ids are rounded toward zero
+    char3 flags = make_char3(0,0,0);
+    if (i == (int) di.getW())
+        {
+        i = 0;
+        flags.x = 1;
+        }
+
+    if (j == (int) di.getH())
+        {
+        j = 0;
+        flags.y = 1;
+        }
+
+    if (k == (int) di.getD())
+        {
+        k = 0;
+        flags.z = 1;
+        }
+
+    // only wrap if the particles is on one of the boundaries
+    uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
+    global_box.setPeriodic(periodic);
+    global_box.wrap(pos, img, flags);
+
+    // place particle using actual domain fractions, not global box fraction
+    unsigned int rank = m_decomposition->placeParticle(m_global_box, pos, cart_ranks);
+
+    if (rank >= n_ranks)
+        {
+        m_exec_conf->msg->error() << "init.*: Particle " << idx << " out of bounds." << std::endl;
+        m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
+        m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
+        m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
+        m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
+        Scalar3 lo = m_global_box.getLo();
+        Scalar3 hi = m_global_box.getHi();
+        m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
+        m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
+
+        throw std::runtime_error("Error initializing from snapshot.");
+        }
+
+    return rank;
+    }
+
+/*! \param elements The particles owned by this rank
+    \param nglobal The global number of particles
+
+    Replaces the local particles with \a elements. The tags of the system are 0 .. nglobal-1.
+*/
+void ParticleData::loadSnapshotElements(const std::vector<snapshot_element>& elements, unsigned int nglobal)
+    {
+    // resize array for reverse-lookup tags
+    m_rtag.resize(nglobal);
+
+    m_nparticles = elements.size();
+
+        {
+        // reset all reverse lookup tags to NOT_LOCAL flag
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+
+        // we have to reset all previous rtags, to remove 'leftover' ghosts
+        unsigned int max_tag = m_rtag.size();
+        for (unsigned int tag = 0; tag < max_tag; tag++)
+            h_rtag.data[tag] = NOT_LOCAL;
+        }
+
+    // update list of active tags
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        {
+        m_tag_set.insert(tag);
+        }
+
+    // Now that active tag list has changed, invalidate the cache
+    m_invalid_cached_tags = true;
+
+    // resize particle data
+    resize(m_nparticles);
+
+    // Load particle data
+    ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::overwrite);
+    ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+    ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar4 > h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar3 > h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+    ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::overwrite);
+    ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
+    ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+
+    for (unsigned int idx = 0; idx < m_nparticles; idx++)
+        {
+        const snapshot_element& p = elements[idx];
+        h_pos.data[idx] = make_scalar4(p.pos.x, p.pos.y, p.pos.z, __int_as_scalar(p.type));
+        h_vel.data[idx] = make_scalar4(p.vel.x, p.vel.y, p.vel.z, p.mass);
+        h_accel.data[idx] = p.accel;
+        h_charge.data[idx] = p.charge;
+        h_diameter.data[idx] = p.diameter;
+        h_image.data[idx] = p.image;
+        h_tag.data[idx] = p.tag;
+        h_rtag.data[p.tag] = idx;
+        h_body.data[idx] = p.body;
+        h_orientation.data[idx] = p.orientation;
+        h_angmom.data[idx] = p.angmom;
+        h_inertia.data[idx] = p.inertia;
+
+        h_comm_flag.data[idx] = 0; // initialize with zero
+        }
+    }
+#endif
+
 //! Initialize from a snapshot
 /*! \param snapshot the initial particle data
     \param ignore_bodies If True, ignore particles that have a body flag set
+    \param distributed If True, every rank holds a part of the snapshot (see below)
 
     \post the particle data arrays are initialized from the snapshot, in index order
 
     \pre In parallel simulations, the local box size must be set before a call to initializeFromSnapshot().
+
+    By default, the snapshot on the root rank holds all particles and is scattered to the other ranks. A distributed
+    snapshot consists of the per-rank snapshots, each holding a contiguous range of tags in rank order. Every rank
+    places its own particles into the domains and the particles are redistributed with a single all-to-all, so no
+    rank ever holds the whole system.
  */
 template <class Real>
-void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snapshot, bool ignore_bodies)
+void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snapshot, bool ignore_bodies,
+    bool distributed)
     {
     m_exec_conf->msg->notice(4) << "ParticleData: initializing from snapshot" << std::endl;
 
@@ -834,7 +1069,7 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     removeAllGhostParticles();
 
     // check that all fields in the snapshot have correct length
-    if (m_exec_conf->getRank() == 0 && ! snapshot.validate())
+    if ((distributed || m_exec_conf->getRank() == 0) && ! snapshot.validate())
         {
         m_exec_conf->msg->error() << "init.*: invalid particle data snapshot."
                                 << std::endl << std::endl;
@@ -852,49 +1087,44 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     unsigned int nglobal = 0;
 
 #ifdef ENABLE_MPI
+    if (distributed && !m_decomposition)
+        {
+        m_exec_conf->msg->error() << "init.*: a distributed snapshot requires a domain decomposition." << std::endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
     if (m_decomposition)
         {
         // gather box information from all processors
         unsigned int root = 0;
 
-        // Define per-processor particle data
-        std::vector< std::vector<Scalar3> > pos_proc;              // Position array of every processor
-        std::vector< std::vector<Scalar3> > vel_proc;              // Velocities array of every processor
-        std::vector< std::vector<Scalar3> > accel_proc;            // Accelerations array of every processor
-        std::vector< std::vector<unsigned int> > type_proc;        // Particle types array of every processor
-        std::vector< std::vector<Scalar > > mass_proc;             // Particle masses array of every processor
-        std::vector< std::vector<Scalar > > charge_proc;           // Particle charges array of every processor
-        std::vector< std::vector<Scalar > > diameter_proc;         // Particle diameters array of every processor
-        std::vector< std::vector<int3 > > image_proc;              // Particle images array of every processor
-        std::vector< std::vector<unsigned int > > body_proc;       // Body ids of every processor
-        std::vector< std::vector<Scalar4> > orientation_proc;      // Orientations of every processor
-        std::vector< std::vector<Scalar4> > angmom_proc;           // Angular momenta of every processor
-        std::vector< std::vector<Scalar3> > inertia_proc;           // Angular momenta of every processor
-        std::vector< std::vector<unsigned int > > tag_proc;         // Global tags of every processor
-        std::vector< unsigned int > N_proc;                        // Number of particles on every processor
-
-
-        // resize to number of ranks in communicator
+        // communicator and ranks
         const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
         unsigned int size = m_exec_conf->getNRanks();
         unsigned int my_rank = m_exec_conf->getRank();
 
-        pos_proc.resize(size);
-        vel_proc.resize(size);
-        accel_proc.resize(size);
-        type_proc.resize(size);
-        mass_proc.resize(size);
-        charge_proc.resize(size);
-        diameter_proc.resize(size);
-        image_proc.resize(size);
-        body_proc.resize(size);
-        orientation_proc.resize(size);
-        angmom_proc.resize(size);
-        inertia_proc.resize(size);
-        tag_proc.resize(size);
-        N_proc.resize(size,0);
-
-        if (my_rank == 0)
+        // placed particles ordered by destination rank, and the number of particles per rank
+        std::vector<snapshot_element> send_elements;
+        std::vector<unsigned int> counts(size, 0);
+
+        // the first tag of the particles placed by this rank
+        unsigned int tag = 0;
+
+        if (distributed)
+            {
+            // every rank holds a contiguous stripe of the tags, in rank order
+            unsigned int n_stripe = 0;
+            for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
+                if (!ignore_bodies || snapshot.body[snap_idx] >= MIN_FLOPPY)
+                    n_stripe++;
+
+            MPI_Exscan(&n_stripe, &tag, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+            if (my_rank == 0)
+                tag = 0;
+            MPI_Allreduce(&n_stripe, &nglobal, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+            }
+
+        if (distributed || my_rank == 0)
             {
             ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
 
@@ -905,93 +1135,62 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
                 throw std::runtime_error("Error initializing ParticleData");
                 }
 
-            const Index3D& di = m_decomposition->getDomainIndexer();
-            unsigned int n_ranks = m_exec_conf->getNRanks();
-
-            BoxDim global_box = m_global_box;
-
-            // loop over particles in snapshot, place them into domains
-            for (typename std::vector< vec3<Real> >::const_iterator it=snapshot.pos.begin(); it != snapshot.pos.end(); it++)
+            // first pass: determine the domain each particle is placed into
+            std::vector<unsigned int> dest(snapshot.size, NOT_LOCAL);
+            for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
                 {
-                unsigned int snap_idx = it - snapshot.pos.begin();
-
                 // if requested, do not initialize constituent particles of bodies
                 if (ignore_bodies && snapshot.body[snap_idx] < MIN_FLOPPY)
                     {
                     continue;
                     }
 
-                // determine domain the particle is placed into
-                Scalar3 pos = vec_to_scalar3(*it);
-                Scalar3 f = m_global_box.makeFraction(pos);
-                int i= f.x * ((Scalar)di.getW());
-                int j= f.y * ((Scalar)di.getH());
-                int k= f.z * ((Scalar)di.getD());
-
-                // wrap particles that are exactly on a boundary
-                // we only need to wrap in the negative direction, since
-                // processor ids are rounded toward zero
-                char3 flags = make_char3(0,0,0);
-                if (i == (int) di.getW())
-                    {
-                    i = 0;
-                    flags.x = 1;
-                    }
-
-                if (j == (int) di.getH())
-                    {
-                    j = 0;
-                    flags.y = 1;
-                    }
-
-                if (k == (int) di.getD())
-                    {
-                    k = 0;
-                    flags.z = 1;
-                    }
-
+                Scalar3 pos = vec_to_scalar3(snapshot.pos[snap_idx]);
                 int3 img = snapshot.image[snap_idx];
+                dest[snap_idx] = placeInitialParticle(pos, img, h_cart_ranks.data, snap_idx);
+                counts[dest[snap_idx]]++;
+                }
 
-                // only wrap if the particles is on one of the boundaries
-                uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
-                global_box.setPeriodic(periodic);
-                global_box.wrap(pos, img, flags);
-
-                // place particle using actual domain fractions, not global box fraction
-                unsigned int rank = m_decomposition->placeParticle(m_global_box, pos, h_cart_ranks.data);
+            // offset of each rank in the send buffer
+            std::vector<unsigned int> offsets(size);
+            unsigned int n_placed = 0;
+            for (unsigned int i = 0; i < size; i++)
+                {
+                offsets[i] = n_placed;
+                n_placed += counts[i];
+                }
 
-                if (rank >= n_ranks)
-                    {
-                    m_exec_conf->msg->error() << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
-                    m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
-                    m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
-                    m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
-                    m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
-                    Scalar3 lo = m_global_box.getLo();
-                    Scalar3 hi = m_global_box.getHi();
-                    m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
-                    m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
-
-                    throw std::runtime_error("Error initializing from snapshot.");
-                    }
+            // second pass: fill the send buffer in place, so that the particles are only copied once
+            send_elements.resize(n_placed);
+            for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
+                {
+                unsigned int rank = dest[snap_idx];
+                if (rank == NOT_LOCAL)
+                    continue;
 
-                // fill up per-processor data structures
-                pos_proc[rank].push_back(pos);
-                image_proc[rank].push_back(img);
-                vel_proc[rank].push_back(vec_to_scalar3(snapshot.vel[snap_idx]));
-                accel_proc[rank].push_back(vec_to_scalar3(snapshot.accel[snap_idx]));
-                type_proc[rank].push_back(snapshot.type[snap_idx]);
-                mass_proc[rank].push_back(snapshot.mass[snap_idx]);
-                charge_proc[rank].push_back(snapshot.charge[snap_idx]);
-                diameter_proc[rank].push_back(snapshot.diameter[snap_idx]);
-                body_proc[rank].push_back(snapshot.body[snap_idx]);
-                orientation_proc[rank].push_back(quat_to_scalar4(snapshot.orientation[snap_idx]));
-                angmom_proc[rank].push_back(quat_to_scalar4(snapshot.angmom[snap_idx]));
-                inertia_proc[rank].push_back(vec_to_scalar3(snapshot.inertia[snap_idx]));
-                tag_proc[rank].push_back(nglobal++);
-                N_proc[rank]++;
+                // wrap the particle into the box again, placement is deterministic
+                Scalar3 pos = vec_to_scalar3(snapshot.pos[snap_idx]);
+                int3 img = snapshot.image[snap_idx];
+                placeInitialParticle(pos, img, h_cart_ranks.data, snap_idx);
+
+                snapshot_element& p = send_elements[offsets[rank]++];
+                p.pos = pos;
+                p.image = img;
+                p.vel = vec_to_scalar3(snapshot.vel[snap_idx]);
+                p.accel = vec_to_scalar3(snapshot.accel[snap_idx]);
+                p.type = snapshot.type[snap_idx];
+                p.mass = snapshot.mass[snap_idx];
+                p.charge = snapshot.charge[snap_idx];
+                p.diameter = snapshot.diameter[snap_idx];
+                p.body = snapshot.body[snap_idx];
+                p.orientation = quat_to_scalar4(snapshot.orientation[snap_idx]);
+                p.angmom = quat_to_scalar4(snapshot.angmom[snap_idx]);
+                p.inertia = vec_to_scalar3(snapshot.inertia[snap_idx]);
+                p.tag = tag++;
                 }
 
+            if (!distributed)
+                nglobal = tag;
             }
 
         // get type mapping
@@ -1005,100 +1204,25 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         // broadcast type mapping
         bcast(m_type_mapping, root, mpi_comm);
 
-        // broadcast global number of particles
-        bcast(nglobal, root, mpi_comm);
-
-        // resize array for reverse-lookup tags
-        m_rtag.resize(nglobal);
-
-        // Local particle data
-        std::vector<Scalar3> pos;
-        std::vector<Scalar3> vel;
-        std::vector<Scalar3> accel;
-        std::vector<unsigned int> type;
-        std::vector<Scalar> mass;
-        std::vector<Scalar> charge;
-        std::vector<Scalar> diameter;
-        std::vector<int3> image;
-        std::vector<unsigned int> body;
-        std::vector<Scalar4> orientation;
-        std::vector<Scalar4> angmom;
-        std::vector<Scalar3> inertia;
-        std::vector<unsigned int> tag;
-
-        // distribute particle data
-        scatter_v(pos_proc,pos,root, mpi_comm);
-        scatter_v(vel_proc,vel,root, mpi_comm);
-        scatter_v(accel_proc, accel, root, mpi_comm);
-        scatter_v(type_proc, type, root, mpi_comm);
-        scatter_v(mass_proc, mass, root, mpi_comm);
-        scatter_v(charge_proc, charge, root, mpi_comm);
-        scatter_v(diameter_proc, diameter, root, mpi_comm);
-        scatter_v(image_proc, image, root, mpi_comm);
-        scatter_v(body_proc, body, root, mpi_comm);
-        scatter_v(orientation_proc, orientation, root, mpi_comm);
-        scatter_v(angmom_proc, angmom, root, mpi_comm);
-        scatter_v(inertia_proc, inertia, root, mpi_comm);
-        scatter_v(tag_proc, tag, root, mpi_comm);
-
-        // distribute number of particles
-        scatter_v(N_proc, m_nparticles, root, mpi_comm);
-
-
+        std::vector<snapshot_element> elements;
+        if (distributed)
             {
-            // reset all reverse lookup tags to NOT_LOCAL flag
-            ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
-
-            // we have to reset all previous rtags, to remove 'leftover' ghosts
-            unsigned int max_tag = m_rtag.size();
-            for (unsigned int tag = 0; tag < max_tag; tag++)
-                h_rtag.data[tag] = NOT_LOCAL;
+            // every rank keeps its own particles and exchanges the rest in a single collective
+            all_to_all_v(send_elements, counts, elements, mpi_comm);
             }
-
-        // update list of active tags
-        for (unsigned int tag = 0; tag < nglobal; tag++)
+        else
             {
-            m_tag_set.insert(tag);
-            }
+            // broadcast global number of particles
+            bcast(nglobal, root, mpi_comm);
 
-        // Now that active tag list has changed, invalidate the cache
-        m_invalid_cached_tags = true;
+            // distribute particle data in a single collective, directly from the send buffer
+            scatter_v(send_elements, counts, elements, root, mpi_comm);
+            }
 
-        // resize particle data
-        resize(m_nparticles);
+        // free the send buffer
+        std::vector<snapshot_element>().swap(send_elements);
 
-        // Load particle data
-        ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::overwrite);
-        ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::overwrite);
-        ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::overwrite);
-        ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::overwrite);
-        ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::overwrite);
-        ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::overwrite);
-        ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::overwrite);
-        ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::overwrite);
-        ArrayHandle< Scalar4 > h_angmom(m_angmom, access_location::host, access_mode::overwrite);
-        ArrayHandle< Scalar3 > h_inertia(m_inertia, access_location::host, access_mode::overwrite);
-        ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::overwrite);
-        ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
-        ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::readwrite);
-
-        for (unsigned int idx = 0; idx < m_nparticles; idx++)
-            {
-            h_pos.data[idx] = make_scalar4(pos[idx].x,pos[idx].y, pos[idx].z, __int_as_scalar(type[idx]));
-            h_vel.data[idx] = make_scalar4(vel[idx].x, vel[idx].y, vel[idx].z, mass[idx]);
-            h_accel.data[idx] = accel[idx];
-            h_charge.data[idx] = charge[idx];
-            h_diameter.data[idx] = diameter[idx];
-            h_image.data[idx] = image[idx];
-            h_tag.data[idx] = tag[idx];
-            h_rtag.data[tag[idx]] = idx;
-            h_body.data[idx] = body[idx];
-            h_orientation.data[idx] = orientation[idx];
-            h_angmom.data[idx] = angmom[idx];
-            h_inertia.data[idx] = inertia[idx];
-
-            h_comm_flag.data[idx] = 0; // initialize with zero
-            }
+        loadSnapshotElements(elements, nglobal);
         }
     else
 #endif
@@ -1193,6 +1317,153 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     m_num_types_signal.emit();
     }
 
+/*! \param unit Snapshot of the unit cell, identical on all ranks
+    \param unit_box Box of the unit cell
+    \param nx Number of replicas along the x direction
+    \param ny Number of replicas along the y direction
+    \param nz Number of replicas along the z direction
+
+    Initializes the particle data to the system that SnapshotParticleData::replicate() generates, without building
+    it on any one rank. The replicated box must already be set as the global box. Every rank generates only the
+    copies of the unit cell particles that fall into its domain, and tags them like SnapshotParticleData::replicate()
+    does: the copy of particle i in replica j has tag j*unit.size + i.
+*/
+template <class Real>
+void ParticleData::initializeReplicated(const SnapshotParticleData<Real>& unit, const BoxDim& unit_box,
+    unsigned int nx, unsigned int ny, unsigned int nz)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing replicated system" << std::endl;
+
+#ifdef ENABLE_MPI
+    if (!m_decomposition)
+#endif
+        {
+        // without domain decomposition, all particles are local
+        SnapshotParticleData<Real> snapshot(unit);
+        snapshot.replicate(nx, ny, nz, unit_box, m_global_box);
+        initializeFromSnapshot(snapshot);
+        return;
+        }
+
+#ifdef ENABLE_MPI
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    // check the input for errors
+    if (! unit.validate())
+        {
+        m_exec_conf->msg->error() << "init.*: invalid particle data snapshot."
+                                << std::endl << std::endl;
+        throw std::runtime_error("Error initializing particle data.");
+        }
+
+    if (unit.type_mapping.size() == 0)
+        {
+        m_exec_conf->msg->error() << "Number of particle types must be greater than 0." << endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
+    uint64_t n_total = uint64_t(unit.size)*nx*ny*nz;
+    if (n_total >= NOT_LOCAL)
+        {
+        m_exec_conf->msg->error() << "init.*: Replication would create " << n_total << " particles, more than "
+                                  << "HOOMD supports." << std::endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
+    // clear set of active tags
+    m_tag_set.clear();
+
+    // clear reservoir of recycled tags
+    while (! m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    unsigned int n_unit = unit.size;
+    unsigned int nglobal = n_total;
+
+    // fractional extent of the local domain
+    uint3 grid_pos = m_decomposition->getGridPos();
+    std::vector<Scalar> frac_x = m_decomposition->getCumulativeFractions(0);
+    std::vector<Scalar> frac_y = m_decomposition->getCumulativeFractions(1);
+    std::vector<Scalar> frac_z = m_decomposition->getCumulativeFractions(2);
+    Scalar3 lo = make_scalar3(frac_x[grid_pos.x], frac_y[grid_pos.y], frac_z[grid_pos.z]);
+    Scalar3 hi = make_scalar3(frac_x[grid_pos.x+1], frac_y[grid_pos.y+1], frac_z[grid_pos.z+1]);
+
+    ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
+    unsigned int my_rank = m_exec_conf->getRank();
+
+    std::vector<snapshot_element> elements;
+    std::vector<unsigned int> replicas_x, replicas_y, replicas_z;
+    for (unsigned int i = 0; i < n_unit; i++)
+        {
+        // unwrap position of particle i in the unit box using image flags
+        vec3<Real> p = vec3<Real>(unit_box.shift(vec3<Scalar>(unit.pos[i]), unit.image[i]));
+        vec3<Real> f = unit_box.makeFraction(p);
+
+        // only visit the replicas whose copy of this particle may be local
+        local_replicas(f.x, lo.x, hi.x, nx, replicas_x);
+        local_replicas(f.y, lo.y, hi.y, ny, replicas_y);
+        local_replicas(f.z, lo.z, hi.z, nz, replicas_z);
+
+        for (unsigned int l : replicas_x)
+            for (unsigned int m : replicas_y)
+                for (unsigned int n : replicas_z)
+                    {
+                    unsigned int j = (l*ny + m)*nz + n;
+                    unsigned int tag = j*n_unit + i;
+
+                    int3 img;
+                    Scalar3 pos = vec_to_scalar3(replica_position(f, l, m, n, nx, ny, nz, m_global_box, img));
+
+                    // the domain decomposition decides ownership, so that every particle is placed exactly once
+                    if (placeInitialParticle(pos, img, h_cart_ranks.data, tag) != my_rank)
+                        continue;
+
+                    snapshot_element e;
+                    e.pos = pos;
+                    e.image = img;
+                    e.vel = vec_to_scalar3(unit.vel[i]);
+                    e.accel = vec_to_scalar3(unit.accel[i]);
+                    e.type = unit.type[i];
+                    e.mass = unit.mass[i];
+                    e.charge = unit.charge[i];
+                    e.diameter = unit.diameter[i];
+                    e.body = (unit.body[i] != NO_BODY ? j*n_unit + unit.body[i] : NO_BODY);
+                    if (unit.body[i] < MIN_FLOPPY && e.body >= MIN_FLOPPY)
+                        throw std::runtime_error("Replication would create more distinct rigid bodies than HOOMD supports!");
+                    e.orientation = quat_to_scalar4(unit.orientation[i]);
+                    e.angmom = quat_to_scalar4(unit.angmom[i]);
+                    e.inertia = vec_to_scalar3(unit.inertia[i]);
+                    e.tag = tag;
+                    elements.push_back(e);
+                    }
+        }
+
+    // store the local particles in tag order, like a scattered snapshot
+    std::sort(elements.begin(), elements.end(),
+        [](const snapshot_element& a, const snapshot_element& b) { return a.tag < b.tag; });
+
+    m_type_mapping = unit.type_mapping;
+    loadSnapshotElements(elements, nglobal);
+
+    // copy over accel_set flag from snapshot
+    m_accel_set = unit.is_accel_set;
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0,0,0);
+    m_o_image = make_int3(0,0,0);
+
+    // notify listeners that number of types has changed
+    m_num_types_signal.emit();
+#endif
+    }
+
 //! take a particle data snapshot
 /* \param snapshot The snapshot to write to
    \returns a map to lookup the snapshot index from a particle tag
@@ -1224,123 +1495,61 @@ std::map<unsigned int, unsigned int> ParticleData::takeSnapshot(SnapshotParticle
     if (m_decomposition)
         {
         // gather a global snapshot
-        std::vector<Scalar3> pos(m_nparticles);
-        std::vector<Scalar3> vel(m_nparticles);
-        std::vector<Scalar3> accel(m_nparticles);
-        std::vector<unsigned int> type(m_nparticles);
-        std::vector<Scalar> mass(m_nparticles);
-        std::vector<Scalar> charge(m_nparticles);
-        std::vector<Scalar> diameter(m_nparticles);
-        std::vector<int3> image(m_nparticles);
-        std::vector<unsigned int> body(m_nparticles);
-        std::vector<Scalar4> orientation(m_nparticles);
-        std::vector<Scalar4> angmom(m_nparticles);
-        std::vector<Scalar3> inertia(m_nparticles);
-        std::vector<unsigned int> tag(m_nparticles);
-        std::map<unsigned int, unsigned int> rtag_map;
+        std::vector<snapshot_element> elements(m_nparticles);
         for (unsigned int idx = 0; idx < m_nparticles; idx++)
             {
-            pos[idx] = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - m_origin;
-            vel[idx] = make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z);
-            accel[idx] = h_accel.data[idx];
-            type[idx] = __scalar_as_int(h_pos.data[idx].w);
-            mass[idx] = h_vel.data[idx].w;
-            charge[idx] = h_charge.data[idx];
-            diameter[idx] = h_diameter.data[idx];
-            image[idx] = h_image.data[idx];
-            image[idx].x -= m_o_image.x;
-            image[idx].y -= m_o_image.y;
-            image[idx].z -= m_o_image.z;
-            body[idx] = h_body.data[idx];
-            orientation[idx] = h_orientation.data[idx];
-            angmom[idx] = h_angmom.data[idx];
-            inertia[idx] = h_inertia.data[idx];
-
-            // insert reverse lookup global tag -> idx
-            rtag_map.insert(std::pair<unsigned int, unsigned int>(h_tag.data[idx], idx));
+            snapshot_element& p = elements[idx];
+            p.pos = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - m_origin;
+            p.vel = make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z);
+            p.accel = h_accel.data[idx];
+            p.type = __scalar_as_int(h_pos.data[idx].w);
+            p.mass = h_vel.data[idx].w;
+            p.charge = h_charge.data[idx];
+            p.diameter = h_diameter.data[idx];
+            p.image = h_image.data[idx];
+            p.image.x -= m_o_image.x;
+            p.image.y -= m_o_image.y;
+            p.image.z -= m_o_image.z;
+            p.body = h_body.data[idx];
+            p.orientation = h_orientation.data[idx];
+            p.angmom = h_angmom.data[idx];
+            p.inertia = h_inertia.data[idx];
+            p.tag = h_tag.data[idx];
             }
 
-        std::vector< std::vector<Scalar3> > pos_proc;              // Position array of every processor
-        std::vector< std::vector<Scalar3> > vel_proc;              // Velocities array of every processor
-        std::vector< std::vector<Scalar3> > accel_proc;            // Accelerations array of every processor
-        std::vector< std::vector<unsigned int> > type_proc;        // Particle types array of every processor
-        std::vector< std::vector<Scalar > > mass_proc;             // Particle masses array of every processor
-        std::vector< std::vector<Scalar > > charge_proc;           // Particle charges array of every processor
-        std::vector< std::vector<Scalar > > diameter_proc;         // Particle diameters array of every processor
-        std::vector< std::vector<int3 > > image_proc;              // Particle images array of every processor
-        std::vector< std::vector<unsigned int > > body_proc;       // Body ids of every processor
-        std::vector< std::vector<Scalar4 > > orientation_proc;     // Orientations of every processor
-        std::vector< std::vector<Scalar4 > > angmom_proc;          // Angular momenta of every processor
-        std::vector< std::vector<Scalar3 > > inertia_proc;         // Moments of inertia of every processor
-
-        std::vector< std::map<unsigned int, unsigned int> > rtag_map_proc; // List of reverse-lookup maps
-
         const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
-        unsigned int size = m_exec_conf->getNRanks();
         unsigned int rank = m_exec_conf->getRank();
-
-        // resize to number of ranks in communicator
-        pos_proc.resize(size);
-        vel_proc.resize(size);
-        accel_proc.resize(size);
-        type_proc.resize(size);
-        mass_proc.resize(size);
-        charge_proc.resize(size);
-        diameter_proc.resize(size);
-        image_proc.resize(size);
-        body_proc.resize(size);
-        orientation_proc.resize(size);
-        angmom_proc.resize(size);
-        inertia_proc.resize(size);
-        rtag_map_proc.resize(size);
-
         unsigned int root = 0;
 
-        // collect all particle data on the root processor
-        gather_v(pos, pos_proc, root,mpi_comm);
-        gather_v(vel, vel_proc, root, mpi_comm);
-        gather_v(accel, accel_proc, root, mpi_comm);
-        gather_v(type, type_proc, root, mpi_comm);
-        gather_v(mass, mass_proc, root, mpi_comm);
-        gather_v(charge, charge_proc, root, mpi_comm);
-        gather_v(diameter, diameter_proc, root, mpi_comm);
-        gather_v(image, image_proc, root, mpi_comm);
-        gather_v(body, body_proc, root, mpi_comm);
-        gather_v(orientation, orientation_proc, root, mpi_comm);
-        gather_v(angmom, angmom_proc, root, mpi_comm);
-        gather_v(inertia, inertia_proc, root, mpi_comm);
-
-        // gather the reverse-lookup maps
-        gather_v(rtag_map, rtag_map_proc, root, mpi_comm);
+        // collect all particle data on the root processor, in a single collective
+        std::vector<snapshot_element> elements_all;
+        std::vector<unsigned int> counts;
+        gather_v(elements, elements_all, counts, root, mpi_comm);
+
+        // free the local copy
+        std::vector<snapshot_element>().swap(elements);
 
         if (rank == root)
             {
             // allocate memory in snapshot
             snapshot.resize(getNGlobal());
 
-            unsigned int n_ranks = m_exec_conf->getNRanks();
-            assert(rtag_map_proc.size() == n_ranks);
-
-            // create single map of all particle ranks and indices
-            std::map<unsigned int, std::pair<unsigned int, unsigned int> > rank_rtag_map;
-            std::map<unsigned int, unsigned int>::iterator it;
-            for (unsigned int irank = 0; irank < n_ranks; ++irank)
-                for (it = rtag_map_proc[irank].begin(); it != rtag_map_proc[irank].end(); ++it)
-                    rank_rtag_map.insert(std::pair<unsigned int, std::pair<unsigned int, unsigned int> >(
-                        it->first, std::pair<unsigned int, unsigned int>(irank, it->second)));
+            // reverse lookup of the gathered particles by tag
+            cached_host_vector<unsigned int> gathered_idx(getMaximumTag()+1, NOT_LOCAL, m_exec_conf->getHostCachedAllocator());
+            for (unsigned int i = 0; i < elements_all.size(); ++i)
+                gathered_idx[elements_all[i].tag] = i;
 
             // add particles to snapshot
             assert(m_tag_set.size() == getNGlobal());
             std::set<unsigned int>::const_iterator tag_set_it = m_tag_set.begin();
 
-            std::map<unsigned int, std::pair<unsigned int, unsigned int> >::iterator rank_rtag_it;
             for (unsigned int snap_id = 0; snap_id < getNGlobal(); snap_id++)
                 {
                 unsigned int tag = *tag_set_it;
                 assert(tag <= getMaximumTag());
-                rank_rtag_it = rank_rtag_map.find(tag);
+                unsigned int idx = gathered_idx[tag];
 
-                if (rank_rtag_it == rank_rtag_map.end())
+                if (idx == NOT_LOCAL)
                     {
                     m_exec_conf->msg->error()
                         << endl << "Could not find particle " << tag << " on any processor. "
@@ -1348,26 +1557,23 @@ std::map<unsigned int, unsigned int> ParticleData::takeSnapshot(SnapshotParticle
                     throw std::runtime_error("Error gathering ParticleData");
                     }
 
-                // rank contains the processor rank on which the particle was found
-                std::pair<unsigned int, unsigned int> rank_idx = rank_rtag_it->second;
-                unsigned int rank = rank_idx.first;
-                unsigned int idx = rank_idx.second;
+                const snapshot_element& p = elements_all[idx];
 
                 // store tag in index map
                 index.insert(std::make_pair(tag, snap_id));
 
-                snapshot.pos[snap_id] = vec3<Real>(pos_proc[rank][idx]);
-                snapshot.vel[snap_id] = vec3<Real>(vel_proc[rank][idx]);
-                snapshot.accel[snap_id] = vec3<Real>(accel_proc[rank][idx]);
-                snapshot.type[snap_id] = type_proc[rank][idx];
-                snapshot.mass[snap_id] = mass_proc[rank][idx];
-                snapshot.charge[snap_id] = charge_proc[rank][idx];
-                snapshot.diameter[snap_id] = diameter_proc[rank][idx];
-                snapshot.image[snap_id] = image_proc[rank][idx];
-                snapshot.body[snap_id] = body_proc[rank][idx];
-                snapshot.orientation[snap_id] = quat<Real>(orientation_proc[rank][idx]);
-                snapshot.angmom[snap_id] = quat<Real>(angmom_proc[rank][idx]);
-                snapshot.inertia[snap_id] = vec3<Real>(inertia_proc[rank][idx]);
+                snapshot.pos[snap_id] = vec3<Real>(p.pos);
+                snapshot.vel[snap_id] = vec3<Real>(p.vel);
+                snapshot.accel[snap_id] = vec3<Real>(p.accel);
+                snapshot.type[snap_id] = p.type;
+                snapshot.mass[snap_id] = p.mass;
+                snapshot.charge[snap_id] = p.charge;
+                snapshot.diameter[snap_id] = p.diameter;
+                snapshot.image[snap_id] = p.image;
+                snapshot.body[snap_id] = p.body;
+                snapshot.orientation[snap_id] = quat<Real>(p.orientation);
+                snapshot.angmom[snap_id] = quat<Real>(p.angmom);
+                snapshot.inertia[snap_id] = vec3<Real>(p.inertia);
 
                 // make sure the position stored in the snapshot is within the boundaries
                 Scalar3 tmp = vec_to_scalar3(snapshot.pos[snap_id]);
@@ -2478,19 +2684,27 @@ string print_ParticleData(ParticleData *pdata)
 template ParticleData::ParticleData(const SnapshotParticleData<double>& snapshot,
                                            const BoxDim& global_box,
                                            std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                           std::shared_ptr<DomainDecomposition> decomposition
+                                           std::shared_ptr<DomainDecomposition> decomposition,
+                                           bool distributed
                                           );
-template void ParticleData::initializeFromSnapshot<double>(const SnapshotParticleData<double> & snapshot, bool ignore_bodies);
+template void ParticleData::initializeFromSnapshot<double>(const SnapshotParticleData<double> & snapshot, bool ignore_bodies,
+    bool distributed);
 template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<double>(SnapshotParticleData<double> &snapshot);
+template void ParticleData::initializeReplicated<double>(const SnapshotParticleData<double>& unit, const BoxDim& unit_box,
+    unsigned int nx, unsigned int ny, unsigned int nz);
 
 
 template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
                                            const BoxDim& global_box,
                                            std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                           std::shared_ptr<DomainDecomposition> decomposition
+                                           std::shared_ptr<DomainDecomposition> decomposition,
+                                           bool distributed
                                           );
-template void ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float> & snapshot, bool ignore_bodies);
+template void ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float> & snapshot, bool ignore_bodies,
+    bool distributed);
 template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<float>(SnapshotParticleData<float> &snapshot);
+template void ParticleData::initializeReplicated<float>(const SnapshotParticleData<float>& unit, const BoxDim& unit_box,
+    unsigned int nx, unsigned int ny, unsigned int nz);
 
 
 void export_ParticleData(py::module& m)
@@ -2698,6 +2912,9 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out, std::vector<
         ArrayHandle<Scalar> h_net_virial_alt(m_net_virial_alt, access_location::host, access_mode::overwrite);
         ArrayHandle<unsigned int> h_tag_alt(m_tag_alt, access_location::host, access_mode::overwrite);
 
+        // record where the particles end up, for incremental updates of subscribers
+        m_reorder_map.resize(old_nparticles);
+
         unsigned int n =0;
         unsigned int m = 0;
         unsigned int net_virial_pitch = m_net_virial.getPitch();
@@ -2706,6 +2923,8 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out, std::vector<
             unsigned int tag = h_tag.data[i];
             if (h_rtag.data[tag] != NOT_LOCAL)
                 {
+                m_reorder_map[i] = n;
+
                 // copy over to alternate pdata arrays
                 h_pos_alt.data[n] = h_pos.data[i];
                 h_vel_alt.data[n] = h_vel.data[i];
@@ -2744,6 +2963,8 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out, std::vector<
                     p.net_virial[j] = h_net_virial.data[net_virial_pitch*j+i];
                 p.tag = h_tag.data[i];
                 out[m++] = p;
+
+                m_reorder_map[i] = NOT_LOCAL;
                 }
             }
 
@@ -2788,7 +3009,7 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out, std::vector<
     if (m_prof) m_prof->pop();
 
     // notify subscribers that particle data order has been changed
-    notifyParticleSort();
+    notifyParticleReorder(m_reorder_map.data(), old_nparticles, new_nparticles);
     }
 
 //! Remove particles from local domain and append new particle data
@@ -2862,8 +3083,8 @@ void ParticleData::addParticles(const std::vector<pdata_element>& in)
 
     if (m_prof) m_prof->pop();
 
-    // notify subscribers that particle data order has been changed
-    notifyParticleSort();
+    // notify subscribers that particle data order has been changed (existing particles keep their indices)
+    notifyParticleReorder(NULL, old_nparticles, old_nparticles);
     }
 
 #ifdef ENABLE_CUDA
@@ -3240,26 +3461,10 @@ void SnapshotParticleData<Real>::replicate(unsigned int nx, unsigned int ny, uns
             for (unsigned int m = 0; m < ny; m++)
                 for (unsigned int n = 0; n < nz; n++)
                     {
-                    Scalar3 f_new;
-                    // replicate particle
-                    f_new.x = f.x/(Real)nx + (Real)l/(Real)nx;
-                    f_new.y = f.y/(Real)ny + (Real)m/(Real)ny;
-                    f_new.z = f.z/(Real)nz + (Real)n/(Real)nz;
-
                     unsigned int k = j*old_size + i;
 
-                    // coordinates in new box
-                    Scalar3 q = new_box.makeCoordinates(f_new);
-
-                    // wrap by multiple box vectors if necessary
-                    image[k] = new_box.getImage(q);
-                    int3 negimg = make_int3(-image[k].x, -image[k].y, -image[k].z);
-                    q = new_box.shift(q, negimg);
-
-                    // rewrap using wrap so that rounding is consistent
-                    new_box.wrap(q,image[k]);
-
-                    pos[k] = vec3<Real>(q);
+                    // replicate particle
+                    pos[k] = replica_position(f, l, m, n, nx, ny, nz, new_box, image[k]);
                     vel[k] = vel[i];
                     accel[k] = accel[i];
                     type[k] = type[i];
@@ -261,6 +261,27 @@ struct pdata_element
     Scalar net_virial[6];      //!< net virial
     };
 
+//! Structure to store the per-particle data of a snapshot
+/*! All fields of a particle are transmitted together, so that a snapshot is gathered or scattered in a single
+    collective without serialization.
+*/
+struct snapshot_element
+    {
+    Scalar3 pos;               //!< Position
+    Scalar3 vel;               //!< Velocity
+    Scalar3 accel;             //!< Acceleration
+    Scalar3 inertia;           //!< Principal moments of inertia
+    Scalar4 orientation;       //!< Orientation
+    Scalar4 angmom;            //!< Angular momentum
+    int3 image;                //!< Image flags
+    unsigned int type;         //!< Type id
+    unsigned int body;         //!< Body id
+    unsigned int tag;          //!< Global tag
+    Scalar mass;               //!< Mass
+    Scalar charge;             //!< Charge
+    Scalar diameter;           //!< Diameter
+    };
+
 //! Manages all of the data arrays for the particles
 /*! <h1> General </h1>
     ParticleData stores and manages particle coordinates, velocities, accelerations, type,
@@ -293,7 +314,10 @@ struct pdata_element
 
     In order to help other classes deal with particles changing indices, any class that
     changes the order must call notifyParticleSort(). Any class interested in being notified
-    can subscribe to the signal by calling connectParticleSort().
+    can subscribe to the signal by calling connectParticleSort(). Classes that know how the particles were
+    rearranged (a permutation, or the removal and addition of particles during migration) call
+    notifyParticleReorder() instead, which passes the map from old to new indices to subscribers of
+    getParticleReorderSignal() before triggering the sort signal, so that they can update incrementally.
 
     Some fields in ParticleData are not computed and assigned by default because they require additional processing
     time. PDataFlags is a bitset that lists which flags (enumerated in pdata_flag) are enable/disabled. Computes should
@@ -419,7 +443,8 @@ class PYBIND11_EXPORT ParticleData
                      const BoxDim& global_box,
                      std::shared_ptr<ExecutionConfiguration> exec_conf,
                      std::shared_ptr<DomainDecomposition> decomposition
-                        = std::shared_ptr<DomainDecomposition>()
+                        = std::shared_ptr<DomainDecomposition>(),
+                     bool distributed = false
                      );
 
         //! Destructor
@@ -731,6 +756,21 @@ class PYBIND11_EXPORT ParticleData
         //! Notify listeners that the particles have been rearranged in memory
         void notifyParticleSort();
 
+        //! Connects a function to be called when the particles are rearranged in a known way
+        /*! Subscribers are called with (old_to_new, old_N, first_new). \a old_to_new lists the new index of every
+            particle that was local before the rearrangement (NOT_LOCAL if it has been removed), or is NULL if the old
+            particles kept their indices. \a old_N is the number of local particles before the rearrangement and
+            particles with index first_new .. getN()-1 have been newly added. The particle sort signal is always
+            triggered immediately afterwards.
+        */
+        Nano::Signal<void (const unsigned int *, unsigned int, unsigned int)>& getParticleReorderSignal()
+            {
+            return m_reorder_signal;
+            }
+
+        //! Notify listeners that the particles have been rearranged in memory according to a known map
+        void notifyParticleReorder(const unsigned int *old_to_new, unsigned int old_N, unsigned int first_new);
+
         //! Connects a function to be called every time the box size is changed
         Nano::Signal<void ()>& getBoxChangeSignal()
             {
@@ -975,7 +1015,13 @@ class PYBIND11_EXPORT ParticleData
 
         //! Initialize from a snapshot
         template <class Real>
-        void initializeFromSnapshot(const SnapshotParticleData<Real> & snapshot, bool ignore_bodies=false);
+        void initializeFromSnapshot(const SnapshotParticleData<Real> & snapshot, bool ignore_bodies=false,
+            bool distributed=false);
+
+        //! Initialize with a unit cell snapshot replicated along the box vectors
+        template <class Real>
+        void initializeReplicated(const SnapshotParticleData<Real>& unit, const BoxDim& unit_box,
+            unsigned int nx, unsigned int ny, unsigned int nz);
 
         //! Take a snapshot
         template <class Real>
@@ -1115,6 +1161,7 @@ class PYBIND11_EXPORT ParticleData
         std::vector<std::string> m_type_mapping;    //!< Mapping between particle type indices and names
 
         Nano::Signal<void ()> m_sort_signal;       //!< Signal that is triggered when particles are sorted in memory
+        Nano::Signal<void (const unsigned int *, unsigned int, unsigned int)> m_reorder_signal; //!< Signal that is triggered with the map of a rearrangement
         Nano::Signal<void ()> m_boxchange_signal;  //!< Signal that is triggered when the box size changes
         Nano::Signal<void ()> m_max_particle_num_signal; //!< Signal that is triggered when the maximum particle number changes
         Nano::Signal<void ()> m_ghost_particles_removed_signal; //!< Signal that is triggered when ghost particles are removed
@@ -1151,6 +1198,7 @@ class PYBIND11_EXPORT ParticleData
         std::set<unsigned int> m_tag_set;            //!< Lookup table for tags by active index
         std::vector<unsigned int> m_cached_tag_set;   //!< Cached constant-time lookup table for tags by active index
         bool m_invalid_cached_tags;                  //!< true if m_cached_tag_set needs to be rebuilt
+        std::vector<unsigned int> m_reorder_map;     //!< Map from old to new particle indices during removal
 
         /* Alternate particle data arrays are provided for fast swapping in and out of particle data
            The size of these arrays is updated in sync with the main particle data arrays.
@@ -1217,9 +1265,18 @@ class PYBIND11_EXPORT ParticleData
         //! Helper function to check that particles of a snapshot are in the box
         /*! \return true If and only if all particles are in the simulation box
          * \param Snapshot to check
+         * \param distributed True if every rank holds a part of the snapshot
          */
         template <class Real>
-        bool inBox(const SnapshotParticleData<Real>& snap);
+        bool inBox(const SnapshotParticleData<Real>& snap, bool distributed=false);
+
+        #ifdef ENABLE_MPI
+        //! Helper function to wrap a particle during initialization and find the rank it is placed on
+        unsigned int placeInitialParticle(Scalar3& pos, int3& img, const unsigned int *cart_ranks, unsigned int idx);
+
+        //! Helper function to replace the local particles during initialization
+        void loadSnapshotElements(const std::vector<snapshot_element>& elements, unsigned int nglobal);
+        #endif
 
         //! Update the CUDA memory hints
         void setGPUAdvice();
@@ -376,6 +376,7 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
       m_particles_sorted(true),
       m_reallocated(false),
       m_global_ptl_num_change(false),
+      m_reorder_applied(false),
       m_selector(selector),
       m_update_tags(update_tags),
       m_warning_printed(false)
@@ -388,8 +389,9 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
     // update member tag arrays
     updateMemberTags(true);
 
-    // connect to the particle sort signal
+    // connect to the particle sort signals
     m_pdata->getParticleSortSignal().connect<ParticleGroup, &ParticleGroup::slotParticleSort>(this);
+    m_pdata->getParticleReorderSignal().connect<ParticleGroup, &ParticleGroup::slotParticleReorder>(this);
 
     // connect reallocate() method to maximum particle number change signal
     m_pdata->getMaxParticleNumberChangeSignal().connect<ParticleGroup, &ParticleGroup::slotReallocate>(this);
@@ -414,6 +416,7 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef, const std
       m_particles_sorted(true),
       m_reallocated(false),
       m_global_ptl_num_change(false),
+      m_reorder_applied(false),
       m_update_tags(false),
       m_warning_printed(false)
     {
@@ -462,10 +465,6 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef, const std
     m_is_member.swap(is_member);
     TAG_ALLOCATION(m_is_member);
 
-    GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_pdata->getExecConf());
-    m_is_member_tag.swap(is_member_tag);
-    TAG_ALLOCATION(m_is_member_tag);
-
     // build the reverse lookup table for tags
     buildTagHash();
 
@@ -481,8 +480,9 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef, const std
     // now that the tag list is completely set up and all memory is allocated, rebuild the index list
     rebuildIndexList();
 
-    // connect to the particle sort signal
+    // connect to the particle sort signals
     m_pdata->getParticleSortSignal().connect<ParticleGroup, &ParticleGroup::slotParticleSort>(this);
+    m_pdata->getParticleReorderSignal().connect<ParticleGroup, &ParticleGroup::slotParticleReorder>(this);
 
     // connect reallocate() method to maximum particle number change signal
     m_pdata->getMaxParticleNumberChangeSignal().connect<ParticleGroup, &ParticleGroup::slotReallocate>(this);
@@ -500,6 +500,7 @@ ParticleGroup::~ParticleGroup()
     if (m_pdata)
         {
         m_pdata->getParticleSortSignal().disconnect<ParticleGroup, &ParticleGroup::slotParticleSort>(this);
+        m_pdata->getParticleReorderSignal().disconnect<ParticleGroup, &ParticleGroup::slotParticleReorder>(this);
         m_pdata->getMaxParticleNumberChangeSignal().disconnect<ParticleGroup, &ParticleGroup::slotReallocate>(this);
         m_pdata->getGlobalParticleNumberChangeSignal().disconnect<ParticleGroup, &ParticleGroup::slotGlobalParticleNumChange>(this);
         }
@@ -572,10 +573,6 @@ void ParticleGroup::updateMemberTags(bool force_update) const
     m_is_member.swap(is_member);
     TAG_ALLOCATION(m_is_member);
 
-    GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_pdata->getExecConf());
-    m_is_member_tag.swap(is_member_tag);
-    TAG_ALLOCATION(m_is_member_tag);
-
     // build the reverse lookup table for tags
     buildTagHash();
 
@@ -587,13 +584,9 @@ void ParticleGroup::reallocate() const
     {
     m_is_member.resize(m_pdata->getMaxN());
 
-    if (m_is_member_tag.getNumElements() != m_pdata->getRTags().size())
+    if (m_tag_membership->is_member_tag.getNumElements() != m_pdata->getRTags().size())
         {
         // reallocate if necessary
-        GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_exec_conf);
-        m_is_member_tag.swap(is_member_tag);
-        TAG_ALLOCATION(m_is_member_tag);
-
         buildTagHash();
         }
     }
@@ -790,21 +783,84 @@ std::shared_ptr<ParticleGroup> ParticleGroup::groupDifference(std::shared_ptr<Pa
     return new_group;
     }
 
+//! Returns the list of per-tag membership flags currently in use by any group
+static std::vector< std::weak_ptr<TagMembership> >& getTagMembershipRegistry()
+    {
+    static std::vector< std::weak_ptr<TagMembership> > registry;
+    return registry;
+    }
+
 /*! Builds the by-tag-lookup table for group membership
+
+    If another group of the same particle data already holds a table with exactly the same members, that table is
+    shared instead of building a new one.
  */
 void ParticleGroup::buildTagHash() const
     {
-    ArrayHandle<unsigned int> h_is_member_tag(m_is_member_tag, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_member_tags(m_member_tags, access_location::host, access_mode::read);
 
-    // reset member ship flags
-    memset(h_is_member_tag.data, 0, sizeof(unsigned int)*(m_pdata->getRTags().size()));
+    // count distinct members, the member tags are sorted
+    unsigned int num_tags = m_member_tags.getNumElements();
+    unsigned int num_members = 0;
+    for (unsigned int member = 0; member < num_tags; member++)
+        {
+        if (member == 0 || h_member_tags.data[member] != h_member_tags.data[member-1])
+            num_members++;
+        }
+
+    // look for an identical table, pruning those that are no longer in use
+    std::vector< std::weak_ptr<TagMembership> >& registry = getTagMembershipRegistry();
+    std::shared_ptr<TagMembership> membership;
+    for (auto it = registry.begin(); it != registry.end(); )
+        {
+        std::shared_ptr<TagMembership> candidate = it->lock();
+        if (!candidate)
+            {
+            it = registry.erase(it);
+            continue;
+            }
+        ++it;
+
+        if (membership || candidate->pdata != m_pdata.get() || candidate->num_members != num_members
+            || candidate->is_member_tag.getNumElements() != m_pdata->getRTags().size())
+            continue;
+
+        // with the same number of members, the tables are identical if all our members are flagged
+        ArrayHandle<unsigned int> h_is_member_tag(candidate->is_member_tag, access_location::host, access_mode::read);
+        bool identical = true;
+        for (unsigned int member = 0; member < num_tags; member++)
+            {
+            if (!h_is_member_tag.data[h_member_tags.data[member]])
+                {
+                identical = false;
+                break;
+                }
+            }
 
-    unsigned int num_members = m_member_tags.getNumElements();
-    for (unsigned int member = 0; member < num_members; member++)
+        if (identical)
+            membership = candidate;
+        }
+
+    if (!membership)
         {
-        h_is_member_tag.data[h_member_tags.data[member]] = 1;
+        membership = std::shared_ptr<TagMembership>(new TagMembership(m_pdata, num_members));
+        TAG_ALLOCATION(membership->is_member_tag);
+
+        ArrayHandle<unsigned int> h_is_member_tag(membership->is_member_tag, access_location::host,
+            access_mode::overwrite);
+
+        // reset member ship flags
+        memset(h_is_member_tag.data, 0, sizeof(unsigned int)*(m_pdata->getRTags().size()));
+
+        for (unsigned int member = 0; member < num_tags; member++)
+            {
+            h_is_member_tag.data[h_member_tags.data[member]] = 1;
+            }
+
+        registry.push_back(membership);
         }
+
+    m_tag_membership = membership;
     }
 
 /*! \pre m_member_tags has been filled out, listing all particle tags in the group
@@ -828,7 +884,8 @@ void ParticleGroup::rebuildIndexList() const
 
         // rebuild the membership flags for the  indices in the group and construct member list
         ArrayHandle<unsigned int> h_is_member(m_is_member, access_location::host, access_mode::readwrite);
-        ArrayHandle<unsigned int> h_is_member_tag(m_is_member_tag, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_is_member_tag(m_tag_membership->is_member_tag, access_location::host,
+            access_mode::read);
         ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_member_idx(m_member_idx, access_location::host, access_mode::readwrite);
         unsigned int nparticles = m_pdata->getN();
@@ -861,6 +918,88 @@ void ParticleGroup::rebuildIndexList() const
     #endif
     }
 
+/*! \param old_to_new New index of every previously local particle (NOT_LOCAL if removed), NULL for the identity
+    \param old_N Number of local particles before the rearrangement
+    \param first_new Index of the first newly added local particle
+
+    The index list is updated incrementally, unless a full rebuild is pending anyway.
+*/
+void ParticleGroup::slotParticleReorder(const unsigned int *old_to_new, unsigned int old_N, unsigned int first_new)
+    {
+    if (m_particles_sorted || m_reallocated || m_global_ptl_num_change)
+        return;
+
+    #ifdef ENABLE_CUDA
+    // the GPU rebuilds the full index list in a single pass
+    if (m_exec_conf->isCUDAEnabled())
+        return;
+    #endif
+
+    updateIndexList(old_to_new, old_N, first_new);
+    m_reorder_applied = true;
+    }
+
+/*! \param old_to_new New index of every previously local particle (NOT_LOCAL if removed), NULL for the identity
+    \param old_N Number of local particles before the rearrangement
+    \param first_new Index of the first newly added local particle
+
+    \pre m_member_idx and m_is_member reflect the particle order before the rearrangement
+    \post m_is_member and m_member_idx are the same as after rebuildIndexList()
+
+    Only the current members and the newly added particles are visited, instead of all local particles.
+*/
+void ParticleGroup::updateIndexList(const unsigned int *old_to_new, unsigned int old_N, unsigned int first_new) const
+    {
+    // notice message
+    m_pdata->getExecConf()->msg->notice(10) << "ParticleGroup: updating index" << std::endl;
+
+    ArrayHandle<unsigned int> h_is_member(m_is_member, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_is_member_tag(m_tag_membership->is_member_tag, access_location::host,
+        access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_member_idx(m_member_idx, access_location::host, access_mode::readwrite);
+
+    // move the members that are still local to their new index
+    unsigned int cur_member = 0;
+    bool sorted = true;
+    for (unsigned int j = 0; j < m_num_local_members; j++)
+        {
+        unsigned int old_idx = h_member_idx.data[j];
+        assert(old_idx < old_N);
+        h_is_member.data[old_idx] = 0;
+
+        unsigned int new_idx = old_to_new ? old_to_new[old_idx] : old_idx;
+        if (new_idx == NOT_LOCAL)
+            continue;
+
+        if (cur_member > 0 && new_idx < h_member_idx.data[cur_member-1])
+            sorted = false;
+        h_member_idx.data[cur_member++] = new_idx;
+        }
+
+    // keep the index list in index order
+    if (!sorted)
+        std::sort(h_member_idx.data, h_member_idx.data + cur_member);
+
+    // append the new members, their indices come after all the old particles
+    unsigned int nparticles = m_pdata->getN();
+    for (unsigned int idx = first_new; idx < nparticles; idx++)
+        {
+        assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
+        if (h_is_member_tag.data[h_tag.data[idx]])
+            {
+            assert(cur_member == 0 || h_member_idx.data[cur_member-1] < idx);
+            h_member_idx.data[cur_member++] = idx;
+            }
+        }
+
+    for (unsigned int j = 0; j < cur_member; j++)
+        h_is_member.data[h_member_idx.data[j]] = 1;
+
+    m_num_local_members = cur_member;
+    assert(m_num_local_members <= m_member_tags.getNumElements());
+    }
+
 void ParticleGroup::updateGPUAdvice() const
     {
     #ifdef ENABLE_CUDA
@@ -893,7 +1032,8 @@ void ParticleGroup::updateGPUAdvice() const
 void ParticleGroup::rebuildIndexListGPU() const
     {
     ArrayHandle<unsigned int> d_is_member(m_is_member, access_location::device, access_mode::overwrite);
-    ArrayHandle<unsigned int> d_is_member_tag(m_is_member_tag, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_is_member_tag(m_tag_membership->is_member_tag, access_location::device,
+        access_mode::read);
     ArrayHandle<unsigned int> d_member_idx(m_member_idx, access_location::device, access_mode::overwrite);
     ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
 
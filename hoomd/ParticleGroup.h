@@ -177,6 +177,25 @@ class PYBIND11_EXPORT ParticleSelectorRigidCenter : public ParticleSelector
     };
 
 
+//! Per-tag membership flags of a particle group
+/*! A TagMembership is shared between all ParticleGroups of the same ParticleData that select the same set of
+    particles. Its contents are never modified after construction, groups whose members change acquire a new one.
+*/
+struct TagMembership
+    {
+    //! Constructor
+    TagMembership(std::shared_ptr<ParticleData> _pdata, unsigned int _num_members)
+        : is_member_tag(_pdata->getRTags().size(), _pdata->getExecConf()),
+          pdata(_pdata.get()),
+          num_members(_num_members)
+        {
+        }
+
+    GlobalArray<unsigned int> is_member_tag;  //!< One entry per tag, == 1 if tag is a member of the group
+    const ParticleData *pdata;                //!< The particle data the tags refer to
+    unsigned int num_members;                 //!< Number of tags flagged as members
+    };
+
 //! Describes a group of particles
 /*! \b Overview
 
@@ -210,6 +229,11 @@ class PYBIND11_EXPORT ParticleSelectorRigidCenter : public ParticleSelector
     Thirdly, a dynamic bitset is used to store one bit per particle for efficient O(1) tests if a given particle is in
     the group.
 
+    The per-tag membership flags from which the index list is built are stored in a TagMembership, which is shared
+    between all groups of the same ParticleData that contain exactly the same particles. When ParticleData reports
+    how the particles were rearranged (see ParticleData::getParticleReorderSignal()), the index list is updated
+    incrementally from the old list instead of scanning all local particles.
+
     Finally, the common use case on the GPU using groups will include running one thread per particle in the group.
     For that it needs a list of indices of all the particles in the group. To facilitates this, the list of indices
     in the group will be stored in a GPUArray.
@@ -372,7 +396,9 @@ class PYBIND11_EXPORT ParticleGroup
         mutable bool m_reallocated;                     //!< True if particle data arrays have been reallocated
         mutable bool m_global_ptl_num_change;           //!< True if the global particle number changed
 
-        mutable GlobalArray<unsigned int> m_is_member_tag;  //!< One byte per particle, == 1 if tag is a member of the group
+        mutable bool m_reorder_applied;                 //!< True if the last particle sort was handled incrementally
+
+        mutable std::shared_ptr<TagMembership> m_tag_membership;  //!< Per-tag membership flags (shared)
         std::shared_ptr<ParticleSelector> m_selector; //!< The associated particle selector
 
         bool m_update_tags;                             //!< True if tags should be updated when global number of particles changes
@@ -424,9 +450,19 @@ class PYBIND11_EXPORT ParticleGroup
         //! Helper function to be called when the particles are resorted
         void slotParticleSort()
             {
-            m_particles_sorted = true;
+            // the index list is already up to date if the rearrangement was announced with its map
+            if (m_reorder_applied)
+                m_reorder_applied = false;
+            else
+                m_particles_sorted = true;
             }
 
+        //! Helper function to be called when the particles are rearranged according to a known map
+        void slotParticleReorder(const unsigned int *old_to_new, unsigned int old_N, unsigned int first_new);
+
+        //! Helper function to update the index list incrementally after the particles have been rearranged
+        void updateIndexList(const unsigned int *old_to_new, unsigned int old_N, unsigned int first_new) const;
+
         //! Update the GPU memory advice
         void updateGPUAdvice() const;
 
@@ -436,7 +472,7 @@ class PYBIND11_EXPORT ParticleGroup
             m_global_ptl_num_change = true;
             }
 
-        //! Helper function to build the 1:1 hash for tag membership
+        //! Helper function to build the 1:1 hash for tag membership, or share an identical one with another group
         void buildTagHash() const;
 
 #ifdef ENABLE_CUDA
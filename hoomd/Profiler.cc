@@ -10,6 +10,8 @@
 
 #include "Profiler.h"
 
+#include <hoomd/extern/pybind/include/pybind11/stl.h>
+
 #include <iomanip>
 #include <sstream>
 
@@ -188,6 +190,20 @@ void ProfileDataElem::output_line(std::ostream &o,
     o << endl;
     }
 
+/*! \param timings Map to add the elapsed times (in seconds) to
+    \param name Full name of this node
+
+    Nodes are keyed by their path in the tree, e.g. "Simulation/Integrate/Net force".
+*/
+void ProfileDataElem::collect(std::map<std::string, double>& timings, const std::string& name) const
+    {
+    timings[name] = double(m_elapsed_time)/1e9;
+
+    map<string, ProfileDataElem>::const_iterator i;
+    for (i = m_children.begin(); i != m_children.end(); ++i)
+        (*i).second.collect(timings, name + "/" + (*i).first);
+    }
+
 ////////////////////////////////////////////////////////////////////
 // Profiler
 
@@ -223,6 +239,19 @@ void Profiler::output(std::ostream &o)
     m_root.output(o, m_name, 0, m_root.m_elapsed_time, (int)m_name.size());
     }
 
+/*! The total time of the root is sampled when the profile is output at the end of a run. Profiles that have not been
+    output yet are sampled now.
+*/
+std::map<std::string, double> Profiler::getTimings()
+    {
+    if (m_root.m_elapsed_time == 0)
+        m_root.m_elapsed_time = m_clk.getTime() - m_root.m_start_time;
+
+    std::map<std::string, double> timings;
+    m_root.collect(timings, m_name);
+    return timings;
+    }
+
 /*! \param o Stream to output to
     \param prof Profiler to print
 */
@@ -247,8 +276,9 @@ string print_profiler(Profiler *prof)
 
 void export_Profiler(py::module& m)
     {
-    py::class_<Profiler>(m,"Profiler")
+    py::class_<Profiler, std::shared_ptr<Profiler> >(m,"Profiler")
     .def(py::init<const std::string&>())
     .def("__str__", &print_profiler)
+    .def("getTimings", &Profiler::getTimings)
     ;
     }
@@ -86,6 +86,8 @@ class PYBIND11_EXPORT ProfileDataElem
                          double flops,
                          double bytes,
                          unsigned int name_width) const;
+        //! Collect the elapsed times of this node and all sub nodes
+        void collect(std::map<std::string, double>& timings, const std::string& name) const;
 
         std::map<std::string, ProfileDataElem> m_children; //!< Child nodes of this profile
 
@@ -135,6 +137,9 @@ class PYBIND11_EXPORT Profiler
         //! Pops back up to the next super-category & syncs the GPUs
         void pop(std::shared_ptr<const ExecutionConfiguration> exec_conf, uint64_t flop_count = 0, uint64_t byte_count = 0);
 
+        //! Get the elapsed time in seconds of every node in the profile tree
+        std::map<std::string, double> getTimings();
+
     private:
         ClockSource m_clk;  //!< Clock to provide timing information
         std::string m_name; //!< The name of this profile
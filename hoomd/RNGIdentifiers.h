@@ -30,6 +30,7 @@ struct RNGIdentifier
     static const uint32_t UpdaterBoxMC= 0xf6a510ab;
     static const uint32_t UpdaterClusters =  0x09365bf5;
     static const uint32_t UpdaterClustersPairwise = 0x50060112;
+    static const uint32_t UpdaterEventChain = 0x3c5e8a71;
     static const uint32_t UpdaterExternalFieldWall = 0xba015a6f;
     static const uint32_t UpdaterMuVT = 0x186df7ba;
     static const uint32_t UpdaterMuVTBox1 = 0x05d4a502;
@@ -47,6 +48,7 @@ struct RNGIdentifier
     static const uint32_t SRDCollisionMethod = 0x7b61fda0;
     static const uint32_t SlitGeometryFiller = 0xdb68c12c;
     static const uint32_t SlitPoreGeometryFiller = 0xc7af9094;
+    static const uint32_t GridGeometryFiller = 0x3f1ad9e2;
     };
 
 }
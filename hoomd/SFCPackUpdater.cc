@@ -18,13 +18,18 @@
 #include <fstream>
 #include <iostream>
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 
 /*! \param sysdef System to perform sorts on
  */
 SFCPackUpdater::SFCPackUpdater(std::shared_ptr<SystemDefinition> sysdef)
-        : Updater(sysdef), m_last_grid(0), m_last_dim(0)
+        : Updater(sysdef), m_last_grid(0), m_last_dim(0), m_adaptive(false), m_threshold(1.5),
+          m_sorted_metric(-1.0), m_last_metric(0.0), m_num_sorts(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing SFCPackUpdater" << endl;
 
@@ -32,6 +37,7 @@ SFCPackUpdater::SFCPackUpdater(std::shared_ptr<SystemDefinition> sysdef)
     assert(m_pdata);
 
     m_sort_order.resize(m_pdata->getMaxN());
+    m_inverse_sort_order.resize(m_pdata->getMaxN());
     m_particle_bins.resize(m_pdata->getMaxN());
 
     // set the default grid
@@ -51,6 +57,7 @@ SFCPackUpdater::SFCPackUpdater(std::shared_ptr<SystemDefinition> sysdef)
 void SFCPackUpdater::reallocate()
     {
     m_sort_order.resize(m_pdata->getMaxN());
+    m_inverse_sort_order.resize(m_pdata->getMaxN());
     m_particle_bins.resize(m_pdata->getMaxN());
     }
 
@@ -62,14 +69,78 @@ SFCPackUpdater::~SFCPackUpdater()
     m_pdata->getMaxParticleNumberChangeSignal().disconnect<SFCPackUpdater, &SFCPackUpdater::reallocate>(this);
     }
 
+/*! The locality metric is the mean minimum image distance between particles that are adjacent in memory, in units
+    of the mean interparticle spacing. It is close to 1 right after a sort and grows as the particles diffuse away
+    from their neighbors in memory. The metric is reduced over all ranks, so every rank reaches the same decision.
+
+    \returns The locality metric of the current particle order
+*/
+Scalar SFCPackUpdater::computeLocalityMetric()
+    {
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    unsigned int N = m_pdata->getN();
+
+    Scalar sum = Scalar(0.0);
+    unsigned int count = 0;
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+
+        for (unsigned int i = 1; i < N; i++)
+            {
+            Scalar3 dx = make_scalar3(h_pos.data[i].x - h_pos.data[i-1].x,
+                                      h_pos.data[i].y - h_pos.data[i-1].y,
+                                      h_pos.data[i].z - h_pos.data[i-1].z);
+            dx = global_box.minImage(dx);
+            sum += fast::sqrt(dot(dx, dx));
+            }
+        count = (N > 1) ? N - 1 : 0;
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &sum, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &count, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    if (count == 0)
+        return Scalar(0.0);
+
+    // normalize by the mean interparticle spacing
+    unsigned int ndim = m_sysdef->getNDimensions();
+    Scalar volume = global_box.getVolume(ndim == 2);
+    Scalar spacing = pow(volume / Scalar(m_pdata->getNGlobal()), Scalar(1.0) / Scalar(ndim));
+
+    return sum / Scalar(count) / spacing;
+    }
+
 /*! Performs the sort.
     \note In an updater list, this sort should be done first, before anyone else
     gets ahold of the particle data
 
+    In adaptive mode, the sort is skipped while the locality metric has not grown by more than the threshold factor
+    since the last sort.
+
     \param timestep Current timestep of the simulation
  */
 void SFCPackUpdater::update(unsigned int timestep)
     {
+    if (m_adaptive)
+        {
+        if (m_prof) m_prof->push(m_exec_conf, "SFCPack metric");
+        m_last_metric = computeLocalityMetric();
+        if (m_prof) m_prof->pop(m_exec_conf);
+
+        if (m_sorted_metric >= Scalar(0.0) && m_last_metric <= m_threshold * m_sorted_metric)
+            {
+            m_exec_conf->msg->notice(6) << "SFCPackUpdater: skipping sort, locality metric " << m_last_metric
+                                        << std::endl;
+            return;
+            }
+        }
+
     m_exec_conf->msg->notice(6) << "SFCPackUpdater: particle sort" << std::endl;
 
     #ifdef ENABLE_MPI
@@ -94,9 +165,18 @@ void SFCPackUpdater::update(unsigned int timestep)
 
     // apply that sort order to the particles
     applySortOrder();
+    m_num_sorts++;
 
     // trigger sort signal (this also forces particle migration)
-    m_pdata->notifyParticleSort();
+    #ifdef ENABLE_CUDA
+    if (m_exec_conf->isCUDAEnabled())
+        m_pdata->notifyParticleSort();
+    else
+    #endif
+        {
+        // pass the permutation along, so that subscribers can update incrementally
+        m_pdata->notifyParticleReorder(m_inverse_sort_order.data(), m_pdata->getN(), m_pdata->getN());
+        }
 
     #ifdef ENABLE_MPI
     if (m_comm)
@@ -107,145 +187,119 @@ void SFCPackUpdater::update(unsigned int timestep)
     #endif
 
     if (m_prof) m_prof->pop(m_exec_conf);
+
+    // remember how well ordered the particles are right after the sort
+    if (m_adaptive)
+        {
+        m_sorted_metric = computeLocalityMetric();
+        m_last_metric = m_sorted_metric;
+        }
     }
 
+/*! The particles are gathered into the alternate particle data arrays in a single pass and the alternate arrays are
+    swapped in afterwards, so no temporary copies are made.
+*/
 void SFCPackUpdater::applySortOrder()
     {
     assert(m_pdata);
     assert(m_sort_order.size() >= m_pdata->getN());
-    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::readwrite);
-    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
-    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::readwrite);
-    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::readwrite);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::readwrite);
-
-    // construct a temporary holding array for the sorted data
-    Scalar4 *scal4_tmp = new Scalar4[m_pdata->getN()];
-
-    // sort positions and types
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal4_tmp[i] = h_pos.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_pos.data[i] = scal4_tmp[i];
-
-    // sort velocities and mass
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal4_tmp[i] = h_vel.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_vel.data[i] = scal4_tmp[i];
-
-    Scalar3 *scal3_tmp = new Scalar3[m_pdata->getN()];
-    // sort accelerations
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal3_tmp[i] = h_accel.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_accel.data[i] = scal3_tmp[i];
-
-    Scalar *scal_tmp  = new Scalar[m_pdata->getN()];
-    // sort charge
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal_tmp[i] = h_charge.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_charge.data[i] = scal_tmp[i];
-
-    // sort diameter
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal_tmp[i] = h_diameter.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_diameter.data[i] = scal_tmp[i];
-
-    // sort angular momentum
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal4_tmp[i] = h_angmom.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_angmom.data[i] = scal4_tmp[i];
-
-    // sort moment of inertia
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal3_tmp[i] = h_inertia.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_inertia.data[i] = scal3_tmp[i];
-
-    // in case anyone access it from frame to frame, sort the net virial
-        {
-        ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(), access_location::host, access_mode::readwrite);
-        unsigned int virial_pitch = m_pdata->getNetVirial().getPitch();
 
-        for (unsigned int j = 0; j < 6; j++)
-            {
-            for (unsigned int i = 0; i < m_pdata->getN(); i++)
-                scal_tmp[i] = h_net_virial.data[j*virial_pitch+m_sort_order[i]];
-            for (unsigned int i = 0; i < m_pdata->getN(); i++)
-                h_net_virial.data[j*virial_pitch+i] = scal_tmp[i];
-            }
-        }
+    unsigned int N = m_pdata->getN();
 
-    // sort net force, net torque, and orientation
         {
-        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::readwrite);
+        // access alternate arrays to write to
+        ArrayHandle<Scalar4> h_pos_alt(m_pdata->getAltPositions(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_vel_alt(m_pdata->getAltVelocities(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_accel_alt(m_pdata->getAltAccelerations(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge_alt(m_pdata->getAltCharges(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter_alt(m_pdata->getAltDiameters(), access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image_alt(m_pdata->getAltImages(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body_alt(m_pdata->getAltBodies(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag_alt(m_pdata->getAltTags(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation_alt(m_pdata->getAltOrientationArray(),
+                                               access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_angmom_alt(m_pdata->getAltAngularMomentumArray(),
+                                          access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_inertia_alt(m_pdata->getAltMomentsOfInertiaArray(),
+                                           access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_net_virial_alt(m_pdata->getAltNetVirial(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_net_force_alt(m_pdata->getAltNetForce(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_net_torque_alt(m_pdata->getAltNetTorqueArray(),
+                                              access_location::host, access_mode::overwrite);
+
+        // access live particle data to read from
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(), access_location::host, access_mode::read);
+
+        // access rtags
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::readwrite);
 
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            scal4_tmp[i] = h_net_force.data[m_sort_order[i]];
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            h_net_force.data[i] = scal4_tmp[i];
-        }
-
-        {
-        ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(), access_location::host, access_mode::readwrite);
-
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            scal4_tmp[i] = h_net_torque.data[m_sort_order[i]];
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            h_net_torque.data[i] = scal4_tmp[i];
-        }
-
-        {
-        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
-
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            scal4_tmp[i] = h_orientation.data[m_sort_order[i]];
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            h_orientation.data[i] = scal4_tmp[i];
-        }
+        unsigned int virial_pitch = m_pdata->getNetVirial().getPitch();
+        unsigned int virial_pitch_alt = m_pdata->getAltNetVirial().getPitch();
 
-    // sort image
-    int3 *int3_tmp = new int3[m_pdata->getN()];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        int3_tmp[i] = h_image.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_image.data[i] = int3_tmp[i];
-
-    // sort body
-    unsigned int *uint_tmp = new unsigned int[m_pdata->getN()];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        uint_tmp[i] = h_body.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_body.data[i] = uint_tmp[i];
-
-    // sort global tag
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        uint_tmp[i] = h_tag.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_tag.data[i] = uint_tmp[i];
-
-    // rebuild global rtag
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        {
-        h_rtag.data[h_tag.data[i]] = i;
+        // every particle is written to a different slot, so the loop can run in parallel
+        auto move_particle = [&](unsigned int i)
+            {
+            unsigned int old_idx = m_sort_order[i];
+
+            h_pos_alt.data[i] = h_pos.data[old_idx];
+            h_vel_alt.data[i] = h_vel.data[old_idx];
+            h_accel_alt.data[i] = h_accel.data[old_idx];
+            h_charge_alt.data[i] = h_charge.data[old_idx];
+            h_diameter_alt.data[i] = h_diameter.data[old_idx];
+            h_image_alt.data[i] = h_image.data[old_idx];
+            h_body_alt.data[i] = h_body.data[old_idx];
+            h_orientation_alt.data[i] = h_orientation.data[old_idx];
+            h_angmom_alt.data[i] = h_angmom.data[old_idx];
+            h_inertia_alt.data[i] = h_inertia.data[old_idx];
+            h_net_force_alt.data[i] = h_net_force.data[old_idx];
+            h_net_torque_alt.data[i] = h_net_torque.data[old_idx];
+            for (unsigned int j = 0; j < 6; j++)
+                h_net_virial_alt.data[j*virial_pitch_alt+i] = h_net_virial.data[j*virial_pitch+old_idx];
+
+            unsigned int tag = h_tag.data[old_idx];
+            h_tag_alt.data[i] = tag;
+            h_rtag.data[tag] = i;
+
+            // record the new index of every particle
+            m_inverse_sort_order[old_idx] = i;
+            };
+
+        #ifdef ENABLE_TBB
+        tbb::parallel_for((unsigned int)0, N, move_particle);
+        #else
+        for (unsigned int i = 0; i < N; i++)
+            move_particle(i);
+        #endif
         }
 
-    delete[] scal_tmp;
-    delete[] scal4_tmp;
-    delete[] scal3_tmp;
-    delete[] uint_tmp;
-    delete[] int3_tmp;
-
+    // make alternate arrays current
+    m_pdata->swapPositions();
+    m_pdata->swapVelocities();
+    m_pdata->swapAccelerations();
+    m_pdata->swapCharges();
+    m_pdata->swapDiameters();
+    m_pdata->swapImages();
+    m_pdata->swapBodies();
+    m_pdata->swapTags();
+    m_pdata->swapOrientations();
+    m_pdata->swapAngularMomenta();
+    m_pdata->swapMomentsOfInertia();
+    m_pdata->swapNetVirial();
+    m_pdata->swapNetForce();
+    m_pdata->swapNetTorque();
     }
 
 //! x walking table for the hilbert curve
@@ -617,5 +671,8 @@ void export_SFCPackUpdater(py::module& m)
     py::class_<SFCPackUpdater, std::shared_ptr<SFCPackUpdater> >(m,"SFCPackUpdater",py::base<Updater>())
     .def(py::init< std::shared_ptr<SystemDefinition> >())
     .def("setGrid", &SFCPackUpdater::setGrid)
+    .def("setAdaptive", &SFCPackUpdater::setAdaptive)
+    .def("getLocalityMetric", &SFCPackUpdater::getLocalityMetric)
+    .def("getNumSorts", &SFCPackUpdater::getNumSorts)
     ;
     }
@@ -67,12 +67,49 @@ class PYBIND11_EXPORT SFCPackUpdater : public Updater
             m_grid = (unsigned int)pow(2.0, ceil(log(double(grid)) / log(2.0)));;
             }
 
+        //! Enable or disable adaptive sorting
+        /*! \param adaptive True if sorts should be skipped while the particle order is still good
+            \param threshold Sort only when the locality metric exceeds \a threshold times its value after the last sort
+        */
+        void setAdaptive(bool adaptive, Scalar threshold)
+            {
+            if (threshold < Scalar(1.0))
+                {
+                m_exec_conf->msg->error() << "update.sort: threshold must be >= 1" << std::endl;
+                throw std::runtime_error("Error setting sort parameters");
+                }
+            m_adaptive = adaptive;
+            m_threshold = threshold;
+            m_sorted_metric = Scalar(-1.0);
+            }
+
+        //! Get the most recently computed locality metric
+        Scalar getLocalityMetric()
+            {
+            return m_last_metric;
+            }
+
+        //! Get the number of sorts performed so far
+        unsigned int getNumSorts()
+            {
+            return m_num_sorts;
+            }
+
+        //! Compute the locality metric of the current particle order
+        Scalar computeLocalityMetric();
+
     protected:
         unsigned int m_grid;        //!< Grid dimension to use
         unsigned int m_last_grid;   //!< The last value of MMax
         unsigned int m_last_dim;    //!< Check the last dimension we ran at
         GPUArray< unsigned int > m_traversal_order;      //!< Generated traversal order of bins
 
+        bool m_adaptive;            //!< True if sorts are skipped while the locality metric is good
+        Scalar m_threshold;         //!< Relative increase of the locality metric that triggers a sort
+        Scalar m_sorted_metric;     //!< Locality metric right after the last sort (negative if not sorted yet)
+        Scalar m_last_metric;       //!< Most recently computed locality metric
+        unsigned int m_num_sorts;   //!< Number of sorts performed
+
         //! Helper function that actually performs the sort
         virtual void getSortedOrder2D();
         //! Helper function that actually performs the sort
@@ -92,6 +129,7 @@ class PYBIND11_EXPORT SFCPackUpdater : public Updater
 
     private:
         std::vector<unsigned int> m_sort_order;             //!< Generated sort order of the particles
+        std::vector<unsigned int> m_inverse_sort_order;     //!< New index of every particle after the sort (CPU)
         std::vector< std::pair<unsigned int, unsigned int> > m_particle_bins;    //!< Binned particles
 
    };
@@ -780,6 +780,10 @@ void System::printStats()
     for (compute = m_computes.begin(); compute != m_computes.end(); ++compute)
         compute->second->printStats();
 
+    // output ArrayHandle counters, per step of the last run
+    if (m_exec_conf->getArrayHandleCounters())
+        m_exec_conf->getArrayHandleCounters()->printStats(m_exec_conf->msg, m_cur_tstep - m_start_tstep);
+
     // output memory trace information
     if (m_exec_conf->getMemoryTracer())
         m_exec_conf->getMemoryTracer()->outputTraces(m_exec_conf->msg);
@@ -804,6 +808,9 @@ void System::resetStats()
     map< string, std::shared_ptr<Compute> >::iterator compute;
     for (compute = m_computes.begin(); compute != m_computes.end(); ++compute)
         compute->second->resetStats();
+
+    if (m_exec_conf->getArrayHandleCounters())
+        m_exec_conf->getArrayHandleCounters()->reset();
     }
 
 void System::generateStatusLine()
@@ -928,6 +935,7 @@ void export_System(py::module& m)
     .def("setStatsPeriod", &System::setStatsPeriod)
     .def("setAutotunerParams", &System::setAutotunerParams)
     .def("enableProfiler", &System::enableProfiler)
+    .def("getProfiler", &System::getProfiler)
     .def("enableQuietRun", &System::enableQuietRun)
     .def("run", &System::run)
 
@@ -150,6 +150,12 @@ class PYBIND11_EXPORT System
         //! Configures profiling of runs
         void enableProfiler(bool enable);
 
+        //! Get the profile of the last run (null if the run was not profiled)
+        std::shared_ptr<Profiler> getProfiler()
+            {
+            return m_profiler;
+            }
+
         //! Toggle whether or not to print the status line and TPS for each run
         void enableQuietRun(bool enable)
             {
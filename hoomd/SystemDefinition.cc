@@ -66,18 +66,24 @@ SystemDefinition::SystemDefinition(unsigned int N,
     \param snapshot Snapshot to use
     \param exec_conf Execution configuration to run on
     \param decomposition (optional) The domain decomposition layout
+    \param distributed (optional) True if the particle data is distributed over the ranks
+
+    In a distributed snapshot, every rank holds a contiguous range of the particles in rank order (see
+    ParticleData::initializeFromSnapshot()). The bonded groups are always read from the root rank.
 */
 template <class Real>
 SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<Real> > snapshot,
                                    std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                   std::shared_ptr<DomainDecomposition> decomposition)
+                                   std::shared_ptr<DomainDecomposition> decomposition,
+                                   bool distributed)
     {
     setNDimensions(snapshot->dimensions);
 
     m_particle_data = std::shared_ptr<ParticleData>(new ParticleData(snapshot->particle_data,
                  snapshot->global_box,
                  exec_conf,
-                 decomposition));
+                 decomposition,
+                 distributed));
 
     #ifdef ENABLE_MPI
     // in MPI simulations, broadcast dimensionality from rank zero
@@ -98,6 +104,66 @@ SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<Real> > s
     m_integrator_data = std::shared_ptr<IntegratorData>(new IntegratorData(snapshot->integrator_data));
     }
 
+/*! \param unit Snapshot of the unit cell (read on the root rank)
+    \param nx Number of replicas along the x direction
+    \param ny Number of replicas along the y direction
+    \param nz Number of replicas along the z direction
+    \param exec_conf Execution configuration to run on
+    \param decomposition (optional) The domain decomposition layout, for the replicated box
+
+    The result is the same as initializing with the snapshot after SnapshotSystemData::replicate(), but the replicated
+    system never exists on a single rank. Only the unit cell is broadcast, and each rank generates the particles and
+    bonded groups it owns with tags computed from the replica index.
+*/
+template <class Real>
+SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<Real> > unit,
+                                   unsigned int nx,
+                                   unsigned int ny,
+                                   unsigned int nz,
+                                   std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                   std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    // all ranks replicate their own copy of the unit cell
+    SnapshotSystemData<Real> unit_snap(*unit);
+    unit_snap.broadcast(0, exec_conf);
+
+    setNDimensions(unit_snap.dimensions);
+
+    // the replicated box keeps the tilt factors of the unit cell
+    BoxDim global_box = unit_snap.global_box;
+    Scalar3 L = global_box.getL();
+    L.x *= (Scalar) nx;
+    L.y *= (Scalar) ny;
+    L.z *= (Scalar) nz;
+    global_box.setL(L);
+
+    m_particle_data = std::shared_ptr<ParticleData>(new ParticleData(0, global_box, 1, exec_conf, decomposition));
+    m_particle_data->initializeReplicated(unit_snap.particle_data, unit_snap.global_box, nx, ny, nz);
+
+    unsigned int n = nx*ny*nz;
+    unsigned int n_unit = unit_snap.particle_data.size;
+
+    m_bond_data = std::shared_ptr<BondData>(new BondData(m_particle_data, 0));
+    m_bond_data->initializeReplicated(unit_snap.bond_data, n, n_unit);
+
+    m_angle_data = std::shared_ptr<AngleData>(new AngleData(m_particle_data, 0));
+    m_angle_data->initializeReplicated(unit_snap.angle_data, n, n_unit);
+
+    m_dihedral_data = std::shared_ptr<DihedralData>(new DihedralData(m_particle_data, 0));
+    m_dihedral_data->initializeReplicated(unit_snap.dihedral_data, n, n_unit);
+
+    m_improper_data = std::shared_ptr<ImproperData>(new ImproperData(m_particle_data, 0));
+    m_improper_data->initializeReplicated(unit_snap.improper_data, n, n_unit);
+
+    m_constraint_data = std::shared_ptr<ConstraintData>(new ConstraintData(m_particle_data, 0));
+    m_constraint_data->initializeReplicated(unit_snap.constraint_data, n, n_unit);
+
+    m_pair_data = std::shared_ptr<PairData>(new PairData(m_particle_data, 0));
+    m_pair_data->initializeReplicated(unit_snap.pair_data, n, n_unit);
+
+    m_integrator_data = std::shared_ptr<IntegratorData>(new IntegratorData(unit_snap.integrator_data));
+    }
+
 /*! Sets the dimensionality of the system.  When quantities involving the dof of
     the system are computed, such as T, P, etc., the dimensionality is needed.
     Therefore, the dimensionality must be set before any temperature/pressure
@@ -265,6 +331,13 @@ void SystemDefinition::initializeFromSnapshot(std::shared_ptr< SnapshotSystemDat
 
 // instantiate both float and double methods
 template SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<float> > snapshot,
+                                                   std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                                   std::shared_ptr<DomainDecomposition> decomposition,
+                                                   bool distributed);
+template SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<float> > unit,
+                                                   unsigned int nx,
+                                                   unsigned int ny,
+                                                   unsigned int nz,
                                                    std::shared_ptr<ExecutionConfiguration> exec_conf,
                                                    std::shared_ptr<DomainDecomposition> decomposition);
 template std::shared_ptr< SnapshotSystemData<float> > SystemDefinition::takeSnapshot<float>(bool particles,
@@ -278,6 +351,13 @@ template std::shared_ptr< SnapshotSystemData<float> > SystemDefinition::takeSnap
 template void SystemDefinition::initializeFromSnapshot<float>(std::shared_ptr< SnapshotSystemData<float> > snapshot);
 
 template SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<double> > snapshot,
+                                                   std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                                   std::shared_ptr<DomainDecomposition> decomposition,
+                                                   bool distributed);
+template SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<double> > unit,
+                                                   unsigned int nx,
+                                                   unsigned int ny,
+                                                   unsigned int nz,
                                                    std::shared_ptr<ExecutionConfiguration> exec_conf,
                                                    std::shared_ptr<DomainDecomposition> decomposition);
 template std::shared_ptr< SnapshotSystemData<double> > SystemDefinition::takeSnapshot<double>(bool particles,
@@ -297,9 +377,15 @@ void export_SystemDefinition(py::module& m)
     .def(py::init<unsigned int, const BoxDim&, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, std::shared_ptr<ExecutionConfiguration> >())
     .def(py::init<unsigned int, const BoxDim&, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition> >())
     .def(py::init<std::shared_ptr< SnapshotSystemData<float> >, std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition> >())
+    .def(py::init<std::shared_ptr< SnapshotSystemData<float> >, std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition>, bool >())
     .def(py::init<std::shared_ptr< SnapshotSystemData<float> >, std::shared_ptr<ExecutionConfiguration> >())
+    .def(py::init<std::shared_ptr< SnapshotSystemData<float> >, unsigned int, unsigned int, unsigned int,
+        std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition> >())
     .def(py::init<std::shared_ptr< SnapshotSystemData<double> >, std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition> >())
+    .def(py::init<std::shared_ptr< SnapshotSystemData<double> >, std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition>, bool >())
     .def(py::init<std::shared_ptr< SnapshotSystemData<double> >, std::shared_ptr<ExecutionConfiguration> >())
+    .def(py::init<std::shared_ptr< SnapshotSystemData<double> >, unsigned int, unsigned int, unsigned int,
+        std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition> >())
     .def("setNDimensions", &SystemDefinition::setNDimensions)
     .def("getNDimensions", &SystemDefinition::getNDimensions)
     .def("getParticleData", &SystemDefinition::getParticleData)
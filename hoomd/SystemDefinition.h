@@ -89,6 +89,16 @@ class PYBIND11_EXPORT SystemDefinition
         template <class Real>
         SystemDefinition(std::shared_ptr<SnapshotSystemData<Real> > snapshot,
                          std::shared_ptr<ExecutionConfiguration> exec_conf=std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration()),
+                         std::shared_ptr<DomainDecomposition> decomposition=std::shared_ptr<DomainDecomposition>(),
+                         bool distributed=false);
+
+        //! Construct from a snapshot of a unit cell, replicated along the box vectors
+        template <class Real>
+        SystemDefinition(std::shared_ptr<SnapshotSystemData<Real> > unit,
+                         unsigned int nx,
+                         unsigned int ny,
+                         unsigned int nz,
+                         std::shared_ptr<ExecutionConfiguration> exec_conf,
                          std::shared_ptr<DomainDecomposition> decomposition=std::shared_ptr<DomainDecomposition>());
 
         //! Set the dimensionality of the system
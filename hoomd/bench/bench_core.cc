@@ -0,0 +1,143 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/bench/bench_utils.h"
+
+#include "hoomd/CellList.h"
+#include "hoomd/SFCPackUpdater.h"
+
+#ifdef ENABLE_CUDA
+#include "hoomd/CellListGPU.h"
+#include "hoomd/SFCPackUpdaterGPU.h"
+#endif
+
+#include <vector>
+
+/*! \file bench_core.cc
+    \brief Microbenchmarks for the kernels of the core library
+    \details Times CellList::computeCellList(), the SFCPackUpdater sort and the particle data pack/unpack used by
+    the Communicator during particle migration.
+*/
+
+using namespace std;
+
+//! Number of bytes of per-particle data that a particle sort or migration has to move
+static double bytes_per_particle()
+    {
+    return 6*sizeof(Scalar4)        // pos, vel, orientation, angmom, net_force, net_torque
+        + 2*sizeof(Scalar3)         // accel, inertia
+        + 8*sizeof(Scalar)          // charge, diameter, net_virial
+        + sizeof(int3)              // image
+        + 2*sizeof(unsigned int);   // body, tag
+    }
+
+//! Benchmark the cell list construction
+template<class CL>
+void bench_cell_list(const BenchmarkOptions& options, const std::string& name)
+    {
+    if (!options.enabled(name))
+        return;
+
+    std::shared_ptr<ExecutionConfiguration> exec_conf = create_benchmark_exec_conf(options);
+    std::shared_ptr<SystemDefinition> sysdef = create_benchmark_system(exec_conf, options);
+
+    // typical cell width of a Lennard-Jones neighbor list
+    std::shared_ptr<CellList> cl(new CL(sysdef));
+    cl->setNominalWidth(Scalar(1.4));
+    cl->setComputeXYZF(true);
+
+    double ms = cl->benchmark(options.num_iters);
+
+    // read the positions, write the cell contents and update the cell sizes
+    double bytes = double(options.N)*(2*sizeof(Scalar4) + sizeof(unsigned int));
+    report_benchmark(name, options.N, ms, bytes);
+    }
+
+//! Benchmark the space filling curve sort
+template<class Sorter>
+void bench_sfc_sort(const BenchmarkOptions& options, const std::string& name, unsigned int n_dimensions)
+    {
+    if (!options.enabled(name))
+        return;
+
+    std::shared_ptr<ExecutionConfiguration> exec_conf = create_benchmark_exec_conf(options);
+    std::shared_ptr<SystemDefinition> sysdef = create_benchmark_system(exec_conf, options, 1, n_dimensions);
+
+    std::shared_ptr<SFCPackUpdater> sorter(new Sorter(sysdef));
+
+    unsigned int timestep = 0;
+    double ms = time_benchmark(exec_conf, options.num_iters, [&]()
+        {
+        sorter->update(timestep++);
+        });
+
+    // every particle is read and written once
+    double bytes = 2*double(options.N)*bytes_per_particle();
+    report_benchmark(name, options.N, ms, bytes);
+    }
+
+#ifdef ENABLE_MPI
+//! Benchmark the particle data pack and unpack used by the communicator for particle migration
+/*! \param stride Every stride-th particle is sent and received
+*/
+void bench_pack_unpack(const BenchmarkOptions& options, const std::string& name, unsigned int stride)
+    {
+    if (!options.enabled(name))
+        return;
+
+    std::shared_ptr<ExecutionConfiguration> exec_conf = create_benchmark_exec_conf(options);
+    std::shared_ptr<SystemDefinition> sysdef = create_benchmark_system(exec_conf, options);
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::vector<pdata_element> buffer;
+    std::vector<unsigned int> comm_flags;
+
+    unsigned int n_moved = (options.N + stride - 1) / stride;
+    double ms = time_benchmark(exec_conf, options.num_iters, [&]()
+        {
+            {
+            // flag every stride-th particle for removal
+            ArrayHandle<unsigned int> h_comm_flags(pdata->getCommFlags(), access_location::host,
+                access_mode::readwrite);
+            for (unsigned int i = 0; i < pdata->getN(); i += stride)
+                h_comm_flags.data[i] = 1;
+            }
+
+        // pack the flagged particles and receive them back
+        pdata->removeParticles(buffer, comm_flags);
+        pdata->addParticles(buffer);
+        });
+
+    // the remaining particles are compacted, the moved ones are packed and unpacked
+    double bytes = 2*double(options.N - n_moved)*bytes_per_particle() + 4*double(n_moved)*sizeof(pdata_element);
+    report_benchmark(name, options.N, ms, bytes);
+    }
+#endif
+
+int main(int argc, char **argv)
+    {
+    return run_benchmarks(argc, argv, [](const BenchmarkOptions& options)
+        {
+        #ifdef ENABLE_CUDA
+        if (options.gpu)
+            {
+            bench_cell_list<CellListGPU>(options, "CellListGPU");
+            bench_sfc_sort<SFCPackUpdaterGPU>(options, "SFCPackUpdaterGPU.3d", 3);
+            bench_sfc_sort<SFCPackUpdaterGPU>(options, "SFCPackUpdaterGPU.2d", 2);
+            return;
+            }
+        #endif
+
+        bench_cell_list<CellList>(options, "CellList");
+        bench_sfc_sort<SFCPackUpdater>(options, "SFCPackUpdater.3d", 3);
+        bench_sfc_sort<SFCPackUpdater>(options, "SFCPackUpdater.2d", 2);
+
+        #ifdef ENABLE_MPI
+        bench_pack_unpack(options, "ParticleData.pack_unpack.5pct", 20);
+        #endif
+        });
+    }
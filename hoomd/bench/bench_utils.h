@@ -0,0 +1,265 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/ClockSource.h"
+#include "hoomd/SnapshotSystemData.h"
+#include "hoomd/SystemDefinition.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+/*! \file bench_utils.h
+    \brief Helpers shared by the C++ microbenchmarks
+    \details The microbenchmarks time individual hot kernels on synthetic systems, without going through python.
+    Every benchmark prints one line with the time per iteration, the time per particle (or per pair) and an
+    estimate of the memory traffic of a single iteration, so that regressions can be spotted in isolation.
+
+    All benchmark executables accept the same command line options:
+     - \c -N <n>        number of particles (default 64000)
+     - \c -i <n>        number of timed iterations (default 20)
+     - \c -d <rho>      number density of the synthetic system (default 0.8)
+     - \c -s <seed>     random number seed (default 1)
+     - \c -f <filter>   only run benchmarks whose name contains \a filter
+     - \c --gpu         run the GPU implementations (requires ENABLE_CUDA)
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __BENCH_UTILS_H__
+#define __BENCH_UTILS_H__
+
+//! Command line options common to all benchmarks
+struct BenchmarkOptions
+    {
+    //! Default options
+    BenchmarkOptions()
+        : N(64000), num_iters(20), density(Scalar(0.8)), seed(1), gpu(false)
+        {
+        }
+
+    unsigned int N;             //!< Number of particles in the synthetic system
+    unsigned int num_iters;     //!< Number of timed iterations
+    Scalar density;             //!< Number density of the synthetic system
+    unsigned int seed;          //!< Random number seed
+    bool gpu;                   //!< True if the GPU implementations should be benchmarked
+    std::string filter;         //!< Only run benchmarks whose name contains this string
+
+    //! Test if a benchmark should be run
+    /*! \param name Name of the benchmark
+    */
+    bool enabled(const std::string& name) const
+        {
+        return filter.empty() || name.find(filter) != std::string::npos;
+        }
+    };
+
+//! Parse the command line options of a benchmark executable
+/*! \param argc Number of arguments
+    \param argv Arguments
+    \returns The parsed options
+*/
+inline BenchmarkOptions parse_benchmark_options(int argc, char **argv)
+    {
+    BenchmarkOptions options;
+
+    for (int i = 1; i < argc; ++i)
+        {
+        std::string arg(argv[i]);
+        bool has_value = i+1 < argc;
+
+        if (arg == "-N" && has_value)
+            options.N = std::atoi(argv[++i]);
+        else if (arg == "-i" && has_value)
+            options.num_iters = std::atoi(argv[++i]);
+        else if (arg == "-d" && has_value)
+            options.density = std::atof(argv[++i]);
+        else if (arg == "-s" && has_value)
+            options.seed = std::atoi(argv[++i]);
+        else if (arg == "-f" && has_value)
+            options.filter = argv[++i];
+        else if (arg == "--gpu")
+            options.gpu = true;
+        else
+            {
+            std::cerr << "Usage: " << argv[0] << " [-N particles] [-i iterations] [-d density] [-s seed]"
+                      << " [-f filter] [--gpu]" << std::endl;
+            throw std::runtime_error("Invalid benchmark option " + arg);
+            }
+        }
+
+    if (options.N == 0 || options.num_iters == 0 || options.density <= Scalar(0.0))
+        throw std::runtime_error("Benchmark options must be positive");
+
+    #ifndef ENABLE_CUDA
+    if (options.gpu)
+        throw std::runtime_error("--gpu requires a build with ENABLE_CUDA");
+    #endif
+
+    return options;
+    }
+
+//! Create the execution configuration requested by the options
+inline std::shared_ptr<ExecutionConfiguration> create_benchmark_exec_conf(const BenchmarkOptions& options)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(
+        options.gpu ? ExecutionConfiguration::GPU : ExecutionConfiguration::CPU));
+
+    // keep the kernels' own notices out of the benchmark table
+    exec_conf->msg->setNoticeLevel(0);
+    return exec_conf;
+    }
+
+//! Create a synthetic system with uniformly distributed particles
+/*! \param exec_conf Execution configuration
+    \param options Benchmark options (number of particles, density and seed)
+    \param n_types Number of particle types, assigned round-robin
+    \param n_dimensions Dimensionality of the system
+
+    Particles are stored in random order, i.e. the system is not sorted.
+*/
+inline std::shared_ptr<SystemDefinition> create_benchmark_system(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                                                 const BenchmarkOptions& options,
+                                                                 unsigned int n_types = 1,
+                                                                 unsigned int n_dimensions = 3)
+    {
+    Scalar L = (n_dimensions == 3) ? pow(Scalar(options.N)/options.density, Scalar(1.0/3.0))
+                                   : sqrt(Scalar(options.N)/options.density);
+
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = (n_dimensions == 3) ? BoxDim(L) : BoxDim(L, L, Scalar(1.0));
+    snap->dimensions = n_dimensions;
+
+    SnapshotParticleData<Scalar>& pdata = snap->particle_data;
+    pdata.resize(options.N);
+
+    std::mt19937 rng(options.seed);
+    std::uniform_real_distribution<Scalar> uniform(-L/Scalar(2.0), L/Scalar(2.0));
+    for (unsigned int i = 0; i < options.N; ++i)
+        {
+        pdata.pos[i] = vec3<Scalar>(uniform(rng), uniform(rng), (n_dimensions == 3) ? uniform(rng) : Scalar(0.0));
+        pdata.type[i] = i % n_types;
+        }
+
+    for (unsigned int i = 0; i < n_types; ++i)
+        pdata.type_mapping.push_back(std::string(1, char('A' + i)));
+
+    return std::shared_ptr<SystemDefinition>(new SystemDefinition(snap, exec_conf));
+    }
+
+//! Time a benchmark kernel
+/*! \param exec_conf Execution configuration (used to synchronize with the GPU)
+    \param num_iters Number of timed iterations
+    \param f Kernel to time, called once for warm up and then \a num_iters times
+    \returns The time per iteration in milliseconds
+*/
+template<class Function>
+double time_benchmark(std::shared_ptr<const ExecutionConfiguration> exec_conf, unsigned int num_iters, Function f)
+    {
+    ClockSource t;
+
+    // warm up run
+    f();
+
+    #ifdef ENABLE_CUDA
+    if (exec_conf->isCUDAEnabled())
+        {
+        cudaDeviceSynchronize();
+        CHECK_CUDA_ERROR();
+        }
+    #endif
+
+    uint64_t start_time = t.getTime();
+    for (unsigned int i = 0; i < num_iters; i++)
+        f();
+
+    #ifdef ENABLE_CUDA
+    if (exec_conf->isCUDAEnabled())
+        cudaDeviceSynchronize();
+    #endif
+    uint64_t total_time_ns = t.getTime() - start_time;
+
+    return double(total_time_ns) / 1e6 / double(num_iters);
+    }
+
+//! Print the header of the benchmark table
+inline void print_benchmark_header()
+    {
+    std::cout << std::left << std::setw(44) << "benchmark"
+              << std::right << std::setw(10) << "N"
+              << std::setw(14) << "ms/iter"
+              << std::setw(14) << "ns/item"
+              << std::setw(14) << "MB/iter"
+              << std::setw(12) << "GB/s" << std::endl;
+    }
+
+//! Print the result of a single benchmark
+/*! \param name Name of the benchmark
+    \param n_items Number of items (particles or pairs) processed in one iteration
+    \param ms_per_iter Time per iteration in milliseconds
+    \param bytes_per_iter Estimated minimum number of bytes read and written in one iteration
+*/
+inline void report_benchmark(const std::string& name, unsigned int n_items, double ms_per_iter,
+    double bytes_per_iter)
+    {
+    double ns_per_item = ms_per_iter * 1e6 / double(n_items);
+    double gb_per_s = bytes_per_iter / (ms_per_iter * 1e-3) / 1e9;
+
+    std::cout << std::left << std::setw(44) << name
+              << std::right << std::setw(10) << n_items
+              << std::fixed << std::setprecision(4)
+              << std::setw(14) << ms_per_iter
+              << std::setw(14) << ns_per_item
+              << std::setprecision(2)
+              << std::setw(14) << bytes_per_iter / 1e6
+              << std::setw(12) << gb_per_s << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+    }
+
+//! Run the benchmarks of an executable
+/*! \param argc Number of arguments
+    \param argv Arguments
+    \param run Function running the benchmarks, called with the parsed options
+
+    Initializes and finalizes MPI where necessary and turns exceptions into a non-zero return value.
+*/
+template<class Function>
+int run_benchmarks(int argc, char **argv, Function run)
+    {
+    #ifdef ENABLE_MPI
+    MPI_Init(&argc, &argv);
+    #endif
+
+    int retval = 0;
+    try
+        {
+        BenchmarkOptions options = parse_benchmark_options(argc, argv);
+        print_benchmark_header();
+        run(options);
+        }
+    catch (std::exception& e)
+        {
+        std::cerr << "**ERROR**: " << e.what() << std::endl;
+        retval = 1;
+        }
+
+    #ifdef ENABLE_MPI
+    MPI_Finalize();
+    #endif
+
+    return retval;
+    }
+
+#endif // __BENCH_UTILS_H__
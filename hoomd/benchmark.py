@@ -6,9 +6,17 @@
 R""" Benchmark utilities
 
 Commands that help in benchmarking HOOMD-blue performance.
+
+:py:meth:`series()` benchmarks the current simulation. :py:meth:`suite()` runs a set of reference :py:data:`workloads`
+at several system sizes, records the TPS and the profile of each in a machine-readable file, and compares the
+results against a baseline so that performance regressions between HOOMD-blue versions can be detected.
 """
 
 import hoomd
+import collections
+import json
+import math
+import numpy
 
 def series(warmup=100000, repeat=20, steps=10000, limit_hours=None):
     R""" Perform a series of benchmark runs.
@@ -36,3 +44,356 @@ def series(warmup=100000, repeat=20, steps=10000, limit_hours=None):
         tps_list.append(hoomd.context.current.system.getLastTPS());
 
     return tps_list;
+
+## \internal
+# \brief Number of lattice sites per direction for approximately N particles (rounded up to a multiple of *multiple*)
+def _lattice_n(N, multiple=1):
+    n = max(2, int(round(N ** (1.0/3.0))))
+    return max(multiple, int(math.ceil(n / multiple)) * multiple)
+
+## \internal
+# \brief Create a snapshot with particles on a simple (ortho-)rhombic lattice of nx*ny*nz sites with spacing a
+def _lattice_snapshot(nx, ny, nz, a, **kwargs):
+    L = numpy.array([nx, ny, nz]) * a
+    box = hoomd.data.boxdim(Lx=float(L[0]), Ly=float(L[1]), Lz=float(L[2]))
+    snap = hoomd.data.make_snapshot(N=nx*ny*nz, box=box, **kwargs)
+
+    # the snapshot only holds data on the root rank
+    idx = None
+    if hoomd.comm.get_rank() == 0:
+        # x runs fastest, so that consecutive tags are neighbors along x
+        z, y, x = numpy.meshgrid(numpy.arange(nz), numpy.arange(ny), numpy.arange(nx), indexing='ij')
+        idx = numpy.stack((x.flatten(), y.flatten(), z.flatten()), axis=1)
+        snap.particles.position[:] = (idx + 0.5) * a - 0.5 * L
+
+    return snap, idx
+
+def lj_liquid(N, seed=1):
+    R""" Lennard-Jones liquid workload.
+
+    Args:
+        N (int): Approximate number of particles.
+        seed (int): Random number seed.
+
+    Particles start on a simple cubic lattice at density 0.8442 and are integrated with NVT at kT=1.2, *r_cut=2.5*.
+    """
+    from hoomd import md
+
+    hoomd.init.create_lattice(unitcell=hoomd.lattice.sc(a=(1.0/0.8442) ** (1.0/3.0)), n=_lattice_n(N))
+    nl = md.nlist.cell()
+    lj = md.pair.lj(r_cut=2.5, nlist=nl)
+    lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+    md.integrate.mode_standard(dt=0.005)
+    nvt = md.integrate.nvt(group=hoomd.group.all(), kT=1.2, tau=0.5)
+    nvt.randomize_velocities(seed=seed)
+
+def kremer_grest(N, seed=1, chain_length=10):
+    R""" Kremer-Grest polymer melt workload.
+
+    Args:
+        N (int): Approximate number of particles.
+        seed (int): Random number seed.
+        chain_length (int): Number of monomers per chain.
+
+    Straight chains start on a simple cubic lattice at density 0.85 and are integrated with Langevin dynamics at
+    kT=1.0. Monomers interact with the WCA potential and are bonded by FENE bonds (k=30, r0=1.5).
+    """
+    from hoomd import md
+
+    n = _lattice_n(N)
+    nx = _lattice_n(N, chain_length)
+    snap, idx = _lattice_snapshot(nx, n, n, (1.0/0.85) ** (1.0/3.0), particle_types=['A'], bond_types=['polymer'])
+
+    if hoomd.comm.get_rank() == 0:
+        # bond consecutive monomers along x, the rows hold a whole number of chains
+        first = numpy.nonzero(idx[:,0] % chain_length != chain_length - 1)[0]
+        snap.bonds.resize(len(first))
+        snap.bonds.group[:] = numpy.stack((first, first + 1), axis=1)
+
+    hoomd.init.read_snapshot(snap)
+    nl = md.nlist.cell()
+    lj = md.pair.lj(r_cut=2.0 ** (1.0/6.0), nlist=nl)
+    lj.set_params(mode='shift')
+    lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+    fene = md.bond.fene()
+    fene.bond_coeff.set('polymer', k=30.0, r0=1.5, sigma=1.0, epsilon=1.0)
+    md.integrate.mode_standard(dt=0.005)
+    md.integrate.langevin(group=hoomd.group.all(), kT=1.0, seed=seed)
+
+def pppm_electrolyte(N, seed=1):
+    R""" Electrolyte workload with long range electrostatics.
+
+    Args:
+        N (int): Approximate number of particles.
+        seed (int): Random number seed.
+
+    Monovalent ions with alternating charges start on a simple cubic lattice at density 0.5 and are integrated with
+    NVT at kT=1.0. Ions interact with the WCA potential and PPPM electrostatics (order 6, *rcut=3.0*, grid spacing of
+    about one).
+    """
+    from hoomd import md
+
+    n = _lattice_n(N, 2)
+    a = (1.0/0.5) ** (1.0/3.0)
+    snap, idx = _lattice_snapshot(n, n, n, a, particle_types=['A', 'B'])
+
+    if hoomd.comm.get_rank() == 0:
+        parity = numpy.sum(idx, axis=1) % 2
+        snap.particles.typeid[:] = parity
+        snap.particles.charge[:] = 1.0 - 2.0 * parity
+
+    hoomd.init.read_snapshot(snap)
+    nl = md.nlist.cell()
+    lj = md.pair.lj(r_cut=2.0 ** (1.0/6.0), nlist=nl)
+    lj.set_params(mode='shift')
+    lj.pair_coeff.set(['A', 'B'], ['A', 'B'], epsilon=1.0, sigma=1.0)
+
+    grid = 2 ** int(math.ceil(math.log(n * a, 2)))
+    pppm = md.charge.pppm(group=hoomd.group.charged(), nlist=nl)
+    pppm.set_params(Nx=grid, Ny=grid, Nz=grid, order=6, rcut=3.0)
+
+    md.integrate.mode_standard(dt=0.005)
+    nvt = md.integrate.nvt(group=hoomd.group.all(), kT=1.0, tau=0.5)
+    nvt.randomize_velocities(seed=seed)
+
+def hard_spheres(N, seed=1):
+    R""" Hard sphere HPMC workload.
+
+    Args:
+        N (int): Approximate number of particles.
+        seed (int): Random number seed.
+
+    Unit diameter spheres start on a simple cubic lattice at a packing fraction of 0.3.
+    """
+    from hoomd import hpmc
+
+    hoomd.init.create_lattice(unitcell=hoomd.lattice.sc(a=1.2), n=_lattice_n(N))
+    mc = hpmc.integrate.sphere(seed=seed, d=0.1)
+    mc.shape_param.set('A', diameter=1.0)
+
+def hard_polyhedra(N, seed=1):
+    R""" Hard convex polyhedron HPMC workload.
+
+    Args:
+        N (int): Approximate number of particles.
+        seed (int): Random number seed.
+
+    Unit cubes start on a simple cubic lattice at a packing fraction of 0.58.
+    """
+    from hoomd import hpmc
+
+    hoomd.init.create_lattice(unitcell=hoomd.lattice.sc(a=1.2), n=_lattice_n(N))
+    mc = hpmc.integrate.convex_polyhedron(seed=seed, d=0.1, a=0.1)
+    mc.shape_param.set('A', vertices=[(x, y, z) for x in (-0.5, 0.5) for y in (-0.5, 0.5) for z in (-0.5, 0.5)])
+
+def mpcd_fluid(N, seed=1):
+    R""" MPCD solvent workload.
+
+    Args:
+        N (int): Approximate number of MPCD particles.
+        seed (int): Random number seed.
+
+    A pure SRD solvent at 5 particles per cell, collision angle 130 degrees, kT=1.0 and *dt=0.1*.
+    """
+    from hoomd import mpcd
+
+    L = max(2, int(round((N / 5.0) ** (1.0/3.0))))
+    hoomd.init.read_snapshot(hoomd.data.make_snapshot(N=0, box=hoomd.data.boxdim(L=L)))
+    mpcd.init.make_random(N=5*L**3, kT=1.0, seed=seed)
+    mpcd.integrator(dt=0.1)
+    mpcd.collide.srd(seed=seed, period=1, angle=130., kT=1.0)
+    mpcd.stream.bulk(period=1)
+
+def rigid_bodies(N, seed=1):
+    R""" Rigid body workload.
+
+    Args:
+        N (int): Approximate number of particles (central and constituent).
+        seed (int): Random number seed.
+
+    Rigid dimers of two WCA spheres at a bond length of 1.0 start aligned on a lattice and are integrated with NVT at
+    kT=1.0.
+    """
+    from hoomd import md
+
+    # leave room for the dimers along x
+    n = _lattice_n(N / 3.0)
+    snap, idx = _lattice_snapshot(n, n, n, numpy.array([2.2, 1.1, 1.1]), particle_types=['R', 'A'])
+
+    if hoomd.comm.get_rank() == 0:
+        snap.particles.moment_inertia[:] = (0.0, 0.5, 0.5)
+
+    hoomd.init.read_snapshot(snap)
+    rigid = md.constrain.rigid()
+    rigid.set_param('R', types=['A', 'A'], positions=[(-0.5, 0, 0), (0.5, 0, 0)])
+    rigid.create_bodies()
+
+    nl = md.nlist.cell()
+    lj = md.pair.lj(r_cut=2.0 ** (1.0/6.0), nlist=nl)
+    lj.set_params(mode='shift')
+    lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+    lj.pair_coeff.set('R', ['R', 'A'], epsilon=0.0, sigma=1.0, r_cut=False)
+
+    md.integrate.mode_standard(dt=0.005)
+    nvt = md.integrate.nvt(group=hoomd.group.rigid_center(), kT=1.0, tau=0.5)
+    nvt.randomize_velocities(seed=seed)
+
+## Reference workloads run by suite(), by name
+workloads = collections.OrderedDict([
+    ('lj_liquid', lj_liquid),
+    ('kremer_grest', kremer_grest),
+    ('pppm_electrolyte', pppm_electrolyte),
+    ('hard_spheres', hard_spheres),
+    ('hard_polyhedra', hard_polyhedra),
+    ('mpcd_fluid', mpcd_fluid),
+    ('rigid_bodies', rigid_bodies),
+    ])
+
+def suite(names=None, sizes=(4000, 32000), warmup=1000, steps=5000, repeat=3, seed=1, output=None, baseline=None,
+          tolerance=0.1):
+    R""" Run the reference workloads and compare their performance against a baseline.
+
+    Args:
+        names (list): Names of the workloads to run (default: all :py:data:`workloads`).
+        sizes (list): Approximate system sizes to run every workload at.
+        warmup (int): Number of time steps to run before timing each workload.
+        repeat (int): Number of times to repeat the timed runs.
+        steps (int): Number of time steps in each timed run.
+        seed (int): Random number seed.
+        output (str): Name of a JSON file to write the results to.
+        baseline (str or dict): Results of a previous :py:meth:`suite()` (or the name of a file containing them) to
+                                compare against.
+        tolerance (float): Fractional slowdown relative to *baseline* reported as a regression.
+
+    Returns:
+        A dictionary with the execution context (``metadata``), one entry per workload and size (``results``), and the
+        entries that are slower than the baseline by more than *tolerance* (``regressions``).
+
+    :py:meth:`suite()` sets up every workload in its own :py:class:`hoomd.context.SimulationContext`. After *warmup*
+    time steps it runs *repeat* profiled runs of *steps* time steps each. Each result contains the median TPS, the
+    TPS of every run, and the time per step in milliseconds of every component in the profile. Workloads that need a
+    component which is not part of this build are skipped.
+
+    Results are matched to the baseline by workload name and number of particles. A result is a regression when its
+    TPS is less than ``(1 - tolerance)`` times the baseline TPS.
+
+    :py:meth:`suite()` must be called after :py:func:`hoomd.context.initialize()` and before any system is
+    initialized in the current context.
+
+    Example::
+
+        hoomd.context.initialize()
+        report = hoomd.benchmark.suite(output='v2.9.0.json')
+
+        # later, on the new version
+        report = hoomd.benchmark.suite(output='new.json', baseline='v2.9.0.json', tolerance=0.05)
+        if len(report['regressions']) > 0:
+            sys.exit(1)
+    """
+    if hoomd.context.exec_conf is None:
+        hoomd.context.msg.error("benchmark.suite: call context.initialize() before running the benchmark suite\n")
+        raise RuntimeError('Error running benchmark suite')
+
+    if names is None:
+        names = list(workloads.keys())
+
+    for name in names:
+        if name not in workloads:
+            hoomd.context.msg.error("benchmark.suite: unknown workload " + str(name) + "\n")
+            raise ValueError('Error running benchmark suite')
+
+    if baseline is not None and not isinstance(baseline, dict):
+        with open(baseline) as f:
+            baseline = json.load(f)
+
+    results = []
+    for name in names:
+        for size in sizes:
+            with hoomd.context.SimulationContext():
+                try:
+                    workloads[name](size, seed=seed)
+                except ImportError as e:
+                    hoomd.context.msg.warning("benchmark.suite: skipping " + name + " (" + str(e) + ")\n")
+                    continue
+
+                system = hoomd.context.current.system
+                N = hoomd.context.current.system_definition.getParticleData().getNGlobal()
+                if hoomd.context.current.mpcd is not None:
+                    N += hoomd.context.current.mpcd.data.getParticleData().getNGlobal()
+
+                hoomd.context.msg.notice(1, "benchmark.suite: " + name + " with N=" + str(N) + "\n")
+
+                if warmup > 0:
+                    hoomd.run(warmup, quiet=True)
+
+                tps_list = []
+                timings = collections.OrderedDict()
+                for i in range(repeat):
+                    hoomd.run(steps, profile=True, quiet=True)
+                    tps_list.append(system.getLastTPS())
+
+                    for component, sec in sorted(system.getProfiler().getTimings().items()):
+                        timings[component] = timings.get(component, 0.0) + sec * 1e3 / (steps * repeat)
+
+                results.append(collections.OrderedDict([
+                    ('workload', name),
+                    ('N', N),
+                    ('tps', float(numpy.median(tps_list))),
+                    ('tps_list', tps_list),
+                    ('ms_per_step', timings),
+                    ]))
+
+    report = collections.OrderedDict([
+        ('metadata', collections.OrderedDict([
+            ('hoomd', hoomd.context.HOOMDContext().get_metadata()),
+            ('context', hoomd.context.ExecutionContext().get_metadata()),
+            ('warmup', warmup),
+            ('steps', steps),
+            ('repeat', repeat),
+            ])),
+        ('results', results),
+        ('regressions', compare(results, baseline, tolerance) if baseline is not None else []),
+        ])
+
+    if output is not None and hoomd.comm.get_rank() == 0:
+        with open(output, 'w') as f:
+            json.dump(report, f, indent=4)
+
+    return report
+
+def compare(results, baseline, tolerance=0.1):
+    R""" Compare benchmark results against a baseline.
+
+    Args:
+        results (list): ``results`` of a :py:meth:`suite()` report.
+        baseline (dict): Report of a previous :py:meth:`suite()` run.
+        tolerance (float): Fractional slowdown reported as a regression.
+
+    Returns:
+        A list with one entry per regression, giving the workload, N, TPS, baseline TPS, and the ratio of the two.
+
+    Results without a matching baseline entry (same workload and number of particles) are not compared.
+    """
+    reference = dict(((r['workload'], r['N']), r['tps']) for r in baseline['results'])
+
+    regressions = []
+    for r in results:
+        key = (r['workload'], r['N'])
+        if key not in reference:
+            hoomd.context.msg.notice(2, "benchmark.compare: no baseline for " + r['workload'] + " with N=" +
+                                     str(r['N']) + "\n")
+            continue
+
+        ratio = r['tps'] / reference[key]
+        if ratio < 1.0 - tolerance:
+            hoomd.context.msg.warning("benchmark.compare: " + r['workload'] + " with N=" + str(r['N']) + " runs at " +
+                                      "{0:.1f}% of the baseline TPS\n".format(ratio * 100.0))
+            regressions.append(collections.OrderedDict([
+                ('workload', r['workload']),
+                ('N', r['N']),
+                ('tps', r['tps']),
+                ('baseline_tps', reference[key]),
+                ('ratio', ratio),
+                ]))
+
+    return regressions
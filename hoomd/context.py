@@ -378,11 +378,21 @@ def _create_exec_conf(mpi_config, msg, options):
     if options.gpu_error_checking:
        exec_conf.setCUDAErrorChecking(True);
 
+    if options.array_handle_stats:
+        exec_conf.setArrayHandleCounting(True);
+
     if _hoomd.is_TBB_available():
         # set the number of TBB threads as necessary
         if options.nthreads != None:
             exec_conf.setNumThreads(options.nthreads)
 
+        # pin the threads before any arrays are first touched
+        if options.pin_threads:
+            exec_conf.setThreadAffinity(True)
+
+        if options.numa_first_touch:
+            exec_conf.setNUMAFirstTouch(True)
+
     exec_conf = exec_conf;
 
     return exec_conf;
@@ -12,11 +12,16 @@
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 
 #include <stdexcept>
+#include <limits>
 
 #ifdef ENABLE_OPENMP
 #include <omp.h>
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 /*! \file DEM2DForceCompute.cc
   \brief Defines the DEM2DForceCompute class
 */
@@ -35,7 +40,7 @@ DEM2DForceCompute<Real, Real4, Potential>::DEM2DForceCompute(
     std::shared_ptr<NeighborList> nlist,
     Real r_cut, Potential potential)
     : ForceCompute(sysdef), m_nlist(nlist), m_r_cut(r_cut),
-      m_evaluator(potential), m_shapes()
+      m_evaluator(potential), m_cull_features(true), m_shapes(), m_typeRadius(), m_edgeRadius()
     {
     m_exec_conf->msg->notice(5) << "Constructing DEM2DForceCompute" << endl;
 
@@ -165,6 +170,21 @@ void DEM2DForceCompute<Real, Real4, Potential>::setParams(
         }
 
     m_shapes[type] = points;
+
+    // bounding circles of the shape about its center of mass and of
+    // each edge (between vertex i and i + 1) about its midpoint
+    m_typeRadius.resize(m_shapes.size(), Real(0));
+    m_edgeRadius.resize(m_shapes.size());
+
+    Real radiussq(0);
+    m_edgeRadius[type].resize(points.size());
+    for(size_t i(0); i < points.size(); ++i)
+        {
+        const vec2<Real> delta(points[(i + 1) % points.size()] - points[i]);
+        m_edgeRadius[type][i] = Real(0.5)*sqrt(dot(delta, delta));
+        radiussq = std::max(radiussq, dot(points[i], points[i]));
+        }
+    m_typeRadius[type] = sqrt(radiussq);
     }
 
 /*! DEM2DForceCompute provides
@@ -246,12 +266,21 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
     // create a temporary copy of r_cut squared
     Scalar r_cut_sq = m_r_cut * m_r_cut;
 
+    const unsigned int N = m_pdata->getN();
+
     // tally up the number of forces calculated
     int64_t n_calc = 0;
+    for (unsigned int i = 0; i < N; i++)
+        n_calc += h_n_neigh.data[i];
 
-    // for each particle
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    // sum the forces on particle i into the force arrays, and the third law contributions to its
+    // neighbors into force_k, torque_k, and virial_k (which may be private to a thread)
+    auto computeParticle = [&](unsigned int i, Scalar4 *force_k, Scalar4 *torque_k,
+        Scalar *virial_k, unsigned int virial_pitch_k)
         {
+        // the evaluator is modified for each pair, so work with a copy of it
+        DEMEvaluator<Real, Real4, Potential> evaluator(m_evaluator);
+
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
         vec3<Scalar> pi(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         quat<Scalar> quati(h_orientation.data[i]);
@@ -283,15 +312,16 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
         for(typename vector<vec2<Real> >::iterator vertIter(vertices_i.begin());
             vertIter != vertices_i.end(); ++vertIter)
             *vertIter = rotate(quati, *vertIter);
+        const vector<Real> &edgeRadius_i(m_edgeRadius[typei]);
+
+        // Make a local copy for the rotated vertices for particle j
+        vector<vec2<Real> > vertices_j;
 
         // loop over all of the neighbors of this particle
         const unsigned int myHead = h_head_list.data[i];
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
         for (unsigned int j = 0; j < size; j++)
             {
-            // increment our calculation counter
-            n_calc++;
-
             // access the index of this neighbor (MEM TRANSFER: 1 scalar)
             unsigned int k = h_nlist.data[myHead + j];
             // sanity check
@@ -318,28 +348,35 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
             if (Potential::needsDiameter())
                 {
                 dj = h_diameter.data[k];
-                m_evaluator.setDiameter(di,dj);
+                evaluator.setDiameter(di,dj);
                 }
 
             if(Potential::needsVelocity())
-                m_evaluator.setVelocity(vi - vec3<Scalar>(h_velocity.data[k]));
+                evaluator.setVelocity(vi - vec3<Scalar>(h_velocity.data[k]));
 
             // start computing the force
             // calculate r squared (FLOPS: 5)
             Scalar rsq = dot(dx, dx);
 
             // only compute the force if the particles are closer than the cutoff (FLOPS: 1)
-            if (m_evaluator.withinCutoff(rsq,r_cut_sq))
+            if (evaluator.withinCutoff(rsq,r_cut_sq))
                 {
                 // local forces and torques for particles i and j
                 vec2<Real> forceij, forceji;
                 Real torqueij(0), torqueji(0), potentialij(0);
 
-                // Make a local copy for the rotated vertices for particle j
-                vector<vec2<Real> > vertices_j(m_shapes[typej]);
+                vertices_j = m_shapes[typej];
                 for(typename vector<vec2<Real> >::iterator vertIter(vertices_j.begin());
                     vertIter != vertices_j.end(); ++vertIter)
                     *vertIter = rotate(quatj, *vertIter);
+                const vector<Real> &edgeRadius_j(m_edgeRadius[typej]);
+
+                // vertices and edges whose bounding circles are further
+                // apart than this can not interact, so they are skipped
+                const Real range(m_cull_features ? evaluator.getFeatureRange() :
+                    std::numeric_limits<Real>::infinity());
+                const Real rmaxi(m_typeRadius[typei] + range);
+                const Real rmaxj(m_typeRadius[typej] + range);
 
                 // Iterate over each vertex of particle i, if particle j has any edges
                 if (vertices_j.size()>1)
@@ -347,21 +384,30 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                     for(typename vector<vec2<Real> >::const_iterator viIter(vertices_i.begin());
                         viIter != vertices_i.end(); ++viIter)
                         {
+                        // skip the vertex if it is out of range of all of particle j
+                        const vec2<Real> r0j(*viIter - dx);
+                        if(dot(r0j, r0j) > rmaxj*rmaxj)
+                            continue;
+
                         // iterate over each edge of particle j
-                        for(typename vector<vec2<Real> >::const_iterator vjIter(vertices_j.begin());
-                            vjIter + 1 != vertices_j.end(); ++vjIter)
+                        for(size_t edgej(0); edgej < vertices_j.size(); ++edgej)
                             {
-                            m_evaluator.vertexEdge(dx, *viIter, *vjIter, *(vjIter + 1),
+                            // evaluate for the last edge, but only if we
+                            // didn't just evaluate that edge (i.e. the
+                            // shape isn't a spherocylinder)
+                            const size_t nextj(edgej + 1 < vertices_j.size() ? edgej + 1 : 0);
+                            if(nextj == 0 && vertices_j.size() <= 2)
+                                break;
+
+                            const vec2<Real> rc(r0j - Real(0.5)*(vertices_j[edgej] + vertices_j[nextj]));
+                            const Real rmax(edgeRadius_j[edgej] + range);
+                            if(dot(rc, rc) > rmax*rmax)
+                                continue;
+
+                            evaluator.vertexEdge(dx, *viIter, vertices_j[edgej], vertices_j[nextj],
                                 potentialij, forceij, torqueij,
                                 forceji, torqueji);
                             }
-                        // evaluate for the last edge, but only if we
-                        // didn't just evaluate that edge (i.e. the
-                        // shape isn't a spherocylinder)
-                        if(vertices_j.size() > 2)
-                            m_evaluator.vertexEdge(dx, *viIter, vertices_j.back(), vertices_j.front(),
-                                potentialij, forceij, torqueij,
-                                forceji, torqueji);
                         }
                     }
                 // iterate over each vertex of particle j, if vi has any edges
@@ -370,28 +416,37 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                     for(typename vector<vec2<Real> >::const_iterator vjIter(vertices_j.begin());
                         vjIter != vertices_j.end(); ++vjIter)
                         {
+                        // skip the vertex if it is out of range of all of particle i
+                        const vec2<Real> r0i(*vjIter + dx);
+                        if(dot(r0i, r0i) > rmaxi*rmaxi)
+                            continue;
+
                         // iterate over each edge of particle i
-                        for(typename vector<vec2<Real> >::const_iterator viIter(vertices_i.begin());
-                            viIter + 1 != vertices_i.end(); ++viIter)
+                        for(size_t edgei(0); edgei < vertices_i.size(); ++edgei)
                             {
-                            m_evaluator.vertexEdge(-dx, *vjIter, *viIter, *(viIter + 1),
+                            // evaluate for the last edge, but only if we
+                            // didn't just evaluate that edge (i.e. the
+                            // shape isn't a spherocylinder)
+                            const size_t nexti(edgei + 1 < vertices_i.size() ? edgei + 1 : 0);
+                            if(nexti == 0 && vertices_i.size() <= 2)
+                                break;
+
+                            const vec2<Real> rc(r0i - Real(0.5)*(vertices_i[edgei] + vertices_i[nexti]));
+                            const Real rmax(edgeRadius_i[edgei] + range);
+                            if(dot(rc, rc) > rmax*rmax)
+                                continue;
+
+                            evaluator.vertexEdge(-dx, *vjIter, vertices_i[edgei], vertices_i[nexti],
                                 potentialij, forceji, torqueji,
                                 forceij, torqueij);
                             }
-                        // evaluate for the last edge, but only if we
-                        // didn't just evaluate that edge (i.e. the
-                        // shape isn't a spherocylinder)
-                        if(vertices_i.size() > 2)
-                            m_evaluator.vertexEdge(-dx, *vjIter, vertices_i.back(), vertices_i.front(),
-                                potentialij, forceji, torqueji,
-                                forceij, torqueij);
                         }
                     }
                 // if i doesn't have any edges and j doesn't have any
                 // edges, both are disks
                 else if(vertices_j.size() <= 1)
                     {
-                    m_evaluator.vertexVertex(dx, vertices_i[0], dx + vertices_j[0],
+                    evaluator.vertexVertex(dx, vertices_i[0], dx + vertices_j[0],
                         potentialij, forceij, torqueij,
                         forceji, torqueji);
                     }
@@ -416,15 +471,15 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                 viriali[3] += pair_virial[3];
 
                 // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
-                if (third_law && k < m_pdata->getN())
+                if (third_law && k < N)
                     {
-                    h_force.data[k].x  += forceji.x;
-                    h_force.data[k].y  += forceji.y;
-                    h_force.data[k].w  += potentialij;
-                    h_torque.data[k].z += torqueji;
-                    h_virial.data[0*virial_pitch + k] += pair_virial[0];
-                    h_virial.data[1*virial_pitch + k] += pair_virial[1];
-                    h_virial.data[3*virial_pitch + k] += pair_virial[3];
+                    force_k[k].x  += forceji.x;
+                    force_k[k].y  += forceji.y;
+                    force_k[k].w  += potentialij;
+                    torque_k[k].z += torqueji;
+                    virial_k[0*virial_pitch_k + k] += pair_virial[0];
+                    virial_k[1*virial_pitch_k + k] += pair_virial[1];
+                    virial_k[3*virial_pitch_k + k] += pair_virial[3];
                     }
                 }
 
@@ -439,6 +494,59 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
         h_virial.data[0*virial_pitch + i] += viriali[0];
         h_virial.data[1*virial_pitch + i] += viriali[1];
         h_virial.data[3*virial_pitch + i] += viriali[3];
+        };
+
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        // each particle is owned by one thread, but its neighbors are not, so
+        // the third law contributions are summed in per-thread buffers
+        tbb::enumerable_thread_specific<DEMThirdLawBuffer> buffers;
+
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            DEMThirdLawBuffer& buffer = buffers.local();
+            if (third_law && buffer.N != N)
+                buffer.reset(N);
+
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                {
+                if (third_law)
+                    computeParticle(i, buffer.force.data(), buffer.torque.data(), buffer.virial.data(), N);
+                else
+                    computeParticle(i, h_force.data, h_torque.data, h_virial.data, virial_pitch);
+                }
+            });
+
+        if (third_law)
+            {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (auto buffer = buffers.begin(); buffer != buffers.end(); ++buffer)
+                    {
+                    for (unsigned int k = r.begin(); k != r.end(); ++k)
+                        {
+                        h_force.data[k].x  += buffer->force[k].x;
+                        h_force.data[k].y  += buffer->force[k].y;
+                        h_force.data[k].z  += buffer->force[k].z;
+                        h_force.data[k].w  += buffer->force[k].w;
+                        h_torque.data[k].x += buffer->torque[k].x;
+                        h_torque.data[k].y += buffer->torque[k].y;
+                        h_torque.data[k].z += buffer->torque[k].z;
+                        for (unsigned int l = 0; l < 6; ++l)
+                            h_virial.data[l*virial_pitch + k] += buffer->virial[l*N + k];
+                        }
+                    }
+                });
+            }
+        }
+    else
+#endif
+        {
+        for (unsigned int i = 0; i < N; i++)
+            computeParticle(i, h_force.data, h_torque.data, h_virial.data, virial_pitch);
         }
 
     int64_t flops = m_pdata->getN() * 5 + n_calc * (3+5+9+1+14+6+8);
@@ -11,6 +11,7 @@
 #include <memory>
 
 #include "DEMEvaluator.h"
+#include "DEMThirdLawBuffer.h"
 #include "hoomd/GSDShapeSpecWriter.h"
 
 /*! \file DEM2DForceCompute.h
@@ -36,6 +37,9 @@
   Forces can be computed directly by calling compute() and then retrieved with a call to acquire(), but
   a more typical usage will be to add the force compute to NVEUpdater or NVTUpdater.
 
+  On the CPU, vertices and edges whose bounding circles are out of range of each other are skipped, and
+  particles are split between threads when TBB is enabled.
+
   \ingroup computes
 */
 template<typename Real, typename Real4, typename Potential>
@@ -56,6 +60,9 @@ class DEM2DForceCompute : public ForceCompute
 
         virtual void setRcut(Real r_cut) {m_r_cut = r_cut;}
 
+        //! Enable or disable skipping feature pairs out of range of each other (the GPU kernels never skip them)
+        void setFeatureCulling(bool cull) {m_cull_features = cull;}
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -98,7 +105,10 @@ class DEM2DForceCompute : public ForceCompute
         std::shared_ptr<NeighborList> m_nlist;    //!< The neighborlist to use for the computation
         Real m_r_cut;         //!< Cutoff radius beyond which the force is set to 0
         DEMEvaluator<Real, Real4, Potential> m_evaluator; //!< Object holding parameters and computation method for the potential
+        bool m_cull_features; //!< True if feature pairs out of range of each other are skipped
         std::vector<std::vector<vec2<Real> > > m_shapes; //!< Vertices for each type
+        std::vector<Real> m_typeRadius; //!< Radius of the circle about the center of mass enclosing each type
+        std::vector<std::vector<Real> > m_edgeRadius; //!< Half length of each edge for each type
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -14,6 +14,7 @@
 
 
 #include <stdexcept>
+#include <limits>
 #include <utility>
 #include <set>
 
@@ -21,6 +22,10 @@
 #include <omp.h>
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 /*! \file DEM3DForceCompute.cc
   \brief Defines the DEM3DForceCompute class
 */
@@ -39,14 +44,15 @@ DEM3DForceCompute<Real, Real4, Potential>::DEM3DForceCompute(
     std::shared_ptr<NeighborList> nlist,
     Real r_cut, Potential potential)
     : ForceCompute(sysdef), m_nlist(nlist), m_r_cut(r_cut),
-      m_evaluator(potential), m_nextFace(0, this->m_exec_conf),
+      m_evaluator(potential), m_cull_features(true), m_nextFace(0, this->m_exec_conf),
       m_firstFaceVert(0, this->m_exec_conf), m_nextFaceVert(0, this->m_exec_conf),
       m_realVertIndex(0, this->m_exec_conf), m_firstTypeVert(0, this->m_exec_conf),
       m_numTypeVerts(0, this->m_exec_conf), m_firstTypeEdge(0, this->m_exec_conf),
       m_numTypeEdges(0, this->m_exec_conf), m_numTypeFaces(0, this->m_exec_conf),
       m_vertexConnectivity(0, this->m_exec_conf), m_edges(0, this->m_exec_conf),
       m_faceRcutSq(0, this->m_exec_conf), m_edgeRcutSq(0, this->m_exec_conf),
-      m_verts(0, this->m_exec_conf), m_shapes(), m_facesVec()
+      m_faceSpheres(0, this->m_exec_conf), m_edgeSpheres(0, this->m_exec_conf),
+      m_typeRadius(0, this->m_exec_conf), m_verts(0, this->m_exec_conf), m_shapes(), m_facesVec()
     {
     m_exec_conf->msg->notice(5) << "Constructing DEM3DForceCompute" << endl;
 
@@ -240,6 +246,12 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
     if(m_faceRcutSq.getNumElements() != nFaces)
         m_faceRcutSq.resize(nFaces);
 
+    if(m_faceSpheres.getNumElements() != nFaces)
+        m_faceSpheres.resize(nFaces);
+
+    if(m_typeRadius.getNumElements() != nTypes)
+        m_typeRadius.resize(nTypes);
+
     if(m_firstTypeVert.getNumElements() != nTypes)
         m_firstTypeVert.resize(nTypes);
 
@@ -261,6 +273,9 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
     if(m_edgeRcutSq.getNumElements() != nEdges)
         m_edgeRcutSq.resize(nEdges);
 
+    if(m_edgeSpheres.getNumElements() != nEdges)
+        m_edgeSpheres.resize(nEdges);
+
     if(m_edges.getNumElements() != 2*nEdges)
         m_edges.resize(2*nEdges);
 
@@ -270,6 +285,12 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
         access_mode::overwrite);
     ArrayHandle<Real> h_edgeRcutSq(m_edgeRcutSq, access_location::host,
         access_mode::overwrite);
+    ArrayHandle<Real4> h_faceSpheres(m_faceSpheres, access_location::host,
+        access_mode::overwrite);
+    ArrayHandle<Real4> h_edgeSpheres(m_edgeSpheres, access_location::host,
+        access_mode::overwrite);
+    ArrayHandle<Real> h_typeRadius(m_typeRadius, access_location::host,
+        access_mode::overwrite);
     ArrayHandle<unsigned int> h_nextFaceVert(m_nextFaceVert, access_location::host,
         access_mode::overwrite);
     ArrayHandle<unsigned int> h_realVertIndex(m_realVertIndex, access_location::host,
@@ -300,11 +321,14 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
         h_firstTypeVert.data[i] = j;
         h_numTypeVerts.data[i] = m_shapes[i].size();
 
+        Real radiussq(0);
         for(size_t k(0); k < m_shapes[i].size(); ++j, ++k)
             {
             const vec3<Real> point(m_shapes[i][k]);
             h_verts.data[j] = vec_to_scalar4(point, 0);
+            radiussq = std::max(radiussq, dot(point, point));
             }
+        h_typeRadius.data[i] = sqrt(radiussq);
         }
 
     // build m_nextFace
@@ -342,6 +366,31 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
             }
         }
 
+    // build m_faceSpheres, following the faces in the same order
+    for(size_t shapeIdx(0); shapeIdx < m_facesVec.size(); ++shapeIdx)
+        {
+        for(size_t faceIdx(shapeIdx), vecIdx(0);
+            vecIdx < m_facesVec[shapeIdx].size();
+            faceIdx = h_nextFace.data[faceIdx], ++vecIdx)
+            {
+            const vector<unsigned int> &face(m_facesVec[shapeIdx][vecIdx]);
+
+            vec3<Real> center;
+            for(size_t vertIdx(0); vertIdx < face.size(); ++vertIdx)
+                center += m_shapes[shapeIdx][face[vertIdx]];
+            center /= Real(face.size());
+
+            Real radiussq(0);
+            for(size_t vertIdx(0); vertIdx < face.size(); ++vertIdx)
+                {
+                const vec3<Real> delta(m_shapes[shapeIdx][face[vertIdx]] - center);
+                radiussq = std::max(radiussq, dot(delta, delta));
+                }
+
+            h_faceSpheres.data[faceIdx] = vec_to_scalar4(center, sqrt(radiussq));
+            }
+        }
+
     // build m_nextFaceVert
     for(size_t shapeIdx(0), vertCount(0);
         shapeIdx < m_facesVec.size(); ++shapeIdx)
@@ -415,6 +464,11 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
             h_edges.data[2*edgeCount] = edgeIter->first;
             h_edges.data[2*edgeCount + 1] = edgeIter->second;
 
+            const vec3<Real> p0(h_verts.data[edgeIter->first]);
+            const vec3<Real> p1(h_verts.data[edgeIter->second]);
+            const vec3<Real> delta(p1 - p0);
+            h_edgeSpheres.data[edgeCount] = vec_to_scalar4(Real(0.5)*(p0 + p1), Real(0.5)*sqrt(dot(delta, delta)));
+
             ++h_vertexConnectivity.data[edgeIter->first];
             ++h_vertexConnectivity.data[edgeIter->second];
             }
@@ -619,6 +673,12 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
         access_mode::read);
     ArrayHandle<Real> h_edgeRcutSq(m_edgeRcutSq, access_location::host,
         access_mode::read);
+    ArrayHandle<Real4> h_faceSpheres(m_faceSpheres, access_location::host,
+        access_mode::read);
+    ArrayHandle<Real4> h_edgeSpheres(m_edgeSpheres, access_location::host,
+        access_mode::read);
+    ArrayHandle<Real> h_typeRadius(m_typeRadius, access_location::host,
+        access_mode::read);
     ArrayHandle<unsigned int> h_nextFaceVert(m_nextFaceVert, access_location::host,
         access_mode::read);
     ArrayHandle<unsigned int> h_realVertIndex(m_realVertIndex, access_location::host,
@@ -649,12 +709,21 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
     // create a temporary copy of r_cut squared
     Scalar r_cut_sq = m_r_cut * m_r_cut;
 
+    const unsigned int N = m_pdata->getN();
+
     // tally up the number of forces calculated
     int64_t n_calc = 0;
+    for (unsigned int i = 0; i < N; i++)
+        n_calc += h_n_neigh.data[i];
 
-    // for each particle
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    // sum the forces on particle i into the force arrays, and the third law contributions to its
+    // neighbors into force_k, torque_k, and virial_k (which may be private to a thread)
+    auto computeParticle = [&](unsigned int i, Scalar4 *force_k, Scalar4 *torque_k,
+        Scalar *virial_k, unsigned int virial_pitch_k)
         {
+        // the evaluator is modified for each pair, so work with a copy of it
+        DEMEvaluator<Real, Real4, Potential> evaluator(m_evaluator);
+
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
         vec3<Scalar> pi(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         quat<Scalar> quati(h_orientation.data[i]);
@@ -687,9 +756,6 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
         for (unsigned int j = 0; j < size; j++)
             {
-            // increment our calculation counter
-            n_calc++;
-
             // access the index of this neighbor (MEM TRANSFER: 1 scalar)
             unsigned int k = h_nlist.data[myHead + j];
             // sanity check
@@ -716,44 +782,61 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
             if (Potential::needsDiameter())
                 {
                 dj = h_diameter.data[k];
-                m_evaluator.setDiameter(di,dj);
+                evaluator.setDiameter(di,dj);
                 }
 
             if(Potential::needsVelocity())
-                m_evaluator.setVelocity(vi - vec3<Scalar>(h_velocity.data[k]));
+                evaluator.setVelocity(vi - vec3<Scalar>(h_velocity.data[k]));
 
             // start computing the force
             // calculate r squared (FLOPS: 5)
             Real rsq = dot(dx, dx);
 
             // only compute the force if the particles are closer than the cutoff (FLOPS: 1)
-            if (m_evaluator.withinCutoff(rsq,r_cut_sq))
+            if (evaluator.withinCutoff(rsq,r_cut_sq))
                 {
                 // local forces and torques for particles i and j
                 vec3<Real> forceij, forceji;
                 vec3<Real> torqueij, torqueji;
                 Real potentialij(0);
 
+                // features whose bounding spheres are further apart than
+                // this can not interact, so they are skipped
+                const Real range(m_cull_features ? evaluator.getFeatureRange() :
+                    std::numeric_limits<Real>::infinity());
+                const Real rmaxi(h_typeRadius.data[typei] + range);
+                const Real rmaxj(h_typeRadius.data[typej] + range);
+
                 // iterate over each vertex in particle i
                 for(size_t vertIndex(0); vertIndex < h_numTypeVerts.data[typei]; ++vertIndex)
                     {
                     const vec3<Real> vertex0(
                         rotate(quati, vec3<Real>(h_verts.data[h_firstTypeVert.data[typei] + vertIndex])));
 
+                    // vertex in the body frame of particle j; skip it if
+                    // it is out of range of all of particle j
+                    const vec3<Real> vertex0j(rotate(conj(quatj), vertex0 - dx));
+                    if(dot(vertex0j, vertex0j) > rmaxj*rmaxj)
+                        continue;
+
                     // iterate over each face in particle j
                     size_t faceIndex(typej);
                     if(h_numTypeFaces.data[typej] > 0)
                         {
                         do
                             {
-                            m_evaluator.vertexFace(dx, vertex0, quatj,
-                                h_verts.data,
-                                h_realVertIndex.data,
-                                h_nextFaceVert.data,
-                                h_firstFaceVert.data[faceIndex],
-                                potentialij,
-                                forceij, torqueij,
-                                forceji, torqueji);
+                            const Real4 sphere(h_faceSpheres.data[faceIndex]);
+                            const vec3<Real> rc(vertex0j - vec3<Real>(sphere));
+                            const Real rmax(sphere.w + range);
+                            if(dot(rc, rc) <= rmax*rmax)
+                                evaluator.vertexFace(dx, vertex0, quatj,
+                                    h_verts.data,
+                                    h_realVertIndex.data,
+                                    h_nextFaceVert.data,
+                                    h_firstFaceVert.data[faceIndex],
+                                    potentialij,
+                                    forceij, torqueij,
+                                    forceji, torqueji);
                             faceIndex = h_nextFace.data[faceIndex];
                             }
                         while(faceIndex != typej);
@@ -764,12 +847,18 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                         // iterate over all edges of j
                         for(size_t edgej(0); edgej < h_numTypeEdges.data[typej]; ++edgej)
                             {
+                            const Real4 sphere(h_edgeSpheres.data[edgej + h_firstTypeEdge.data[typej]]);
+                            const vec3<Real> rc(vertex0j - vec3<Real>(sphere));
+                            const Real rmax(sphere.w + range);
+                            if(dot(rc, rc) > rmax*rmax)
+                                continue;
+
                             vec3<Real> p10(h_verts.data[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej])]]);
                             vec3<Real> p11(h_verts.data[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej]) + 1]]);
                             p10 = rotate(quatj, p10);
                             p11 = rotate(quatj, p11);
 
-                            m_evaluator.vertexEdge(dx, vertex0, p10, p11,
+                            evaluator.vertexEdge(dx, vertex0, p10, p11,
                                 potentialij, forceij, torqueij,
                                 forceji, torqueji);
                             }
@@ -783,7 +872,7 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                             vec3<Real> vertex1(h_verts.data[h_firstTypeVert.data[typej] + vertj]);
                             vertex1 = rotate(quatj, vertex1);
 
-                            m_evaluator.vertexVertex(dx, vertex0, dx + vertex1,
+                            evaluator.vertexVertex(dx, vertex0, dx + vertex1,
                                 potentialij, forceij, torqueij,
                                 forceji, torqueji);
                             }
@@ -796,20 +885,30 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                     const vec3<Real> vertex0(
                         rotate(quatj, vec3<Real>(h_verts.data[h_firstTypeVert.data[typej] + vertIndex])));
 
+                    // vertex in the body frame of particle i; skip it if
+                    // it is out of range of all of particle i
+                    const vec3<Real> vertex0i(rotate(conj(quati), vertex0 + dx));
+                    if(dot(vertex0i, vertex0i) > rmaxi*rmaxi)
+                        continue;
+
                     // iterate over each face in particle i
                     size_t faceIndex(typei);
                     if(h_numTypeFaces.data[typei] > 0)
                         {
                         do
                             {
-                            m_evaluator.vertexFace(-dx, vertex0, quati,
-                                h_verts.data,
-                                h_realVertIndex.data,
-                                h_nextFaceVert.data,
-                                h_firstFaceVert.data[faceIndex],
-                                potentialij,
-                                forceji, torqueji,
-                                forceij, torqueij);
+                            const Real4 sphere(h_faceSpheres.data[faceIndex]);
+                            const vec3<Real> rc(vertex0i - vec3<Real>(sphere));
+                            const Real rmax(sphere.w + range);
+                            if(dot(rc, rc) <= rmax*rmax)
+                                evaluator.vertexFace(-dx, vertex0, quati,
+                                    h_verts.data,
+                                    h_realVertIndex.data,
+                                    h_nextFaceVert.data,
+                                    h_firstFaceVert.data[faceIndex],
+                                    potentialij,
+                                    forceji, torqueji,
+                                    forceij, torqueij);
                             faceIndex = h_nextFace.data[faceIndex];
                             }
                         while(faceIndex != typei);
@@ -820,12 +919,18 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                         // iterate over all edges of i
                         for(size_t edgei(0); edgei < h_numTypeEdges.data[typei]; ++edgei)
                             {
+                            const Real4 sphere(h_edgeSpheres.data[edgei + h_firstTypeEdge.data[typei]]);
+                            const vec3<Real> rc(vertex0i - vec3<Real>(sphere));
+                            const Real rmax(sphere.w + range);
+                            if(dot(rc, rc) > rmax*rmax)
+                                continue;
+
                             vec3<Real> p10(h_verts.data[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei])]]);
                             vec3<Real> p11(h_verts.data[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei]) + 1]]);
                             p10 = rotate(quati, p10);
                             p11 = rotate(quati, p11);
 
-                            m_evaluator.vertexEdge(-dx, vertex0, p10, p11,
+                            evaluator.vertexEdge(-dx, vertex0, p10, p11,
                                 potentialij, forceji, torqueji,
                                 forceij, torqueij);
                             }
@@ -838,6 +943,13 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                 // iterate over all pairs of edges
                 for(size_t edgei(0); edgei < h_numTypeEdges.data[typei]; ++edgei)
                     {
+                    // center of the edge in the body frame of particle j;
+                    // skip it if it is out of range of all of particle j
+                    const Real4 spherei(h_edgeSpheres.data[edgei + h_firstTypeEdge.data[typei]]);
+                    const vec3<Real> centeri(rotate(conj(quatj), rotate(quati, vec3<Real>(spherei)) - dx));
+                    if(dot(centeri, centeri) > (rmaxj + spherei.w)*(rmaxj + spherei.w))
+                        continue;
+
                     vec3<Real> p00(h_verts.data[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei])]]);
                     vec3<Real> p01(h_verts.data[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei]) + 1]]);
                     p00 = rotate(quati, p00);
@@ -846,12 +958,18 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                     // iterate over all edges of j
                     for(size_t edgej(0); edgej < h_numTypeEdges.data[typej]; ++edgej)
                         {
+                        const Real4 spherej(h_edgeSpheres.data[edgej + h_firstTypeEdge.data[typej]]);
+                        const vec3<Real> rc(centeri - vec3<Real>(spherej));
+                        const Real rmax(spherei.w + spherej.w + range);
+                        if(dot(rc, rc) > rmax*rmax)
+                            continue;
+
                         vec3<Real> p10(h_verts.data[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej])]]);
                         vec3<Real> p11(h_verts.data[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej]) + 1]]);
                         p10 = rotate(quatj, p10);
                         p11 = rotate(quatj, p11);
 
-                        m_evaluator.edgeEdge(dx, p00, p01, dx + p10, dx + p11, potentialij, forceij, torqueij, forceji, torqueji);
+                        evaluator.edgeEdge(dx, p00, p01, dx + p10, dx + p11, potentialij, forceij, torqueij, forceji, torqueji);
                         }
                     }
 
@@ -880,21 +998,21 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                 viriali[5] += pair_virial[5];
 
                 // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
-                if (third_law && k < m_pdata->getN())
+                if (third_law && k < N)
                     {
-                    h_force.data[k].x  += forceji.x;
-                    h_force.data[k].y  += forceji.y;
-                    h_force.data[k].z  += forceji.z;
-                    h_force.data[k].w  += potentialij;
-                    h_torque.data[k].x += torqueji.x;
-                    h_torque.data[k].y += torqueji.y;
-                    h_torque.data[k].z += torqueji.z;
-                    h_virial.data[0*virial_pitch + k] += pair_virial[0];
-                    h_virial.data[1*virial_pitch + k] += pair_virial[1];
-                    h_virial.data[2*virial_pitch + k] += pair_virial[2];
-                    h_virial.data[3*virial_pitch + k] += pair_virial[3];
-                    h_virial.data[4*virial_pitch + k] += pair_virial[4];
-                    h_virial.data[5*virial_pitch + k] += pair_virial[5];
+                    force_k[k].x  += forceji.x;
+                    force_k[k].y  += forceji.y;
+                    force_k[k].z  += forceji.z;
+                    force_k[k].w  += potentialij;
+                    torque_k[k].x += torqueji.x;
+                    torque_k[k].y += torqueji.y;
+                    torque_k[k].z += torqueji.z;
+                    virial_k[0*virial_pitch_k + k] += pair_virial[0];
+                    virial_k[1*virial_pitch_k + k] += pair_virial[1];
+                    virial_k[2*virial_pitch_k + k] += pair_virial[2];
+                    virial_k[3*virial_pitch_k + k] += pair_virial[3];
+                    virial_k[4*virial_pitch_k + k] += pair_virial[4];
+                    virial_k[5*virial_pitch_k + k] += pair_virial[5];
                     }
                 }
 
@@ -915,6 +1033,59 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
         h_virial.data[3*virial_pitch + i] += viriali[3];
         h_virial.data[4*virial_pitch + i] += viriali[4];
         h_virial.data[5*virial_pitch + i] += viriali[5];
+        };
+
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        // each particle is owned by one thread, but its neighbors are not, so
+        // the third law contributions are summed in per-thread buffers
+        tbb::enumerable_thread_specific<DEMThirdLawBuffer> buffers;
+
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            DEMThirdLawBuffer& buffer = buffers.local();
+            if (third_law && buffer.N != N)
+                buffer.reset(N);
+
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                {
+                if (third_law)
+                    computeParticle(i, buffer.force.data(), buffer.torque.data(), buffer.virial.data(), N);
+                else
+                    computeParticle(i, h_force.data, h_torque.data, h_virial.data, virial_pitch);
+                }
+            });
+
+        if (third_law)
+            {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (auto buffer = buffers.begin(); buffer != buffers.end(); ++buffer)
+                    {
+                    for (unsigned int k = r.begin(); k != r.end(); ++k)
+                        {
+                        h_force.data[k].x  += buffer->force[k].x;
+                        h_force.data[k].y  += buffer->force[k].y;
+                        h_force.data[k].z  += buffer->force[k].z;
+                        h_force.data[k].w  += buffer->force[k].w;
+                        h_torque.data[k].x += buffer->torque[k].x;
+                        h_torque.data[k].y += buffer->torque[k].y;
+                        h_torque.data[k].z += buffer->torque[k].z;
+                        for (unsigned int l = 0; l < 6; ++l)
+                            h_virial.data[l*virial_pitch + k] += buffer->virial[l*N + k];
+                        }
+                    }
+                });
+            }
+        }
+    else
+#endif
+        {
+        for (unsigned int i = 0; i < N; i++)
+            computeParticle(i, h_force.data, h_torque.data, h_virial.data, virial_pitch);
         }
 
     int64_t flops = m_pdata->getN() * 5 + n_calc * (3+5+9+1+14+6+8);
@@ -10,6 +10,7 @@
 #include <memory>
 
 #include "DEMEvaluator.h"
+#include "DEMThirdLawBuffer.h"
 #include "hoomd/GSDShapeSpecWriter.h"
 
 /*! \file DEM3DForceCompute.h
@@ -50,12 +51,16 @@
   - type index->number of edges in type
   - (2*edge index)->first real vertex index in edge, (2*edge index + 1)->second real vertex in edge
   - real vertex index->vertex (3D point)
+  - face index->bounding sphere of the face, edge index->bounding sphere of the edge
+  - type index->radius of the sphere about the center of mass enclosing the shape
 
   Implementation details:
   - The first face of the type with type index i is stored at index i within the face->next face array
   - Faces in a shape and vertices in a face use a circularly linked index structure
   - Vertices (3D points) are stored consecutively for a shape
   - Edges (pairs of vertex indices) are stored consecutively for a shape
+  - On the CPU, features whose bounding spheres are out of range of each other
+    are skipped, and particles are split between threads when TBB is enabled
 
   \ingroup computes
 */
@@ -78,6 +83,9 @@ class DEM3DForceCompute : public ForceCompute
 
         virtual void setRcut(Real r_cut) {m_r_cut = r_cut;}
 
+        //! Enable or disable skipping feature pairs out of range of each other (the GPU kernels never skip them)
+        void setFeatureCulling(bool cull) {m_cull_features = cull;}
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -135,6 +143,7 @@ class DEM3DForceCompute : public ForceCompute
         std::shared_ptr<NeighborList> m_nlist;    //!< The neighborlist to use for the computation
         Real m_r_cut;         //!< Cutoff radius beyond which the force is set to 0
         DEMEvaluator<Real, Real4, Potential> m_evaluator; //!< Object holding parameters and computation method for the potential
+        bool m_cull_features; //!< True if feature pairs out of range of each other are skipped
         GPUArray<unsigned int> m_nextFace; //! face->next face
         GPUArray<unsigned int> m_firstFaceVert; //!< face->first vertex
         GPUArray<unsigned int> m_nextFaceVert; //!< vertex->next vertex in the given face
@@ -148,6 +157,9 @@ class DEM3DForceCompute : public ForceCompute
         GPUArray<unsigned int> m_edges; //!< 2*edge->first real vert, 2*edge+1->second real vert in edge
         GPUArray<Real> m_faceRcutSq; //!< face index->rcut*rcut
         GPUArray<Real> m_edgeRcutSq; //!< edge index->rcut*rcut
+        GPUArray<Real4> m_faceSpheres; //!< face index->bounding sphere (center, radius) in the body frame
+        GPUArray<Real4> m_edgeSpheres; //!< edge index->bounding sphere (center, radius) in the body frame
+        GPUArray<Real> m_typeRadius; //!< type->circumsphere radius about the center of mass
         GPUArray<Real4> m_verts; //! Vertices for each real index
         std::vector<std::vector<vec3<Real> > > m_shapes; //!< Vertices for each type
         std::vector<std::vector<std::vector<unsigned int> > > m_facesVec; //!< Faces for each type
@@ -43,6 +43,11 @@ class DEMEvaluator
 
         Real getRadius() const {return m_potential.getRadius();}
 
+        /*! Largest distance between two features that can still
+          interact, used to cull feature pairs with bounding spheres
+        */
+        DEVICE Real getFeatureRange() const {return m_potential.getFeatureRange();}
+
         /*! Evaluate the force and torque contributions for particles i
           and j, with centers of mass separated by rij. The appropriate
           forces and torques for particles i and j will be added to
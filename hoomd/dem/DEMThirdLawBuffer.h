@@ -0,0 +1,47 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mspells
+
+/*! \file DEMThirdLawBuffer.h
+  \brief Declares the DEMThirdLawBuffer struct
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __DEMTHIRDLAWBUFFER_H__
+#define __DEMTHIRDLAWBUFFER_H__
+
+#include "hoomd/HOOMDMath.h"
+
+#include <vector>
+#include <string.h>
+
+//! Per-thread accumulator for the forces on neighbors in the threaded DEM force computes
+/*! With a half neighbor list, the force on particle j is applied while particle i is processed. When particles
+  are split between threads, two threads can hit the same j, so each thread accumulates these contributions
+  into its own buffer (virial indexed with a pitch of N) that is summed into the force arrays afterwards.
+*/
+struct DEMThirdLawBuffer
+    {
+    std::vector<Scalar4> force;     //!< Force and energy on each particle
+    std::vector<Scalar4> torque;    //!< Torque on each particle
+    std::vector<Scalar> virial;     //!< Virial of each particle, 6*N
+    unsigned int N = 0;             //!< Number of particles
+
+    //! Size and zero the buffer for \a n particles
+    void reset(unsigned int n)
+        {
+        N = n;
+        force.resize(n);
+        torque.resize(n);
+        virial.resize(6*n);
+        memset((void*)force.data(), 0, sizeof(Scalar4)*n);
+        memset((void*)torque.data(), 0, sizeof(Scalar4)*n);
+        memset((void*)virial.data(), 0, sizeof(Scalar)*6*n);
+        }
+    };
+
+#endif
@@ -74,6 +74,9 @@ class SWCAPotential
         DEVICE static bool needsDiameter() {return true;}
         DEVICE void setDiameter(Real di, Real dj) {m_delta = 0.5*(di+dj) - 1;}
 
+        //! Get the largest separation of two contact points that can interact (after setDiameter)
+        DEVICE Real getFeatureRange() const {return sqrt(m_rcutsq) + (m_delta > 0 ? m_delta : Real(0));}
+
         //! Swap the sense of particle i and j for the friction params
         DEVICE inline void swapij() {m_frictionParams.swapij();}
         DEVICE static bool needsVelocity() {return FrictionModel::needsVelocity();}
@@ -59,6 +59,9 @@ class WCAPotential
         // Get this potential's rounding radius
         Real getRadius() const {return m_radius;}
 
+        // Get the largest separation of two contact points that can interact
+        DEVICE Real getFeatureRange() const {return sqrt(m_rcutsq);}
+
         // Mutate this object by adjusting its lengthscale
         void scale(Real factor)
             {
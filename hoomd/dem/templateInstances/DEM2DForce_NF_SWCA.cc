@@ -24,6 +24,7 @@ void export_NF_SWCA_2D(py::module& m)
         .def(py::init< std::shared_ptr<SystemDefinition>, std::shared_ptr<NeighborList>, Scalar, SWCA>())
         .def("setParams", &SWCA_DEM_2D::setParams)
         .def("setRcut", &SWCA_DEM_2D::setRcut)
+        .def("setFeatureCulling", &SWCA_DEM_2D::setFeatureCulling)
         .def("connectDEMGSDShapeSpec", &SWCA_DEM_2D::connectDEMGSDShapeSpec)
         .def("slotWriteDEMGSDShapeSpec", &SWCA_DEM_2D::slotWriteDEMGSDShapeSpec)
         .def("getTypeShapesPy", &SWCA_DEM_2D::getTypeShapesPy)
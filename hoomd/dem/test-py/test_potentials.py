@@ -6,6 +6,7 @@ import hoomd.dem;
 hoomd.context.initialize();
 
 import itertools
+import numpy
 import unittest
 
 def not_on_mpi(f):
@@ -243,5 +244,80 @@ class shape_shape(unittest.TestCase):
     def tearDown(self):
         hoomd.comm.barrier();
 
+class feature_culling(unittest.TestCase):
+
+    def test_culling_wca_2d(self):
+        self._test_culling(hoomd.dem.pair.WCA, twoD=True, radius=.5);
+
+    def test_culling_wca_3d(self):
+        self._test_culling(hoomd.dem.pair.WCA, twoD=False, radius=.5);
+
+    def _test_culling(self, typ, twoD, **params):
+        # lattice of unit squares or cubes, slightly rotated, whose
+        # neighbors are closer than the range of the potential
+        n = 3;
+        a = 1.8;
+        dims = (2 if twoD else 3);
+        box = hoomd.data.boxdim(L=n*a, dimensions=dims);
+        snap = hoomd.data.make_snapshot(N=n**dims, box=box);
+
+        if hoomd.comm.get_rank() == 0:
+            rng = numpy.random.RandomState(42);
+            for (i, idx) in enumerate(itertools.product(*(dims*[range(n)]))):
+                pos = [(k + .5)*a - n*a/2 for k in idx] + (3 - dims)*[0];
+                snap.particles.position[i] = pos;
+
+                if twoD:
+                    axis = numpy.array([0, 0, 1.]);
+                else:
+                    axis = rng.normal(size=3);
+                    axis /= numpy.linalg.norm(axis);
+                angle = rng.uniform(-.3, .3);
+                snap.particles.orientation[i] = [numpy.cos(angle/2)] + list(numpy.sin(angle/2)*axis);
+
+        system = hoomd.init.read_snapshot(snap);
+        nl = hoomd.md.nlist.cell();
+
+        potential = typ(nlist=nl, **params);
+        nve = hoomd.md.integrate.nve(group=hoomd.group.all());
+        mode = hoomd.md.integrate.mode_standard(dt=0);
+
+        if twoD:
+            vertices = [[.5, .5], [-.5, .5], [-.5, -.5], [.5, -.5]];
+            potential.setParams('A', vertices, center=False);
+        else:
+            vertices = list(itertools.product(*(3*[[-.5, .5]])));
+            faces = [[4, 0, 2, 6],
+                     [1, 0, 4, 5],
+                     [5, 4, 6, 7],
+                     [2, 0, 1, 3],
+                     [6, 2, 3, 7],
+                     [3, 1, 5, 7]];
+            potential.setParams('A', vertices, faces, center=False);
+
+        # features out of range of each other are skipped by default
+        hoomd.run(1);
+        culled = [(p.net_force, p.net_torque, p.net_energy) for p in system.particles];
+
+        potential.cpp_force.setFeatureCulling(False);
+        hoomd.run(1);
+        full = [(p.net_force, p.net_torque, p.net_energy) for p in system.particles];
+
+        self.assertGreater(numpy.max(numpy.abs([f for (f, t, U) in full])), 0);
+        for ((f0, t0, U0), (f1, t1, U1)) in zip(culled, full):
+            numpy.testing.assert_allclose(f0, f1, rtol=1e-5, atol=1e-5);
+            numpy.testing.assert_allclose(t0, t1, rtol=1e-5, atol=1e-5);
+            self.assertAlmostEqual(U0, U1, places=5);
+
+        potential.disable();
+        del potential;
+        del system;
+
+    def setUp(self):
+        hoomd.context.initialize();
+
+    def tearDown(self):
+        hoomd.comm.barrier();
+
 if __name__ == '__main__':
     unittest.main(argv = ['test_potentials.py', '-v']);
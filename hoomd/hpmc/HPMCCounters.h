@@ -89,6 +89,19 @@ DEVICE inline hpmc_counters_t operator-(const hpmc_counters_t& a, const hpmc_cou
     }
 
 
+//! Add two sets of counters
+DEVICE inline hpmc_counters_t operator+(const hpmc_counters_t& a, const hpmc_counters_t& b)
+    {
+    hpmc_counters_t result;
+    result.translate_accept_count = a.translate_accept_count + b.translate_accept_count;
+    result.rotate_accept_count = a.rotate_accept_count + b.rotate_accept_count;
+    result.translate_reject_count = a.translate_reject_count + b.translate_reject_count;
+    result.rotate_reject_count = a.rotate_reject_count + b.rotate_reject_count;
+    result.overlap_checks = a.overlap_checks + b.overlap_checks;
+    result.overlap_err_count = a.overlap_err_count + b.overlap_err_count;
+    return result;
+    }
+
 //! Storage for NPT acceptance counters
 /*! \ingroup hpmc_data_structs */
 struct hpmc_boxmc_counters_t
@@ -406,6 +419,34 @@ struct hpmc_clusters_counters_t
         }
     };
 
+//! Storage for event chain counters
+/*! \ingroup hpmc_data_structs */
+struct hpmc_event_chain_counters_t
+    {
+    unsigned long long int chain_count;       //!< Number of event chains
+    unsigned long long int collision_count;   //!< Number of collisions, i.e. lifts of the moving particle
+    unsigned long long int truncated_count;   //!< Number of chains stopped before their full length
+
+    //! Construct a zero set of counters
+    hpmc_event_chain_counters_t()
+        {
+        chain_count = 0;
+        collision_count = 0;
+        truncated_count = 0;
+        }
+
+    //! Get the number of collisions per chain
+    /*! \returns The average number of collisions in a chain, or 0 if there are no chains
+    */
+    DEVICE double getCollisionsPerChain() const
+        {
+        if (chain_count == 0)
+            return 0.0;
+        else
+            return double(collision_count) / double(chain_count);
+        }
+    };
+
 //! Take the difference of two sets of counters
 DEVICE inline hpmc_implicit_counters_t operator-(const hpmc_implicit_counters_t& a, const hpmc_implicit_counters_t& b)
     {
@@ -417,6 +458,17 @@ DEVICE inline hpmc_implicit_counters_t operator-(const hpmc_implicit_counters_t&
     return result;
     }
 
+//! Add two sets of counters
+DEVICE inline hpmc_implicit_counters_t operator+(const hpmc_implicit_counters_t& a, const hpmc_implicit_counters_t& b)
+    {
+    hpmc_implicit_counters_t result;
+    result.insert_count = a.insert_count + b.insert_count;
+    result.free_volume_count = a.free_volume_count + b.free_volume_count;
+    result.overlap_count = a.overlap_count + b.overlap_count;
+    result.reinsert_count = a.reinsert_count + b.reinsert_count;
+    return result;
+    }
+
 DEVICE inline hpmc_muvt_counters_t operator-(const hpmc_muvt_counters_t& a, const hpmc_muvt_counters_t& b)
     {
     hpmc_muvt_counters_t result;
@@ -447,6 +499,17 @@ DEVICE inline hpmc_clusters_counters_t operator-(const hpmc_clusters_counters_t&
     return result;
     }
 
+//! Take the difference of two sets of counters
+DEVICE inline hpmc_event_chain_counters_t operator-(const hpmc_event_chain_counters_t& a,
+    const hpmc_event_chain_counters_t& b)
+    {
+    hpmc_event_chain_counters_t result;
+    result.chain_count = a.chain_count - b.chain_count;
+    result.collision_count = a.collision_count - b.collision_count;
+    result.truncated_count = a.truncated_count - b.truncated_count;
+    return result;
+    }
+
 } // end namespace hpmc
 
 #endif // _HPMC_COUNTERS_H_
@@ -17,6 +17,7 @@
 #include "HPMCPrecisionSetup.h"
 #include "IntegratorHPMC.h"
 #include "Moves.h"
+#include "OverlapWitness.h"
 #include "hoomd/AABBTree.h"
 #include "GSDHPMCSchema.h"
 #include "hoomd/Index1D.h"
@@ -161,6 +162,51 @@ class IntegratorHPMCMono : public IntegratorHPMC
             this->m_external_base = (ExternalField*)external.get();
             }
 
+        //! Set the patch energy
+        virtual void setPatchEnergy(std::shared_ptr< PatchEnergy > patch)
+            {
+            IntegratorHPMC::setPatchEnergy(patch);
+
+            // the patch cutoff enters the search radius of the candidate lists
+            m_candidates_invalid = true;
+            }
+
+        //! Enable the patch energy only for logging
+        /*! \param log if True, only enabled for logging purposes
+         */
+        virtual void disablePatchEnergyLogOnly(bool log)
+            {
+            IntegratorHPMC::disablePatchEnergyLogOnly(log);
+            m_candidates_invalid = true;
+            }
+
+        //! Set the skin of the candidate lists
+        /*! \param skin Distance added to the search radius when building the candidate lists, 0 to search the AABB tree
+                        in every trial move
+        */
+        void setCandidateSkin(Scalar skin)
+            {
+            if (skin < Scalar(0.0))
+                {
+                m_exec_conf->msg->error() << "hpmc: the candidate skin must be non-negative" << std::endl;
+                throw std::runtime_error("Error setting HPMC candidate skin");
+                }
+            m_candidate_skin = skin;
+            m_candidates_invalid = true;
+            }
+
+        //! Get the skin of the candidate lists
+        Scalar getCandidateSkin()
+            {
+            return m_candidate_skin;
+            }
+
+        //! Get the number of times the candidate lists have been built
+        unsigned int getCandidateListBuilds()
+            {
+            return m_candidate_builds;
+            }
+
         //! Get a list of logged quantities
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -373,6 +419,50 @@ class IntegratorHPMCMono : public IntegratorHPMC
 
         Index2D m_overlap_idx;                      //!!< Indexer for interaction matrix
 
+        detail::PatchEnergyBatch m_patch_batch;     //!< Neighbors of the trial particle for the patch energy
+
+        detail::OverlapWitnessCache m_witness_cache; //!< Overlapping parts of recent neighbors, for composite shapes
+
+        Scalar m_candidate_skin;                    //!< Skin of the candidate lists, 0 if disabled
+        bool m_candidates_invalid;                  //!< Flag if the candidate lists have been invalidated
+        unsigned int m_candidate_builds;            //!< Number of times the candidate lists have been built
+        Scalar m_candidate_max_disp;                //!< Largest displacement of any particle since the last build
+        std::vector<unsigned int> m_candidate_start;        //!< First candidate of each local particle (N+1 entries)
+        std::vector<unsigned int> m_candidate_idx;          //!< Index of each candidate
+        std::vector< vec3<Scalar> > m_candidate_r;          //!< Position of each candidate relative to the image of i at the last build
+        std::vector< vec3<Scalar> > m_candidate_ref_pos;    //!< Position of each particle at the last build, shifted along when wrapped
+        std::vector<Scalar4> m_candidate_last_postype;      //!< Positions at the end of the last step
+
+        //! Build the candidate lists from the AABB tree
+        void buildCandidateLists(const Scalar4 *h_postype);
+
+        //! Rebuild the candidate lists if the particles have changed since the last step
+        void checkCandidateLists();
+
+        //! Test a trial move of particle i for overlap with particle j
+        /*! \param i The particle being moved
+            \param j The neighbor
+            \param r_ij Position of j relative to the trial position of i
+            \param shape_i Shape of i at its trial orientation
+            \param shape_j Shape of j
+            \param err Incremented if there is an error condition
+
+            Shapes that record overlap witnesses start from the parts of the pair that overlapped last.
+        */
+        inline bool testOverlapMove(unsigned int i, unsigned int j, const vec3<Scalar>& r_ij,
+            const Shape& shape_i, const Shape& shape_j, unsigned int& err)
+            {
+            if (!uses_overlap_witness<Shape>::value)
+                return test_overlap(r_ij, shape_i, shape_j, err);
+
+            detail::OverlapWitness witness = m_witness_cache.find(i, j);
+            bool found = witness.tolerance != OverlapReal(0.0);
+            bool overlap = test_overlap(r_ij, shape_i, shape_j, err, witness);
+            if (overlap || found)
+                m_witness_cache.store(i, j, witness);
+            return overlap;
+            }
+
         //! Set the nominal width appropriate for looped moves
         virtual void updateCellWidth();
 
@@ -390,12 +480,14 @@ class IntegratorHPMCMono : public IntegratorHPMC
             // anything that changes the box (i.e. NPT, box_resize) is also moving the particles,
             // so use it as a sign to rebuild the AABB tree
             m_aabb_tree_invalid = true;
+            m_candidates_invalid = true;
             }
 
         //! callback so that the particle sort signal can invalidate the AABB tree
         virtual void slotSorted()
             {
             m_aabb_tree_invalid = true;
+            m_candidates_invalid = true;
             }
     };
 
@@ -407,7 +499,11 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
               m_image_list_is_initialized(false),
               m_image_list_valid(false),
               m_hasOrientation(true),
-              m_extra_image_width(0.0)
+              m_extra_image_width(0.0),
+              m_candidate_skin(0.0),
+              m_candidates_invalid(true),
+              m_candidate_builds(0),
+              m_candidate_max_disp(0.0)
     {
     // allocate the parameter storage
     m_params = std::vector<param_type, managed_allocator<param_type> >(m_pdata->getNTypes(), param_type(), managed_allocator<param_type>(m_exec_conf->isCUDAEnabled()));
@@ -577,6 +673,9 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     m_update_order.resize(m_pdata->getN());
     m_update_order.shuffle(timestep);
 
+    if (uses_overlap_witness<Shape>::value)
+        m_witness_cache.resize(m_pdata->getN());
+
     // update the AABB Tree
     buildAABBTree();
     // limit m_d entries so that particles cannot possibly wander more than one box image in one time step
@@ -584,6 +683,11 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     // update the image list
     updateImageList();
 
+    // trial moves test the candidate lists instead of searching the tree while no particle moved farther than the skin
+    bool use_candidates = m_candidate_skin > Scalar(0.0);
+    if (use_candidates)
+        checkCandidateLists();
+
     if (this->m_prof) this->m_prof->push(this->m_exec_conf, "HPMC update");
 
     if( m_external ) // I think we need this here otherwise I don't think it will get called.
@@ -683,12 +787,92 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                 r_cut_patch-getMinCoreDiameter()/(OverlapReal)2.0);
             detail::AABB aabb_i_local = detail::AABB(vec3<Scalar>(0,0,0),R_query);
 
+            // the candidates of i are complete if i and its candidates together moved less than the skin since the
+            // lists were built, this holds for both the trial and the old position of i
+            bool candidates_valid = false;
+            vec3<Scalar> dr_i, dr_old;
+            if (use_candidates)
+                {
+                dr_i = pos_i - m_candidate_ref_pos[i];
+                dr_old = pos_old - m_candidate_ref_pos[i];
+                Scalar disp = fast::sqrt(std::max(dot(dr_i,dr_i), dot(dr_old,dr_old)));
+                Scalar disp_move = fast::sqrt(dot(pos_i-pos_old, pos_i-pos_old));
+
+                // rebuild at the current positions, unless the trial move alone is larger than the skin
+                if (disp + m_candidate_max_disp > m_candidate_skin && disp_move <= m_candidate_skin)
+                    {
+                    buildCandidateLists(h_postype.data);
+                    dr_i = pos_i - pos_old;
+                    dr_old = vec3<Scalar>(0,0,0);
+                    disp = disp_move;
+                    }
+
+                candidates_valid = disp + m_candidate_max_disp <= m_candidate_skin;
+                }
+
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
 
-            // check for overlaps with neighboring particle's positions (also calculate the new energy)
+            // neighbors within the patch cutoff are collected and evaluated together after the overlap check
+            m_patch_batch.clear();
+
+            // check for overlaps with the candidates of i (also calculate the new energy)
+            if (candidates_valid)
+                {
+                for (unsigned int cur_candidate = m_candidate_start[i]; cur_candidate < m_candidate_start[i+1]; cur_candidate++)
+                    {
+                    unsigned int j = m_candidate_idx[cur_candidate];
+
+                    Scalar4 postype_j;
+                    Scalar4 orientation_j;
+                    vec3<Scalar> r_ij = m_candidate_r[cur_candidate];
+
+                    // handle j==i situations, the lists contain i only in outside images
+                    if ( j != i )
+                        {
+                        // load the position and orientation of the j particle
+                        postype_j = h_postype.data[j];
+                        orientation_j = h_orientation.data[j];
+
+                        // put particles in coordinate system of particle i
+                        r_ij += vec3<Scalar>(postype_j) - m_candidate_ref_pos[j] - dr_i;
+                        }
+                    else
+                        {
+                        // use the translated position and orientation
+                        postype_j = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+                        orientation_j = quat_to_scalar4(shape_i.orientation);
+                        }
+
+                    unsigned int typ_j = __scalar_as_int(postype_j.w);
+                    Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+
+                    Scalar rcut = 0.0;
+                    if (m_patch)
+                        rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
+
+                    counters.overlap_checks++;
+                    if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
+                        && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                        && testOverlapMove(i, j, r_ij, shape_i, shape_j, counters.overlap_err_count))
+                        {
+                        overlap = true;
+                        break;
+                        }
+                    else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, record the neighbor
+                        {
+                        m_patch_batch.push_back(vec3<float>(r_ij),
+                                                typ_j,
+                                                quat<float>(orientation_j),
+                                                h_diameter.data[j],
+                                                h_charge.data[j]);
+                        }
+                    }
+                }
+
+            // otherwise check for overlaps with neighboring particle's positions (also calculate the new energy)
             // All image boxes (including the primary)
-            const unsigned int n_images = m_image_list.size();
+            const unsigned int n_images = candidates_valid ? 0 : m_image_list.size();
             for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                 {
                 vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
@@ -745,23 +929,18 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                                 counters.overlap_checks++;
                                 if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
                                     && check_circumsphere_overlap(r_ij, shape_i, shape_j)
-                                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                                    && testOverlapMove(i, j, r_ij, shape_i, shape_j, counters.overlap_err_count))
                                     {
                                     overlap = true;
                                     break;
                                     }
-                                else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, calculate energy
+                                else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, record the neighbor
                                     {
-                                    // deltaU = U_old - U_new: subtract energy of new configuration
-                                    patch_field_energy_diff -= m_patch->energy(r_ij, typ_i,
-                                                               quat<float>(shape_i.orientation),
-                                                               h_diameter.data[i],
-                                                               h_charge.data[i],
-                                                               typ_j,
-                                                               quat<float>(orientation_j),
-                                                               h_diameter.data[j],
-                                                               h_charge.data[j]
-                                                               );
+                                    m_patch_batch.push_back(vec3<float>(r_ij),
+                                                            typ_j,
+                                                            quat<float>(orientation_j),
+                                                            h_diameter.data[j],
+                                                            h_charge.data[j]);
                                     }
                                 }
                             }
@@ -780,9 +959,51 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                     break;
                 } // end loop over images
 
-            // calculate old patch energy only if m_patch not NULL and no overlaps
+            // calculate new and old patch energy only if m_patch not NULL and no overlaps
             if (m_patch && !m_patch_log && !overlap)
                 {
+                // deltaU = U_old - U_new: subtract energy of new configuration
+                patch_field_energy_diff -= m_patch_batch.evaluate(*m_patch,
+                                                                  typ_i,
+                                                                  quat<float>(shape_i.orientation),
+                                                                  h_diameter.data[i],
+                                                                  h_charge.data[i]);
+
+                m_patch_batch.clear();
+                if (candidates_valid)
+                    {
+                    for (unsigned int cur_candidate = m_candidate_start[i]; cur_candidate < m_candidate_start[i+1]; cur_candidate++)
+                        {
+                        unsigned int j = m_candidate_idx[cur_candidate];
+
+                        Scalar4 postype_j;
+                        Scalar4 orientation_j;
+                        vec3<Scalar> r_ij = m_candidate_r[cur_candidate];
+
+                        if ( j != i )
+                            {
+                            postype_j = h_postype.data[j];
+                            orientation_j = h_orientation.data[j];
+                            r_ij += vec3<Scalar>(postype_j) - m_candidate_ref_pos[j] - dr_old;
+                            }
+                        else
+                            {
+                            postype_j = make_scalar4(pos_old.x, pos_old.y, pos_old.z, postype_i.w);
+                            orientation_j = quat_to_scalar4(shape_old.orientation);
+                            }
+
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
+
+                        if (dot(r_ij,r_ij) <= rcut*rcut)
+                            m_patch_batch.push_back(vec3<float>(r_ij),
+                                                    typ_j,
+                                                    quat<float>(orientation_j),
+                                                    h_diameter.data[j],
+                                                    h_charge.data[j]);
+                        }
+                    }
+
                 for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                     {
                     vec3<Scalar> pos_i_image = pos_old + m_image_list[cur_image];
@@ -833,17 +1054,12 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
 
                                     Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
 
-                                    // deltaU = U_old - U_new: add energy of old configuration
                                     if (dot(r_ij,r_ij) <= rcut*rcut)
-                                        patch_field_energy_diff += m_patch->energy(r_ij,
-                                                                   typ_i,
-                                                                   quat<float>(orientation_i),
-                                                                   h_diameter.data[i],
-                                                                   h_charge.data[i],
-                                                                   typ_j,
-                                                                   quat<float>(orientation_j),
-                                                                   h_diameter.data[j],
-                                                                   h_charge.data[j]);
+                                        m_patch_batch.push_back(vec3<float>(r_ij),
+                                                                typ_j,
+                                                                quat<float>(orientation_j),
+                                                                h_diameter.data[j],
+                                                                h_charge.data[j]);
                                     }
                                 }
                             }
@@ -854,6 +1070,13 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                             }
                         }  // end loop over AABB nodes
                     } // end loop over images
+
+                // deltaU = U_old - U_new: add energy of old configuration
+                patch_field_energy_diff += m_patch_batch.evaluate(*m_patch,
+                                                                  typ_i,
+                                                                  quat<float>(orientation_i),
+                                                                  h_diameter.data[i],
+                                                                  h_charge.data[i]);
                 } // end if (m_patch)
 
             // Add external energetic contribution
@@ -880,6 +1103,13 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                 aabb.translate(pos_i);
                 m_aabb_tree.update(i, aabb);
 
+                // track how far the particles moved since the candidate lists were built
+                if (use_candidates)
+                    {
+                    vec3<Scalar> dr = pos_i - m_candidate_ref_pos[i];
+                    m_candidate_max_disp = std::max(m_candidate_max_disp, fast::sqrt(dot(dr,dr)));
+                    }
+
                 // update position of particle
                 h_postype.data[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
 
@@ -908,7 +1138,17 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
         // wrap particles back into box
         for (unsigned int i = 0; i < m_pdata->getN(); i++)
             {
-            box.wrap(h_postype.data[i], h_image.data[i]);
+            if (use_candidates)
+                {
+                // shift the reference position along, so that the candidate separations remain valid
+                vec3<Scalar> pos_i = vec3<Scalar>(h_postype.data[i]);
+                box.wrap(h_postype.data[i], h_image.data[i]);
+                m_candidate_ref_pos[i] += vec3<Scalar>(h_postype.data[i]) - pos_i;
+                }
+            else
+                {
+                box.wrap(h_postype.data[i], h_image.data[i]);
+                }
             }
         }
 
@@ -949,6 +1189,13 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
 
     // all particle have been moved, the aabb tree is now invalid
     m_aabb_tree_invalid = true;
+
+    // remember the positions, to detect changes made outside of the integrator before the next step
+    if (use_candidates)
+        {
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+        m_candidate_last_postype.assign(h_postype.data, h_postype.data + m_pdata->getN());
+        }
     }
 
 /*! \param timestep current step
@@ -1122,8 +1369,10 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(unsigned int timestep)
     energy = tbb::parallel_reduce(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
         0.0f,
         [&](const tbb::blocked_range<unsigned int>& r, float energy)->float {
+        detail::PatchEnergyBatch batch;
         for (unsigned int i = r.begin(); i != r.end(); ++i)
     #else
+    detail::PatchEnergyBatch batch;
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
     #endif
         {
@@ -1133,6 +1382,7 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(unsigned int timestep)
         unsigned int typ_i = __scalar_as_int(postype_i.w);
         Shape shape_i(quat<Scalar>(orientation_i), m_params[typ_i]);
         vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+        batch.clear();
 
         Scalar d_i = h_diameter.data[i];
         Scalar charge_i = h_charge.data[i];
@@ -1184,15 +1434,11 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(unsigned int timestep)
 
                             if (h_tag.data[i] <= h_tag.data[j] && dot(r_ij,r_ij) <= rcut_ij*rcut_ij)
                                 {
-                                energy += m_patch->energy(r_ij,
-                                       typ_i,
-                                       quat<float>(orientation_i),
-                                       d_i,
-                                       charge_i,
-                                       typ_j,
-                                       quat<float>(orientation_j),
-                                       d_j,
-                                       charge_j);
+                                batch.push_back(vec3<float>(r_ij),
+                                                typ_j,
+                                                quat<float>(orientation_j),
+                                                d_j,
+                                                charge_j);
                                 }
                             }
                         }
@@ -1205,6 +1451,8 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(unsigned int timestep)
 
                 } // end loop over AABB nodes
             } // end loop over images
+
+        energy += batch.evaluate(*m_patch, typ_i, quat<float>(orientation_i), d_i, charge_i);
         } // end loop over particles
     #ifdef ENABLE_TBB
     return energy;
@@ -1487,9 +1735,10 @@ void IntegratorHPMCMono<Shape>::updateCellWidth()
         }
 
     // changing the cell width means that the particle shapes have changed, assume this invalidates the
-    // image list and aabb tree
+    // image list, aabb tree and candidate lists
     m_image_list_valid = false;
     m_aabb_tree_invalid = true;
+    m_candidates_invalid = true;
     }
 
 template <class Shape>
@@ -1568,6 +1817,142 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
     return m_aabb_tree;
     }
 
+/*! \param h_postype Current particle positions (local and ghost)
+
+    The candidates of particle i are all particles (in all images) whose bounding box overlaps the search box of i,
+    enlarged by the skin. The bounding box of a particle is taken from its circumsphere, so that the lists remain
+    complete when the particles rotate. Rebuilding requires an up to date AABB tree.
+
+    A trial move of i may use the lists as long as the displacements of i and of any candidate since the build add up
+    to less than the skin.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::buildCandidateLists(const Scalar4 *h_postype)
+    {
+    m_exec_conf->msg->notice(8) << "Building HPMC candidate lists: " << m_pdata->getN() << " ptls " << m_pdata->getNGhosts() << " ghosts" << std::endl;
+    if (this->m_prof) this->m_prof->push(this->m_exec_conf, "HPMC candidate lists");
+
+    // search radius and orientation independent extent of each type
+    unsigned int ntypes = m_pdata->getNTypes();
+    std::vector<OverlapReal> R_query(ntypes);
+    std::vector<OverlapReal> R_extent(ntypes);
+    OverlapReal R_extent_max = 0.0;
+    OverlapReal min_core_diameter = getMinCoreDiameter();
+    quat<Scalar> q(make_scalar4(1,0,0,0));
+    for (unsigned int typ = 0; typ < ntypes; typ++)
+        {
+        Shape shape(q, m_params[typ]);
+
+        OverlapReal r_cut_patch = 0;
+        if (m_patch && !m_patch_log)
+            r_cut_patch = m_patch->getRCut() + 0.5*m_patch->getAdditiveCutoff(typ);
+
+        R_query[typ] = std::max(shape.getCircumsphereDiameter()/OverlapReal(2.0),
+            r_cut_patch-min_core_diameter/(OverlapReal)2.0) + m_candidate_skin;
+
+        R_extent[typ] = shape.getCircumsphereDiameter()/OverlapReal(2.0);
+        if (m_patch)
+            R_extent[typ] = std::max(R_extent[typ], OverlapReal(0.5*m_patch->getAdditiveCutoff(typ)));
+        R_extent_max = std::max(R_extent_max, R_extent[typ]);
+        }
+
+    unsigned int N = m_pdata->getN();
+    unsigned int n_total = N + m_pdata->getNGhosts();
+    m_candidate_ref_pos.resize(n_total);
+    for (unsigned int i = 0; i < n_total; i++)
+        m_candidate_ref_pos[i] = vec3<Scalar>(h_postype[i]);
+
+    m_candidate_start.resize(N+1);
+    m_candidate_idx.clear();
+    m_candidate_r.clear();
+
+    const unsigned int n_images = m_image_list.size();
+    for (unsigned int i = 0; i < N; i++)
+        {
+        m_candidate_start[i] = m_candidate_idx.size();
+
+        vec3<Scalar> pos_i(h_postype[i]);
+        unsigned int typ_i = __scalar_as_int(h_postype[i].w);
+
+        for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+            {
+            vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+
+            // the tree AABB of a particle lies within its extent around its center
+            detail::AABB aabb(pos_i_image, R_query[typ_i] + OverlapReal(2.0)*R_extent_max);
+
+            // stackless search
+            for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+                {
+                if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                    {
+                    if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                        {
+                        for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                            {
+                            unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                            // in the first image, skip i == j
+                            if (j == i && cur_image == 0)
+                                continue;
+
+                            vec3<Scalar> r_ij = vec3<Scalar>(h_postype[j]) - pos_i_image;
+                            Scalar r_max = R_query[typ_i] + R_extent[__scalar_as_int(h_postype[j].w)];
+                            if (fabs(r_ij.x) <= r_max && fabs(r_ij.y) <= r_max && fabs(r_ij.z) <= r_max)
+                                {
+                                m_candidate_idx.push_back(j);
+                                m_candidate_r.push_back(r_ij);
+                                }
+                            }
+                        }
+                    }
+                else
+                    {
+                    // skip ahead
+                    cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                    }
+                }
+            }
+        }
+    m_candidate_start[N] = m_candidate_idx.size();
+
+    m_candidate_max_disp = 0.0;
+    m_candidates_invalid = false;
+    m_candidate_builds++;
+
+    if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
+    }
+
+/*! The candidate lists are kept from one step to the next. Other updaters, the particle sort, or the user may change
+    the particles between steps, so the current positions are compared to those at the end of the last step.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::checkCandidateLists()
+    {
+    #ifdef ENABLE_MPI
+    // particles migrate and ghosts are exchanged every step
+    if (m_comm)
+        m_candidates_invalid = true;
+    #endif
+
+    unsigned int N = m_pdata->getN();
+    if (m_candidate_last_postype.size() != N || m_candidate_ref_pos.size() != N + m_pdata->getNGhosts())
+        m_candidates_invalid = true;
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < N && !m_candidates_invalid; i++)
+        {
+        Scalar4 postype_i = h_postype.data[i];
+        Scalar4 last_postype_i = m_candidate_last_postype[i];
+        if (postype_i.x != last_postype_i.x || postype_i.y != last_postype_i.y || postype_i.z != last_postype_i.z
+            || __scalar_as_int(postype_i.w) != __scalar_as_int(last_postype_i.w))
+            m_candidates_invalid = true;
+        }
+
+    if (m_candidates_invalid)
+        buildCandidateLists(h_postype.data);
+    }
+
 /*! Call to reduce the m_d values down to safe levels for the bvh tree + small box limitations. That code path
     will not work if particles can wander more than one image in a time step.
 
@@ -1876,6 +2261,9 @@ template < class Shape > void export_IntegratorHPMCMono(pybind11::module& m, con
           .def("restoreStateGSD", &IntegratorHPMCMono<Shape>::restoreStateGSD)
           .def("py_test_overlap", &IntegratorHPMCMono<Shape>::py_test_overlap)
           .def("getTypeShapesPy", &IntegratorHPMCMono<Shape>::getTypeShapesPy)
+          .def("setCandidateSkin", &IntegratorHPMCMono<Shape>::setCandidateSkin)
+          .def("getCandidateSkin", &IntegratorHPMCMono<Shape>::getCandidateSkin)
+          .def("getCandidateListBuilds", &IntegratorHPMCMono<Shape>::getCandidateListBuilds)
           ;
     }
 
@@ -36,6 +36,9 @@ namespace hpmc
 
     The penetrable depletants model is simulated.
 
+    Optionally, the trial moves are processed in the cells of a checkerboard. Trial moves in cells of the same color
+    are independent, so that their depletant insertions run concurrently, not only the depletants of a single move.
+
     \ingroup hpmc_integrators
 */
 template< class Shape >
@@ -94,6 +97,21 @@ class IntegratorHPMCMonoImplicit : public IntegratorHPMCMono<Shape>
             return m_n_trial;
             }
 
+        //! Set whether to process independent trial moves concurrently
+        /*! \param checkerboard True to move the particles in the cells of a checkerboard
+         */
+        void setCheckerboard(bool checkerboard)
+            {
+            m_checkerboard = checkerboard;
+            m_checkerboard_warned = false;
+            }
+
+        //! Return whether independent trial moves are processed concurrently
+        bool getCheckerboard() const
+            {
+            return m_checkerboard;
+            }
+
         //! Reset statistics counters
         virtual void resetStats()
             {
@@ -178,21 +196,72 @@ class IntegratorHPMCMonoImplicit : public IntegratorHPMCMono<Shape>
 
         unsigned int m_method;                                   //!< Whether to use the "overlap_regions" or "circumsphere" integrator
 
+        bool m_checkerboard;                                     //!< True if the trial moves are processed in the cells of a checkerboard
+        bool m_checkerboard_warned;                              //!< True if the box has been reported too small for the checkerboard
+        Index3D m_checkerboard_indexer;                          //!< Indexer of the checkerboard cells
+        Scalar3 m_checkerboard_shift;                            //!< Random shift of the checkerboard in fractional coordinates
+        std::vector<unsigned int> m_checkerboard_cell_start;     //!< Offset of each cell in m_checkerboard_particles
+        std::vector<unsigned int> m_checkerboard_particles;      //!< Local particles sorted by cell
+
+        #ifdef ENABLE_TBB
+        //! Random number streams of one thread
+        struct ThreadRNG
+            {
+            std::size_t thread_hash;                             //!< Hash of the id of the thread owning the streams
+            hoomd::detail::Saru saru;                            //!< Stream for the depletant positions
+            std::mt19937 mt;                                     //!< Stream for the number of depletants
+            };
+
+        unsigned int m_rng_timestep;                             //!< Timestep the per-thread RNGs are seeded for
+        tbb::enumerable_thread_specific<ThreadRNG> m_rng_parallel; //!< Per-thread RNGs, kept between steps
+        tbb::enumerable_thread_specific<detail::PatchEnergyBatch> m_patch_batch_parallel; //!< Per-thread patch neighbor buffers
+        #endif
+
         //! Take one timestep forward
         virtual void update(unsigned int timestep);
 
+        //! Attempt a trial move of a single particle
+        #ifndef ENABLE_TBB
+        inline void attemptMove(unsigned int i, unsigned int i_nselect, unsigned int timestep, bool checkerboard, Scalar4 *h_postype, Scalar4 *h_orientation, Scalar *h_diameter, Scalar *h_charge, unsigned int *h_overlaps, Scalar *h_d, Scalar *h_a, Scalar *h_d_max, Scalar *h_d_min, detail::PatchEnergyBatch& patch_batch, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters, std::mt19937& rng_poisson);
+        #else
+        inline void attemptMove(unsigned int i, unsigned int i_nselect, unsigned int timestep, bool checkerboard, Scalar4 *h_postype, Scalar4 *h_orientation, Scalar *h_diameter, Scalar *h_charge, unsigned int *h_overlaps, Scalar *h_d, Scalar *h_a, Scalar *h_d_max, Scalar *h_d_min, detail::PatchEnergyBatch& patch_batch, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters);
+        #endif
+
+        //! Set up the checkerboard for this step
+        bool initializeCheckerboard(unsigned int timestep);
+
+        //! Get the checkerboard cell containing a position
+        inline unsigned int getCheckerboardCell(const vec3<Scalar>& pos, const BoxDim& box) const
+            {
+            Scalar3 f = box.makeFraction(vec_to_scalar3(pos)) - m_checkerboard_shift;
+            int cx = int(floor(f.x*m_checkerboard_indexer.getW())) % int(m_checkerboard_indexer.getW());
+            int cy = int(floor(f.y*m_checkerboard_indexer.getH())) % int(m_checkerboard_indexer.getH());
+            int cz = int(floor(f.z*m_checkerboard_indexer.getD())) % int(m_checkerboard_indexer.getD());
+
+            // the checkerboard is periodic
+            if (cx < 0) cx += m_checkerboard_indexer.getW();
+            if (cy < 0) cy += m_checkerboard_indexer.getH();
+            if (cz < 0) cz += m_checkerboard_indexer.getD();
+            return m_checkerboard_indexer(cx, cy, cz);
+            }
+
+        #ifdef ENABLE_TBB
+        //! Seed the random number streams of one thread for the current step
+        void seedThreadRNG(ThreadRNG& rng);
+        #endif
+
         //! Test whether to reject the current particle move based on depletants
         #ifndef ENABLE_TBB
         inline bool checkDepletantOverlap(unsigned int i, vec3<Scalar> pos_i, Shape shape_i, unsigned int typ_i, Scalar d_max, Scalar d_min, Scalar4 *h_postype, Scalar4 *h_orientation, unsigned int *h_overlaps, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters, std::mt19937& rng_poisson, hoomd::detail::Saru& rng_i);
         #else
-        inline bool checkDepletantOverlap(unsigned int i, vec3<Scalar> pos_i, Shape shape_i, unsigned int typ_i, Scalar d_max, Scalar d_min, Scalar4 *h_postype, Scalar4 *h_orientation, unsigned int *h_overlaps, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters, hoomd::detail::Saru& rng_i, tbb::enumerable_thread_specific< hoomd::detail::Saru >& rng_parallel, tbb::enumerable_thread_specific<std::mt19937>& rng_parallel_mt);
+        inline bool checkDepletantOverlap(unsigned int i, vec3<Scalar> pos_i, Shape shape_i, unsigned int typ_i, Scalar d_max, Scalar d_min, Scalar4 *h_postype, Scalar4 *h_orientation, unsigned int *h_overlaps, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters, hoomd::detail::Saru& rng_i);
         #endif
 
         //! Test whether to reject the current particle move based on depletants
         #ifndef ENABLE_TBB
         inline bool checkDepletantCircumsphere(unsigned int i, vec3<Scalar> pos_i, Shape shape_i, unsigned int typ_i, Scalar d_max, Scalar d_min, Scalar4 *h_postype, Scalar4 *h_orientation, unsigned int *h_overlaps, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters, std::mt19937& rng_poisson, hoomd::detail::Saru& rng_i);
         #else
-        inline bool checkDepletantCircumsphere(unsigned int i, vec3<Scalar> pos_i, Shape shape_i, unsigned int typ_i, Scalar d_max, Scalar d_min, Scalar4 *h_postype, Scalar4 *h_orientation, unsigned int *h_overlaps, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters, hoomd::detail::Saru& rng_i, tbb::enumerable_thread_specific< hoomd::detail::Saru >& rng_parallel, tbb::enumerable_thread_specific<std::mt19937>& rng_parallel_mt);
+        inline bool checkDepletantCircumsphere(unsigned int i, vec3<Scalar> pos_i, Shape shape_i, unsigned int typ_i, Scalar d_max, Scalar d_min, Scalar4 *h_postype, Scalar4 *h_orientation, unsigned int *h_overlaps, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters, hoomd::detail::Saru& rng_i);
         #endif
 
         //! Initialize Poisson distribution parameters
@@ -233,7 +302,18 @@ IntegratorHPMCMonoImplicit< Shape >::IntegratorHPMCMonoImplicit(std::shared_ptr<
                                                                    unsigned int seed,
                                                                    unsigned int method)
     : IntegratorHPMCMono<Shape>(sysdef, seed), m_n_R(0), m_type(0), m_d_dep(0.0), m_n_trial(0),
-      m_need_initialize_poisson(true), m_method(method)
+      m_need_initialize_poisson(true), m_method(method), m_checkerboard(false), m_checkerboard_warned(false),
+      m_checkerboard_shift(make_scalar3(0,0,0))
+      #ifdef ENABLE_TBB
+      , m_rng_timestep(0), m_rng_parallel([this]
+        {
+        ThreadRNG rng;
+        std::hash<std::thread::id> hash;
+        rng.thread_hash = hash(std::this_thread::get_id());
+        seedThreadRNG(rng);
+        return rng;
+        })
+      #endif
     {
     this->m_exec_conf->msg->notice(5) << "Constructing IntegratorHPMCImplicit" << std::endl;
 
@@ -341,6 +421,184 @@ void IntegratorHPMCMonoImplicit< Shape >::updateCellWidth()
     this->m_exec_conf->msg->notice(5) << "IntegratorHPMCMonoImplicit: updating nominal width to " << this->m_nominal_width << std::endl;
     }
 
+#ifdef ENABLE_TBB
+/*! \param rng The random number streams of one thread
+
+    The seeds combine the user seed, the timestep, the rank and the thread, so that no two threads share a stream.
+*/
+template< class Shape >
+void IntegratorHPMCMonoImplicit< Shape >::seedThreadRNG(ThreadRNG& rng)
+    {
+    std::vector<unsigned int> seed_seq(5);
+    seed_seq[0] = this->m_seed;
+    seed_seq[1] = m_rng_timestep;
+    seed_seq[2] = this->m_exec_conf->getRank();
+    seed_seq[3] = rng.thread_hash;
+    std::vector<unsigned int> s(1);
+
+    seed_seq[4] = 0x6b71abc8;
+    std::seed_seq seed_saru(seed_seq.begin(), seed_seq.end());
+    seed_saru.generate(s.begin(),s.end());
+    rng.saru = hoomd::detail::Saru(s[0]);
+
+    seed_seq[4] = 0x91baff72;
+    std::seed_seq seed_mt(seed_seq.begin(), seed_seq.end());
+    seed_mt.generate(s.begin(),s.end());
+    rng.mt.seed(s[0]); // use a single seed
+    }
+#endif
+
+/*! \param timestep Current timestep
+    \returns false if the box is too small for the checkerboard
+
+    The local box is divided into an even number of cells along each dimension, and the cells are colored
+    alternately. Cells of the same color are separated by at least one cell width, which is chosen larger than the
+    extent of any interaction, depletant insertion or AABB tree query of the trial moves along the normal of the cell
+    faces, also in tilted boxes. The trial moves in cells of
+    the same color are therefore independent and are processed concurrently. The checkerboard is shifted randomly
+    every step.
+
+    The AABB tree is built from spheres that bound every position and orientation a particle can reach in this
+    step, so that it needs no updates during the step.
+*/
+template< class Shape >
+bool IntegratorHPMCMonoImplicit< Shape >::initializeCheckerboard(unsigned int timestep)
+    {
+    const BoxDim& box = this->m_pdata->getBox();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    unsigned int N = this->m_pdata->getN();
+
+    ArrayHandle<Scalar> h_d(this->m_d, access_location::host, access_mode::read);
+
+    // largest AABB query around a particle and largest AABB of a particle in the tree
+    OverlapReal R_query_max = 0.0;
+    Scalar R_tree_max = 0.0;
+    for (unsigned int typ = 0; typ < this->m_pdata->getNTypes(); typ++)
+        {
+        Shape shape(quat<Scalar>(), this->m_params[typ]);
+        OverlapReal R = shape.getCircumsphereDiameter()/OverlapReal(2.0);
+        OverlapReal R_query = R;
+        Scalar R_tree = R;
+
+        if (m_n_R > Scalar(0.0))
+            R_query = std::max(R_query, OverlapReal(R + m_d_dep));
+
+        if (this->m_patch)
+            {
+            if (!this->m_patch_log)
+                {
+                OverlapReal r_cut_patch = this->m_patch->getRCut() + 0.5*this->m_patch->getAdditiveCutoff(typ);
+                R_query = std::max(R_query, r_cut_patch - this->getMinCoreDiameter()/OverlapReal(2.0));
+                }
+            R_tree = std::max(R_tree, Scalar(0.5)*this->m_patch->getAdditiveCutoff(typ));
+            }
+
+        R_query_max = std::max(R_query_max, R_query);
+        R_tree_max = std::max(R_tree_max, R_tree + this->m_nselect*h_d.data[typ]);
+        }
+
+    // the AABB queries find all particles within R_query_max + R_tree_max in every Cartesian component. In a
+    // tilted box, the cell faces are not perpendicular to the axes, and the extent of such a query along the normal
+    // of a face is larger by the 1-norm of the unit normal.
+    Scalar xy = box.getTiltFactorXY();
+    Scalar xz = (ndim == 3) ? box.getTiltFactorXZ() : Scalar(0.0);
+    Scalar yz = (ndim == 3) ? box.getTiltFactorYZ() : Scalar(0.0);
+    Scalar3 normal_scale;
+    normal_scale.x = (Scalar(1.0) + fabs(xy) + fabs(xy*yz - xz))/sqrt(Scalar(1.0) + xy*xy + (xy*yz - xz)*(xy*yz - xz));
+    normal_scale.y = (Scalar(1.0) + fabs(yz))/sqrt(Scalar(1.0) + yz*yz);
+    normal_scale.z = Scalar(1.0);
+
+    Scalar3 width = (Scalar(R_query_max) + R_tree_max)*normal_scale;
+
+    // there is no benefit from cells smaller than the volume per particle
+    Scalar3 npd = box.getNearestPlaneDistance();
+    Scalar V = npd.x*npd.y*((ndim == 3) ? npd.z : Scalar(1.0));
+    Scalar min_width = std::max(this->m_nominal_width, pow(V/Scalar(std::max(N, 1u)), Scalar(1.0)/Scalar(ndim)));
+    width.x = std::max(width.x, min_width);
+    width.y = std::max(width.y, min_width);
+    width.z = std::max(width.z, min_width);
+
+    // an even number of cells keeps the colors alternating across the periodic boundaries
+    unsigned int nx = (unsigned int)(npd.x/width.x);
+    unsigned int ny = (unsigned int)(npd.y/width.y);
+    unsigned int nz = (ndim == 3) ? (unsigned int)(npd.z/width.z) : 1;
+    nx -= nx % 2;
+    ny -= ny % 2;
+    if (ndim == 3)
+        nz -= nz % 2;
+
+    if (nx < 2 || ny < 2 || (ndim == 3 && nz < 2))
+        {
+        if (!m_checkerboard_warned)
+            {
+            this->m_exec_conf->msg->warning() << "hpmc: Box is too small for the checkerboard, "
+                << "processing trial moves sequentially." << std::endl;
+            m_checkerboard_warned = true;
+            }
+        return false;
+        }
+
+    m_checkerboard_indexer = Index3D(nx, ny, nz);
+
+    hoomd::detail::Saru rng(timestep, this->m_seed + this->m_exec_conf->getRank(), 0x4e0c7b13);
+    m_checkerboard_shift.x = rng.s(Scalar(0.0), Scalar(1.0)/Scalar(nx));
+    m_checkerboard_shift.y = rng.s(Scalar(0.0), Scalar(1.0)/Scalar(ny));
+    m_checkerboard_shift.z = (ndim == 3) ? rng.s(Scalar(0.0), Scalar(1.0)/Scalar(nz)) : Scalar(0.0);
+
+    ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(), access_location::host, access_mode::read);
+
+    // sort the particles into the cells, keeping the shuffled order within each cell
+    unsigned int n_cells = m_checkerboard_indexer.getNumElements();
+    m_checkerboard_cell_start.assign(n_cells+1, 0);
+    m_checkerboard_particles.resize(N);
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        unsigned int cell = getCheckerboardCell(vec3<Scalar>(h_postype.data[i]), box);
+        m_checkerboard_cell_start[cell+1]++;
+        }
+
+    for (unsigned int cell = 0; cell < n_cells; cell++)
+        m_checkerboard_cell_start[cell+1] += m_checkerboard_cell_start[cell];
+
+    for (unsigned int cur_particle = 0; cur_particle < N; cur_particle++)
+        {
+        unsigned int i = this->m_update_order[cur_particle];
+        unsigned int cell = getCheckerboardCell(vec3<Scalar>(h_postype.data[i]), box);
+        m_checkerboard_particles[m_checkerboard_cell_start[cell]++] = i;
+        }
+
+    // filling the cells advanced each offset to the start of the next cell
+    for (unsigned int cell = n_cells; cell > 0; cell--)
+        m_checkerboard_cell_start[cell] = m_checkerboard_cell_start[cell-1];
+    m_checkerboard_cell_start[0] = 0;
+
+    // build the AABB tree, ghost particles are not moved
+    unsigned int n_aabb = N + this->m_pdata->getNGhosts();
+    if (n_aabb > 0)
+        {
+        this->growAABBList(n_aabb);
+        for (unsigned int i = 0; i < n_aabb; i++)
+            {
+            unsigned int typ_i = __scalar_as_int(h_postype.data[i].w);
+            Shape shape(quat<Scalar>(), this->m_params[typ_i]);
+            Scalar radius = Scalar(0.5)*shape.getCircumsphereDiameter();
+            if (this->m_patch)
+                radius = std::max(radius, Scalar(0.5)*this->m_patch->getAdditiveCutoff(typ_i));
+            if (i < N)
+                radius += this->m_nselect*h_d.data[typ_i];
+
+            this->m_aabbs[i] = detail::AABB(vec3<Scalar>(h_postype.data[i]), radius);
+            }
+        this->m_aabb_tree.buildTree(this->m_aabbs, n_aabb);
+        }
+
+    // the tree is only valid for this step
+    this->m_aabb_tree_invalid = true;
+
+    return true;
+    }
+
 template< class Shape >
 void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
     {
@@ -366,20 +624,21 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
     const BoxDim& box = this->m_pdata->getBox();
     unsigned int ndim = this->m_sysdef->getNDimensions();
 
-    #ifdef ENABLE_MPI
-    // compute the width of the active region
-    Scalar3 npd = box.getNearestPlaneDistance();
-    Scalar3 ghost_fraction = this->m_nominal_width / npd;
-    #endif
-
     // Shuffle the order of particles for this step
     this->m_update_order.resize(this->m_pdata->getN());
     this->m_update_order.shuffle(timestep);
 
-    // update the AABB Tree
-    this->buildAABBTree();
+    if (uses_overlap_witness<Shape>::value)
+        this->m_witness_cache.resize(this->m_pdata->getN());
+
     // limit m_d entries so that particles cannot possibly wander more than one box image in one time step
     this->limitMoveDistances();
+
+    // set up the checkerboard, which comes with its own AABB tree, or update the AABB Tree
+    bool checkerboard = m_checkerboard && initializeCheckerboard(timestep);
+    if (!checkerboard)
+        this->buildAABBTree();
+
     // update the image list
     this->updateImageList();
 
@@ -393,35 +652,14 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
     std::seed_seq seed(seed_seq.begin(), seed_seq.end());
     std::mt19937 rng_poisson(seed);
     #else
-    // create one RNG per thread
-    tbb::enumerable_thread_specific< hoomd::detail::Saru > rng_parallel([=]
-        {
-        std::vector<unsigned int> seed_seq(5);
-        seed_seq[0] = this->m_seed;
-        seed_seq[1] = timestep;
-        seed_seq[2] = this->m_exec_conf->getRank();
-        std::hash<std::thread::id> hash;
-        seed_seq[3] = hash(std::this_thread::get_id());
-        seed_seq[4] = 0x6b71abc8;
-        std::seed_seq seed(seed_seq.begin(), seed_seq.end());
-        std::vector<unsigned int> s(1);
-        seed.generate(s.begin(),s.end());
-        return s[0];
-        });
-    tbb::enumerable_thread_specific<std::mt19937> rng_parallel_mt([=]
-        {
-        std::vector<unsigned int> seed_seq(5);
-        seed_seq[0] = this->m_seed;
-        seed_seq[1] = timestep;
-        seed_seq[2] = this->m_exec_conf->getRank();
-        std::hash<std::thread::id> hash;
-        seed_seq[3] = hash(std::this_thread::get_id());
-        seed_seq[4] = 0x91baff72;
-        std::seed_seq seed(seed_seq.begin(), seed_seq.end());
-        std::vector<unsigned int> s(1);
-        seed.generate(s.begin(),s.end());
-        return s[0]; // use a single seed
-        });
+    // reseed the per-thread RNGs, threads that join later seed theirs on first use
+    m_rng_timestep = timestep;
+    for (auto it = m_rng_parallel.begin(); it != m_rng_parallel.end(); ++it)
+        seedThreadRNG(*it);
+
+    // counters of the trial moves processed concurrently
+    tbb::enumerable_thread_specific<hpmc_counters_t> counters_parallel;
+    tbb::enumerable_thread_specific<hpmc_implicit_counters_t> implicit_counters_parallel;
     #endif
 
     if (this->m_prof) this->m_prof->push(this->m_exec_conf, "HPMC implicit");
@@ -446,377 +684,503 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
         ArrayHandle<Scalar> h_d(this->m_d, access_location::host, access_mode::read);
         ArrayHandle<Scalar> h_a(this->m_a, access_location::host, access_mode::read);
 
-        // loop through N particles in a shuffled order
-        for (unsigned int cur_particle = 0; cur_particle < this->m_pdata->getN(); cur_particle++)
+        if (checkerboard)
             {
-            unsigned int i = this->m_update_order[cur_particle];
+            // visit the colors in a random order
+            const unsigned int n_colors = (ndim == 3) ? 8 : 4;
+            unsigned int colors[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+            hoomd::detail::Saru rng_colors(timestep, this->m_seed + this->m_exec_conf->getRank(), 0x2a7d61c5 + i_nselect);
+            for (unsigned int c = n_colors - 1; c > 0; --c)
+                std::swap(colors[c], colors[rng_colors.u32() % (c+1)]);
+
+            // every other cell along each dimension has the same color
+            Index3D color_indexer(m_checkerboard_indexer.getW()/2,
+                                  m_checkerboard_indexer.getH()/2,
+                                  (ndim == 3) ? m_checkerboard_indexer.getD()/2 : 1);
+
+            for (unsigned int cur_color = 0; cur_color < n_colors; ++cur_color)
+                {
+                unsigned int color = colors[cur_color];
 
-            // read in the current position and orientation
-            Scalar4 postype_i = h_postype.data[i];
-            Scalar4 orientation_i = h_orientation.data[i];
-            vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+                // the trial moves in cells of the same color are independent of each other
+                #ifdef ENABLE_TBB
+                tbb::parallel_for((unsigned int) 0, color_indexer.getNumElements(), [&] (unsigned int k)
+                #else
+                for (unsigned int k = 0; k < color_indexer.getNumElements(); ++k)
+                #endif
+                    {
+                    unsigned int cx = 2*(k % color_indexer.getW()) + (color & 1);
+                    unsigned int cy = 2*((k / color_indexer.getW()) % color_indexer.getH()) + ((color >> 1) & 1);
+                    unsigned int cz = 2*(k / (color_indexer.getW()*color_indexer.getH())) + ((color >> 2) & 1);
+                    unsigned int cell = m_checkerboard_indexer(cx, cy, cz);
+
+                    #ifdef ENABLE_TBB
+                    detail::PatchEnergyBatch& patch_batch = m_patch_batch_parallel.local();
+                    hpmc_counters_t& thread_counters = counters_parallel.local();
+                    hpmc_implicit_counters_t& thread_implicit_counters = implicit_counters_parallel.local();
+                    #endif
 
-            #ifdef ENABLE_MPI
-            if (this->m_comm)
+                    // process the particles in the cell sequentially, in the shuffled order
+                    for (unsigned int cur_particle = m_checkerboard_cell_start[cell];
+                         cur_particle < m_checkerboard_cell_start[cell+1]; cur_particle++)
+                        {
+                        #ifndef ENABLE_TBB
+                        attemptMove(m_checkerboard_particles[cur_particle], i_nselect, timestep, true, h_postype.data, h_orientation.data, h_diameter.data, h_charge.data, h_overlaps.data, h_d.data, h_a.data, h_d_max.data, h_d_min.data, this->m_patch_batch, counters, implicit_counters, rng_poisson);
+                        #else
+                        attemptMove(m_checkerboard_particles[cur_particle], i_nselect, timestep, true, h_postype.data, h_orientation.data, h_diameter.data, h_charge.data, h_overlaps.data, h_d.data, h_a.data, h_d_max.data, h_d_min.data, patch_batch, thread_counters, thread_implicit_counters);
+                        #endif
+                        }
+                    }
+                #ifdef ENABLE_TBB
+                    );
+                #endif
+                } // end loop over colors
+            }
+        else
+            {
+            // loop through N particles in a shuffled order
+            for (unsigned int cur_particle = 0; cur_particle < this->m_pdata->getN(); cur_particle++)
                 {
-                // only move particle if active
-                if (!isActive(make_scalar3(postype_i.x, postype_i.y, postype_i.z), box, ghost_fraction))
-                    continue;
+                #ifndef ENABLE_TBB
+                attemptMove(this->m_update_order[cur_particle], i_nselect, timestep, false, h_postype.data, h_orientation.data, h_diameter.data, h_charge.data, h_overlaps.data, h_d.data, h_a.data, h_d_max.data, h_d_min.data, this->m_patch_batch, counters, implicit_counters, rng_poisson);
+                #else
+                attemptMove(this->m_update_order[cur_particle], i_nselect, timestep, false, h_postype.data, h_orientation.data, h_diameter.data, h_charge.data, h_overlaps.data, h_d.data, h_a.data, h_d_max.data, h_d_min.data, this->m_patch_batch, counters, implicit_counters);
+                #endif
                 }
-            #endif
+            }
+        } // end loop over nselect
 
-            // make a trial move for i
-            hoomd::detail::Saru rng_i(i, this->m_seed + this->m_exec_conf->getRank()*this->m_nselect + i_nselect, timestep);
-            int typ_i = __scalar_as_int(postype_i.w);
-            Shape shape_i(quat<Scalar>(orientation_i), this->m_params[typ_i]);
-            unsigned int move_type_select = rng_i.u32() & 0xffff;
-            bool move_type_translate = !shape_i.hasOrientation() || (move_type_select < this->m_move_ratio);
+    #ifdef ENABLE_TBB
+    // add up the counters of the concurrent trial moves
+    for (auto it = counters_parallel.begin(); it != counters_parallel.end(); ++it)
+        counters = counters + *it;
+    for (auto it = implicit_counters_parallel.begin(); it != implicit_counters_parallel.end(); ++it)
+        implicit_counters = implicit_counters + *it;
+    #endif
 
-            Shape shape_old(quat<Scalar>(orientation_i), this->m_params[typ_i]);
-            vec3<Scalar> pos_old = pos_i;
+        {
+        ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<int3> h_image(this->m_pdata->getImages(), access_location::host, access_mode::readwrite);
 
-            if (move_type_translate)
-                {
-                // skip if no overlap check is required
-                if (h_d.data[typ_i] == 0.0)
-                    {
-                    if (!shape_i.ignoreStatistics())
-                        counters.translate_accept_count++;
-                    continue;
-                    }
+        // wrap particles back into box
+        for (unsigned int i = 0; i < this->m_pdata->getN(); i++)
+            {
+            box.wrap(h_postype.data[i], h_image.data[i]);
+            }
+        }
 
-                move_translate(pos_i, rng_i, h_d.data[typ_i], ndim);
+    // perform the grid shift
+    #ifdef ENABLE_MPI
+    if (this->m_comm)
+        {
+        ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<int3> h_image(this->m_pdata->getImages(), access_location::host, access_mode::readwrite);
 
-                #ifdef ENABLE_MPI
-                if (this->m_comm)
-                    {
-                    // check if particle has moved into the ghost layer, and skip if it is
-                    if (!isActive(vec_to_scalar3(pos_i), box, ghost_fraction))
-                        continue;
-                    }
-                #endif
-                }
-            else
-                {
-                if (h_a.data[typ_i] == 0.0)
-                    {
-                    if (!shape_i.ignoreStatistics())
-                        counters.rotate_accept_count++;
-                    continue;
-                    }
+        // precalculate the grid shift
+        hoomd::detail::Saru rng(timestep, this->m_seed, 0xf4a3210e);
+        Scalar3 shift = make_scalar3(0,0,0);
+        shift.x = rng.s(-this->m_nominal_width/Scalar(2.0),this->m_nominal_width/Scalar(2.0));
+        shift.y = rng.s(-this->m_nominal_width/Scalar(2.0),this->m_nominal_width/Scalar(2.0));
+        if (this->m_sysdef->getNDimensions() == 3)
+            {
+            shift.z = rng.s(-this->m_nominal_width/Scalar(2.0),this->m_nominal_width/Scalar(2.0));
+            }
+        for (unsigned int i = 0; i < this->m_pdata->getN(); i++)
+            {
+            // read in the current position and orientation
+            Scalar4 postype_i = h_postype.data[i];
+            vec3<Scalar> r_i = vec3<Scalar>(postype_i); // translation from local to global coordinates
+            r_i += vec3<Scalar>(shift);
+            h_postype.data[i] = vec_to_scalar4(r_i, postype_i.w);
+            box.wrap(h_postype.data[i], h_image.data[i]);
+            }
+        this->m_pdata->translateOrigin(shift);
+        }
+    #endif
 
-                move_rotate(shape_i.orientation, rng_i, h_a.data[typ_i], ndim);
-                }
+    if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
 
-            // check for overlaps with neighboring particle's positions
-            bool overlap=false;
-            OverlapReal r_cut_patch = 0;
+    // migrate and exchange particles
+    this->communicate(true);
 
-            if (this->m_patch && !this->m_patch_log)
-                {
-                r_cut_patch = this->m_patch->getRCut() + 0.5*this->m_patch->getAdditiveCutoff(typ_i);
-                }
-            OverlapReal R_query = std::max(shape_i.getCircumsphereDiameter()/OverlapReal(2.0), r_cut_patch-this->getMinCoreDiameter()/(OverlapReal)2.0);
-            detail::AABB aabb_i_local = detail::AABB(vec3<Scalar>(0,0,0),R_query);
+    // all particle have been moved, the aabb tree is now invalid
+    this->m_aabb_tree_invalid = true;
+    }
 
-            // patch + field interaction deltaU
-            double patch_field_energy_diff = 0;
+/*! \param i The particle to move
+    \param i_nselect The current sweep over the particles
+    \param timestep The current timestep
+    \param checkerboard True if the trial moves are processed in the cells of the checkerboard
+    \param h_postype Pointer to GPUArray containing particle positions
+    \param h_orientation Pointer to GPUArray containing particle orientations
+    \param h_diameter Pointer to GPUArray containing particle diameters
+    \param h_charge Pointer to GPUArray containing particle charges
+    \param h_overlaps Pointer to GPUArray containing interaction matrix
+    \param h_d Pointer to GPUArray containing maximum translation move sizes
+    \param h_a Pointer to GPUArray containing maximum rotation move sizes
+    \param h_d_max Pointer to GPUArray containing maximum spheres for test depletant exclusion
+    \param h_d_min Pointer to GPUArray containing minimum spheres in which depletants may be inserted
+    \param patch_batch Buffer for the neighbors in the patch energy cutoff
+    \param hpmc_counters_t&  Pointer to current counters
+    \param hpmc_implicit_counters_t&  Pointer to current implicit counters
+    \param rng_poisson The RNG used for the number of depletants
 
-            // All image boxes (including the primary)
-            const unsigned int n_images = this->m_image_list.size();
-            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
-                {
-                vec3<Scalar> pos_i_image = pos_i + this->m_image_list[cur_image];
-                detail::AABB aabb = aabb_i_local;
-                aabb.translate(pos_i_image);
+    With the checkerboard, particles cannot leave their cell, and the AABB tree is not updated, because it is read by
+    the trial moves in the other cells of the same color at the same time.
+    */
+#ifndef ENABLE_TBB
+template<class Shape>
+inline void IntegratorHPMCMonoImplicit<Shape>::attemptMove(unsigned int i, unsigned int i_nselect, unsigned int timestep, bool checkerboard, Scalar4 *h_postype, Scalar4 *h_orientation, Scalar *h_diameter, Scalar *h_charge, unsigned int *h_overlaps, Scalar *h_d, Scalar *h_a, Scalar *h_d_max, Scalar *h_d_min, detail::PatchEnergyBatch& patch_batch, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters, std::mt19937& rng_poisson)
+#else
+template<class Shape>
+inline void IntegratorHPMCMonoImplicit<Shape>::attemptMove(unsigned int i, unsigned int i_nselect, unsigned int timestep, bool checkerboard, Scalar4 *h_postype, Scalar4 *h_orientation, Scalar *h_diameter, Scalar *h_charge, unsigned int *h_overlaps, Scalar *h_d, Scalar *h_a, Scalar *h_d_max, Scalar *h_d_min, detail::PatchEnergyBatch& patch_batch, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters)
+#endif
+    {
+    const BoxDim& box = this->m_pdata->getBox();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
 
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes(); cur_node_idx++)
-                    {
-                    if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
-                        {
-                        if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
-                            {
-                            for (unsigned int cur_p = 0; cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
-                                {
-                                // read in its position and orientation
-                                unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+    #ifdef ENABLE_MPI
+    // compute the width of the active region
+    Scalar3 npd = box.getNearestPlaneDistance();
+    Scalar3 ghost_fraction = this->m_nominal_width / npd;
+    #endif
 
-                                Scalar4 postype_j;
-                                Scalar4 orientation_j;
+    // read in the current position and orientation
+    Scalar4 postype_i = h_postype[i];
+    Scalar4 orientation_i = h_orientation[i];
+    vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
 
-                                // handle j==i situations
-                                if ( j != i )
-                                    {
-                                    // load the position and orientation of the j particle
-                                    postype_j = h_postype.data[j];
-                                    orientation_j = h_orientation.data[j];
-                                    }
-                                else
-                                    {
-                                    if (cur_image == 0)
-                                        {
-                                        // in the first image, skip i == j
-                                        continue;
-                                        }
-                                    else
-                                        {
-                                        // If this is particle i and we are in an outside image, use the translated position and orientation
-                                        postype_j = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
-                                        orientation_j = quat_to_scalar4(shape_i.orientation);
-                                        }
-                                    }
+    #ifdef ENABLE_MPI
+    if (this->m_comm)
+        {
+        // only move particle if active
+        if (!isActive(make_scalar3(postype_i.x, postype_i.y, postype_i.z), box, ghost_fraction))
+            return;
+        }
+    #endif
 
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+    // make a trial move for i
+    hoomd::detail::Saru rng_i(i, this->m_seed + this->m_exec_conf->getRank()*this->m_nselect + i_nselect, timestep);
+    int typ_i = __scalar_as_int(postype_i.w);
+    Shape shape_i(quat<Scalar>(orientation_i), this->m_params[typ_i]);
+    unsigned int move_type_select = rng_i.u32() & 0xffff;
+    bool move_type_translate = !shape_i.hasOrientation() || (move_type_select < this->m_move_ratio);
 
-                                unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                Shape shape_j(quat<Scalar>(orientation_j), this->m_params[typ_j]);
+    Shape shape_old(quat<Scalar>(orientation_i), this->m_params[typ_i]);
+    vec3<Scalar> pos_old = pos_i;
 
-                                counters.overlap_checks++;
+    if (move_type_translate)
+        {
+        // skip if no overlap check is required
+        if (h_d[typ_i] == 0.0)
+            {
+            if (!shape_i.ignoreStatistics())
+                counters.translate_accept_count++;
+            return;
+            }
 
-                                // check circumsphere overlap
-                                OverlapReal rsq = dot(r_ij,r_ij);
-                                OverlapReal DaDb = shape_i.getCircumsphereDiameter() + shape_j.getCircumsphereDiameter();
-                                bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+        move_translate(pos_i, rng_i, h_d[typ_i], ndim);
 
-                                Scalar r_cut_ij = 0.0;
-                                if (this->m_patch)
-                                    r_cut_ij = r_cut_patch + 0.5*this->m_patch->getAdditiveCutoff(typ_j);
+        #ifdef ENABLE_MPI
+        if (this->m_comm)
+            {
+            // check if particle has moved into the ghost layer, and skip if it is
+            if (!isActive(vec_to_scalar3(pos_i), box, ghost_fraction))
+                return;
+            }
+        #endif
 
-                                if (h_overlaps.data[this->m_overlap_idx(typ_i,typ_j)]
-                                    && circumsphere_overlap
-                                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
-                                    {
-                                    overlap = true;
-                                    break;
-                                    }
-                                // If there is no overlap and m_patch is not NULL, calculate energy
-                                else if (this->m_patch && !this->m_patch_log && rsq <= r_cut_ij*r_cut_ij)
-                                    {
-                                    patch_field_energy_diff -= this->m_patch->energy(r_ij, typ_i,
-                                                               quat<float>(shape_i.orientation),
-                                                               h_diameter.data[i],
-                                                               h_charge.data[i],
-                                                               typ_j,
-                                                               quat<float>(orientation_j),
-                                                               h_diameter.data[j],
-                                                               h_charge.data[j]
-                                                               );
-                                    }
-                                }
-                            }
-                        }
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
-                        }
+        if (checkerboard && getCheckerboardCell(pos_i, box) != getCheckerboardCell(pos_old, box))
+            {
+            // particles are confined to their cell, so that the moves in cells of one color remain independent
+            if (!shape_i.ignoreStatistics())
+                counters.translate_reject_count++;
+            return;
+            }
+        }
+    else
+        {
+        if (h_a[typ_i] == 0.0)
+            {
+            if (!shape_i.ignoreStatistics())
+                counters.rotate_accept_count++;
+            return;
+            }
 
-                    if (overlap)
-                        break;
-                    }  // end loop over AABB nodes
+        move_rotate(shape_i.orientation, rng_i, h_a[typ_i], ndim);
+        }
 
-                if (overlap)
-                    break;
+    // check for overlaps with neighboring particle's positions
+    bool overlap=false;
+    OverlapReal r_cut_patch = 0;
 
-                } // end loop over images
+    if (this->m_patch && !this->m_patch_log)
+        {
+        r_cut_patch = this->m_patch->getRCut() + 0.5*this->m_patch->getAdditiveCutoff(typ_i);
+        }
+    OverlapReal R_query = std::max(shape_i.getCircumsphereDiameter()/OverlapReal(2.0), r_cut_patch-this->getMinCoreDiameter()/(OverlapReal)2.0);
+    detail::AABB aabb_i_local = detail::AABB(vec3<Scalar>(0,0,0),R_query);
 
-            // whether the move is accepted
-            bool accept = !overlap;
+    // patch + field interaction deltaU
+    double patch_field_energy_diff = 0;
+
+    // neighbors within the patch cutoff are collected and evaluated together after the overlap check
+    patch_batch.clear();
+
+    // All image boxes (including the primary)
+    const unsigned int n_images = this->m_image_list.size();
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_i_image = pos_i + this->m_image_list[cur_image];
+        detail::AABB aabb = aabb_i_local;
+        aabb.translate(pos_i_image);
 
-            // In most cases checking patch energy should be cheaper than computing
-            // depletants, so do that first. Calculate old patch energy only if
-            // m_patch not NULL and no overlaps. Note that we are computing U_old-U_new
-            // and then exponentiating directly (rather than exp(-(U_new-U_old)))
-            if (this->m_patch && !this->m_patch_log && accept)
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes(); cur_node_idx++)
+            {
+            if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
                 {
-                for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+                if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
                     {
-                    vec3<Scalar> pos_i_image = pos_old + this->m_image_list[cur_image];
-                    detail::AABB aabb = aabb_i_local;
-                    aabb.translate(pos_i_image);
-
-                    // stackless search
-                    for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes(); cur_node_idx++)
+                    for (unsigned int cur_p = 0; cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
                         {
-                        if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                        // read in its position and orientation
+                        unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        Scalar4 postype_j;
+                        Scalar4 orientation_j;
+
+                        // handle j==i situations
+                        if ( j != i )
                             {
-                            if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                            // load the position and orientation of the j particle
+                            postype_j = h_postype[j];
+                            orientation_j = h_orientation[j];
+                            }
+                        else
+                            {
+                            if (cur_image == 0)
                                 {
-                                for (unsigned int cur_p = 0; cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
-                                    {
-                                    // read in its position and orientation
-                                    unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+                                // in the first image, skip i == j
+                                continue;
+                                }
+                            else
+                                {
+                                // If this is particle i and we are in an outside image, use the translated position and orientation
+                                postype_j = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+                                orientation_j = quat_to_scalar4(shape_i.orientation);
+                                }
+                            }
 
-                                    Scalar4 postype_j;
-                                    Scalar4 orientation_j;
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
 
-                                    // handle j==i situations
-                                    if ( j != i )
-                                        {
-                                        // load the position and orientation of the j particle
-                                        postype_j = h_postype.data[j];
-                                        orientation_j = h_orientation.data[j];
-                                        }
-                                    else
-                                        {
-                                        if (cur_image == 0)
-                                            {
-                                            // in the first image, skip i == j
-                                            continue;
-                                            }
-                                        else
-                                            {
-                                            // If this is particle i and we are in an outside image, use the translated position and orientation
-                                            postype_j = make_scalar4(pos_old.x, pos_old.y, pos_old.z, postype_i.w);
-                                            orientation_j = quat_to_scalar4(shape_old.orientation);
-                                            }
-                                        }
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        Shape shape_j(quat<Scalar>(orientation_j), this->m_params[typ_j]);
 
-                                    // put particles in coordinate system of particle i
-                                    vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
-                                    unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                    Shape shape_j(quat<Scalar>(orientation_j), this->m_params[typ_j]);
-                                    if (dot(r_ij,r_ij) <= r_cut_patch*r_cut_patch)
-                                        patch_field_energy_diff += this->m_patch->energy(r_ij,
-                                                                   typ_i,
-                                                                   quat<float>(orientation_i),
-                                                                   h_diameter.data[i],
-                                                                   h_charge.data[i],
-                                                                   typ_j,
-                                                                   quat<float>(orientation_j),
-                                                                   h_diameter.data[j],
-                                                                   h_charge.data[j]);
-                                    }
-                                }
+                        counters.overlap_checks++;
+
+                        // check circumsphere overlap
+                        OverlapReal rsq = dot(r_ij,r_ij);
+                        OverlapReal DaDb = shape_i.getCircumsphereDiameter() + shape_j.getCircumsphereDiameter();
+                        bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+
+                        Scalar r_cut_ij = 0.0;
+                        if (this->m_patch)
+                            r_cut_ij = r_cut_patch + 0.5*this->m_patch->getAdditiveCutoff(typ_j);
+
+                        if (h_overlaps[this->m_overlap_idx(typ_i,typ_j)]
+                            && circumsphere_overlap
+                            && this->testOverlapMove(i, j, r_ij, shape_i, shape_j, counters.overlap_err_count))
+                            {
+                            overlap = true;
+                            break;
                             }
-                        else
+                        // If there is no overlap and m_patch is not NULL, record the neighbor
+                        else if (this->m_patch && !this->m_patch_log && rsq <= r_cut_ij*r_cut_ij)
                             {
-                            // skip ahead
-                            cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                            patch_batch.push_back(vec3<float>(r_ij),
+                                                          typ_j,
+                                                          quat<float>(orientation_j),
+                                                          h_diameter[j],
+                                                          h_charge[j]);
                             }
-                        }  // end loop over AABB nodes
-                    } // end loop over images
-                } // end if (m_patch)
-
-            // Add external energetic contribution
-            if (this->m_external)
+                        }
+                    }
+                }
+            else
                 {
-                patch_field_energy_diff -= this->m_external->energydiff(i, pos_old, shape_old, pos_i, shape_i);
+                // skip ahead
+                cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
                 }
 
-            accept = accept && (rng_i.d() < slow::exp(patch_field_energy_diff));
+            if (overlap)
+                break;
+            }  // end loop over AABB nodes
+
+        if (overlap)
+            break;
+
+        } // end loop over images
+
+    // whether the move is accepted
+    bool accept = !overlap;
 
-            // If no overlaps and Metropolis criterion is met, check if it is
-            // invalidated by depletants.
-            if (accept && h_overlaps.data[this->m_overlap_idx(m_type, typ_i)])
+    // In most cases checking patch energy should be cheaper than computing
+    // depletants, so do that first. Calculate old patch energy only if
+    // m_patch not NULL and no overlaps. Note that we are computing U_old-U_new
+    // and then exponentiating directly (rather than exp(-(U_new-U_old)))
+    if (this->m_patch && !this->m_patch_log && accept)
+        {
+        patch_field_energy_diff -= patch_batch.evaluate(*this->m_patch,
+                                                                typ_i,
+                                                                quat<float>(shape_i.orientation),
+                                                                h_diameter[i],
+                                                                h_charge[i]);
+
+        patch_batch.clear();
+        for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+            {
+            vec3<Scalar> pos_i_image = pos_old + this->m_image_list[cur_image];
+            detail::AABB aabb = aabb_i_local;
+            aabb.translate(pos_i_image);
+
+            // stackless search
+            for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes(); cur_node_idx++)
                 {
-                if (m_method == 0)
+                if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
                     {
-                    // check free volume in circumsphere
-                    #ifndef ENABLE_TBB
-                    accept = checkDepletantCircumsphere(i, pos_i, shape_i, typ_i, h_d_max.data[typ_i], h_d_min.data[typ_i], h_postype.data, h_orientation.data, h_overlaps.data, counters, implicit_counters, rng_poisson, rng_i);
-                    #else
-                    accept = checkDepletantCircumsphere(i, pos_i, shape_i, typ_i, h_d_max.data[typ_i], h_d_min.data[typ_i], h_postype.data, h_orientation.data, h_overlaps.data, counters, implicit_counters, rng_i, rng_parallel, rng_parallel_mt);
-                    #endif
+                    if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                        {
+                        for (unsigned int cur_p = 0; cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                            {
+                            // read in its position and orientation
+                            unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                            Scalar4 postype_j;
+                            Scalar4 orientation_j;
+
+                            // handle j==i situations
+                            if ( j != i )
+                                {
+                                // load the position and orientation of the j particle
+                                postype_j = h_postype[j];
+                                orientation_j = h_orientation[j];
+                                }
+                            else
+                                {
+                                if (cur_image == 0)
+                                    {
+                                    // in the first image, skip i == j
+                                    continue;
+                                    }
+                                else
+                                    {
+                                    // If this is particle i and we are in an outside image, use the translated position and orientation
+                                    postype_j = make_scalar4(pos_old.x, pos_old.y, pos_old.z, postype_i.w);
+                                    orientation_j = quat_to_scalar4(shape_old.orientation);
+                                    }
+                                }
+
+                            // put particles in coordinate system of particle i
+                            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                            unsigned int typ_j = __scalar_as_int(postype_j.w);
+                            Shape shape_j(quat<Scalar>(orientation_j), this->m_params[typ_j]);
+                            if (dot(r_ij,r_ij) <= r_cut_patch*r_cut_patch)
+                                patch_batch.push_back(vec3<float>(r_ij),
+                                                              typ_j,
+                                                              quat<float>(orientation_j),
+                                                              h_diameter[j],
+                                                              h_charge[j]);
+                            }
+                        }
                     }
                 else
                     {
-                    // check overlap volume only
-                    #ifndef ENABLE_TBB
-                    accept = checkDepletantOverlap(i, pos_i, shape_i, typ_i, h_d_max.data[typ_i], h_d_min.data[typ_i], h_postype.data, h_orientation.data, h_overlaps.data, counters, implicit_counters, rng_poisson, rng_i);
-                    #else
-                    accept = checkDepletantOverlap(i, pos_i, shape_i, typ_i, h_d_max.data[typ_i], h_d_min.data[typ_i], h_postype.data, h_orientation.data, h_overlaps.data, counters, implicit_counters, rng_i, rng_parallel, rng_parallel_mt);
-                    #endif
+                    // skip ahead
+                    cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
                     }
-                } // end depletant placement
+                }  // end loop over AABB nodes
+            } // end loop over images
 
-            // if the move is accepted
-            if (accept)
-                {
-                // increment accept counter and assign new position
-                if (!shape_i.ignoreStatistics())
-                  {
-                  if (move_type_translate)
-                      counters.translate_accept_count++;
-                  else
-                      counters.rotate_accept_count++;
-                  }
-                // update the position of the particle in the tree for future updates
-                detail::AABB aabb = aabb_i_local;
-                aabb.translate(pos_i);
-                this->m_aabb_tree.update(i, aabb);
-
-                // update position of particle
-                h_postype.data[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
-
-                if (shape_i.hasOrientation())
-                    {
-                    h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
-                    }
-                }
-             else
-                {
-                if (!shape_i.ignoreStatistics())
-                    {
-                    // increment reject counter
-                    if (move_type_translate)
-                        counters.translate_reject_count++;
-                    else
-                        counters.rotate_reject_count++;
-                    }
-                }
-            } // end loop over all particles
-        } // end loop over nselect
+        patch_field_energy_diff += patch_batch.evaluate(*this->m_patch,
+                                                                typ_i,
+                                                                quat<float>(orientation_i),
+                                                                h_diameter[i],
+                                                                h_charge[i]);
+        } // end if (m_patch)
 
+    // Add external energetic contribution
+    if (this->m_external)
         {
-        ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(), access_location::host, access_mode::readwrite);
-        ArrayHandle<int3> h_image(this->m_pdata->getImages(), access_location::host, access_mode::readwrite);
+        patch_field_energy_diff -= this->m_external->energydiff(i, pos_old, shape_old, pos_i, shape_i);
+        }
 
-        // wrap particles back into box
-        for (unsigned int i = 0; i < this->m_pdata->getN(); i++)
+    accept = accept && (rng_i.d() < slow::exp(patch_field_energy_diff));
+
+    // If no overlaps and Metropolis criterion is met, check if it is
+    // invalidated by depletants.
+    if (accept && h_overlaps[this->m_overlap_idx(m_type, typ_i)])
+        {
+        if (m_method == 0)
             {
-            box.wrap(h_postype.data[i], h_image.data[i]);
+            // check free volume in circumsphere
+            #ifndef ENABLE_TBB
+            accept = checkDepletantCircumsphere(i, pos_i, shape_i, typ_i, h_d_max[typ_i], h_d_min[typ_i], h_postype, h_orientation, h_overlaps, counters, implicit_counters, rng_poisson, rng_i);
+            #else
+            accept = checkDepletantCircumsphere(i, pos_i, shape_i, typ_i, h_d_max[typ_i], h_d_min[typ_i], h_postype, h_orientation, h_overlaps, counters, implicit_counters, rng_i);
+            #endif
             }
-        }
+        else
+            {
+            // check overlap volume only
+            #ifndef ENABLE_TBB
+            accept = checkDepletantOverlap(i, pos_i, shape_i, typ_i, h_d_max[typ_i], h_d_min[typ_i], h_postype, h_orientation, h_overlaps, counters, implicit_counters, rng_poisson, rng_i);
+            #else
+            accept = checkDepletantOverlap(i, pos_i, shape_i, typ_i, h_d_max[typ_i], h_d_min[typ_i], h_postype, h_orientation, h_overlaps, counters, implicit_counters, rng_i);
+            #endif
+            }
+        } // end depletant placement
 
-    // perform the grid shift
-    #ifdef ENABLE_MPI
-    if (this->m_comm)
+    // if the move is accepted
+    if (accept)
         {
-        ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(), access_location::host, access_mode::readwrite);
-        ArrayHandle<int3> h_image(this->m_pdata->getImages(), access_location::host, access_mode::readwrite);
+        // increment accept counter and assign new position
+        if (!shape_i.ignoreStatistics())
+          {
+          if (move_type_translate)
+              counters.translate_accept_count++;
+          else
+              counters.rotate_accept_count++;
+          }
+        // update the position of the particle in the tree for future updates, with the checkerboard the tree
+        // already bounds all positions the particle can reach in this step and is shared between threads
+        if (!checkerboard)
+            {
+            detail::AABB aabb = aabb_i_local;
+            aabb.translate(pos_i);
+            this->m_aabb_tree.update(i, aabb);
+            }
 
-        // precalculate the grid shift
-        hoomd::detail::Saru rng(timestep, this->m_seed, 0xf4a3210e);
-        Scalar3 shift = make_scalar3(0,0,0);
-        shift.x = rng.s(-this->m_nominal_width/Scalar(2.0),this->m_nominal_width/Scalar(2.0));
-        shift.y = rng.s(-this->m_nominal_width/Scalar(2.0),this->m_nominal_width/Scalar(2.0));
-        if (this->m_sysdef->getNDimensions() == 3)
+        // update position of particle
+        h_postype[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
+
+        if (shape_i.hasOrientation())
             {
-            shift.z = rng.s(-this->m_nominal_width/Scalar(2.0),this->m_nominal_width/Scalar(2.0));
+            h_orientation[i] = quat_to_scalar4(shape_i.orientation);
             }
-        for (unsigned int i = 0; i < this->m_pdata->getN(); i++)
+        }
+    else
+        {
+        if (!shape_i.ignoreStatistics())
             {
-            // read in the current position and orientation
-            Scalar4 postype_i = h_postype.data[i];
-            vec3<Scalar> r_i = vec3<Scalar>(postype_i); // translation from local to global coordinates
-            r_i += vec3<Scalar>(shift);
-            h_postype.data[i] = vec_to_scalar4(r_i, postype_i.w);
-            box.wrap(h_postype.data[i], h_image.data[i]);
+            // increment reject counter
+            if (move_type_translate)
+                counters.translate_reject_count++;
+            else
+                counters.rotate_reject_count++;
             }
-        this->m_pdata->translateOrigin(shift);
         }
-    #endif
-
-    if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
-
-    // migrate and exchange particles
-    this->communicate(true);
-
-    // all particle have been moved, the aabb tree is now invalid
-    this->m_aabb_tree_invalid = true;
     }
 
 
@@ -844,7 +1208,7 @@ template<class Shape>
 inline bool IntegratorHPMCMonoImplicit<Shape>::checkDepletantCircumsphere(unsigned int i, vec3<Scalar> pos_i, Shape shape_i, unsigned int typ_i, Scalar d_max, Scalar d_min, Scalar4 *h_postype, Scalar4 *h_orientation, unsigned int *h_overlaps, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters, std::mt19937& rng_poisson, hoomd::detail::Saru& rng_i)
 #else
 template<class Shape>
-inline bool IntegratorHPMCMonoImplicit<Shape>::checkDepletantCircumsphere(unsigned int i, vec3<Scalar> pos_i, Shape shape_i, unsigned int typ_i, Scalar d_max, Scalar d_min, Scalar4 *h_postype, Scalar4 *h_orientation, unsigned int *h_overlaps, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters, hoomd::detail::Saru& rng_i, tbb::enumerable_thread_specific< hoomd::detail::Saru >& rng_parallel, tbb::enumerable_thread_specific<std::mt19937>& rng_parallel_mt)
+inline bool IntegratorHPMCMonoImplicit<Shape>::checkDepletantCircumsphere(unsigned int i, vec3<Scalar> pos_i, Shape shape_i, unsigned int typ_i, Scalar d_max, Scalar d_min, Scalar4 *h_postype, Scalar4 *h_orientation, unsigned int *h_overlaps, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters, hoomd::detail::Saru& rng_i)
 #endif
     {
     // log of acceptance probability
@@ -858,7 +1222,7 @@ inline bool IntegratorHPMCMonoImplicit<Shape>::checkDepletantCircumsphere(unsign
 
     // draw number from Poisson distribution
     #ifdef ENABLE_TBB
-    std::mt19937& rng_poisson = rng_parallel_mt.local();
+    std::mt19937& rng_poisson = m_rng_parallel.local().mt;
     #endif
 
     unsigned int n = 0;
@@ -908,7 +1272,7 @@ inline bool IntegratorHPMCMonoImplicit<Shape>::checkDepletantCircumsphere(unsign
         quat<Scalar> orientation_test;
 
         #ifdef ENABLE_TBB
-        hoomd::detail::Saru& my_rng = rng_parallel.local();
+        hoomd::detail::Saru& my_rng = m_rng_parallel.local().saru;
         #else
         hoomd::detail::Saru& my_rng = rng_i;
         #endif
@@ -1240,7 +1604,7 @@ template<class Shape>
 inline bool IntegratorHPMCMonoImplicit<Shape>::checkDepletantOverlap(unsigned int i, vec3<Scalar> pos_i, Shape shape_i, unsigned int typ_i, Scalar d_max, Scalar d_min, Scalar4 *h_postype, Scalar4 *h_orientation, unsigned int *h_overlaps, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters, std::mt19937& rng_poisson, hoomd::detail::Saru& rng_i)
 #else
 template<class Shape>
-inline bool IntegratorHPMCMonoImplicit<Shape>::checkDepletantOverlap(unsigned int i, vec3<Scalar> pos_i, Shape shape_i, unsigned int typ_i, Scalar d_max, Scalar d_min, Scalar4 *h_postype, Scalar4 *h_orientation, unsigned int *h_overlaps, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters, hoomd::detail::Saru& rng_i, tbb::enumerable_thread_specific< hoomd::detail::Saru >& rng_parallel, tbb::enumerable_thread_specific<std::mt19937>& rng_parallel_mt)
+inline bool IntegratorHPMCMonoImplicit<Shape>::checkDepletantOverlap(unsigned int i, vec3<Scalar> pos_i, Shape shape_i, unsigned int typ_i, Scalar d_max, Scalar d_min, Scalar4 *h_postype, Scalar4 *h_orientation, unsigned int *h_overlaps, hpmc_counters_t& counters, hpmc_implicit_counters_t& implicit_counters, hoomd::detail::Saru& rng_i)
 #endif
     {
     // List of particles whose circumspheres intersect particle i's excluded-volume circumsphere
@@ -1370,8 +1734,8 @@ inline bool IntegratorHPMCMonoImplicit<Shape>::checkDepletantOverlap(unsigned in
         // chooose the number of depletants in the intersection volume
         std::poisson_distribution<unsigned int> poisson(m_n_R*V);
         #ifdef ENABLE_TBB
-        std::mt19937& rng_poisson = rng_parallel_mt.local();
-        hoomd::detail::Saru& my_rng = rng_parallel.local();
+        std::mt19937& rng_poisson = m_rng_parallel.local().mt;
+        hoomd::detail::Saru& my_rng = m_rng_parallel.local().saru;
         #else
         hoomd::detail::Saru& my_rng = rng_i;
         #endif
@@ -1989,6 +2353,8 @@ template < class Shape > void export_IntegratorHPMCMonoImplicit(pybind11::module
         .def("setDepletantDensity", &IntegratorHPMCMonoImplicit<Shape>::setDepletantDensity)
         .def("setDepletantType", &IntegratorHPMCMonoImplicit<Shape>::setDepletantType)
         .def("setNTrial", &IntegratorHPMCMonoImplicit<Shape>::setNTrial)
+        .def("setCheckerboard", &IntegratorHPMCMonoImplicit<Shape>::setCheckerboard)
+        .def("getCheckerboard", &IntegratorHPMCMonoImplicit<Shape>::getCheckerboard)
         .def("getNTrial", &IntegratorHPMCMonoImplicit<Shape>::getNTrial)
         .def("getImplicitCounters", &IntegratorHPMCMonoImplicit<Shape>::getImplicitCounters)
         ;
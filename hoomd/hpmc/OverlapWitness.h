@@ -0,0 +1,176 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+#include "ShapeSphere.h"    //< For the base template of test_overlap
+
+#ifndef __OVERLAP_WITNESS_H__
+#define __OVERLAP_WITNESS_H__
+
+/*! \file OverlapWitness.h
+    \brief Defines the cache of overlapping parts between successive overlap checks of the same particles
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __device__ when included in nvcc and blank when included into the host compiler
+#ifdef NVCC
+#define DEVICE __device__
+#else
+#define DEVICE
+#include <vector>
+#endif
+
+namespace hpmc
+{
+
+namespace detail
+{
+
+//! Pair of parts of two composite shapes that overlapped in the last overlap check
+/*! Successive overlap checks of the same pair of particles in HPMC differ only by a small trial move. A composite
+    shape records the pair of tree nodes that proved the overlap, together with the relative position and orientation
+    of the shapes, and tests that node pair first in the next check. The witness is only tried while the shapes have
+    moved relative to each other by less than the tolerance.
+
+    A witness is only a hint, any node pair that overlaps proves the overlap of the shapes. Stale witnesses, e.g. after
+    the particles have been reordered, cost one extra test but never change the result.
+*/
+struct OverlapWitness
+    {
+    //! Construct an empty witness
+    DEVICE OverlapWitness()
+        : node_a(0), node_b(0), tolerance(0)
+        {
+        }
+
+    //! Check if the witness is worth testing in the given configuration
+    /*! \param _r Position of shape a in the frame of shape b
+        \param _q Orientation of shape a in the frame of shape b
+        \param diameter Circumsphere diameter of shape a
+    */
+    DEVICE bool isValid(const vec3<OverlapReal>& _r, const quat<OverlapReal>& _q, OverlapReal diameter) const
+        {
+        if (tolerance == OverlapReal(0.0))
+            return false;
+
+        // displacement of the center
+        vec3<OverlapReal> dr = _r - r;
+        OverlapReal dr_sq = dot(dr, dr);
+        if (dr_sq >= tolerance*tolerance)
+            return false;
+
+        // displacement of the surface by the rotation, the chord between the unit quaternions is half the angle
+        OverlapReal cos_half = fabs(_q.s*q.s + dot(_q.v, q.v));
+        OverlapReal chord = fast::sqrt(detail::max(OverlapReal(2.0)*(OverlapReal(1.0) - cos_half), OverlapReal(0.0)));
+        return fast::sqrt(dr_sq) + diameter*chord < tolerance;
+        }
+
+    //! Record the overlapping node pair
+    DEVICE void set(unsigned int _node_a, unsigned int _node_b, const vec3<OverlapReal>& _r,
+        const quat<OverlapReal>& _q, OverlapReal _tolerance)
+        {
+        node_a = _node_a;
+        node_b = _node_b;
+        r = _r;
+        q = _q;
+        tolerance = _tolerance;
+        }
+
+    unsigned int node_a;     //!< Node of shape a
+    unsigned int node_b;     //!< Node of shape b
+    vec3<OverlapReal> r;     //!< Position of shape a in the frame of shape b when recorded
+    quat<OverlapReal> q;     //!< Orientation of shape a in the frame of shape b when recorded
+    OverlapReal tolerance;   //!< Relative displacement up to which the witness is tested, 0 if empty
+    };
+
+#ifndef NVCC
+//! Overlap witnesses of the recently overlapping neighbors of each particle
+/*! Each particle remembers the witnesses of up to n_slots neighbors and replaces them round robin. Only the particle
+    being moved writes to its slots, so that trial moves of different particles may run concurrently.
+*/
+class OverlapWitnessCache
+    {
+    public:
+        //! Number of neighbors remembered per particle
+        static const unsigned int n_slots = 4;
+
+        //! Set the number of particles, forgetting all witnesses if it changes
+        void resize(unsigned int N)
+            {
+            if (m_neighbor.size() != N*n_slots)
+                {
+                m_neighbor.assign(N*n_slots, 0xffffffff);
+                m_witness.assign(N*n_slots, OverlapWitness());
+                m_next.assign(N, 0);
+                }
+            }
+
+        //! Get the witness of the pair i,j
+        /*! \returns An empty witness if the pair is not in the cache
+        */
+        OverlapWitness find(unsigned int i, unsigned int j) const
+            {
+            for (unsigned int k = i*n_slots; k < (i+1)*n_slots; ++k)
+                {
+                if (m_neighbor[k] == j)
+                    return m_witness[k];
+                }
+            return OverlapWitness();
+            }
+
+        //! Store the witness of the pair i,j, or remove the pair if the witness is empty
+        void store(unsigned int i, unsigned int j, const OverlapWitness& witness)
+            {
+            for (unsigned int k = i*n_slots; k < (i+1)*n_slots; ++k)
+                {
+                if (m_neighbor[k] == j)
+                    {
+                    m_witness[k] = witness;
+                    if (witness.tolerance == OverlapReal(0.0))
+                        m_neighbor[k] = 0xffffffff;
+                    return;
+                    }
+                }
+
+            if (witness.tolerance == OverlapReal(0.0))
+                return;
+
+            unsigned int k = i*n_slots + m_next[i];
+            m_next[i] = (m_next[i] + 1) % n_slots;
+            m_neighbor[k] = j;
+            m_witness[k] = witness;
+            }
+
+    private:
+        std::vector<unsigned int> m_neighbor;    //!< Neighbor of each slot
+        std::vector<OverlapWitness> m_witness;   //!< Witness of each slot
+        std::vector<unsigned int> m_next;        //!< Next slot to replace per particle
+    };
+#endif
+
+} // end namespace detail
+
+//! Flags shapes that record overlap witnesses
+/*! Specialize this for shapes that implement test_overlap() with an OverlapWitness argument.
+*/
+template<class Shape>
+struct uses_overlap_witness
+    {
+    static const bool value = false;
+    };
+
+//! Overlap check that uses a witness from the last check of the same pair
+/*! The default implementation ignores the witness.
+*/
+template <class ShapeA, class ShapeB>
+DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab, const ShapeA &a, const ShapeB& b, unsigned int& err,
+    detail::OverlapWitness& witness)
+    {
+    return test_overlap(r_ab, a, b, err);
+    }
+
+} // end namespace hpmc
+
+#undef DEVICE
+#endif // __OVERLAP_WITNESS_H__
@@ -8,6 +8,7 @@
 #include "ShapeSpheropolyhedron.h"
 #include "ShapeConvexPolyhedron.h"
 #include "GPUTree.h"
+#include "OverlapWitness.h"
 
 #include "hoomd/ManagedArray.h"
 
@@ -339,6 +340,80 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     return false;
     }
 
+//! ShapeUnion records the overlapping pair of leaf nodes
+template<class Shape>
+struct uses_overlap_witness< ShapeUnion<Shape> >
+    {
+    static const bool value = true;
+    };
+
+//! Overlap check that tests the overlapping pair of leaf nodes from the last check first
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param err Incremented if there is an error condition. Left unchanged otherwise.
+    \param witness Leaf nodes that overlapped in the last check of the same particles, updated on return
+    \returns true when *a* and *b* overlap, and false when they are disjoint
+
+    The witness is tested while the relative displacement since it was recorded is smaller than the smallest half
+    axis of the two leaf OBBs. When it fails, the trees are traversed in tandem and the first overlapping leaf pair
+    becomes the new witness. Disjoint shapes always require the full traversal.
+
+    \ingroup shape
+*/
+template <class Shape >
+DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
+                                const ShapeUnion<Shape>& a,
+                                const ShapeUnion<Shape>& b,
+                                unsigned int& err,
+                                detail::OverlapWitness& witness)
+    {
+    const detail::GPUTree& tree_a = a.members.tree;
+    const detail::GPUTree& tree_b = b.members.tree;
+
+    vec3<OverlapReal> dr_rot(rotate(conj(b.orientation),-r_ab));
+    quat<OverlapReal> q(conj(b.orientation)*a.orientation);
+
+    // the nodes may be out of range when the shape parameters have changed
+    if (witness.isValid(dr_rot, q, a.getCircumsphereDiameter())
+        && witness.node_a < tree_a.getNumNodes() && witness.node_b < tree_b.getNumNodes()
+        && test_narrow_phase_overlap(r_ab, a, b, witness.node_a, witness.node_b))
+        {
+        return true;
+        }
+
+    witness = detail::OverlapWitness();
+
+    // perform a tandem tree traversal
+    unsigned long int stack = 0;
+    unsigned int cur_node_a = 0;
+    unsigned int cur_node_b = 0;
+
+    detail::OBB obb_a = tree_a.getOBB(cur_node_a);
+    obb_a.affineTransform(q, dr_rot);
+
+    detail::OBB obb_b = tree_b.getOBB(cur_node_b);
+
+    while (cur_node_a != tree_a.getNumNodes() && cur_node_b != tree_b.getNumNodes())
+        {
+        unsigned int query_node_a = cur_node_a;
+        unsigned int query_node_b = cur_node_b;
+
+        if (detail::traverseBinaryStack(tree_a, tree_b, cur_node_a, cur_node_b, stack, obb_a, obb_b, q, dr_rot)
+            && test_narrow_phase_overlap(r_ab, a, b, query_node_a, query_node_b))
+            {
+            vec3<OverlapReal> lengths_a = tree_a.getOBB(query_node_a).lengths;
+            vec3<OverlapReal> lengths_b = tree_b.getOBB(query_node_b).lengths;
+            OverlapReal tolerance = detail::min(detail::min(detail::min(lengths_a.x, lengths_a.y), lengths_a.z),
+                detail::min(detail::min(lengths_b.x, lengths_b.y), lengths_b.z));
+            witness.set(query_node_a, query_node_b, dr_rot, q, tolerance);
+            return true;
+            }
+        }
+
+    return false;
+    }
+
 } // end namespace hpmc
 
 #undef DEVICE
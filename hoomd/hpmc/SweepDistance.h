@@ -0,0 +1,370 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+#include "HPMCPrecisionSetup.h"
+#include "MinkowskiMath.h"
+#include "XenoCollide2D.h"
+#include "ShapeSphere.h"
+#include "ShapeConvexPolygon.h"
+#include "ShapeConvexPolyhedron.h"
+
+#ifndef __SWEEP_DISTANCE_H__
+#define __SWEEP_DISTANCE_H__
+
+/*! \file SweepDistance.h
+    \brief Distance a shape can translate along a direction before it touches another shape
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <algorithm>
+#include <limits>
+
+namespace hpmc
+{
+
+namespace detail
+{
+
+//! Lift a 2D support function into the xy plane
+/*! The GJK ray cast works on 3D vectors, this adapter lets it handle 2D shapes.
+*/
+template<class SupportFunc2D>
+class SupportFuncXY
+    {
+    public:
+        //! Construct the adapter
+        /*! \param _s The 2D support function
+        */
+        SupportFuncXY(const SupportFunc2D& _s)
+            : s(_s)
+            {
+            }
+
+        //! Compute the support function
+        /*! \param n Normal vector input, the z component is ignored
+            \returns The point furthest in the direction of n
+        */
+        vec3<OverlapReal> operator() (const vec3<OverlapReal>& n) const
+            {
+            vec2<OverlapReal> p = s(vec2<OverlapReal>(n.x, n.y));
+            return vec3<OverlapReal>(p.x, p.y, OverlapReal(0.0));
+            }
+
+    private:
+        const SupportFunc2D& s;  //!< The 2D support function
+    };
+
+//! Find the point of a simplex closest to a given point
+/*! \param x The point
+    \param Y Vertices of the simplex (up to 4)
+    \param n Number of vertices
+    \returns x minus the point of the simplex closest to x
+
+    On return, Y and n are reduced to the vertices of the smallest face of the simplex that contains the closest point.
+    Every face is tested by projecting x onto its affine hull. The closest point lies inside the face whose projection
+    has positive barycentric coordinates and the smallest distance.
+*/
+inline vec3<double> closest_point_simplex(const vec3<double>& x, vec3<double>* Y, unsigned int& n)
+    {
+    double min_dist_sq = std::numeric_limits<double>::max();
+    vec3<double> min_v;
+    unsigned int min_face = 0;
+
+    for (unsigned int face = 1; face < (1u << n); face++)
+        {
+        // vertices of this face, relative to x
+        vec3<double> W[4];
+        unsigned int k = 0;
+        for (unsigned int m = 0; m < n; m++)
+            {
+            if (face & (1u << m))
+                W[k++] = x - Y[m];
+            }
+
+        // minimize |W_0 + sum_m mu_m (W_m - W_0)| via the normal equations G mu = b
+        double G[3][4];
+        double scale = dot(W[0], W[0]);
+        for (unsigned int r = 1; r < k; r++)
+            {
+            vec3<double> e_r = W[r] - W[0];
+            for (unsigned int c = 1; c < k; c++)
+                G[r-1][c-1] = dot(e_r, W[c] - W[0]);
+            G[r-1][k-1] = -dot(e_r, W[0]);
+            scale = std::max(scale, G[r-1][r-1]);
+            }
+
+        // Gaussian elimination with partial pivoting, skip degenerate faces
+        bool degenerate = false;
+        const unsigned int dim = k-1;
+        for (unsigned int c = 0; c < dim && !degenerate; c++)
+            {
+            unsigned int pivot = c;
+            for (unsigned int r = c+1; r < dim; r++)
+                {
+                if (fabs(G[r][c]) > fabs(G[pivot][c]))
+                    pivot = r;
+                }
+            if (fabs(G[pivot][c]) <= 1e-12*scale)
+                {
+                degenerate = true;
+                break;
+                }
+            for (unsigned int cc = 0; cc <= dim; cc++)
+                std::swap(G[c][cc], G[pivot][cc]);
+            for (unsigned int r = c+1; r < dim; r++)
+                {
+                double f = G[r][c] / G[c][c];
+                for (unsigned int cc = c; cc <= dim; cc++)
+                    G[r][cc] -= f*G[c][cc];
+                }
+            }
+        if (degenerate)
+            continue;
+
+        double mu[3];
+        for (int r = int(dim)-1; r >= 0; r--)
+            {
+            double sum = G[r][dim];
+            for (unsigned int c = r+1; c < dim; c++)
+                sum -= G[r][c]*mu[c];
+            mu[r] = sum / G[r][r];
+            }
+
+        // the projection must lie inside the face
+        double mu_0 = double(1.0);
+        bool inside = true;
+        vec3<double> v = W[0];
+        for (unsigned int m = 0; m < dim; m++)
+            {
+            inside = inside && mu[m] > double(0.0);
+            mu_0 -= mu[m];
+            v += mu[m]*(W[m+1] - W[0]);
+            }
+        if (!inside || mu_0 <= double(0.0))
+            continue;
+
+        double dist_sq = dot(v,v);
+        if (dist_sq < min_dist_sq)
+            {
+            min_dist_sq = dist_sq;
+            min_v = v;
+            min_face = face;
+            }
+        }
+
+    // keep only the vertices of the closest face
+    unsigned int k = 0;
+    for (unsigned int m = 0; m < n; m++)
+        {
+        if (min_face & (1u << m))
+            Y[k++] = Y[m];
+        }
+    n = k;
+
+    return min_v;
+    }
+
+//! Cast a ray from the origin against a convex set
+/*! \param S Support function of the convex set
+    \param ray Direction of the ray
+    \param max_lambda Largest ray parameter of interest
+    \param lambda (out) Ray parameter of the hit
+    \param err Incremented if the iteration did not converge
+    \returns true if the ray hits the set at a parameter lambda <= max_lambda
+
+    This is the GJK ray cast of G. van den Bergen, "Ray casting against general convex objects with application to
+    continuous collision detection" (2004). The ray advances from one separating plane of the set to the next, so
+    lambda never exceeds the true hit parameter. When the iteration does not converge, the last lambda is returned as
+    a conservative estimate.
+*/
+template<class SupportFunc>
+inline bool gjk_ray_cast(const SupportFunc& S,
+                         const vec3<OverlapReal>& ray,
+                         OverlapReal max_lambda,
+                         OverlapReal& lambda,
+                         unsigned int& err)
+    {
+    const unsigned int max_iterations = 64;
+    const double tol = 1e-6;
+
+    // the support points are computed in OverlapReal, the simplex in double so that the closest point is accurate
+    // close to convergence
+    const vec3<double> r(ray);
+    double lam = 0.0;
+    vec3<double> x(0,0,0);
+    vec3<double> Y[4];
+    unsigned int n = 0;
+
+    // start from an arbitrary point of the set
+    vec3<double> v = x - vec3<double>(S(ray));
+
+    for (unsigned int iteration = 0; iteration < max_iterations; iteration++)
+        {
+        vec3<double> p(S(vec3<OverlapReal>(v)));
+        vec3<double> w = x - p;
+        double vw = dot(v,w);
+        if (vw > 0.0)
+            {
+            // the support plane separates x from the set, advance x onto the plane
+            double vr = dot(v,r);
+            if (vr >= 0.0)
+                return false;
+            lam -= vw / vr;
+            if (lam > max_lambda)
+                return false;
+            x = lam*r;
+            }
+        else
+            {
+            // no progress is possible once the support point is already in the simplex
+            for (unsigned int m = 0; m < n; m++)
+                {
+                if (Y[m].x == p.x && Y[m].y == p.y && Y[m].z == p.z)
+                    {
+                    lambda = OverlapReal(lam);
+                    return true;
+                    }
+                }
+            }
+
+        if (n < 4)
+            Y[n++] = p;
+        v = closest_point_simplex(x, Y, n);
+
+        // converged when x touches the set
+        double max_dist_sq = 0;
+        for (unsigned int m = 0; m < n; m++)
+            max_dist_sq = std::max(max_dist_sq, dot(x - Y[m], x - Y[m]));
+        if (n == 4 || dot(v,v) <= tol*tol*max_dist_sq)
+            {
+            lambda = OverlapReal(lam);
+            return true;
+            }
+        }
+
+    err++;
+    lambda = OverlapReal(lam);
+    return true;
+    }
+
+} // end namespace detail
+
+//! Distance a sphere can translate before it touches another sphere
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a Moving shape
+    \param b Resting shape
+    \param dir Unit vector in the direction of motion of a
+    \param max_distance Largest distance of interest
+    \param err in/out variable incremented when error conditions occur
+    \returns The distance a can move before it touches b, or max_distance if that is smaller
+
+    \ingroup shape
+*/
+inline OverlapReal sweep_distance(const vec3<Scalar>& r_ab,
+                                  const ShapeSphere& a,
+                                  const ShapeSphere& b,
+                                  const vec3<Scalar>& dir,
+                                  OverlapReal max_distance,
+                                  unsigned int& err)
+    {
+    Scalar R = Scalar(a.params.radius) + Scalar(b.params.radius);
+    Scalar along = dot(r_ab, dir);
+    Scalar perp_sq = dot(r_ab, r_ab) - along*along;
+
+    // moving apart, or passing by
+    if (along <= Scalar(0.0) || perp_sq >= R*R)
+        return max_distance;
+
+    Scalar s = along - fast::sqrt(R*R - perp_sq);
+    return std::min(std::max(OverlapReal(s), OverlapReal(0.0)), max_distance);
+    }
+
+//! Distance a convex polygon can translate before it touches another convex polygon
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a Moving shape
+    \param b Resting shape
+    \param dir Unit vector in the direction of motion of a
+    \param max_distance Largest distance of interest
+    \param err in/out variable incremented when error conditions occur
+    \returns The distance a can move before it touches b, or max_distance if that is smaller
+
+    The distance is found by casting a ray in the direction of motion against the Minkowski difference of b and a.
+
+    \ingroup shape
+*/
+inline OverlapReal sweep_distance(const vec3<Scalar>& r_ab,
+                                  const ShapeConvexPolygon& a,
+                                  const ShapeConvexPolygon& b,
+                                  const vec3<Scalar>& dir,
+                                  OverlapReal max_distance,
+                                  unsigned int& err)
+    {
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+    Scalar along = dot(r_ab, dir);
+    Scalar perp_sq = dot(r_ab, r_ab) - along*along;
+    if (along <= -DaDb/OverlapReal(2.0) || OverlapReal(4.0)*perp_sq >= DaDb*DaDb)
+        return max_distance;
+
+    vec2<OverlapReal> dr(r_ab.x, r_ab.y);
+    detail::SupportFuncConvexPolygon sa(a.verts);
+    detail::SupportFuncConvexPolygon sb(b.verts);
+    detail::CompositeSupportFunc2D<detail::SupportFuncConvexPolygon, detail::SupportFuncConvexPolygon> S(sa, sb, dr,
+        quat<OverlapReal>(a.orientation), quat<OverlapReal>(b.orientation));
+    detail::SupportFuncXY<detail::CompositeSupportFunc2D<detail::SupportFuncConvexPolygon,
+        detail::SupportFuncConvexPolygon> > S_xy(S);
+
+    OverlapReal lambda;
+    if (detail::gjk_ray_cast(S_xy, vec3<OverlapReal>(dir.x, dir.y, 0), max_distance, lambda, err))
+        return lambda;
+    return max_distance;
+    }
+
+//! Distance a convex polyhedron can translate before it touches another convex polyhedron
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a Moving shape
+    \param b Resting shape
+    \param dir Unit vector in the direction of motion of a
+    \param max_distance Largest distance of interest
+    \param err in/out variable incremented when error conditions occur
+    \returns The distance a can move before it touches b, or max_distance if that is smaller
+
+    The distance is found by casting a ray in the direction of motion against the Minkowski difference of b and a,
+    in the body frame of a.
+
+    \ingroup shape
+*/
+inline OverlapReal sweep_distance(const vec3<Scalar>& r_ab,
+                                  const ShapeConvexPolyhedron& a,
+                                  const ShapeConvexPolyhedron& b,
+                                  const vec3<Scalar>& dir,
+                                  OverlapReal max_distance,
+                                  unsigned int& err)
+    {
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+    Scalar along = dot(r_ab, dir);
+    Scalar perp_sq = dot(r_ab, r_ab) - along*along;
+    if (along <= -DaDb/OverlapReal(2.0) || OverlapReal(4.0)*perp_sq >= DaDb*DaDb)
+        return max_distance;
+
+    quat<OverlapReal> q_a_conj = conj(quat<OverlapReal>(a.orientation));
+    vec3<OverlapReal> dr = rotate(q_a_conj, vec3<OverlapReal>(r_ab));
+    quat<OverlapReal> q_ab = q_a_conj * quat<OverlapReal>(b.orientation);
+    detail::SupportFuncConvexPolyhedron sa(a.verts);
+    detail::SupportFuncConvexPolyhedron sb(b.verts);
+    detail::CompositeSupportFunc3D<detail::SupportFuncConvexPolyhedron, detail::SupportFuncConvexPolyhedron> S(sa, sb,
+        dr, q_ab);
+
+    OverlapReal lambda;
+    if (detail::gjk_ray_cast(S, rotate(q_a_conj, vec3<OverlapReal>(dir)), max_distance, lambda, err))
+        return lambda;
+    return max_distance;
+    }
+
+} // end namespace hpmc
+
+#endif // __SWEEP_DISTANCE_H__
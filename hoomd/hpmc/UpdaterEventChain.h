@@ -0,0 +1,442 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// inclusion guard
+#ifndef _UPDATER_HPMC_EVENT_CHAIN_
+#define _UPDATER_HPMC_EVENT_CHAIN_
+
+/*! \file UpdaterEventChain.h
+    \brief Declaration of UpdaterEventChain
+*/
+
+#include "hoomd/HOOMDMPI.h"
+#include "hoomd/Updater.h"
+#include "hoomd/RandomNumbers.h"
+#include "hoomd/RNGIdentifiers.h"
+
+#include "HPMCCounters.h"
+#include "IntegratorHPMCMono.h"
+#include "SweepDistance.h"
+
+namespace hpmc
+{
+
+/*! Event-chain Monte Carlo for hard particles
+
+    An event chain moves one particle along a direction until it collides with another particle, then continues with
+    the particle it hit (a lift) until the total displacement of the chain reaches the chain length. Every
+    displacement is rejection free, the distance to the next collision is computed with sweep_distance(), cf. Bernard,
+    Krauth and Wilson PRE 2009 and Michel, Kapfer and Krauth JCP 2014.
+
+    Chains run along the positive x, y and z axes, chosen at random for each chain. Orientations are not changed, so
+    anisotropic shapes still need the rotation moves of the integrator. The moving particle stops a small gap short of
+    the contact so that round off does not leave the shapes overlapping.
+
+    The shape must provide a sweep_distance() overload. Patch energies, external fields and domain decomposition are
+    not supported.
+*/
+template< class Shape >
+class UpdaterEventChain : public Updater
+    {
+    public:
+        //! Constructor
+        /*! \param sysdef System definition
+            \param mc HPMC integrator
+            \param seed PRNG seed
+        */
+        UpdaterEventChain(std::shared_ptr<SystemDefinition> sysdef,
+                          std::shared_ptr<IntegratorHPMCMono<Shape> > mc,
+                          unsigned int seed);
+
+        //! Destructor
+        virtual ~UpdaterEventChain();
+
+        //! Get the value of a logged quantity
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep)
+            {
+            if (quantity == "hpmc_event_chain_collisions")
+                {
+                hpmc_event_chain_counters_t counters = getCounters(2);
+                return counters.getCollisionsPerChain();
+                }
+            return Scalar(0.0);
+            }
+
+        /*
+            \returns a list of provided quantities
+        */
+        std::vector< std::string > getProvidedLogQuantities()
+            {
+            std::vector< std::string > result;
+            result.push_back("hpmc_event_chain_collisions");
+            return result;
+            }
+
+        //! Take one timestep forward
+        /*! \param timestep timestep at which update is being evaluated
+        */
+        virtual void update(unsigned int timestep);
+
+        //! Set the total displacement of each chain
+        void setChainLength(Scalar chain_length)
+            {
+            if (chain_length < Scalar(0.0))
+                {
+                m_exec_conf->msg->error() << "update.event_chain: chain_length must be non-negative" << std::endl;
+                throw std::runtime_error("Error setting event chain parameters");
+                }
+            m_chain_length = chain_length;
+            }
+
+        //! Get the total displacement of each chain
+        Scalar getChainLength()
+            {
+            return m_chain_length;
+            }
+
+        //! Set the number of chains per time step
+        void setNChains(unsigned int nchains)
+            {
+            m_nchains = nchains;
+            }
+
+        //! Get the number of chains per time step
+        unsigned int getNChains()
+            {
+            return m_nchains;
+            }
+
+        //! Reset statistics counters
+        virtual void resetStats()
+            {
+            m_count_run_start = m_count_total;
+            }
+
+        //! Print statistics about the event chains
+        void printStats()
+            {
+            hpmc_event_chain_counters_t counters = getCounters(1);
+            m_exec_conf->msg->notice(2) << "-- HPMC event chain stats:" << std::endl;
+            m_exec_conf->msg->notice(2) << "Total event chains:            " << counters.chain_count << std::endl;
+            m_exec_conf->msg->notice(2) << "Average collisions per chain:  " << counters.getCollisionsPerChain() << std::endl;
+            if (counters.truncated_count)
+                {
+                m_exec_conf->msg->notice(2) << "Truncated event chains:        " << counters.truncated_count << std::endl;
+                }
+            }
+
+        /*! \param mode 0 -> Absolute count, 1 -> relative to the start of the run, 2 -> relative to the last executed step
+            \return The current state of the counters
+        */
+        hpmc_event_chain_counters_t getCounters(unsigned int mode)
+            {
+            hpmc_event_chain_counters_t result;
+
+            if (mode == 0)
+                result = m_count_total;
+            else if (mode == 1)
+                result = m_count_total - m_count_run_start;
+            else
+                result = m_count_total - m_count_step_start;
+
+            return result;
+            }
+
+    protected:
+        std::shared_ptr< IntegratorHPMCMono<Shape> > m_mc; //!< HPMC integrator
+        unsigned int m_seed;                        //!< RNG seed
+        Scalar m_chain_length;                      //!< Total displacement of each chain
+        unsigned int m_nchains;                     //!< Number of chains per time step, 0 for one per particle
+        unsigned int m_max_collisions;              //!< Collisions after which a chain is stopped
+
+        detail::AABBTree m_aabb_tree;               //!< Locality lookup, updated as the particles move
+        std::vector<vec3<Scalar> > m_image_list;    //!< Box images in range of a chain segment
+
+        hpmc_event_chain_counters_t m_count_total;        //!< Total count since initialization
+        hpmc_event_chain_counters_t m_count_run_start;    //!< Count saved at run() start
+        hpmc_event_chain_counters_t m_count_step_start;   //!< Count saved at the start of the last step
+
+        //! Build the list of box images that a chain segment can interact with
+        void updateImageList(Scalar range);
+    };
+
+template< class Shape >
+UpdaterEventChain<Shape>::UpdaterEventChain(std::shared_ptr<SystemDefinition> sysdef,
+                                            std::shared_ptr<IntegratorHPMCMono<Shape> > mc,
+                                            unsigned int seed)
+        : Updater(sysdef), m_mc(mc), m_seed(seed), m_chain_length(1.0), m_nchains(0), m_max_collisions(10000)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing UpdaterEventChain" << std::endl;
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        m_exec_conf->msg->error() << "update.event_chain: Domain decomposition is not supported" << std::endl;
+        throw std::runtime_error("Error initializing UpdaterEventChain");
+        }
+    #endif
+
+    // initialize logger and stats
+    resetStats();
+    }
+
+template< class Shape >
+UpdaterEventChain<Shape>::~UpdaterEventChain()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying UpdaterEventChain" << std::endl;
+    }
+
+/*! \param range Largest distance between a particle and the particles a chain segment of it can hit
+
+    Like IntegratorHPMCMono::updateImageList(), every image within range plus the box circumsphere is included, so
+    that the primary image is always the first one.
+*/
+template< class Shape >
+void UpdaterEventChain<Shape>::updateImageList(Scalar range)
+    {
+    m_image_list.clear();
+
+    unsigned int ndim = m_sysdef->getNDimensions();
+    const BoxDim& box = m_pdata->getGlobalBox();
+    vec3<Scalar> e1 = vec3<Scalar>(box.getLatticeVector(0));
+    vec3<Scalar> e2 = vec3<Scalar>(box.getLatticeVector(1));
+    vec3<Scalar> e3(0,0,0);
+    if (ndim == 3)
+        e3 = vec3<Scalar>(box.getLatticeVector(2));
+
+    // the longest of the four body diagonals is the box circumsphere diameter
+    Scalar diag = 0.0;
+    vec3<Scalar> body_diagonal;
+    body_diagonal = e1 - e2 - e3;
+    diag = detail::max(diag, dot(body_diagonal, body_diagonal));
+    body_diagonal = e1 - e2 + e3;
+    diag = detail::max(diag, dot(body_diagonal, body_diagonal));
+    body_diagonal = e1 + e2 - e3;
+    diag = detail::max(diag, dot(body_diagonal, body_diagonal));
+    body_diagonal = e1 + e2 + e3;
+    diag = detail::max(diag, dot(body_diagonal, body_diagonal));
+    range += fast::sqrt(diag);
+    Scalar range_sq = range*range;
+
+    // images further away than range along any lattice direction cannot be in range
+    Scalar3 npd = box.getNearestPlaneDistance();
+    int h_max = int(ceil(range/npd.x));
+    int k_max = int(ceil(range/npd.y));
+    int l_max = (ndim == 3) ? int(ceil(range/npd.z)) : 0;
+
+    m_image_list.push_back(vec3<Scalar>(0,0,0));
+    for (int h = -h_max; h <= h_max; h++)
+        {
+        for (int k = -k_max; k <= k_max; k++)
+            {
+            for (int l = -l_max; l <= l_max; l++)
+                {
+                if (h == 0 && k == 0 && l == 0)
+                    continue;
+
+                vec3<Scalar> r = Scalar(h) * e1 + Scalar(k) * e2 + Scalar(l) * e3;
+                if (dot(r,r) <= range_sq)
+                    m_image_list.push_back(r);
+                }
+            }
+        }
+    }
+
+/*! Perform the event chains
+    \param timestep Current time step of the simulation
+*/
+template< class Shape >
+void UpdaterEventChain<Shape>::update(unsigned int timestep)
+    {
+    m_exec_conf->msg->notice(10) << timestep << " UpdaterEventChain" << std::endl;
+
+    m_count_step_start = m_count_total;
+
+    // if no particles, exit early
+    if (! m_pdata->getN() || m_chain_length == Scalar(0.0)) return;
+
+    if (m_mc->getPatchInteraction() || m_mc->getExternalField())
+        {
+        m_exec_conf->msg->error() << "update.event_chain: Patch energies and external fields are not supported"
+            << std::endl;
+        throw std::runtime_error("Error in UpdaterEventChain");
+        }
+
+    // the chains advance in segments no longer than the largest particle, so that the images in range stay bounded
+    Scalar max_segment = m_mc->getMaxCoreDiameter();
+    if (max_segment == Scalar(0.0)) return;
+
+    if (m_prof) m_prof->push(m_exec_conf,"HPMC event chain");
+
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int ndim = m_sysdef->getNDimensions();
+
+    updateImageList(Scalar(2.0)*max_segment);
+
+    // start from the integrator's tree and keep it up to date while particles move
+    m_aabb_tree = m_mc->buildAABBTree();
+
+    auto& params = m_mc->getParams();
+    ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(), access_location::host, access_mode::read);
+    const Index2D& overlap_idx = m_mc->getOverlapIndexer();
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+
+    hoomd::RandomGenerator rng(hoomd::RNGIdentifier::UpdaterEventChain, m_seed, timestep);
+
+    unsigned int nchains = m_nchains ? m_nchains : m_pdata->getN();
+    unsigned int err_count = 0;
+    for (unsigned int chain = 0; chain < nchains; chain++)
+        {
+        unsigned int i = hoomd::UniformIntDistribution(m_pdata->getN()-1)(rng);
+        unsigned int axis = hoomd::UniformIntDistribution(ndim-1)(rng);
+        vec3<Scalar> dir(Scalar(axis == 0), Scalar(axis == 1), Scalar(axis == 2));
+
+        Scalar remaining = m_chain_length;
+        unsigned int n_collisions = 0;
+        while (remaining > Scalar(0.0))
+            {
+            if (n_collisions >= m_max_collisions)
+                {
+                m_count_total.truncated_count++;
+                break;
+                }
+
+            Scalar4 postype_i = h_postype.data[i];
+            vec3<Scalar> pos_i(postype_i);
+            unsigned int typ_i = __scalar_as_int(postype_i.w);
+            Shape shape_i(quat<Scalar>(h_orientation.data[i]), params[typ_i]);
+
+            Scalar segment = std::min(remaining, max_segment);
+
+            // bounding box of the sweep
+            detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0,0,0));
+            detail::AABB aabb_end = aabb_i_local;
+            aabb_end.translate(segment*dir);
+            aabb_i_local = detail::merge(aabb_i_local, aabb_end);
+
+            // find the first collision along the segment
+            OverlapReal s_min = OverlapReal(segment);
+            unsigned int j_min = i;
+            for (unsigned int cur_image = 0; cur_image < m_image_list.size(); cur_image++)
+                {
+                vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+                detail::AABB aabb = aabb_i_local;
+                aabb.translate(pos_i_image);
+
+                // stackless search
+                for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+                    {
+                    if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                        {
+                        if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                            {
+                            for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                {
+                                unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                                // the images of i move along with it and are never hit
+                                if (j == i)
+                                    continue;
+
+                                Scalar4 postype_j = h_postype.data[j];
+                                unsigned int typ_j = __scalar_as_int(postype_j.w);
+                                if (!h_overlaps.data[overlap_idx(typ_i,typ_j)])
+                                    continue;
+
+                                Shape shape_j(quat<Scalar>(h_orientation.data[j]), params[typ_j]);
+                                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                                OverlapReal s = sweep_distance(r_ij, shape_i, shape_j, dir, s_min, err_count);
+                                if (s < s_min)
+                                    {
+                                    s_min = s;
+                                    j_min = j;
+                                    }
+                                }
+                            }
+                        }
+                    else
+                        {
+                        // skip ahead
+                        cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                        }
+                    }  // end loop over AABB nodes
+                } // end loop over images
+
+            // move i up to the collision, or to the end of the segment
+            Scalar move = segment;
+            if (j_min != i)
+                {
+                // stop short of the contact
+                Scalar gap = Scalar(1e-5)*max_segment;
+                move = std::max(Scalar(s_min) - gap, Scalar(0.0));
+                }
+
+            pos_i += move*dir;
+            h_postype.data[i] = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+            box.wrap(h_postype.data[i], h_image.data[i]);
+            m_aabb_tree.update(i, shape_i.getAABB(vec3<Scalar>(h_postype.data[i])));
+
+            // lift to the particle that was hit
+            if (j_min != i)
+                {
+                remaining -= Scalar(s_min);
+                i = j_min;
+                n_collisions++;
+                }
+            else
+                {
+                remaining -= segment;
+                }
+            }
+
+        m_count_total.chain_count++;
+        m_count_total.collision_count += n_collisions;
+        }
+
+    if (err_count)
+        {
+        m_exec_conf->msg->warning() << "update.event_chain: " << err_count
+            << " sweep distances did not converge" << std::endl;
+        }
+
+    // the integrator's tree refers to the old positions. The candidate lists are rebuilt on their own, because
+    // checkCandidateLists() sees the displacements.
+    m_mc->invalidateAABBTree();
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
+//! Export the UpdaterEventChain class to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape An instantiation of UpdaterEventChain<Shape> will be exported
+*/
+template < class Shape> void export_UpdaterEventChain(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_< UpdaterEventChain<Shape>, std::shared_ptr< UpdaterEventChain<Shape> > >(m, name.c_str(), pybind11::base<Updater>())
+          .def( pybind11::init< std::shared_ptr<SystemDefinition>,
+                         std::shared_ptr< IntegratorHPMCMono<Shape> >,
+                         unsigned int >())
+        .def("getCounters", &UpdaterEventChain<Shape>::getCounters)
+        .def("setChainLength", &UpdaterEventChain<Shape>::setChainLength)
+        .def("getChainLength", &UpdaterEventChain<Shape>::getChainLength)
+        .def("setNChains", &UpdaterEventChain<Shape>::setNChains)
+        .def("getNChains", &UpdaterEventChain<Shape>::getNChains)
+    ;
+    }
+
+inline void export_hpmc_event_chain_counters(pybind11::module &m)
+    {
+    pybind11::class_< hpmc_event_chain_counters_t >(m, "hpmc_event_chain_counters_t")
+        .def_readonly("chain_count", &hpmc_event_chain_counters_t::chain_count)
+        .def_readonly("collision_count", &hpmc_event_chain_counters_t::collision_count)
+        .def_readonly("truncated_count", &hpmc_event_chain_counters_t::truncated_count)
+        .def("getCollisionsPerChain", &hpmc_event_chain_counters_t::getCollisionsPerChain);
+    }
+
+} // end namespace hpmc
+
+#endif // _UPDATER_HPMC_EVENT_CHAIN_
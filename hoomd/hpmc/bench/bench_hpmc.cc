@@ -0,0 +1,330 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/bench/bench_utils.h"
+
+#include "hoomd/hpmc/ShapeSphere.h"
+#include "hoomd/hpmc/ShapeConvexPolygon.h"
+#include "hoomd/hpmc/ShapeSimplePolygon.h"
+#include "hoomd/hpmc/ShapeSpheropolygon.h"
+#include "hoomd/hpmc/ShapeConvexPolyhedron.h"
+#include "hoomd/hpmc/ShapeSpheropolyhedron.h"
+#include "hoomd/hpmc/ShapeEllipsoid.h"
+#include "hoomd/hpmc/ShapeFacetedEllipsoid.h"
+#include "hoomd/hpmc/ShapePolyhedron.h"
+#include "hoomd/hpmc/ShapeSphinx.h"
+#include "hoomd/hpmc/ShapeUnion.h"
+
+#include <sstream>
+#include <vector>
+
+/*! \file bench_hpmc.cc
+    \brief Microbenchmarks for the HPMC overlap checks
+    \details Times test_overlap() for every shape class on N random pairs of particles. The separations are drawn
+    uniformly from within the circumsphere diameter, so that a mix of overlapping and non-overlapping configurations is
+    tested. The overlap checks run on the CPU only, --gpu is ignored.
+*/
+
+using namespace std;
+using namespace hpmc;
+using namespace hpmc::detail;
+
+//! Benchmark the overlap check of a shape
+/*! \param param Shape parameters
+    \param n_dimensions Dimensionality of the shape (2D shapes are only rotated about z)
+*/
+template<class Shape>
+void bench_overlap(const BenchmarkOptions& options, const std::string& name,
+    const typename Shape::param_type& param, unsigned int n_dimensions)
+    {
+    if (!options.enabled(name))
+        return;
+
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    exec_conf->msg->setNoticeLevel(0);
+
+    Shape probe(quat<Scalar>(), param);
+    Scalar d = probe.getCircumsphereDiameter();
+
+    // generate random pair configurations
+    std::mt19937 rng(options.seed);
+    std::uniform_real_distribution<Scalar> uniform(Scalar(-1.0), Scalar(1.0));
+    std::normal_distribution<Scalar> normal;
+
+    std::vector< vec3<Scalar> > r_ab(options.N);
+    std::vector< quat<Scalar> > q_a(options.N), q_b(options.N);
+    for (unsigned int i = 0; i < options.N; ++i)
+        {
+        vec3<Scalar> r;
+        do
+            {
+            r = vec3<Scalar>(uniform(rng), uniform(rng), (n_dimensions == 3) ? uniform(rng) : Scalar(0.0));
+            } while (dot(r,r) > Scalar(1.0));
+        r_ab[i] = d*r;
+
+        if (n_dimensions == 3)
+            {
+            q_a[i] = quat<Scalar>(normal(rng), vec3<Scalar>(normal(rng), normal(rng), normal(rng)));
+            q_b[i] = quat<Scalar>(normal(rng), vec3<Scalar>(normal(rng), normal(rng), normal(rng)));
+            q_a[i] = q_a[i] * (Scalar(1.0)/sqrt(norm2(q_a[i])));
+            q_b[i] = q_b[i] * (Scalar(1.0)/sqrt(norm2(q_b[i])));
+            }
+        else
+            {
+            q_a[i] = quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,0,1), Scalar(M_PI)*uniform(rng));
+            q_b[i] = quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,0,1), Scalar(M_PI)*uniform(rng));
+            }
+        }
+
+    unsigned int n_overlap = 0;
+    unsigned int err_count = 0;
+    double ms = time_benchmark(exec_conf, options.num_iters, [&]()
+        {
+        n_overlap = 0;
+        for (unsigned int i = 0; i < options.N; ++i)
+            {
+            Shape a(q_a[i], param);
+            Shape b(q_b[i], param);
+            if (test_overlap(r_ab[i], a, b, err_count))
+                n_overlap++;
+            }
+        });
+
+    std::ostringstream oss;
+    oss << name << " (" << (100*n_overlap)/options.N << "% overlap)";
+
+    // the shape parameters stay in cache, only the configurations are streamed
+    double bytes = double(options.N)*(sizeof(vec3<Scalar>) + 2*sizeof(quat<Scalar>));
+    report_benchmark(oss.str(), options.N, ms, bytes);
+    }
+
+//! Set up the vertices of a polygon
+static poly2d_verts make_poly2d(const std::vector< vec2<OverlapReal> >& vlist, OverlapReal sweep_radius)
+    {
+    poly2d_verts result;
+    result.N = vlist.size();
+    result.sweep_radius = sweep_radius;
+    result.ignore = 0;
+
+    OverlapReal radius_sq = OverlapReal(0.0);
+    for (unsigned int i = 0; i < vlist.size(); i++)
+        {
+        result.x[i] = vlist[i].x;
+        result.y[i] = vlist[i].y;
+        radius_sq = std::max(radius_sq, dot(vlist[i], vlist[i]));
+        }
+
+    result.diameter = 2*(sqrt(radius_sq) + sweep_radius);
+    return result;
+    }
+
+//! Set up the vertices of a convex polyhedron
+static poly3d_verts make_poly3d(const std::vector< vec3<OverlapReal> >& vlist, OverlapReal sweep_radius)
+    {
+    poly3d_verts result(vlist.size(), false);
+    result.sweep_radius = sweep_radius;
+    result.ignore = 0;
+
+    OverlapReal radius_sq = OverlapReal(0.0);
+    for (unsigned int i = 0; i < vlist.size(); i++)
+        {
+        result.x[i] = vlist[i].x;
+        result.y[i] = vlist[i].y;
+        result.z[i] = vlist[i].z;
+        radius_sq = std::max(radius_sq, dot(vlist[i], vlist[i]));
+        }
+
+    result.diameter = 2*(sqrt(radius_sq) + sweep_radius);
+    return result;
+    }
+
+//! Vertices of a unit cube
+static std::vector< vec3<OverlapReal> > cube_verts()
+    {
+    std::vector< vec3<OverlapReal> > vlist;
+    for (int i = 0; i < 8; ++i)
+        vlist.push_back(vec3<OverlapReal>((i & 1) ? 0.5 : -0.5, (i & 2) ? 0.5 : -0.5, (i & 4) ? 0.5 : -0.5));
+    return vlist;
+    }
+
+//! Set up a general polyhedron (an octahedron) including its OBB tree
+static ShapePolyhedron::param_type make_polyhedron()
+    {
+    poly3d_data data(6,8,24,6,false);
+    data.sweep_radius = data.convex_hull_verts.sweep_radius = 0.0f;
+
+    data.verts[0] = vec3<OverlapReal>(-0.5,-0.5,0);
+    data.verts[1] = vec3<OverlapReal>(0.5,-0.5,0);
+    data.verts[2] = vec3<OverlapReal>(0.5,0.5,0);
+    data.verts[3] = vec3<OverlapReal>(-0.5,0.5,0);
+    data.verts[4] = vec3<OverlapReal>(0,0,0.707106781186548);
+    data.verts[5] = vec3<OverlapReal>(0,0,-0.707106781186548);
+
+    const unsigned int faces[8][3] = {{0,4,1}, {1,4,2}, {2,4,3}, {3,4,0}, {0,5,1}, {1,5,2}, {2,5,3}, {3,5,0}};
+    for (unsigned int i = 0; i < 8; ++i)
+        {
+        data.face_offs[i] = 3*i;
+        for (unsigned int j = 0; j < 3; ++j)
+            data.face_verts[3*i+j] = faces[i][j];
+        }
+    data.face_offs[8] = 24;
+    data.origin = vec3<OverlapReal>(0,0,0);
+    data.ignore = 0;
+
+    OverlapReal radius_sq = OverlapReal(0.0);
+    for (unsigned int i = 0; i < data.n_verts; ++i)
+        {
+        radius_sq = std::max(radius_sq, dot(data.verts[i], data.verts[i]));
+        data.convex_hull_verts.x[i] = data.verts[i].x;
+        data.convex_hull_verts.y[i] = data.verts[i].y;
+        data.convex_hull_verts.z[i] = data.verts[i].z;
+        }
+    data.convex_hull_verts.diameter = 2*sqrt(radius_sq);
+
+    // build the OBB tree of the faces
+    OBB *obbs = new OBB[data.n_faces];
+    std::vector< std::vector< vec3<OverlapReal> > > internal_coordinates;
+    for (unsigned int i = 0; i < data.n_faces; ++i)
+        {
+        std::vector< vec3<OverlapReal> > face_vec;
+        for (unsigned int j = data.face_offs[i]; j < data.face_offs[i+1]; ++j)
+            face_vec.push_back(data.verts[data.face_verts[j]]);
+        std::vector<OverlapReal> vertex_radii(face_vec.size(), data.sweep_radius);
+        obbs[i] = compute_obb(face_vec, vertex_radii, false);
+        internal_coordinates.push_back(face_vec);
+        }
+
+    OBBTree tree;
+    tree.buildTree(obbs, internal_coordinates, data.sweep_radius, data.n_faces, 4);
+    delete[] obbs;
+
+    ShapePolyhedron::param_type p = data;
+    p.tree = GPUTree(tree);
+    return p;
+    }
+
+//! Set up a union of shapes including its OBB tree
+template<class Shape>
+typename ShapeUnion<Shape>::param_type make_union(const std::vector< vec3<OverlapReal> >& pos,
+    const typename Shape::param_type& member_param)
+    {
+    typename ShapeUnion<Shape>::param_type params(pos.size(), false);
+
+    OverlapReal R = 0;
+    OBB *obbs = new OBB[pos.size()];
+    for (unsigned int i = 0; i < pos.size(); ++i)
+        {
+        params.mpos[i] = pos[i];
+        params.morientation[i] = quat<OverlapReal>();
+        params.mparams[i] = member_param;
+        params.moverlap[i] = 1;
+
+        Shape dummy(quat<Scalar>(), member_param);
+        obbs[i] = OBB(dummy.getAABB(vec3<Scalar>(pos[i])));
+        R = std::max(R, OverlapReal(sqrt(dot(pos[i],pos[i])) + 0.5*dummy.getCircumsphereDiameter()));
+        }
+    params.diameter = 2*R;
+    params.ignore = 0;
+
+    OBBTree tree;
+    tree.buildTree(obbs, pos.size(), 4, true);
+    delete[] obbs;
+    params.tree = typename ShapeUnion<Shape>::param_type::gpu_tree_type(tree);
+    return params;
+    }
+
+int main(int argc, char **argv)
+    {
+    return run_benchmarks(argc, argv, [](const BenchmarkOptions& options)
+        {
+        // spheres
+        sph_params sphere;
+        sphere.radius = 0.5;
+        sphere.ignore = 0;
+        sphere.isOriented = false;
+        bench_overlap<ShapeSphere>(options, "ShapeSphere", sphere, 3);
+
+        // 2D shapes, a regular hexagon and a concave arrow head
+        std::vector< vec2<OverlapReal> > hexagon;
+        for (unsigned int i = 0; i < 6; ++i)
+            hexagon.push_back(vec2<OverlapReal>(0.5*cos(M_PI*i/3.0), 0.5*sin(M_PI*i/3.0)));
+        std::vector< vec2<OverlapReal> > arrow;
+        arrow.push_back(vec2<OverlapReal>(-0.5,-0.5));
+        arrow.push_back(vec2<OverlapReal>(0.5,0));
+        arrow.push_back(vec2<OverlapReal>(-0.5,0.5));
+        arrow.push_back(vec2<OverlapReal>(-0.25,0));
+
+        bench_overlap<ShapeConvexPolygon>(options, "ShapeConvexPolygon", make_poly2d(hexagon, 0), 2);
+        bench_overlap<ShapeSimplePolygon>(options, "ShapeSimplePolygon", make_poly2d(arrow, 0), 2);
+        bench_overlap<ShapeSpheropolygon>(options, "ShapeSpheropolygon", make_poly2d(hexagon, 0.1), 2);
+
+        // 3D shapes
+        bench_overlap<ShapeConvexPolyhedron>(options, "ShapeConvexPolyhedron", make_poly3d(cube_verts(), 0), 3);
+        bench_overlap<ShapeSpheropolyhedron>(options, "ShapeSpheropolyhedron", make_poly3d(cube_verts(), 0.1), 3);
+
+        ell_params ellipsoid;
+        ellipsoid.x = 0.5;
+        ellipsoid.y = 0.25;
+        ellipsoid.z = 0.75;
+        ellipsoid.ignore = 0;
+        bench_overlap<ShapeEllipsoid>(options, "ShapeEllipsoid", ellipsoid, 3);
+
+        // a sphere truncated by the six faces of a cube
+        faceted_ellipsoid_params faceted(6, false);
+        faceted.a = faceted.b = faceted.c = 0.5;
+        for (unsigned int i = 0; i < 6; ++i)
+            {
+            vec3<OverlapReal> n(0,0,0);
+            if (i / 2 == 0) n.x = (i % 2) ? -1 : 1;
+            if (i / 2 == 1) n.y = (i % 2) ? -1 : 1;
+            if (i / 2 == 2) n.z = (i % 2) ? -1 : 1;
+            faceted.n[i] = n;
+            faceted.offset[i] = -0.25;
+            }
+
+        // the corners of the cube lie within the sphere, vertices are given in units of the half-axes
+        faceted.verts = make_poly3d(cube_verts(), 0);
+        faceted.origin = vec3<OverlapReal>(0,0,0);
+        faceted.ignore = 0;
+        ShapeFacetedEllipsoid::initializeVertices(faceted, false);
+        bench_overlap<ShapeFacetedEllipsoid>(options, "ShapeFacetedEllipsoid", faceted, 3);
+
+        bench_overlap<ShapePolyhedron>(options, "ShapePolyhedron", make_polyhedron(), 3);
+
+        // a sphere with two spherical dimples
+        sphinx3d_params sphinx;
+        sphinx.N = 3;
+        for (unsigned int i = 0; i < MAX_SPHERE_CENTERS; ++i)
+            {
+            sphinx.diameter[i] = 0;
+            sphinx.center[i] = vec3<OverlapReal>(0,0,0);
+            }
+        sphinx.diameter[0] = 1.0;
+        sphinx.diameter[1] = -1.1;
+        sphinx.diameter[2] = -1.1;
+        sphinx.center[1] = vec3<OverlapReal>(0,0,0.575);
+        sphinx.center[2] = vec3<OverlapReal>(0,0,-0.575);
+        sphinx.circumsphereDiameter = 1.0;
+        sphinx.ignore = 0;
+        bench_overlap<ShapeSphinx>(options, "ShapeSphinx", sphinx, 3);
+
+        // unions of a tetrahedral cluster of spheres and of a pair of cubes
+        std::vector< vec3<OverlapReal> > tetrahedron;
+        tetrahedron.push_back(vec3<OverlapReal>(0.5,0.5,0.5));
+        tetrahedron.push_back(vec3<OverlapReal>(0.5,-0.5,-0.5));
+        tetrahedron.push_back(vec3<OverlapReal>(-0.5,0.5,-0.5));
+        tetrahedron.push_back(vec3<OverlapReal>(-0.5,-0.5,0.5));
+        bench_overlap< ShapeUnion<ShapeSphere> >(options, "ShapeUnion<ShapeSphere>",
+            make_union<ShapeSphere>(tetrahedron, sphere), 3);
+
+        std::vector< vec3<OverlapReal> > dimer;
+        dimer.push_back(vec3<OverlapReal>(0,0,0.5));
+        dimer.push_back(vec3<OverlapReal>(0,0,-0.5));
+        bench_overlap< ShapeUnion<ShapeSpheropolyhedron> >(options, "ShapeUnion<ShapeSpheropolyhedron>",
+            make_union<ShapeSpheropolyhedron>(dimer, make_poly3d(cube_verts(), 0)), 3);
+        });
+    }
@@ -391,7 +391,9 @@ class mode_hpmc(_integrator):
                    nR=None,
                    depletant_type=None,
                    ntrial=None,
-                   deterministic=None):
+                   checkerboard=None,
+                   deterministic=None,
+                   candidate_skin=None):
         R""" Changes parameters of an existing integration mode.
 
         Args:
@@ -403,7 +405,16 @@ class mode_hpmc(_integrator):
             depletant_type (str): (if set) **Implicit depletants only**: Particle type to use as implicit depletant.
             ntrial (int): (if set) **Implicit depletants only**: Number of re-insertion attempts per overlapping depletant.
                 (Only supported with **depletant_mode='circumsphere'**)
+            checkerboard (bool): (if set) **Implicit depletants only**: Process the trial moves in the cells of a checkerboard,
+                so that moves in non-interacting cells insert their depletants concurrently. Particles may not leave their
+                cell during a step. (CPU only, the GPU always uses a checkerboard)
             deterministic (bool): (if set) Make HPMC integration deterministic on the GPU by sorting the cell list.
+            candidate_skin (float): (if set) Keep a list of the possible overlap partners of every particle, searched
+                within this extra distance, and test only those in trial moves. The lists are rebuilt when particles
+                have moved too far. 0 disables the lists. (CPU only, not supported with implicit depletants)
+
+        Choose a *candidate_skin* of several times the move size *d*. Larger values build the lists less often but test
+        more candidates in every trial move.
 
         .. note:: Simulations are only deterministic with respect to the same execution configuration (CPU or GPU) and
                   number of MPI ranks. Simulation output will not be identical if either of these is changed.
@@ -452,12 +463,20 @@ class mode_hpmc(_integrator):
                     self.cpp_integrator.setNTrial(ntrial)
                 else:
                     hoomd.context.msg.warning("ntrial is only supported with depletant_mode='circumsphere'. Ignoring.\n")
-        elif any([p is not None for p in [nR,depletant_type,ntrial]]):
+            if checkerboard is not None:
+                self.cpp_integrator.setCheckerboard(checkerboard)
+        elif any([p is not None for p in [nR,depletant_type,ntrial,checkerboard]]):
             hoomd.context.msg.warning("Implicit depletant parameters not supported by this integrator.\n")
 
         if deterministic is not None:
             self.cpp_integrator.setDeterministic(deterministic);
 
+        if candidate_skin is not None:
+            if self.implicit or hoomd.context.exec_conf.isCUDAEnabled():
+                hoomd.context.msg.warning("candidate_skin is not supported by this integrator. Ignoring.\n")
+            else:
+                self.cpp_integrator.setCandidateSkin(candidate_skin);
+
     def map_overlaps(self):
         R""" Build an overlap map of the system
 
@@ -20,6 +20,7 @@
 #include "AnalyzerSDF.h"
 #include "UpdaterBoxMC.h"
 #include "UpdaterClusters.h"
+#include "UpdaterEventChain.h"
 
 #include "ShapeProxy.h"
 
@@ -109,6 +110,7 @@ PYBIND11_MODULE(_hpmc, m)
     export_hpmc_implicit_counters(m);
 
     export_hpmc_clusters_counters(m);
+    export_hpmc_event_chain_counters(m);
     }
 
 /*! \defgroup hpmc_integrators HPMC integrators
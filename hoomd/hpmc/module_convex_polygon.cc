@@ -23,6 +23,7 @@
 #include "UpdaterMuVTImplicit.h"
 #include "UpdaterClusters.h"
 #include "UpdaterClustersImplicit.h"
+#include "UpdaterEventChain.h"
 
 #ifdef ENABLE_CUDA
 #include "IntegratorHPMCMonoGPU.h"
@@ -53,6 +54,7 @@ void export_convex_polygon(py::module& m)
     export_UpdaterMuVTImplicit< ShapeConvexPolygon, IntegratorHPMCMonoImplicit<ShapeConvexPolygon> >(m, "UpdaterMuVTImplicitConvexPolygon");
     export_UpdaterClusters< ShapeConvexPolygon >(m, "UpdaterClustersConvexPolygon");
     export_UpdaterClustersImplicit< ShapeConvexPolygon, IntegratorHPMCMonoImplicit<ShapeConvexPolygon> >(m, "UpdaterClustersImplicitConvexPolygon");
+    export_UpdaterEventChain< ShapeConvexPolygon >(m, "UpdaterEventChainConvexPolygon");
 
     export_ExternalFieldInterface<ShapeConvexPolygon>(m, "ExternalFieldConvexPolygon");
     export_LatticeField<ShapeConvexPolygon>(m, "ExternalFieldLatticeConvexPolygon");
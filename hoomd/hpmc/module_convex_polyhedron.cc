@@ -23,6 +23,7 @@
 #include "UpdaterMuVTImplicit.h"
 #include "UpdaterClusters.h"
 #include "UpdaterClustersImplicit.h"
+#include "UpdaterEventChain.h"
 
 #ifdef ENABLE_CUDA
 #include "IntegratorHPMCMonoGPU.h"
@@ -52,6 +53,7 @@ void export_convex_polyhedron(py::module& m)
     export_UpdaterMuVT< ShapeConvexPolyhedron >(m, "UpdaterMuVTConvexPolyhedron");
     export_UpdaterClusters< ShapeConvexPolyhedron >(m, "UpdaterClustersConvexPolyhedron");
     export_UpdaterClustersImplicit< ShapeConvexPolyhedron, IntegratorHPMCMonoImplicit<ShapeConvexPolyhedron> >(m, "UpdaterClustersImplicitConvexPolyhedron");
+    export_UpdaterEventChain< ShapeConvexPolyhedron >(m, "UpdaterEventChainConvexPolyhedron");
     export_UpdaterMuVTImplicit< ShapeConvexPolyhedron, IntegratorHPMCMonoImplicit<ShapeConvexPolyhedron> >(m, "UpdaterMuVTImplicitConvexPolyhedron");
 
     export_ExternalFieldInterface<ShapeConvexPolyhedron >(m, "ExternalFieldConvexPolyhedron");
@@ -23,6 +23,7 @@
 #include "UpdaterMuVTImplicit.h"
 #include "UpdaterClusters.h"
 #include "UpdaterClustersImplicit.h"
+#include "UpdaterEventChain.h"
 
 #ifdef ENABLE_CUDA
 #include "IntegratorHPMCMonoGPU.h"
@@ -49,6 +50,7 @@ void export_sphere(py::module& m)
     export_UpdaterMuVT< ShapeSphere >(m, "UpdaterMuVTSphere");
     export_UpdaterClusters< ShapeSphere >(m, "UpdaterClustersSphere");
     export_UpdaterClustersImplicit< ShapeSphere,IntegratorHPMCMonoImplicit<ShapeSphere> >(m, "UpdaterClustersImplicitSphere");
+    export_UpdaterEventChain< ShapeSphere >(m, "UpdaterEventChainSphere");
     export_UpdaterMuVTImplicit< ShapeSphere, IntegratorHPMCMonoImplicit<ShapeSphere> >(m, "UpdaterMuVTImplicitSphere");
 
     export_ExternalFieldInterface<ShapeSphere>(m, "ExternalFieldSphere");
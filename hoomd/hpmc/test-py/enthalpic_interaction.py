@@ -7,6 +7,8 @@ from hoomd import hpmc, jit
 
 import unittest
 import os
+import shutil
+import tempfile
 import numpy as np
 import itertools
 import sys
@@ -189,6 +191,60 @@ class enthalpic_dipole_interaction(unittest.TestCase):
             hoomd.run(2, quiet=True);
             self.assertEqual(self.log.query('hpmc_patch_energy'), 0);
 
+        # e) particles with several neighbors each, evaluated in one batch per particle
+        def test_many_neighbors(self):
+            square_well = """float rsq = dot(r_ij, r_ij);
+                             if (rsq < 6.25f)
+                                 return -1.0f;
+                             else
+                                 return 0.0f;
+                          """
+            self.snapshot = data.make_snapshot(N=5, box=data.boxdim(L=2*self.r_cut, dimensions=3), particle_types=['A']);
+            self.snapshot.particles.position[:] = [(i,0,0) for i in range(5)];
+            init.read_snapshot(self.snapshot);
+            self.mc = hpmc.integrate.sphere(seed=10,d=0.1);
+            self.mc.shape_param.set('A', diameter=0);
+            self.patch = jit.patch.user(mc=self.mc,r_cut=2.5, code=square_well);
+            self.log = analyze.log(filename=None, quantities=['hpmc_patch_energy'],period=0,overwrite=True);
+
+            # pairs closer than 2.5: 4 at distance 1 and 3 at distance 2
+            hoomd.run(0, quiet=True);
+            self.assertEqual(self.log.query('hpmc_patch_energy'), -7);
+
+            # trial moves evaluate the old and new neighbors of a particle in a batch
+            hoomd.run(10, quiet=True);
+            self.assertLessEqual(self.log.query('hpmc_patch_energy'), 0);
+
+        # f) compiled code is stored in and loaded from the cache
+        @unittest.skipIf(not jit._jit.is_cache_available(), "the JIT cache requires LLVM 5 or newer")
+        def test_cache(self):
+            cache_dir = tempfile.mkdtemp();
+            jit.set_cache_dir(cache_dir);
+            try:
+                self.snapshot.particles.position[0,:]    = (0,0,0);
+                self.snapshot.particles.position[1,:]    = (self.diameter,0,0);
+                self.snapshot.particles.orientation[0,:] = (1,0,0,0);
+                self.snapshot.particles.orientation[1,:] = (1,0,0,0);
+                init.read_snapshot(self.snapshot);
+                self.mc = hpmc.integrate.sphere(seed=10,a=0,d=0);
+                self.mc.shape_param.set('A', diameter=self.diameter,orientable=True);
+                self.log = analyze.log(filename=None, quantities=['hpmc_patch_energy'],period=0,overwrite=True);
+
+                # the first patch compiles the code and stores it
+                self.patch = jit.patch.user(mc=self.mc,r_cut=self.r_cut, code=self.dipole_dipole);
+                hoomd.run(0, quiet=True);
+                self.assertEqual(self.log.query('hpmc_patch_energy'), -self.lamb);
+                self.assertGreater(len([f for f in os.listdir(cache_dir) if f.endswith('.o')]), 0);
+
+                # the second patch loads it from the cache
+                self.patch.disable();
+                self.patch = jit.patch.user(mc=self.mc,r_cut=self.r_cut, code=self.dipole_dipole);
+                hoomd.run(0, quiet=True);
+                self.assertEqual(self.log.query('hpmc_patch_energy'), -self.lamb);
+            finally:
+                jit.set_cache_dir(None);
+                shutil.rmtree(cache_dir);
+
         def tearDown(self):
             del self.mc;
             del self.patch;
@@ -0,0 +1,89 @@
+from __future__ import division, print_function
+from hoomd import *
+from hoomd import hpmc
+import unittest
+import numpy
+
+try:
+    from hoomd import jit
+    from hoomd.jit import _jit
+    enable_jit = True
+except ImportError:
+    enable_jit = False
+
+context.initialize()
+
+# The candidate lists only change which neighbors are tested, not the result of the overlap checks. A simulation with
+# candidate lists must therefore follow the same trajectory as one that searches the AABB tree in every trial move.
+
+class candidate_list_test(unittest.TestCase):
+    def run_spheres(self, skin, steps):
+        context.initialize()
+        system = init.create_lattice(unitcell=lattice.sc(a=1.2), n=6)
+
+        mc = hpmc.integrate.sphere(seed=123, d=0.05)
+        mc.shape_param.set('A', diameter=1.0)
+        if skin is not None:
+            mc.set_params(candidate_skin=skin)
+
+        run(steps)
+
+        snap = system.take_snapshot()
+        self.assertEqual(mc.count_overlaps(), 0)
+        return mc, snap
+
+    def test_same_trajectory(self):
+        mc, snap_list = self.run_spheres(1.0, 200)
+        self.assertAlmostEqual(mc.cpp_integrator.getCandidateSkin(), 1.0)
+        builds = mc.cpp_integrator.getCandidateListBuilds()
+        self.assertGreater(builds, 0)
+        if comm.get_num_ranks() == 1:
+            # the lists are kept over several steps
+            self.assertLess(builds, 200)
+
+        mc, snap_tree = self.run_spheres(None, 200)
+        self.assertEqual(mc.cpp_integrator.getCandidateListBuilds(), 0)
+
+        if comm.get_rank() == 0:
+            numpy.testing.assert_allclose(snap_list.particles.position, snap_tree.particles.position, atol=1e-5)
+            numpy.testing.assert_array_equal(snap_list.particles.image, snap_tree.particles.image)
+
+    def run_patch(self, skin):
+        context.initialize()
+        system = init.create_lattice(unitcell=lattice.sc(a=1.2), n=4)
+
+        mc = hpmc.integrate.sphere(seed=123, d=0.02)
+        mc.shape_param.set('A', diameter=1.0)
+        if skin is not None:
+            mc.set_params(candidate_skin=skin)
+
+        # build the lists without the patch, its cutoff is larger than the lattice spacing
+        run(10)
+
+        jit.patch.user(mc=mc, r_cut=2.0, code='float rsq = dot(r_ij, r_ij); return rsq < 4.0f ? -10.0f/rsq : 0.0f;')
+        run(50)
+
+        return system.take_snapshot()
+
+    # attaching a patch energy between runs must extend the candidate lists to the patch cutoff
+    @unittest.skipIf(not enable_jit, "no JIT support")
+    def test_patch_after_run(self):
+        snap_list = self.run_patch(0.05)
+        snap_tree = self.run_patch(None)
+
+        if comm.get_rank() == 0:
+            numpy.testing.assert_allclose(snap_list.particles.position, snap_tree.particles.position, atol=1e-5)
+            numpy.testing.assert_array_equal(snap_list.particles.image, snap_tree.particles.image)
+
+    def test_negative_skin(self):
+        context.initialize()
+        init.create_lattice(unitcell=lattice.sc(a=1.2), n=2)
+        mc = hpmc.integrate.sphere(seed=123, d=0.1)
+        mc.shape_param.set('A', diameter=1.0)
+        self.assertRaises(RuntimeError, mc.set_params, candidate_skin=-1.0)
+
+    def tearDown(self):
+        context.initialize()
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -0,0 +1,122 @@
+from __future__ import division, print_function
+from hoomd import *
+from hoomd import hpmc
+import unittest
+import numpy
+import math
+import os
+import tempfile
+
+context.initialize()
+
+class event_chain_test(unittest.TestCase):
+    # measure the hard sphere pressure with the scale distribution function, for event chains or local trial moves
+    def sample_pressure(self, event_chain):
+        context.initialize()
+
+        # packing fraction 0.4
+        system = init.create_lattice(unitcell=lattice.sc(a=math.pow(math.pi/6.0/0.4, 1.0/3.0)), n=6)
+        rho = len(system.particles)/system.box.get_volume()
+
+        if event_chain:
+            mc = hpmc.integrate.sphere(seed=123, d=0.0)
+            hpmc.update.event_chain(mc, seed=456, chain_length=2.0, nchains=50)
+        else:
+            mc = hpmc.integrate.sphere(seed=123, d=0.1)
+        mc.shape_param.set('A', diameter=1.0)
+
+        # melt the lattice
+        run(1000)
+
+        if comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.hpmc-test-ecmc-sdf')
+            tmp_file = tmp[1]
+        else:
+            tmp_file = "invalid"
+
+        xmax = 0.02
+        dx = 1e-4
+        hpmc.analyze.sdf(mc=mc, filename=tmp_file, xmax=xmax, dx=dx, navg=50, period=10, overwrite=True)
+        run(5000)
+
+        if comm.get_rank() != 0:
+            return None
+
+        # extrapolate s(0+) for every averaged histogram and convert it to a pressure, betaP = rho*(1+s(0+)/6)
+        r = numpy.atleast_2d(numpy.loadtxt(tmp_file))
+        os.remove(tmp_file)
+        x = (numpy.arange(int(round(xmax/dx))) + 0.5)*dx
+        betaP = []
+        for s in r[:, 1:]:
+            p = numpy.polyfit(x, s[0:x.size], 5)
+            betaP.append(rho*(1.0 + numpy.polyval(p, 0.0)/6.0))
+
+        return numpy.mean(betaP), numpy.std(betaP, ddof=1)/math.sqrt(len(betaP))
+
+    # event chains must sample the same equilibrium state as local Metropolis moves
+    def test_pressure(self):
+        result_ecmc = self.sample_pressure(True)
+        result_mc = self.sample_pressure(False)
+
+        if comm.get_rank() == 0:
+            (P_ecmc, err_ecmc) = result_ecmc
+            (P_mc, err_mc) = result_mc
+            context.msg.notice(1, 'betaP = {0} +- {1} (event chain), {2} +- {3} (Metropolis)\n'.format(
+                P_ecmc, err_ecmc, P_mc, err_mc))
+            self.assertAlmostEqual(P_ecmc, P_mc, delta=4*math.sqrt(err_ecmc**2 + err_mc**2))
+
+    def test_spheres(self):
+        system = init.create_lattice(unitcell=lattice.sc(a=1.1), n=6)
+
+        mc = hpmc.integrate.sphere(seed=123, d=0.0)
+        mc.shape_param.set('A', diameter=1.0)
+        ecmc = hpmc.update.event_chain(mc, seed=456, chain_length=2.0, nchains=50)
+
+        snap_before = system.take_snapshot()
+        run(20)
+        snap_after = system.take_snapshot()
+
+        # the integrator does not move the particles, the event chains do
+        self.assertEqual(mc.count_overlaps(), 0)
+        self.assertGreater(ecmc.get_collisions_per_chain(), 0)
+        if comm.get_rank() == 0:
+            self.assertFalse(numpy.allclose(snap_before.particles.position, snap_after.particles.position))
+
+    def test_convex_polyhedron(self):
+        system = init.create_lattice(unitcell=lattice.sc(a=1.2), n=5)
+
+        mc = hpmc.integrate.convex_polyhedron(seed=123, d=0.0, a=0.1)
+        mc.shape_param.set('A', vertices=[(-0.5,-0.5,-0.5), (-0.5,-0.5,0.5), (-0.5,0.5,-0.5), (-0.5,0.5,0.5),
+                                          (0.5,-0.5,-0.5), (0.5,-0.5,0.5), (0.5,0.5,-0.5), (0.5,0.5,0.5)])
+        ecmc = hpmc.update.event_chain(mc, seed=456, chain_length=1.0)
+
+        run(20)
+        self.assertEqual(mc.count_overlaps(), 0)
+        self.assertGreater(ecmc.get_collisions_per_chain(), 0)
+
+    def test_convex_polygon(self):
+        system = init.create_lattice(unitcell=lattice.sq(a=1.2), n=8)
+
+        mc = hpmc.integrate.convex_polygon(seed=123, d=0.0, a=0.1)
+        mc.shape_param.set('A', vertices=[(-0.5,-0.5), (0.5,-0.5), (0.5,0.5), (-0.5,0.5)])
+        ecmc = hpmc.update.event_chain(mc, seed=456, chain_length=1.0)
+
+        run(20)
+        self.assertEqual(mc.count_overlaps(), 0)
+        self.assertGreater(ecmc.get_collisions_per_chain(), 0)
+
+    def test_set_params(self):
+        init.create_lattice(unitcell=lattice.sc(a=1.2), n=2)
+        mc = hpmc.integrate.sphere(seed=123)
+        mc.shape_param.set('A', diameter=1.0)
+        ecmc = hpmc.update.event_chain(mc, seed=456, chain_length=2.0)
+        ecmc.set_params(chain_length=3.0, nchains=10)
+        self.assertAlmostEqual(ecmc.cpp_updater.getChainLength(), 3.0)
+        self.assertEqual(ecmc.cpp_updater.getNChains(), 10)
+        self.assertRaises(RuntimeError, ecmc.set_params, chain_length=-1.0)
+
+    def tearDown(self):
+        context.initialize()
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -160,6 +160,58 @@ class implicit_test_sphere_new (unittest.TestCase):
 
         context.msg.notice(1,'eta_p = {0}\n'.format(avg_eta_p))
 
+    def test_checkerboard(self):
+        self.mc.set_params(checkerboard=True)
+        self.assertTrue(self.mc.cpp_integrator.getCheckerboard())
+
+        run(self.steps)
+
+        self.assertEqual(self.mc.count_overlaps(),0)
+        self.assertGreater(self.mc.get_translate_acceptance(),0)
+
+    # sample the depletant free volume with and without the checkerboard
+    def sample_eta_p(self, checkerboard):
+        # only query the free volume at the sample points
+        log = analyze.log(filename=None, quantities=['volume','hpmc_free_volume'], period=1)
+        log.disable()
+
+        self.mc.set_params(checkerboard=checkerboard)
+
+        # equilibrate
+        run(200)
+
+        eta_p = []
+        for i in range(20):
+            run(20)
+            eta_p.append(math.pi/6.0*log.query('hpmc_free_volume')/log.query('volume')*self.nR)
+
+        mean = sum(eta_p)/len(eta_p)
+        var = sum((x-mean)**2 for x in eta_p)/(len(eta_p)-1)
+        return mean, math.sqrt(var/len(eta_p))
+
+    # the checkerboard only changes the order of the trial moves, it must sample the same depletant free volume
+    def test_checkerboard_free_volume(self):
+        mean_seq, err_seq = self.sample_eta_p(False)
+        mean_cb, err_cb = self.sample_eta_p(True)
+        context.msg.notice(1,'eta_p = {0} +- {1} (sequential), {2} +- {3} (checkerboard)\n'.format(
+            mean_seq, err_seq, mean_cb, err_cb))
+
+        self.assertEqual(self.mc.count_overlaps(),0)
+        self.assertAlmostEqual(mean_seq, mean_cb, delta=4*math.sqrt(err_seq**2 + err_cb**2))
+
+    # in a tilted box, the cell faces are not perpendicular to the axes of the AABB queries
+    def test_checkerboard_tilted(self):
+        update.box_resize(xy=0.8, xz=0.5, yz=-0.6, period=None)
+
+        mean_seq, err_seq = self.sample_eta_p(False)
+        mean_cb, err_cb = self.sample_eta_p(True)
+        context.msg.notice(1,'eta_p = {0} +- {1} (sequential), {2} +- {3} (checkerboard, tilted)\n'.format(
+            mean_seq, err_seq, mean_cb, err_cb))
+
+        self.assertTrue(self.mc.cpp_integrator.getCheckerboard())
+        self.assertEqual(self.mc.count_overlaps(),0)
+        self.assertAlmostEqual(mean_seq, mean_cb, delta=4*math.sqrt(err_seq**2 + err_cb**2))
+
     def tearDown(self):
         if comm.get_rank() == 0:
             os.remove(self.tmp_file);
@@ -106,3 +106,65 @@ UP_TEST( bigger )
         UP_ASSERT(in(i, hits));
         }
     }
+
+UP_TEST( lbvh )
+    {
+    const unsigned int N = 1000;
+    hoomd::RandomGenerator rng(2);
+
+    // build a linear BVH big enough to have several levels
+    std::vector< vec3<Scalar> > points(N);
+    AABB aabbs[N];
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng))
+                                  * Scalar(100);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+
+    AABBTree tree;
+    tree.buildTreeLBVH(aabbs, N);
+
+    // a complete binary tree over the leaves
+    unsigned int n_leaves = (N + NODE_CAPACITY - 1) / NODE_CAPACITY;
+    UP_ASSERT_EQUAL(tree.getNumNodes(), 2*n_leaves-1);
+
+    // the queries must find exactly the overlapping AABBs
+    std::vector<unsigned int> hits;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        AABB query(points[i], Scalar(2.0));
+        hits.clear();
+        tree.query(hits, query);
+
+        unsigned int n_overlap = 0;
+        for (unsigned int j = 0; j < N; j++)
+            {
+            if (overlap(aabbs[j], query))
+                {
+                n_overlap++;
+                UP_ASSERT(in(j, hits));
+                }
+            }
+        UP_ASSERT_EQUAL(hits.size(), n_overlap);
+        }
+
+    // move all the points and refit the tree
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] += vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng));
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+    tree.refit(aabbs);
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+    }
@@ -242,3 +242,60 @@ UP_TEST( overlapping_dumbbells )
     UP_ASSERT(test_overlap(r_b - r_a, a, b, err_count));
     UP_ASSERT(test_overlap(r_a - r_b, b, a, err_count));
     }
+
+UP_TEST( overlap_witness )
+    {
+    quat<Scalar> o;
+
+    // dumbbell: spheres of radius 0.25, located at x= +/- 0.25
+    ShapeSphere::param_type par;
+    par.radius = 0.25;
+    par.ignore = 0;
+
+    ShapeUnion<ShapeSphere>::param_type params(2,false);
+    params.diameter = 1.0;
+    params.mpos[0] = vec3<Scalar>(-0.25, 0, 0);
+    params.mpos[1] = vec3<Scalar>(0.25, 0, 0);
+    params.morientation[0] = o;
+    params.morientation[1] = o;
+    params.mparams[0] = par;
+    params.mparams[1] = par;
+    params.ignore = 0;
+    params.moverlap[0] = 1;
+    params.moverlap[1] = 1;
+    build_tree<ShapeSphere>(params);
+
+    ShapeUnion<ShapeSphere> a(o, params);
+    ShapeUnion<ShapeSphere> b(o, params);
+
+    // an overlap records a witness
+    OverlapWitness witness;
+    UP_ASSERT(test_overlap(vec3<Scalar>(0.9, 0, 0), a, b, err_count, witness));
+    UP_ASSERT(witness.tolerance > 0);
+    UP_ASSERT(witness.node_a < params.tree.getNumNodes());
+    UP_ASSERT(witness.node_b < params.tree.getNumNodes());
+
+    // small moves keep the result of the full check
+    UP_ASSERT(test_overlap(vec3<Scalar>(0.91, 0.01, 0), a, b, err_count, witness));
+    UP_ASSERT(!test_overlap(vec3<Scalar>(1.01, 0, 0), a, b, err_count, witness));
+    UP_ASSERT(witness.tolerance == 0);
+    UP_ASSERT(!test_overlap(vec3<Scalar>(1.01, 0, 0), a, b, err_count, witness));
+
+    // a stale witness does not change the result
+    UP_ASSERT(test_overlap(vec3<Scalar>(0.9, 0, 0), a, b, err_count, witness));
+    witness.node_a = 1000;
+    UP_ASSERT(test_overlap(vec3<Scalar>(0, 0.49, 0), a, b, err_count, witness));
+    UP_ASSERT(witness.node_a < params.tree.getNumNodes());
+    UP_ASSERT(!test_overlap(vec3<Scalar>(0, 0.51, 0), a, b, err_count, witness));
+
+    // the cache remembers the pair until the witness is empty
+    OverlapWitnessCache cache;
+    cache.resize(2);
+    UP_ASSERT(cache.find(0, 1).tolerance == 0);
+    UP_ASSERT(test_overlap(vec3<Scalar>(0.9, 0, 0), a, b, err_count, witness));
+    cache.store(0, 1, witness);
+    UP_ASSERT(cache.find(0, 1).tolerance == witness.tolerance);
+    UP_ASSERT(cache.find(1, 0).tolerance == 0);
+    cache.store(0, 1, OverlapWitness());
+    UP_ASSERT(cache.find(0, 1).tolerance == 0);
+    }
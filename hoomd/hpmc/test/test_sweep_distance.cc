@@ -0,0 +1,149 @@
+
+#include "hoomd/HOOMDMath.h"
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+#include "hoomd/hpmc/SweepDistance.h"
+
+#include <iostream>
+#include <string>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+using namespace hpmc;
+using namespace std;
+using namespace hpmc::detail;
+
+unsigned int err_count = 0;
+
+// cube with edge length 1
+poly3d_verts setup_cube()
+    {
+    poly3d_verts result(8,false);
+    result.ignore = 0;
+
+    unsigned int k = 0;
+    for (int a = -1; a <= 1; a += 2)
+        for (int b = -1; b <= 1; b += 2)
+            for (int c = -1; c <= 1; c += 2)
+                {
+                result.x[k] = OverlapReal(0.5*a);
+                result.y[k] = OverlapReal(0.5*b);
+                result.z[k] = OverlapReal(0.5*c);
+                k++;
+                }
+
+    result.diameter = sqrt(OverlapReal(3.0));
+    return result;
+    }
+
+// square with edge length 1
+poly2d_verts setup_square()
+    {
+    poly2d_verts result;
+    result.N = 4;
+    result.ignore = 0;
+    result.sweep_radius = 0;
+    for (unsigned int i = 0; i < MAX_POLY2D_VERTS; i++)
+        {
+        result.x[i] = 0;
+        result.y[i] = 0;
+        }
+
+    result.x[0] = -0.5; result.y[0] = -0.5;
+    result.x[1] = 0.5;  result.y[1] = -0.5;
+    result.x[2] = 0.5;  result.y[2] = 0.5;
+    result.x[3] = -0.5; result.y[3] = 0.5;
+
+    result.diameter = sqrt(OverlapReal(2.0));
+    return result;
+    }
+
+UP_TEST( sphere )
+    {
+    sph_params par;
+    par.radius = 0.5;
+    par.ignore = 0;
+    par.isOriented = false;
+    ShapeSphere a(quat<Scalar>(), par);
+    ShapeSphere b(quat<Scalar>(), par);
+    vec3<Scalar> dir(1,0,0);
+
+    // head on
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,0,0), a, b, dir, 10, err_count), 2.0, tol);
+
+    // off center, contact at sqrt(1 - 0.5^2) in front of b
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,0.5,0), a, b, dir, 10, err_count), 3.0-sqrt(0.75), tol);
+
+    // limited by the largest distance of interest
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,0,0), a, b, dir, 1.5, err_count), 1.5, tol);
+
+    // passing by and moving apart
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,1.1,0), a, b, dir, 10, err_count), 10.0, tol);
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(-3,0,0), a, b, dir, 10, err_count), 10.0, tol);
+    }
+
+UP_TEST( convex_polyhedron )
+    {
+    poly3d_verts verts = setup_cube();
+    ShapeConvexPolyhedron a(quat<Scalar>(), verts);
+    ShapeConvexPolyhedron b(quat<Scalar>(), verts);
+
+    // face to face
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,0.2,-0.3), a, b, vec3<Scalar>(1,0,0), 10, err_count), 2.0, tol);
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(0.1,0,-3), a, b, vec3<Scalar>(0,0,-1), 10, err_count), 2.0, tol);
+
+    // an edge of b rotated by 45 degrees about z points at a
+    ShapeConvexPolyhedron b_rot(quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,0,1), M_PI/4), verts);
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,0,0), a, b_rot, vec3<Scalar>(1,0,0), 10, err_count),
+        2.5-sqrt(0.5), tol);
+
+    // a rotated instead, the frame of a is used internally
+    ShapeConvexPolyhedron a_rot(quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,0,1), M_PI/4), verts);
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,0,0), a_rot, b, vec3<Scalar>(1,0,0), 10, err_count),
+        2.5-sqrt(0.5), tol);
+
+    // passing by and moving apart
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,1.1,0), a, b, vec3<Scalar>(1,0,0), 10, err_count), 10.0, tol);
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(-3,0,0), a, b, vec3<Scalar>(1,0,0), 10, err_count), 10.0, tol);
+
+    UP_ASSERT_EQUAL(err_count, 0);
+    }
+
+UP_TEST( convex_polyhedron_contact )
+    {
+    // after moving the sweep distance, the shapes touch but do not overlap
+    poly3d_verts verts = setup_cube();
+    ShapeConvexPolyhedron a(quat<Scalar>::fromAxisAngle(vec3<Scalar>(1,1,0)/sqrt(Scalar(2.0)), 0.3), verts);
+    ShapeConvexPolyhedron b(quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,1,1)/sqrt(Scalar(2.0)), 1.1), verts);
+    vec3<Scalar> r_ab(2.5,0.4,0.2);
+    vec3<Scalar> dir(1,0,0);
+
+    OverlapReal s = sweep_distance(r_ab, a, b, dir, 10, err_count);
+    UP_ASSERT(s < 10);
+    UP_ASSERT(!test_overlap(r_ab - Scalar(s - 1e-3)*dir, a, b, err_count));
+    UP_ASSERT(test_overlap(r_ab - Scalar(s + 1e-3)*dir, a, b, err_count));
+    UP_ASSERT_EQUAL(err_count, 0);
+    }
+
+UP_TEST( convex_polygon )
+    {
+    poly2d_verts verts = setup_square();
+    ShapeConvexPolygon a(quat<Scalar>(), verts);
+    ShapeConvexPolygon b(quat<Scalar>(), verts);
+
+    // edge to edge
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(0.2,3,0), a, b, vec3<Scalar>(0,1,0), 10, err_count), 2.0, tol);
+
+    // a vertex of b rotated by 45 degrees points at a
+    ShapeConvexPolygon b_rot(quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,0,1), M_PI/4), verts);
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,0,0), a, b_rot, vec3<Scalar>(1,0,0), 10, err_count),
+        2.5-sqrt(0.5), tol);
+
+    // passing by
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,1.1,0), a, b, vec3<Scalar>(1,0,0), 10, err_count), 10.0, tol);
+
+    UP_ASSERT_EQUAL(err_count, 0);
+    }
@@ -1012,3 +1012,96 @@ class clusters(_updater):
         """
         counters = self.cpp_updater.getCounters(1);
         return counters.getSwapAcceptance();
+
+class event_chain(_updater):
+    R""" Equilibrate hard particles with event-chain Monte Carlo.
+
+    Event-chain Monte Carlo, as described in Bernard, Krauth and Wilson (2009), http://doi.org/10.1103/PhysRevE.80.056704 ,
+    moves a particle along a straight line until it touches another particle, then continues the move with the particle
+    it hit, until the total displacement of the chain reaches *chain_length*. All displacements are accepted, there
+    are no rejected trial moves. Each chain runs along the positive x, y or z axis, chosen at random.
+
+    Event chains only translate particles. With anisotropic shapes, keep the rotation moves of the integrator enabled.
+
+    :py:class:`event_chain` supports :py:class:`hoomd.hpmc.integrate.sphere`,
+    :py:class:`hoomd.hpmc.integrate.convex_polygon` and :py:class:`hoomd.hpmc.integrate.convex_polyhedron`
+    without depletants, patch energies or external fields. It runs on the CPU and does not support MPI domain
+    decomposition.
+
+    Args:
+        mc (:py:mod:`hoomd.hpmc.integrate`): MC integrator.
+        seed (int): The seed of the pseudo-random number generator.
+        chain_length (float): Total displacement of each chain.
+        nchains (int): Number of chains per time step, the number of particles when None.
+        period (int): Number of timesteps between event chain updates.
+
+    Example::
+
+        mc = hpmc.integrate.sphere(seed=415236)
+        hpmc.update.event_chain(mc=mc, seed=123, chain_length=2.0)
+
+    """
+    def __init__(self, mc, seed, chain_length, nchains=None, period=1):
+        hoomd.util.print_status_line();
+
+        if not isinstance(mc, integrate.mode_hpmc):
+            hoomd.context.msg.warning("update.event_chain: Must have a handle to an HPMC integrator.\n");
+            return
+
+        if mc.implicit:
+            hoomd.context.msg.error("update.event_chain: Depletants are not supported.\n");
+            raise RuntimeError("Error initializing update.event_chain");
+
+        # initialize base class
+        _updater.__init__(self);
+
+        if isinstance(mc, integrate.sphere):
+            cls = _hpmc.UpdaterEventChainSphere;
+        elif isinstance(mc, integrate.convex_polygon):
+            cls = _hpmc.UpdaterEventChainConvexPolygon;
+        elif isinstance(mc, integrate.convex_polyhedron):
+            cls = _hpmc.UpdaterEventChainConvexPolyhedron;
+        else:
+            hoomd.context.msg.error("update.event_chain: Unsupported integrator.\n");
+            raise RuntimeError("Error initializing update.event_chain");
+
+        self.cpp_updater = cls(hoomd.context.current.system_definition, mc.cpp_integrator, int(seed))
+        hoomd.util.quiet_status();
+        self.set_params(chain_length=chain_length, nchains=nchains)
+        hoomd.util.unquiet_status();
+
+        # register the event chain updater
+        self.setupUpdater(period)
+
+    def set_params(self, chain_length=None, nchains=None):
+        R""" Set options for the event chains.
+
+        Args:
+            chain_length (float): Total displacement of each chain
+            nchains (int): Number of chains per time step, 0 for the number of particles
+
+        Note:
+            When an argument is None, the value is left unchanged from its current state.
+
+        Example::
+
+            ecmc = hpmc.update.event_chain(mc, seed=123, chain_length=2.0)
+            ecmc.set_params(chain_length=4.0, nchains=100)
+        """
+
+        hoomd.util.print_status_line();
+
+        if chain_length is not None:
+            self.cpp_updater.setChainLength(float(chain_length))
+
+        if nchains is not None:
+            self.cpp_updater.setNChains(int(nchains))
+
+    def get_collisions_per_chain(self):
+        R""" Get the average number of collisions in an event chain
+
+        Returns:
+            The average number of collisions per chain during the last run
+        """
+        counters = self.cpp_updater.getCounters(1);
+        return counters.getCollisionsPerChain();
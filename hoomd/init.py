@@ -81,12 +81,25 @@ def create_lattice(unitcell, n):
         hoomd.context.msg.error("n must have length equal to the number of dimensions in the unit cell\n");
         raise RuntimeError("Error initializing");
 
-    if snap.box.dimensions == 3:
-        snap.replicate(n[0],n[1],n[2])
     if snap.box.dimensions == 2:
-        snap.replicate(n[0],n[1],1)
+        n = [n[0], n[1], 1];
+
+    # the replicated box keeps the tilt factors of the unit cell
+    snap._broadcast_box(hoomd.context.exec_conf);
+    unit_box = snap._global_box;
+    L = unit_box.getL();
+    box = _hoomd.BoxDim(L.x*n[0], L.y*n[1], L.z*n[2]);
+    box.setTiltFactors(unit_box.getTiltFactorXY(), unit_box.getTiltFactorXZ(), unit_box.getTiltFactorYZ());
+    my_domain_decomposition = _create_domain_decomposition(box);
 
-    read_snapshot(snapshot=snap);
+    if my_domain_decomposition is not None:
+        # every rank generates only the replicas in its own domain
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snap, n[0], n[1], n[2], hoomd.context.exec_conf, my_domain_decomposition);
+        hoomd.context.current.system = _hoomd.System(hoomd.context.current.system_definition, 0);
+        _perform_common_init_tasks();
+    else:
+        snap.replicate(n[0],n[1],n[2])
+        read_snapshot(snapshot=snap);
 
     hoomd.util.unquiet_status();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
@@ -250,7 +263,7 @@ def read_snapshot(snapshot):
     _perform_common_init_tasks();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
 
-def read_gsd(filename, restart = None, frame = 0, time_step = None):
+def read_gsd(filename, restart = None, frame = 0, time_step = None, distributed = False):
     R""" Read initial system state from an GSD file.
 
     Args:
@@ -258,6 +271,7 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
         restart (str): If it exists, read the file *restart* instead of *filename*.
         frame (int): Index of the frame to read from the GSD file. Negative values index from the end of the file.
         time_step (int): (if specified) Time step number to initialize instead of the one stored in the GSD file.
+        distributed (bool): When True, all MPI ranks read the file in parallel.
 
     All particles, bonds, angles, dihedrals, impropers, constraints, and box information
     are read from the given GSD file at the given frame index. To read and write GSD files
@@ -273,6 +287,12 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     The result of :py:func:`hoomd.init.read_gsd` can be saved in a variable and later used to read and/or
     change particle properties later in the script. See :py:mod:`hoomd.data` for more information.
 
+    By default, the root rank reads the whole frame and distributes the particles to the other ranks. Set
+    *distributed* to True for large systems in MPI simulations: every rank then reads a stripe of the particle
+    data directly from the file and the particles are exchanged with a single all-to-all, so that neither the
+    time nor the memory to initialize grows with the number of particles on any one rank. The file must be
+    accessible from all ranks. Bonds and other topology are read on the root rank in both cases.
+
     See Also:
         :py:class:`hoomd.dump.gsd`
     """
@@ -288,10 +308,10 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     restart = _hoomd.mpi_bcast_str(restart, hoomd.context.exec_conf);
 
     if restart is not None and os.path.exists(restart):
-        reader = _hoomd.GSDReader(hoomd.context.exec_conf, restart, abs(frame), frame < 0);
+        reader = _hoomd.GSDReader(hoomd.context.exec_conf, restart, abs(frame), frame < 0, distributed);
         time_step = reader.getTimeStep();
     else:
-        reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, abs(frame), frame < 0);
+        reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, abs(frame), frame < 0, distributed);
         if time_step is None:
             time_step = reader.getTimeStep();
 
@@ -302,7 +322,7 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     my_domain_decomposition = _create_domain_decomposition(snapshot._global_box);
 
     if my_domain_decomposition is not None:
-        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf, my_domain_decomposition);
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf, my_domain_decomposition, reader.isDistributed());
     else:
         hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf);
 
@@ -18,10 +18,11 @@
 #include "llvm/Support/raw_os_ostream.h"
 
 //! C'tor
-EvalFactory::EvalFactory(const std::string& llvm_ir)
+EvalFactory::EvalFactory(const std::string& llvm_ir, const std::string& cache_dir)
     {
     // set to null pointer
     m_eval = NULL;
+    m_eval_batch = NULL;
 
     // initialize LLVM
     std::ostringstream sstream;
@@ -58,8 +59,10 @@ EvalFactory::EvalFactory(const std::string& llvm_ir)
         return;
         }
 
-    // Build the JIT
-    m_jit = std::unique_ptr<llvm::orc::KaleidoscopeJIT>(new llvm::orc::KaleidoscopeJIT());
+    // Build the JIT, reusing previously compiled object code when possible
+    if (!cache_dir.empty())
+        m_cache = std::unique_ptr<JITObjectCache>(new JITObjectCache(cache_dir, llvm_ir));
+    m_jit = std::unique_ptr<llvm::orc::KaleidoscopeJIT>(new llvm::orc::KaleidoscopeJIT(m_cache.get()));
 
     // Add the module, look up main and run it.
     m_jit->addModule(std::move(Mod));
@@ -88,12 +91,19 @@ EvalFactory::EvalFactory(const std::string& llvm_ir)
         return;
         }
 
+    // the batched evaluator is optional, IR compiled outside of HOOMD may only provide eval
+    auto eval_batch = m_jit->findSymbol("eval_batch");
+
     #if defined LLVM_VERSION_MAJOR && LLVM_VERSION_MAJOR >= 5
     m_eval = (EvalFnPtr)(long unsigned int)(cantFail(eval.getAddress()));
+    if (eval_batch)
+        m_eval_batch = (EvalBatchFnPtr)(long unsigned int)(cantFail(eval_batch.getAddress()));
     m_alpha = (float *)(cantFail(alpha.getAddress()));
     m_alpha_union = (float *)(cantFail(alpha_union.getAddress()));
     #else
     m_eval = (EvalFnPtr) eval.getAddress();
+    if (eval_batch)
+        m_eval_batch = (EvalBatchFnPtr) eval_batch.getAddress();
     m_alpha = (float *) alpha.getAddress();
     m_alpha_union = (float *) alpha_union.getAddress();
     #endif
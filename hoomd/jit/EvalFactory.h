@@ -6,6 +6,7 @@
 #include "hoomd/VectorMath.h"
 
 #include "KaleidoscopeJIT.h"
+#include "JITObjectCache.h"
 
 class EvalFactory
     {
@@ -20,8 +21,23 @@ class EvalFactory
             float d_j,
             float charge_j);
 
+        typedef void (*EvalBatchFnPtr)(unsigned int n,
+            const vec3<float> *r_ij,
+            unsigned int type_i,
+            const quat<float>& q_i,
+            float d_i,
+            float charge_i,
+            const unsigned int *type_j,
+            const quat<float> *q_j,
+            const float *d_j,
+            const float *charge_j,
+            float *energy);
+
         //! Constructor
-        EvalFactory(const std::string& llvm_ir);
+        /*! \param llvm_ir Contents of the LLVM IR to load
+            \param cache_dir Directory to cache the compiled object code in, empty to disable the cache
+        */
+        EvalFactory(const std::string& llvm_ir, const std::string& cache_dir="");
 
         //! Return the evaluator
         EvalFnPtr getEval()
@@ -29,6 +45,18 @@ class EvalFactory
             return m_eval;
             }
 
+        //! Return the batched evaluator, or NULL if the module does not provide one
+        EvalBatchFnPtr getEvalBatch()
+            {
+            return m_eval_batch;
+            }
+
+        //! Check if the object code was loaded from the cache
+        bool isCacheHit()
+            {
+            return m_cache && m_cache->isHit();
+            }
+
         //! Get the error message from initialization
         const std::string& getError()
             {
@@ -48,8 +76,10 @@ class EvalFactory
             }
 
     private:
+        std::unique_ptr<JITObjectCache> m_cache;           //!< The on-disk object cache (must outlive m_jit)
         std::unique_ptr<llvm::orc::KaleidoscopeJIT> m_jit; //!< The persistent JIT engine
         EvalFnPtr m_eval;         //!< Function pointer to evaluator
+        EvalBatchFnPtr m_eval_batch; //!< Function pointer to batched evaluator (optional)
         float * m_alpha;         // Pointer to alpha array
         float * m_alpha_union;   // Pointer to alpha array for union
         std::string m_error_msg; //!< The error message if initialization fails
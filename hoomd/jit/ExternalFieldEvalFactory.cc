@@ -18,7 +18,7 @@
 #include "llvm/Support/raw_os_ostream.h"
 
 //! C'tor
-ExternalFieldEvalFactory::ExternalFieldEvalFactory(const std::string& llvm_ir)
+ExternalFieldEvalFactory::ExternalFieldEvalFactory(const std::string& llvm_ir, const std::string& cache_dir)
     {
     // set to null pointer
     m_eval = NULL;
@@ -58,8 +58,10 @@ ExternalFieldEvalFactory::ExternalFieldEvalFactory(const std::string& llvm_ir)
         return;
         }
 
-    // Build the JIT
-    m_jit = std::unique_ptr<llvm::orc::KaleidoscopeJIT>(new llvm::orc::KaleidoscopeJIT());
+    // Build the JIT, reusing previously compiled object code when possible
+    if (!cache_dir.empty())
+        m_cache = std::unique_ptr<JITObjectCache>(new JITObjectCache(cache_dir, llvm_ir));
+    m_jit = std::unique_ptr<llvm::orc::KaleidoscopeJIT>(new llvm::orc::KaleidoscopeJIT(m_cache.get()));
 
     // Add the module, look up main and run it.
     m_jit->addModule(std::move(Mod));
@@ -6,6 +6,7 @@
 #include "hoomd/VectorMath.h"
 
 #include "KaleidoscopeJIT.h"
+#include "JITObjectCache.h"
 
 // Forward declare box class
 class BoxDim;
@@ -22,7 +23,10 @@ class ExternalFieldEvalFactory
             );
 
         //! Constructor
-        ExternalFieldEvalFactory(const std::string& llvm_ir);
+        /*! \param llvm_ir Contents of the LLVM IR to load
+            \param cache_dir Directory to cache the compiled object code in, empty to disable the cache
+        */
+        ExternalFieldEvalFactory(const std::string& llvm_ir, const std::string& cache_dir="");
 
         //! Return the evaluator
         ExternalFieldEvalFnPtr getEval()
@@ -30,6 +34,12 @@ class ExternalFieldEvalFactory
             return m_eval;
             }
 
+        //! Check if the object code was loaded from the cache
+        bool isCacheHit()
+            {
+            return m_cache && m_cache->isHit();
+            }
+
         //! Get the error message from initialization
         const std::string& getError()
             {
@@ -37,6 +47,7 @@ class ExternalFieldEvalFactory
             }
 
     private:
+        std::unique_ptr<JITObjectCache> m_cache;           //!< The on-disk object cache (must outlive m_jit)
         std::unique_ptr<llvm::orc::KaleidoscopeJIT> m_jit; //!< The persistent JIT engine
         ExternalFieldEvalFnPtr m_eval;         //!< Function pointer to evaluator
 
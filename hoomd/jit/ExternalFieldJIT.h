@@ -8,6 +8,7 @@
 #include "hoomd/BoxDim.h"
 
 #include "ExternalFieldEvalFactory.h"
+#include "JITFactory.h"
 
 #define EXTERNAL_FIELD_JIT_LOG_NAME           "jit_energy"
 
@@ -33,10 +34,11 @@ class ExternalFieldJIT : public hpmc::ExternalFieldMono<Shape>
     {
     public:
         //! Constructor
-        ExternalFieldJIT(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<ExecutionConfiguration> exec_conf, const std::string& llvm_ir) : hpmc::ExternalFieldMono<Shape>(sysdef)
+        ExternalFieldJIT(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<ExecutionConfiguration> exec_conf, const std::string& llvm_ir,
+                         const std::string& cache_dir="") : hpmc::ExternalFieldMono<Shape>(sysdef)
             {
             // build the JIT.
-            m_factory = std::shared_ptr<ExternalFieldEvalFactory>(new ExternalFieldEvalFactory(llvm_ir));
+            m_factory = makeJITFactory<ExternalFieldEvalFactory>(exec_conf, llvm_ir, cache_dir);
 
             // get the evaluator
             m_eval = m_factory->getEval();
@@ -190,6 +192,7 @@ void export_ExternalFieldJIT(pybind11::module &m, std::string name)
     pybind11::class_<ExternalFieldJIT<Shape>, std::shared_ptr<ExternalFieldJIT<Shape> > >(m, name.c_str(), pybind11::base< hpmc::ExternalFieldMono <Shape> >())
             .def(pybind11::init< std::shared_ptr<SystemDefinition>, 
                                  std::shared_ptr<ExecutionConfiguration>,
+                                 const std::string&,
                                  const std::string& >())
             .def("energy", &ExternalFieldJIT<Shape>::energy);
     }
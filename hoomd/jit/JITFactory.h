@@ -0,0 +1,49 @@
+#ifndef _JIT_FACTORY_H_
+#define _JIT_FACTORY_H_
+
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <memory>
+#include <string>
+
+//! Construct a JIT evaluator factory
+/*! \param exec_conf The execution configuration (used for messages and MPI communication)
+    \param llvm_ir Contents of the LLVM IR to load
+    \param cache_dir Directory to cache the compiled object code in, empty to disable the cache
+
+    Without the cache, every rank compiles the IR. With it, the root rank compiles the IR first and stores the object
+    code, and the other ranks load it after a barrier. When the cache directory is not shared between the nodes, the
+    other ranks miss the cache and compile the IR themselves.
+
+    Factory construction does not throw, errors are reported by the factory after construction. This guarantees that
+    all ranks reach the barrier.
+*/
+template<class Factory>
+std::shared_ptr<Factory> makeJITFactory(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                        const std::string& llvm_ir,
+                                        const std::string& cache_dir)
+    {
+    std::shared_ptr<Factory> factory;
+
+    #ifdef ENABLE_MPI
+    if (!cache_dir.empty() && exec_conf->getNRanks() > 1)
+        {
+        if (exec_conf->isRoot())
+            factory = std::shared_ptr<Factory>(new Factory(llvm_ir, cache_dir));
+        MPI_Barrier(exec_conf->getMPICommunicator());
+        if (!exec_conf->isRoot())
+            factory = std::shared_ptr<Factory>(new Factory(llvm_ir, cache_dir));
+        }
+    else
+    #endif
+        {
+        factory = std::shared_ptr<Factory>(new Factory(llvm_ir, cache_dir));
+        }
+
+    if (factory->isCacheHit())
+        exec_conf->msg->notice(3) << "Loaded JIT code from the cache in " << cache_dir << std::endl;
+
+    return factory;
+    }
+
+#endif // _JIT_FACTORY_H_
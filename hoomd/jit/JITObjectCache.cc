@@ -0,0 +1,93 @@
+#include "JITObjectCache.h"
+
+#include "llvm/Config/llvm-config.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/MD5.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdio.h>
+#include <unistd.h>
+#include <vector>
+
+/*! \param cache_dir Directory to store the objects in
+    \param llvm_ir The IR of the module that will be compiled
+*/
+JITObjectCache::JITObjectCache(const std::string& cache_dir, const std::string& llvm_ir)
+    : m_cache_dir(cache_dir), m_hit(false)
+    {
+    // hash everything that changes the generated code
+    llvm::MD5 hash;
+    hash.update(llvm_ir);
+    hash.update(llvm::StringRef("\0", 1));
+    hash.update(llvm::sys::getProcessTriple());
+    hash.update(llvm::StringRef("\0", 1));
+    hash.update(llvm::sys::getHostCPUName());
+    hash.update(llvm::StringRef("\0", 1));
+    hash.update(LLVM_VERSION_STRING);
+
+    // the feature map is unordered, sort the names for a reproducible key
+    llvm::StringMap<bool> features;
+    if (llvm::sys::getHostCPUFeatures(features))
+        {
+        std::vector<std::string> enabled;
+        for (const auto& f : features)
+            {
+            if (f.getValue())
+                enabled.push_back(f.getKey().str());
+            }
+        std::sort(enabled.begin(), enabled.end());
+        for (const auto& f : enabled)
+            {
+            hash.update(llvm::StringRef("\0", 1));
+            hash.update(f);
+            }
+        }
+
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    llvm::SmallString<32> key;
+    llvm::MD5::stringifyResult(result, key);
+
+    m_filename = m_cache_dir + "/" + key.str().str() + ".o";
+    }
+
+void JITObjectCache::notifyObjectCompiled(const llvm::Module *M, llvm::MemoryBufferRef Obj)
+    {
+    // nothing to store when the object came from the cache
+    if (m_hit)
+        return;
+
+    // the cache is an optimization, so failing to write it is not an error
+    if (llvm::sys::fs::create_directories(m_cache_dir))
+        return;
+
+    // write under a name unique to this process and move the complete file into place
+    std::string tmp_filename = m_filename + ".tmp" + std::to_string(getpid());
+        {
+        std::ofstream out(tmp_filename.c_str(), std::ios::binary);
+        out.write(Obj.getBufferStart(), Obj.getBufferSize());
+        out.close();
+        if (!out)
+            {
+            remove(tmp_filename.c_str());
+            return;
+            }
+        }
+
+    if (rename(tmp_filename.c_str(), m_filename.c_str()) != 0)
+        remove(tmp_filename.c_str());
+    }
+
+std::unique_ptr<llvm::MemoryBuffer> JITObjectCache::getObject(const llvm::Module *M)
+    {
+    auto buffer = llvm::MemoryBuffer::getFile(m_filename);
+    if (!buffer)
+        return nullptr;
+
+    m_hit = true;
+    return std::move(*buffer);
+    }
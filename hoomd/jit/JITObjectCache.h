@@ -0,0 +1,51 @@
+#pragma once
+
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include <memory>
+#include <string>
+
+//! Store the object code compiled from LLVM IR on disk
+/*! Compiling the user supplied IR to machine code dominates the construction of the JIT evaluators. JITObjectCache
+    is passed to the JIT compiler, which asks it for the object code before compiling a module and hands it the object
+    code after compiling it. The objects are stored in files in the cache directory, named by a hash of the IR, the
+    target triple, the host CPU and its features, and the LLVM version. Any change of these compiles the code again.
+
+    Each JITObjectCache handles a single module, so the key is computed once from the IR on construction.
+
+    Files are written to a temporary name and then renamed, so that other processes sharing the cache directory never
+    read a partially written object.
+*/
+class JITObjectCache : public llvm::ObjectCache
+    {
+    public:
+        //! Constructor
+        /*! \param cache_dir Directory to store the objects in
+            \param llvm_ir The IR of the module that will be compiled
+        */
+        JITObjectCache(const std::string& cache_dir, const std::string& llvm_ir);
+
+        //! Store the object code of a newly compiled module
+        virtual void notifyObjectCompiled(const llvm::Module *M, llvm::MemoryBufferRef Obj);
+
+        //! Get the object code of a module, or nullptr if it is not in the cache
+        virtual std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *M);
+
+        //! Get the file the object code is stored in
+        const std::string& getFilename() const
+            {
+            return m_filename;
+            }
+
+        //! Check if the object code was loaded from the cache
+        bool isHit() const
+            {
+            return m_hit;
+            }
+
+    private:
+        std::string m_cache_dir; //!< The cache directory
+        std::string m_filename;  //!< Name of the object file of this module
+        bool m_hit;              //!< True if the object was found in the cache
+    };
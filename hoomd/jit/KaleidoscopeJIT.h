@@ -17,6 +17,7 @@
 #include "llvm/Config/llvm-config.h"
 
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/RTDyldMemoryManager.h"
 #include "llvm/ExecutionEngine/Orc/CompileUtils.h"
 #include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
@@ -64,7 +65,7 @@ public:
   typedef RTDYLDOBJECTLINKINGLAYER ObjLayerT;
   typedef IRCOMPILELAYER<ObjLayerT, SimpleCompiler> CompileLayerT;
   typedef VModuleKey ModuleHandleT;
-  KaleidoscopeJIT()
+  KaleidoscopeJIT(ObjectCache *Cache = nullptr)
       : Resolver(createLegacyLookupResolver(
             ES,
             [this](const std::string &Name) -> JITSymbol {
@@ -84,7 +85,7 @@ public:
                       return RTDYLDOBJECTLINKINGLAYER::Resources{
                           std::make_shared<SectionMemoryManager>(), Resolver};
                     }),
-        CompileLayer(ObjectLayer, SimpleCompiler(*TM)),
+        CompileLayer(ObjectLayer, SimpleCompiler(*TM, Cache)),
         CXXRuntimeOverrides(
             [this](const std::string &S) { return mangle(S); })
         {
@@ -123,10 +124,10 @@ public:
   typedef IRCompileLayer<ObjLayerT, SimpleCompiler> CompileLayerT;
   typedef CompileLayerT::ModuleHandleT ModuleHandleT;
 
-  KaleidoscopeJIT()
+  KaleidoscopeJIT(ObjectCache *Cache = nullptr)
       : TM(EngineBuilder().selectTarget()), DL(TM->createDataLayout()),
         ObjectLayer([]() { return std::make_shared<SectionMemoryManager>(); }),
-        CompileLayer(ObjectLayer, SimpleCompiler(*TM)),
+        CompileLayer(ObjectLayer, SimpleCompiler(*TM, Cache)),
         CXXRuntimeOverrides(
             [this](const std::string &S) { return mangle(S); })
         {
@@ -178,7 +179,8 @@ public:
   typedef IRCompileLayer<ObjLayerT> CompileLayerT;
   typedef CompileLayerT::ModuleSetHandleT ModuleHandleT;
 
-  KaleidoscopeJIT()
+  // object caching is not supported by the compile layer before LLVM 5
+  KaleidoscopeJIT(ObjectCache *Cache = nullptr)
       : TM(EngineBuilder().selectTarget()), DL(TM->createDataLayout()),
         CompileLayer(ObjectLayer, SimpleCompiler(*TM)),
         CXXRuntimeOverrides(
@@ -7,6 +7,7 @@
 #include "hoomd/hpmc/IntegratorHPMC.h"
 
 #include "EvalFactory.h"
+#include "JITFactory.h"
 
 
 //! Evaluate patch energies via runtime generated code
@@ -36,7 +37,7 @@ class PYBIND11_EXPORT PatchEnergyJIT : public hpmc::PatchEnergy
     public:
         //! Constructor
         PatchEnergyJIT(std::shared_ptr<ExecutionConfiguration> exec_conf, const std::string& llvm_ir, Scalar r_cut,
-                       const unsigned int array_size);
+                       const unsigned int array_size, const std::string& cache_dir="");
 
         //! Get the maximum r_ij radius beyond which energies are always 0
         virtual Scalar getRCut()
@@ -76,6 +77,33 @@ class PYBIND11_EXPORT PatchEnergyJIT : public hpmc::PatchEnergy
             return m_eval(r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j);
             }
 
+        //! evaluate the energies of the patch interactions of particle i with many neighbors
+        /*! When the module provides an eval_batch function, all pairs are evaluated in one call into the JIT code.
+            Otherwise, eval is called for each pair.
+        */
+        virtual void energyBatch(unsigned int n,
+            const vec3<float> *r_ij,
+            unsigned int type_i,
+            const quat<float>& q_i,
+            float d_i,
+            float charge_i,
+            const unsigned int *type_j,
+            const quat<float> *q_j,
+            const float *d_j,
+            const float *charge_j,
+            float *energy)
+            {
+            if (m_eval_batch)
+                {
+                m_eval_batch(n, r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j, energy);
+                }
+            else
+                {
+                for (unsigned int k = 0; k < n; ++k)
+                    energy[k] = m_eval(r_ij[k], type_i, q_i, d_i, charge_i, type_j[k], q_j[k], d_j[k], charge_j[k]);
+                }
+            }
+
         static pybind11::object getAlphaNP(pybind11::object self)
             {
             auto self_cpp = self.cast<PatchEnergyJIT *>();
@@ -88,6 +116,7 @@ class PYBIND11_EXPORT PatchEnergyJIT : public hpmc::PatchEnergy
         Scalar m_r_cut;                             //!< Cutoff radius
         std::shared_ptr<EvalFactory> m_factory;       //!< The factory for the evaluator function
         EvalFactory::EvalFnPtr m_eval;                //!< Pointer to evaluator function inside the JIT module
+        EvalFactory::EvalBatchFnPtr m_eval_batch;     //!< Pointer to batched evaluator function (may be NULL)
         float * m_alpha;                            //!< Array containing adjustable elements
         unsigned int m_alpha_size;                  //!< Size of array
     };
@@ -16,12 +16,13 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
             const std::string& llvm_ir_iso, Scalar r_cut_iso,
             const unsigned int array_size_iso,
             const std::string& llvm_ir_union, Scalar r_cut_union,
-            const unsigned int array_size_union)
-            : PatchEnergyJIT(exec_conf, llvm_ir_iso, r_cut_iso, array_size_iso), m_sysdef(sysdef),
+            const unsigned int array_size_union,
+            const std::string& cache_dir="")
+            : PatchEnergyJIT(exec_conf, llvm_ir_iso, r_cut_iso, array_size_iso, cache_dir), m_sysdef(sysdef),
             m_rcut_union(r_cut_union), m_alpha_size_union(array_size_union)
             {
             // build the JIT.
-            m_factory_union = std::shared_ptr<EvalFactory>(new EvalFactory(llvm_ir_union));
+            m_factory_union = makeJITFactory<EvalFactory>(exec_conf, llvm_ir_union, cache_dir);
 
             // get the evaluator
             m_eval_union = m_factory_union->getEval();
@@ -111,6 +112,24 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
             float d_j,
             float charge_j);
 
+        //! evaluate the energies of the patch interactions of particle i with many neighbors
+        /*! Each pair traverses the trees of the constituent particles, so evaluate them one at a time
+        */
+        virtual void energyBatch(unsigned int n,
+            const vec3<float> *r_ij,
+            unsigned int type_i,
+            const quat<float>& q_i,
+            float d_i,
+            float charge_i,
+            const unsigned int *type_j,
+            const quat<float> *q_j,
+            const float *d_j,
+            const float *charge_j,
+            float *energy)
+            {
+            hpmc::PatchEnergy::energyBatch(n, r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j, energy);
+            }
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -16,5 +16,38 @@ existing job scripts may need to be updated. **Maintainer:** Joshua A. Anderson,
 
 from hoomd.hpmc import _hpmc
 
+import os
+
+# directory the compiled object code is cached in, empty when the cache is disabled
+_cache_dir = os.environ.get('HOOMD_JIT_CACHE_DIR', '')
+
+def set_cache_dir(path):
+    R''' Set the directory to cache compiled JIT code in.
+
+    Args:
+        path (str): Directory to store the compiled code in, or None to disable the cache.
+
+    Compiling the LLVM IR to machine code takes a noticeable time when patch energies and external fields are
+    created. With the cache enabled, the machine code is stored in *path* and reused by later simulations that
+    compile the same code on the same type of CPU. In MPI simulations, the root rank compiles the code and the other
+    ranks load it from the cache. *path* should be on a file system shared by all nodes, otherwise ranks on other
+    nodes compile the code themselves.
+
+    The cache applies to patch energies and external fields created after this call. The default is taken from
+    the ``HOOMD_JIT_CACHE_DIR`` environment variable. Remove the files in *path* to clear the cache. The cache
+    requires LLVM 5 or newer, with older versions the code is always compiled.
+
+    Example::
+
+        hoomd.jit.set_cache_dir(os.path.expanduser('~/.cache/hoomd-jit'))
+
+    '''
+    global _cache_dir
+
+    if path is None:
+        _cache_dir = ''
+    else:
+        _cache_dir = os.path.abspath(path)
+
 from hoomd.jit import patch
 from hoomd.jit import external
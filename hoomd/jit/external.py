@@ -140,7 +140,7 @@ class user(field._external):
 
         self.compute_name = "external_field_jit"
         self.cpp_compute = cls(hoomd.context.current.system_definition,
-            hoomd.context.exec_conf, llvm_ir);
+            hoomd.context.exec_conf, llvm_ir, hoomd.jit._cache_dir);
         hoomd.context.current.system.addCompute(self.cpp_compute, self.compute_name)
 
         self.mc = mc
@@ -23,9 +23,22 @@
 
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 
+#include "llvm/Config/llvm-config.h"
+
 using namespace hpmc;
 using namespace hpmc::detail;
 
+//! Determine availability of the on-disk cache of compiled code
+bool is_cache_available()
+   {
+   return
+#if defined LLVM_VERSION_MAJOR && LLVM_VERSION_MAJOR >= 5
+       true;
+#else
+       false;
+#endif
+    }
+
 //! Create the python module
 /*! each class setup their own python exports in a function export_ClassName
  create the hoomd python module and define the exports here.
@@ -33,6 +46,8 @@ using namespace hpmc::detail;
 
 PYBIND11_MODULE(_jit, m)
     {
+    m.def("is_cache_available", &is_cache_available);
+
     export_PatchEnergyJIT(m);
     export_PatchEnergyJITUnion(m);
 
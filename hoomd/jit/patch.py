@@ -124,6 +124,26 @@ class user(object):
 
     ``vec3`` and ``quat`` are defined in HOOMDMath.h.
 
+    The file may also contain an extern "C" function that evaluates all neighbors of particle *i* in one call.
+    HOOMD calls it instead of *eval* when it is present:
+
+    .. code::
+
+        void eval_batch(unsigned int n,
+                        const vec3<float> *r_ij,
+                        unsigned int type_i,
+                        const quat<float>& q_i,
+                        float d_i,
+                        float charge_i,
+                        const unsigned int *type_j,
+                        const quat<float> *q_j,
+                        const float *d_j,
+                        const float *charge_j,
+                        float *energy)
+
+    It must store the energy of the pair with the *k*-th neighbor in ``energy[k]``. Code passed in *code* is
+    compiled with such a function automatically.
+
     Compile the file with clang: ``clang -O3 --std=c++11 -DHOOMD_LLVMJIT_BUILD -I /path/to/hoomd/include -S -emit-llvm code.cc`` to produce
     the LLVM IR in ``code.ll``.
 
@@ -155,7 +175,7 @@ class user(object):
                 llvm_ir = f.read()
 
         self.compute_name = "patch"
-        self.cpp_evaluator = _jit.PatchEnergyJIT(hoomd.context.exec_conf, llvm_ir, r_cut, array_size);
+        self.cpp_evaluator = _jit.PatchEnergyJIT(hoomd.context.exec_conf, llvm_ir, r_cut, array_size, hoomd.jit._cache_dir);
         mc.set_PatchEnergyEvaluator(self);
 
         self.mc = mc
@@ -199,6 +219,23 @@ float eval(const vec3<float>& r_ij,
         cpp_function += code
         cpp_function += """
     }
+
+// evaluate all neighbors of particle i in one call, this loop is inlined and vectorized by clang
+void eval_batch(unsigned int n,
+    const vec3<float> *r_ij,
+    unsigned int type_i,
+    const quat<float>& q_i,
+    float d_i,
+    float charge_i,
+    const unsigned int *type_j,
+    const quat<float> *q_j,
+    const float *d_j,
+    const float *charge_j,
+    float *energy)
+    {
+    for (unsigned int k = 0; k < n; ++k)
+        energy[k] = eval(r_ij[k], type_i, q_i, d_i, charge_i, type_j[k], q_j[k], d_j[k], charge_j[k]);
+    }
 }
 """
 
@@ -355,7 +392,7 @@ class user_union(user):
 
         self.compute_name = "patch_union"
         self.cpp_evaluator = _jit.PatchEnergyJITUnion(hoomd.context.current.system_definition, hoomd.context.exec_conf,
-            llvm_ir_iso, r_cut_iso, array_size_iso, llvm_ir, r_cut,  array_size);
+            llvm_ir_iso, r_cut_iso, array_size_iso, llvm_ir, r_cut,  array_size, hoomd.jit._cache_dir);
         mc.set_PatchEnergyEvaluator(self);
 
         self.mc = mc
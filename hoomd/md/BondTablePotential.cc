@@ -5,6 +5,7 @@
 // Maintainer: phillicl
 
 #include "BondTablePotential.h"
+#include "BondedForceLoop.h"
 #include "hoomd/BondedGroupData.h"
 
 namespace py = pybind11;
@@ -157,8 +158,6 @@ void BondTablePotential::computeForces(unsigned int timestep)
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
-
 
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
@@ -176,42 +175,20 @@ void BondTablePotential::computeForces(unsigned int timestep)
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
 
-    // for each of the bonds
-    const unsigned int size = (unsigned int)m_bond_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // evaluate a single bond, each member receives half of the energy and virial
+    auto eval_bond = [&](const unsigned int *idx, unsigned int type, Scalar4 *force, Scalar *bond_virial)
         {
-        // lookup the tag of each of the particles participating in the bond
-        const BondData::members_t bond = m_bond_data->getMembersByIndex(i);
-        assert(bond.tag[0] < m_pdata->getN());
-        assert(bond.tag[1] < m_pdata->getN());
-
-        // transform a and b into indices into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[bond.tag[0]];
-        unsigned int idx_b = h_rtag.data[bond.tag[1]];
-        assert(idx_a <= m_pdata->getMaximumTag());
-        assert(idx_b <= m_pdata->getMaximumTag());
-
-        // throw an error if this bond is incomplete
-        if (idx_a == NOT_LOCAL || idx_b == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "bond.table: bond " <<
-                bond.tag[0] << " " << bond.tag[1] << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
-        assert(idx_a <= m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_b <= m_pdata->getN() + m_pdata->getNGhosts());
+        unsigned int idx_a = idx[0];
+        unsigned int idx_b = idx[1];
 
         Scalar3 pa = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
         Scalar3 pb = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
         Scalar3 dx = pb-pa;
 
-
         // apply periodic boundary conditions
         dx = box.minImage(dx);
 
         // access needed parameters
-        unsigned int type = m_bond_data->getTypeByIndex(i);
         Scalar4 params = h_params.data[type];
         Scalar rmin = params.x;
         Scalar rmax = params.y;
@@ -222,71 +199,56 @@ void BondTablePotential::computeForces(unsigned int timestep)
         Scalar r = sqrt(rsq);
 
         // only compute the force if the particles are within the region defined by V
-
-        if (r < rmax && r >= rmin)
-            {
-            // precomputed term
-            Scalar value_f = (r - rmin) / delta_r;
-
-            // compute index into the table and read in values
-
-            /// Here we use the table!!
-            unsigned int value_i = (unsigned int)floor(value_f);
-            Scalar2 VF0 = h_tables.data[m_table_value(value_i, type)];
-            Scalar2 VF1 = h_tables.data[m_table_value(value_i+1, type)];
-            // unpack the data
-            Scalar V0 = VF0.x;
-            Scalar V1 = VF1.x;
-            Scalar F0 = VF0.y;
-            Scalar F1 = VF1.y;
-
-            // compute the linear interpolation coefficient
-            Scalar f = value_f - Scalar(value_i);
-
-            // interpolate to get V and F;
-            Scalar V = V0 + f * (V1 - V0);
-            Scalar F = F0 + f * (F1 - F0);
-
-            // convert to standard variables used by the other pair computes in HOOMD-blue
-            Scalar force_divr = Scalar(0.0);
-            if (r > Scalar(0.0))
-                force_divr = F / r;
-            Scalar bond_eng = Scalar(0.5) * V;
-
-            // compute the virial
-            Scalar bond_virial[6];
-            Scalar force_div2r = Scalar(0.5) * force_divr;
-            bond_virial[0] = dx.x * dx.x * force_div2r; // xx
-            bond_virial[1] = dx.x * dx.y * force_div2r; // xy
-            bond_virial[2] = dx.x * dx.z * force_div2r; // xz
-            bond_virial[3] = dx.y * dx.y * force_div2r; // yy
-            bond_virial[4] = dx.y * dx.z * force_div2r; // yz
-            bond_virial[5] = dx.z * dx.z * force_div2r; // zz
-
-            // add the force to the particles
-            // (MEM TRANSFER: 20 Scalars / FLOPS 16)
-            h_force.data[idx_b].x += force_divr * dx.x;
-            h_force.data[idx_b].y += force_divr * dx.y;
-            h_force.data[idx_b].z += force_divr * dx.z;
-            h_force.data[idx_b].w += bond_eng;
-            for (unsigned int i = 0; i < 6; i++)
-                h_virial.data[i*m_virial_pitch+idx_b]  += bond_virial[i];
-
-            h_force.data[idx_a].x -= force_divr * dx.x;
-            h_force.data[idx_a].y -= force_divr * dx.y;
-            h_force.data[idx_a].z -= force_divr * dx.z;
-            h_force.data[idx_a].w += bond_eng;
-            for (unsigned int i = 0; i < 6; i++)
-                h_virial.data[i*m_virial_pitch+idx_a]  += bond_virial[i];
-
-            }
-        else
+        if (!(r < rmax && r >= rmin))
             {
             m_exec_conf->msg->errorAllRanks() << "Table bond out of bounds" << endl;
             throw std::runtime_error("Error in bond calculation");
             }
 
-        }
+        // precomputed term
+        Scalar value_f = (r - rmin) / delta_r;
+
+        // compute index into the table and read in values
+
+        /// Here we use the table!!
+        unsigned int value_i = (unsigned int)floor(value_f);
+        Scalar2 VF0 = h_tables.data[m_table_value(value_i, type)];
+        Scalar2 VF1 = h_tables.data[m_table_value(value_i+1, type)];
+        // unpack the data
+        Scalar V0 = VF0.x;
+        Scalar V1 = VF1.x;
+        Scalar F0 = VF0.y;
+        Scalar F1 = VF1.y;
+
+        // compute the linear interpolation coefficient
+        Scalar f = value_f - Scalar(value_i);
+
+        // interpolate to get V and F;
+        Scalar V = V0 + f * (V1 - V0);
+        Scalar F = F0 + f * (F1 - F0);
+
+        // convert to standard variables used by the other pair computes in HOOMD-blue
+        Scalar force_divr = Scalar(0.0);
+        if (r > Scalar(0.0))
+            force_divr = F / r;
+        Scalar bond_eng = Scalar(0.5) * V;
+
+        // compute the virial
+        Scalar force_div2r = Scalar(0.5) * force_divr;
+        bond_virial[0] = dx.x * dx.x * force_div2r; // xx
+        bond_virial[1] = dx.x * dx.y * force_div2r; // xy
+        bond_virial[2] = dx.x * dx.z * force_div2r; // xz
+        bond_virial[3] = dx.y * dx.y * force_div2r; // yy
+        bond_virial[4] = dx.y * dx.z * force_div2r; // yz
+        bond_virial[5] = dx.z * dx.z * force_div2r; // zz
+
+        force[0] = make_scalar4(-force_divr * dx.x, -force_divr * dx.y, -force_divr * dx.z, bond_eng);
+        force[1] = make_scalar4(force_divr * dx.x, force_divr * dx.y, force_divr * dx.z, bond_eng);
+        };
+
+    compute_bonded_forces(m_exec_conf, m_pdata, m_bond_data, h_force.data, h_virial.data, m_virial_pitch,
+        "bond.table", eval_bond);
+
     if (m_prof) m_prof->pop();
     }
 
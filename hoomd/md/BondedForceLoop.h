@@ -0,0 +1,178 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/BondedGroupData.h"
+#include "hoomd/ParticleData.h"
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+/*! \file BondedForceLoop.h
+    \brief Defines the driver loop shared by the CPU bonded force computes
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __BONDED_FORCE_LOOP_H__
+#define __BONDED_FORCE_LOOP_H__
+
+//! Driver for the CPU evaluation of bonded group forces
+/*! \param exec_conf Execution configuration (used to query the number of threads and for messages)
+    \param pdata Particle data
+    \param group_data Bonded group data (bonds, angles, dihedrals, ...)
+    \param h_force Force array to accumulate into (must be zeroed by the caller)
+    \param h_virial Virial array to accumulate into (must be zeroed by the caller)
+    \param virial_pitch Pitch of the virial array
+    \param log_name Name of the force compute, used in error messages
+    \param eval Functor evaluating a single group
+
+    \a eval is called as eval(idx, type, force, virial) with \a idx the group_size particle indices of the group
+    members in group order and \a type the group type. It must fill in force[j] (force and energy share of member j)
+    for every member and the per-member share of the virial in virial[0..5]. It may throw to signal an error.
+
+    In serial execution, every group is evaluated exactly once and its forces are scattered onto the local members.
+
+    When TBB is enabled and more than one thread is active, the per-particle group table of \a group_data
+    (the same table used by the GPU kernels) is used instead. Every thread then owns a range of local particles and
+    gathers the contributions of all groups its particles take part in. Each group is evaluated once per member, but
+    no two threads ever write to the same force or virial element, so no atomics or reductions are necessary.
+
+    Only forces on local particles are accumulated, ghost particles never receive bonded forces.
+*/
+template<class group_data_t, class Evaluator>
+void compute_bonded_forces(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                           std::shared_ptr<ParticleData> pdata,
+                           std::shared_ptr<group_data_t> group_data,
+                           Scalar4 *h_force,
+                           Scalar *h_virial,
+                           unsigned int virial_pitch,
+                           const std::string& log_name,
+                           const Evaluator& eval)
+    {
+    const unsigned int group_size = group_data_t::size;
+    typedef typename group_data_t::members_t members_t;
+
+    const unsigned int N = pdata->getN();
+
+    #ifdef ENABLE_TBB
+    if (exec_conf->getNumThreads() > 1)
+        {
+        // the group table is rebuilt only when the groups or the particle order changed
+        ArrayHandle<members_t> h_gpu_table(group_data->getGPUTable(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_gpu_pos_table(group_data->getGPUPosTable(), access_location::host,
+            access_mode::read);
+        ArrayHandle<unsigned int> h_n_groups(group_data->getNGroupsArray(), access_location::host,
+            access_mode::read);
+        const Index2D table_indexer = group_data->getGPUTableIndexer();
+
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                {
+                const unsigned int n_groups = h_n_groups.data[i];
+
+                Scalar4 f_i = make_scalar4(0,0,0,0);
+                Scalar virial_i[6] = {0,0,0,0,0,0};
+
+                for (unsigned int k = 0; k < n_groups; ++k)
+                    {
+                    const members_t entry = h_gpu_table.data[table_indexer(i,k)];
+                    const unsigned int pos_in_group = h_gpu_pos_table.data[table_indexer(i,k)];
+
+                    // reassemble the member list in group order, the last element of the entry is the type
+                    unsigned int idx[group_size];
+                    unsigned int n = 0;
+                    for (unsigned int j = 0; j < group_size; ++j)
+                        idx[j] = (j == pos_in_group) ? i : entry.idx[n++];
+                    const unsigned int type = entry.idx[group_size-1];
+
+                    Scalar4 force[group_size];
+                    Scalar virial[6];
+                    eval(idx, type, force, virial);
+
+                    f_i.x += force[pos_in_group].x;
+                    f_i.y += force[pos_in_group].y;
+                    f_i.z += force[pos_in_group].z;
+                    f_i.w += force[pos_in_group].w;
+                    for (unsigned int l = 0; l < 6; ++l)
+                        virial_i[l] += virial[l];
+                    }
+
+                h_force[i].x += f_i.x;
+                h_force[i].y += f_i.y;
+                h_force[i].z += f_i.z;
+                h_force[i].w += f_i.w;
+                for (unsigned int l = 0; l < 6; ++l)
+                    h_virial[l*virial_pitch+i] += virial_i[l];
+                }
+            });
+
+        return;
+        }
+    #endif
+
+    ArrayHandle<unsigned int> h_rtag(pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<members_t> h_groups(group_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(group_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    const unsigned int max_local = N + pdata->getNGhosts();
+
+    const unsigned int n_groups = group_data->getN();
+    for (unsigned int group_idx = 0; group_idx < n_groups; ++group_idx)
+        {
+        const members_t& g = h_groups.data[group_idx];
+
+        // transform the tags into indices into the particle data arrays
+        unsigned int idx[group_size];
+        bool complete = true;
+        for (unsigned int j = 0; j < group_size; ++j)
+            {
+            assert(g.tag[j] <= pdata->getMaximumTag());
+            idx[j] = h_rtag.data[g.tag[j]];
+            if (idx[j] >= max_local)
+                complete = false;
+            }
+
+        // throw an error if this group is incomplete
+        if (!complete)
+            {
+            std::ostringstream oss;
+            oss << log_name << ": " << group_data_t::getName() << " ";
+            for (unsigned int j = 0; j < group_size; ++j)
+                oss << g.tag[j] << " ";
+            oss << "incomplete." << std::endl << std::endl;
+            exec_conf->msg->error() << oss.str();
+            throw std::runtime_error("Error in " + std::string(group_data_t::getName()) + " calculation");
+            }
+
+        Scalar4 force[group_size];
+        Scalar virial[6];
+        eval(idx, h_typeval.data[group_idx].type, force, virial);
+
+        // add the forces to the local members (do not update ghost particles)
+        for (unsigned int j = 0; j < group_size; ++j)
+            {
+            if (idx[j] >= N)
+                continue;
+
+            h_force[idx[j]].x += force[j].x;
+            h_force[idx[j]].y += force[j].y;
+            h_force[idx[j]].z += force[j].z;
+            h_force[idx[j]].w += force[j].w;
+            for (unsigned int l = 0; l < 6; ++l)
+                h_virial[l*virial_pitch+idx[j]] += virial[l];
+            }
+        }
+    }
+
+#endif // __BONDED_FORCE_LOOP_H__
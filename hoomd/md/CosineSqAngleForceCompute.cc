@@ -4,6 +4,7 @@
 
 
 #include "CosineSqAngleForceCompute.h"
+#include "BondedForceLoop.h"
 
 namespace py = pybind11;
 
@@ -118,7 +119,6 @@ void CosineSqAngleForceCompute::computeForces(unsigned int timestep)
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
@@ -128,7 +128,6 @@ void CosineSqAngleForceCompute::computeForces(unsigned int timestep)
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
 
     // Zero data for force calculation.
     memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
@@ -137,33 +136,12 @@ void CosineSqAngleForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getGlobalBox();
 
-    // for each of the angles
-    const unsigned int size = (unsigned int)m_angle_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // evaluate a single angle, each member receives 1/3 of the energy and virial
+    auto eval_angle = [&](const unsigned int *idx, unsigned int angle_type, Scalar4 *force, Scalar *angle_virial)
         {
-        // lookup the tag of each of the particles participating in the angle
-        const AngleData::members_t& angle = m_angle_data->getMembersByIndex(i);
-        assert(angle.tag[0] <= m_pdata->getMaximumTag());
-        assert(angle.tag[1] <= m_pdata->getMaximumTag());
-        assert(angle.tag[2] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indices into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[angle.tag[0]];
-        unsigned int idx_b = h_rtag.data[angle.tag[1]];
-        unsigned int idx_c = h_rtag.data[angle.tag[2]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "angle.cosinesq: angle " <<
-                angle.tag[0] << " " << angle.tag[1] << " " << angle.tag[2] << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in angle calculation");
-            }
-
-        assert(idx_a < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN()+m_pdata->getNGhosts());
+        unsigned int idx_a = idx[0];
+        unsigned int idx_b = idx[1];
+        unsigned int idx_c = idx[2];
 
         // calculate d\vec{r}
         Scalar3 dab;
@@ -176,15 +154,9 @@ void CosineSqAngleForceCompute::computeForces(unsigned int timestep)
         dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
         dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
 
-        Scalar3 dac;
-        dac.x = h_pos.data[idx_a].x - h_pos.data[idx_c].x; // used for the 1-3 JL interaction
-        dac.y = h_pos.data[idx_a].y - h_pos.data[idx_c].y;
-        dac.z = h_pos.data[idx_a].z - h_pos.data[idx_c].z;
-
-        // apply minimum image conventions to all 3 vectors
+        // apply minimum image conventions to both vectors
         dab = box.minImage(dab);
         dcb = box.minImage(dcb);
-        dac = box.minImage(dac);
 
         // this is where cosinesq differs from harmonic
         // FLOPS: 14 / MEM TRANSFER: 2 Scalars
@@ -202,7 +174,6 @@ void CosineSqAngleForceCompute::computeForces(unsigned int timestep)
         if (c_abbc < -1.0) c_abbc = -1.0;
 
         // actually calculate the force
-        unsigned int angle_type = m_angle_data->getTypeByIndex(i);
         Scalar dcosth = c_abbc - cos(m_t_0[angle_type]);  // = cos(t) - cos(t0)
         Scalar tk = m_K[angle_type]*dcosth;  // = k(cos(t) - cos(t0))
 
@@ -227,7 +198,6 @@ void CosineSqAngleForceCompute::computeForces(unsigned int timestep)
 
         // compute 1/3 of the virial, 1/3 for each atom in the angle
         // upper triangular version of virial tensor
-        Scalar angle_virial[6];
         angle_virial[0] = Scalar(1./3.) * ( dab.x*fab[0] + dcb.x*fcb[0] );
         angle_virial[1] = Scalar(1./3.) * ( dab.y*fab[0] + dcb.y*fcb[0] );
         angle_virial[2] = Scalar(1./3.) * ( dab.z*fab[0] + dcb.z*fcb[0] );
@@ -235,38 +205,14 @@ void CosineSqAngleForceCompute::computeForces(unsigned int timestep)
         angle_virial[4] = Scalar(1./3.) * ( dab.z*fab[1] + dcb.z*fcb[1] );
         angle_virial[5] = Scalar(1./3.) * ( dab.z*fab[2] + dcb.z*fcb[2] );
 
-        // Now, apply the force to each individual atom a,b,c, and accumulate the energy/virial
-        // do not update ghost particles
-        if (idx_a < m_pdata->getN())
-            {
-            h_force.data[idx_a].x += fab[0];
-            h_force.data[idx_a].y += fab[1];
-            h_force.data[idx_a].z += fab[2];
-            h_force.data[idx_a].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_a]  += angle_virial[j];
-            }
-
-        if (idx_b < m_pdata->getN())
-            {
-            h_force.data[idx_b].x -= fab[0] + fcb[0];
-            h_force.data[idx_b].y -= fab[1] + fcb[1];
-            h_force.data[idx_b].z -= fab[2] + fcb[2];
-            h_force.data[idx_b].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_b]  += angle_virial[j];
-            }
-
-        if (idx_c < m_pdata->getN())
-            {
-            h_force.data[idx_c].x += fcb[0];
-            h_force.data[idx_c].y += fcb[1];
-            h_force.data[idx_c].z += fcb[2];
-            h_force.data[idx_c].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_c]  += angle_virial[j];
-            }
-        }
+        // apply the force to each individual atom a,b,c
+        force[0] = make_scalar4(fab[0], fab[1], fab[2], angle_eng);
+        force[1] = make_scalar4(-fab[0] - fcb[0], -fab[1] - fcb[1], -fab[2] - fcb[2], angle_eng);
+        force[2] = make_scalar4(fcb[0], fcb[1], fcb[2], angle_eng);
+        };
+
+    compute_bonded_forces(m_exec_conf, m_pdata, m_angle_data, h_force.data, h_virial.data, virial_pitch,
+        "angle.cosinesq", eval_angle);
 
     if (m_prof) m_prof->pop();
     }
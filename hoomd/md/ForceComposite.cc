@@ -9,6 +9,11 @@
 
 #include <map>
 #include <string.h>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 namespace py = pybind11;
 
 /*! \file ForceComposite.cc
@@ -19,6 +24,7 @@ namespace py = pybind11;
 */
 ForceComposite::ForceComposite(std::shared_ptr<SystemDefinition> sysdef)
         : MolecularForceCompute(sysdef), m_bodies_changed(false), m_ptls_added_removed(false),
+         m_body_packed_dirty(true),
          m_global_max_d(0.0),
          m_memory_initialized(false),
          #ifdef ENABLE_MPI
@@ -206,6 +212,7 @@ void ForceComposite::setParam(unsigned int body_typeid,
                 }
             }
         m_bodies_changed = true;
+        m_body_packed_dirty = true;
         assert(m_d_max_changed.size() > body_typeid);
 
         // make sure central particle will be communicated
@@ -264,6 +271,47 @@ Scalar ForceComposite::getBodyDiameter(unsigned int body_type)
     return d_max;
     }
 
+/*! The GlobalArrays m_body_pos and m_body_orientation are laid out with the body type as the fast index, which suits
+    the GPU kernels. The CPU code walks over the constituents of one body at a time, so it uses a copy in which all
+    constituents of a body type are stored contiguously.
+ */
+void ForceComposite::updatePackedBodies()
+    {
+    lazyInitMem();
+
+    if (!m_body_packed_dirty)
+        return;
+
+    ArrayHandle<unsigned int> h_body_len(m_body_len, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_body_pos(m_body_pos, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_body_orientation(m_body_orientation, access_location::host, access_mode::read);
+
+    unsigned int ntypes = m_body_len.getNumElements();
+    m_body_offset.resize(ntypes+1);
+
+    unsigned int offset = 0;
+    for (unsigned int type = 0; type < ntypes; ++type)
+        {
+        m_body_offset[type] = offset;
+        offset += h_body_len.data[type];
+        }
+    m_body_offset[ntypes] = offset;
+
+    m_body_pos_packed.resize(offset);
+    m_body_orientation_packed.resize(offset);
+
+    for (unsigned int type = 0; type < ntypes; ++type)
+        {
+        for (unsigned int i = 0; i < h_body_len.data[type]; ++i)
+            {
+            m_body_pos_packed[m_body_offset[type]+i] = h_body_pos.data[m_body_idx(type,i)];
+            m_body_orientation_packed[m_body_offset[type]+i] = h_body_orientation.data[m_body_idx(type,i)];
+            }
+        }
+
+    m_body_packed_dirty = false;
+    }
+
 void ForceComposite::slotNumTypesChange()
     {
     //! initial allocation if necessary
@@ -298,6 +346,8 @@ void ForceComposite::slotNumTypesChange()
 
     m_body_max_diameter.resize(new_ntypes,0.0);
 
+    m_body_packed_dirty = true;
+
     //! update memory hints, after re-allocation
     lazyInitMem();
     }
@@ -784,8 +834,10 @@ void ForceComposite::computeForces(unsigned int timestep)
     ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
 
     // access rigid body definition
-    ArrayHandle<Scalar3> h_body_pos(m_body_pos, access_location::host, access_mode::read);
+    updatePackedBodies();
     ArrayHandle<unsigned int> h_body_len(m_body_len, access_location::host, access_mode::read);
+    const Scalar3 *body_pos = m_body_pos_packed.data();
+    const unsigned int *body_offset = m_body_offset.data();
 
     // reset constraint forces and torques
     memset(h_force.data,0, sizeof(Scalar4)*m_pdata->getN());
@@ -802,8 +854,8 @@ void ForceComposite::computeForces(unsigned int timestep)
         compute_virial = true;
         }
 
-    // loop over all molecules, also incomplete ones
-    for (unsigned int ibody = 0; ibody < nmol; ibody++)
+    // every molecule only writes to its own central particle and constituents, so molecules are independent
+    auto process_molecule = [&](unsigned int ibody)
         {
         unsigned int len = h_molecule_length.data[ibody];
 
@@ -817,7 +869,7 @@ void ForceComposite::computeForces(unsigned int timestep)
         assert(central_tag <= m_pdata->getMaximumTag());
         unsigned int central_idx = h_rtag.data[central_tag];
 
-        if (central_idx >= nptl_local) continue;
+        if (central_idx >= nptl_local) return;
 
         // the central ptl must be present
         assert(central_tag == h_tag.data[first_idx]);
@@ -868,7 +920,7 @@ void ForceComposite::computeForces(unsigned int timestep)
                 h_force.data[central_idx].w += net_force.w;
 
                 // fetch relative position from rigid body definition
-                vec3<Scalar> dr(h_body_pos.data[m_body_idx(type, jptl - 1)]);
+                vec3<Scalar> dr(body_pos[body_offset[type] + jptl - 1]);
 
                 // rotate into space frame
                 vec3<Scalar> dr_space = rotate(orientation, dr);
@@ -914,7 +966,15 @@ void ForceComposite::computeForces(unsigned int timestep)
             h_net_virial.data[4*net_virial_pitch+idxj] = 0.0;
             h_net_virial.data[5*net_virial_pitch+idxj] = 0.0;
             }
-        }
+        };
+
+    // loop over all molecules, also incomplete ones
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, nmol, process_molecule);
+    #else
+    for (unsigned int ibody = 0; ibody < nmol; ibody++)
+        process_molecule(ibody);
+    #endif
     }
 
 /* Set position and velocity of constituent particles in rigid bodies in the 1st or second half of integration on the CPU
@@ -943,9 +1003,11 @@ void ForceComposite::updateCompositeParticles(unsigned int timestep)
     ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
     // access body positions and orientations
-    ArrayHandle<Scalar3> h_body_pos(m_body_pos, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_body_orientation(m_body_orientation, access_location::host, access_mode::read);
+    updatePackedBodies();
     ArrayHandle<unsigned int> h_body_len(m_body_len, access_location::host, access_mode::read);
+    const Scalar3 *body_pos = m_body_pos_packed.data();
+    const Scalar4 *body_orientation = m_body_orientation_packed.data();
+    const unsigned int *body_offset = m_body_offset.data();
 
     const BoxDim& box = m_pdata->getBox();
     const BoxDim& global_box = m_pdata->getGlobalBox();
@@ -953,19 +1015,20 @@ void ForceComposite::updateCompositeParticles(unsigned int timestep)
     // we need to update both local and ghost particles
     unsigned int nptl = m_pdata->getN() + m_pdata->getNGhosts();
 
-    for (unsigned int iptl = 0; iptl < nptl; iptl++)
+    // every particle only updates itself from its (never modified) central particle
+    auto update_particle = [&](unsigned int iptl)
         {
         unsigned int central_tag = h_body.data[iptl];
 
         if (central_tag >= MIN_FLOPPY)
-            continue;
+            return;
 
         // body tag equals tag for central ptl
         assert(central_tag <= m_pdata->getMaximumTag());
         unsigned int central_idx = h_rtag.data[central_tag];
 
         if (central_idx == NOT_LOCAL && iptl >= m_pdata->getN())
-            continue;
+            return;
 
         if (central_idx == NOT_LOCAL)
             {
@@ -978,7 +1041,7 @@ void ForceComposite::updateCompositeParticles(unsigned int timestep)
         assert(central_idx <= m_pdata->getN() + m_pdata->getNGhosts());
 
         // do not overwrite the central ptl
-        if (iptl == central_idx) continue;
+        if (iptl == central_idx) return;
 
         Scalar4 postype = h_postype.data[central_idx];
         vec3<Scalar> pos(postype);
@@ -1000,7 +1063,7 @@ void ForceComposite::updateCompositeParticles(unsigned int timestep)
                 }
 
             // otherwise we must ignore it
-            continue;
+            return;
             }
 
         int3 img = h_image.data[central_idx];
@@ -1009,12 +1072,12 @@ void ForceComposite::updateCompositeParticles(unsigned int timestep)
         assert(h_molecule_order.data[iptl] > 0);
         unsigned int idx_in_body = h_molecule_order.data[iptl] - 1;
 
-        vec3<Scalar> local_pos(h_body_pos.data[m_body_idx(type,idx_in_body)]);
+        vec3<Scalar> local_pos(body_pos[body_offset[type] + idx_in_body]);
         vec3<Scalar> dr_space = rotate(orientation, local_pos);
 
         // update position and orientation
         vec3<Scalar> updated_pos(pos);
-        quat<Scalar> local_orientation(h_body_orientation.data[m_body_idx(type, idx_in_body)]);
+        quat<Scalar> local_orientation(body_orientation[body_offset[type] + idx_in_body]);
 
         updated_pos += dr_space;
         quat<Scalar> updated_orientation = orientation*local_orientation;
@@ -1028,7 +1091,14 @@ void ForceComposite::updateCompositeParticles(unsigned int timestep)
         h_postype.data[iptl] = make_scalar4(updated_pos.x, updated_pos.y, updated_pos.z, h_postype.data[iptl].w);
         h_orientation.data[iptl] = quat_to_scalar4(updated_orientation);
         h_image.data[iptl] = img+imgi;
-        }
+        };
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, nptl, update_particle);
+    #else
+    for (unsigned int iptl = 0; iptl < nptl; iptl++)
+        update_particle(iptl);
+    #endif
     }
 
 void export_ForceComposite(py::module& m)
@@ -86,6 +86,11 @@ class PYBIND11_EXPORT ForceComposite : public MolecularForceCompute
         std::vector<std::vector<Scalar> > m_body_diameter;    //!< Constituent ptl diameters
         Index2D m_body_idx;                     //!< Indexer for body parameters
 
+        std::vector<Scalar3> m_body_pos_packed;          //!< Constituent ptl offsets, contiguous per body type (CPU)
+        std::vector<Scalar4> m_body_orientation_packed;  //!< Constituent ptl orientations, contiguous per body type (CPU)
+        std::vector<unsigned int> m_body_offset;         //!< Offset of each body type into the packed arrays
+        bool m_body_packed_dirty;                        //!< True if the packed body definitions need to be rebuilt
+
         std::vector<Scalar> m_d_max;                              //!< Maximum body diameter per constituent particle type
         std::vector<bool> m_d_max_changed;                        //!< True if maximum body diameter changed (per type)
         std::vector<Scalar> m_body_max_diameter;                  //!< List of diameters for all body types
@@ -156,6 +161,9 @@ class PYBIND11_EXPORT ForceComposite : public MolecularForceCompute
         //! Initialize memory
         virtual void lazyInitMem();
 
+        //! Rebuild the contiguous per-body copy of the body definitions used by the CPU code path
+        void updatePackedBodies();
+
     private:
         #ifdef ENABLE_MPI
         bool m_comm_ghost_layer_connected; //!< Track if we have already connected ghost layer width requests
@@ -7,6 +7,15 @@
 #include "ForceDistanceConstraint.h"
 
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <tuple>
+#include <unordered_map>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 using namespace Eigen;
 namespace py = pybind11;
 
@@ -21,7 +30,8 @@ ForceDistanceConstraint::ForceDistanceConstraint(std::shared_ptr<SystemDefinitio
           m_cmatrix(m_exec_conf), m_cvec(m_exec_conf), m_lagrange(m_exec_conf),
           m_rel_tol(1e-3), m_constraint_violated(m_exec_conf), m_condition(m_exec_conf),
           m_sparse_idxlookup(m_exec_conf), m_constraint_reorder(true), m_constraints_added_removed(true),
-          m_d_max(0.0)
+          m_d_max(0.0), m_solver(block), m_iter_tol(1e-8), m_max_iter(100), m_blocks_dirty(true),
+          m_lagrange_valid(false)
     {
     m_constraint_violated.resetFlags(0);
 
@@ -63,7 +73,11 @@ void ForceDistanceConstraint::computeForces(unsigned int timestep)
 
     // reallocate through amortized resizin
     unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
-    m_cmatrix.resize(n_constraint*n_constraint);
+    if (m_solver == sparse)
+        {
+        // only the global solver needs the full matrix
+        m_cmatrix.resize(n_constraint*n_constraint);
+        }
     m_cvec.resize(n_constraint);
 
     // populate the terms in the matrix vector equation
@@ -84,6 +98,12 @@ void ForceDistanceConstraint::computeForces(unsigned int timestep)
 
 void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
     {
+    if (m_solver != sparse)
+        {
+        fillBlockVector(timestep);
+        return;
+        }
+
     // fill the matrix in column-major order
     unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
 
@@ -264,6 +284,12 @@ void ForceDistanceConstraint::checkConstraints(unsigned int timestep)
 
 void ForceDistanceConstraint::solveConstraints(unsigned int timestep)
     {
+    if (m_solver != sparse)
+        {
+        solveBlocks(timestep);
+        return;
+        }
+
     // use Eigen dense matrix algebra (slow for large matrices)
     typedef Matrix<double, Dynamic, Dynamic, ColMajor> matrix_t;
     typedef Matrix<double, Dynamic, 1> vec_t;
@@ -372,6 +398,387 @@ void ForceDistanceConstraint::solveConstraints(unsigned int timestep)
         m_prof->pop();
     }
 
+/*! The constraints are grouped by the molecule tag of their first particle. Within a molecule, the constraints
+    are sorted by the tags of their members, so that copies of the same molecule list their members in the same
+    relative order, and share the same BlockTopology.
+*/
+void ForceDistanceConstraint::buildBlocks()
+    {
+    // label the molecules if the global constraint topology has changed
+    if (m_constraints_added_removed)
+        {
+        assignMoleculeTags();
+        m_constraints_added_removed = false;
+        }
+
+    unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
+
+    ArrayHandle<ConstraintData::members_t> h_members(m_cdata->getMembersArray(), access_location::host,
+        access_mode::read);
+    ArrayHandle<unsigned int> h_molecule_tag(m_molecule_tag, access_location::host, access_mode::read);
+
+    // sort by (molecule, first tag, second tag)
+    std::vector< std::tuple<unsigned int, unsigned int, unsigned int, unsigned int> > order(n_constraint);
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        const ConstraintData::members_t constraint = h_members.data[n];
+        assert(constraint.tag[0] < m_molecule_tag.getNumElements());
+        order[n] = std::make_tuple(h_molecule_tag.data[constraint.tag[0]], constraint.tag[0], constraint.tag[1], n);
+        }
+    std::sort(order.begin(), order.end());
+
+    m_block_offset.clear();
+    m_block_topology.clear();
+    m_block_constraints.resize(n_constraint);
+
+    std::vector<unsigned int> members;
+    std::unordered_map<unsigned int, unsigned int> local_idx;
+    unsigned int first = 0;
+    while (first < n_constraint)
+        {
+        const unsigned int molecule = std::get<0>(order[first]);
+
+        // members of the molecule, numbered by first appearance
+        members.clear();
+        local_idx.clear();
+        unsigned int last = first;
+        for (; last < n_constraint && std::get<0>(order[last]) == molecule; ++last)
+            {
+            m_block_constraints[last] = std::get<3>(order[last]);
+            for (unsigned int tag : {std::get<1>(order[last]), std::get<2>(order[last])})
+                {
+                auto it = local_idx.insert(std::make_pair(tag, (unsigned int)local_idx.size())).first;
+                members.push_back(it->second);
+                }
+            }
+
+        // find the non-zero pattern for this topology, computing it only if it is new
+        unsigned int topology;
+        auto it = m_topology_map.find(members);
+        if (it != m_topology_map.end())
+            {
+            topology = it->second;
+            }
+        else
+            {
+            const unsigned int n_block = last - first;
+            BlockTopology pattern;
+            pattern.row_offset.resize(n_block+1);
+            for (unsigned int row = 0; row < n_block; ++row)
+                {
+                pattern.row_offset[row] = pattern.couplings.size();
+                const unsigned int a = members[2*row];
+                const unsigned int b = members[2*row+1];
+                for (unsigned int col = 0; col < n_block; ++col)
+                    {
+                    const unsigned int col_a = members[2*col];
+                    const unsigned int col_b = members[2*col+1];
+
+                    BlockCoupling coupling;
+                    coupling.row = row;
+                    coupling.col = col;
+                    coupling.sign_a = int(col_a == a) - int(col_b == a);
+                    coupling.sign_b = int(col_b == b) - int(col_a == b);
+                    if (coupling.sign_a != 0 || coupling.sign_b != 0)
+                        pattern.couplings.push_back(coupling);
+                    }
+                }
+            pattern.row_offset[n_block] = pattern.couplings.size();
+
+            topology = m_topologies.size();
+            m_topologies.push_back(pattern);
+            m_topology_map.insert(std::make_pair(members, topology));
+            }
+
+        m_block_offset.push_back(first);
+        m_block_topology.push_back(topology);
+        first = last;
+        }
+    m_block_offset.push_back(n_constraint);
+
+    m_exec_conf->msg->notice(6) << "ForceDistanceConstraint: " << m_block_topology.size() << " molecules with "
+        << m_topologies.size() << " distinct topologies" << std::endl;
+    }
+
+/*! Computes the same right hand side as fillMatrixVector(), but instead of the full matrix, only the vectors
+    needed to compute the elements of each molecule's matrix are stored.
+*/
+void ForceDistanceConstraint::fillBlockVector(unsigned int timestep)
+    {
+    unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
+
+    if (m_blocks_dirty)
+        {
+        buildBlocks();
+        m_blocks_dirty = false;
+        }
+
+    m_rn.resize(n_constraint);
+    m_qn.resize(n_constraint);
+    m_inv_mass.resize(n_constraint);
+
+    // access particle data
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(), access_location::host, access_mode::read);
+
+    // access constraints
+    ArrayHandle<ConstraintData::members_t> h_members(m_cdata->getMembersArray(), access_location::host,
+        access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_cdata->getTypeValArray(), access_location::host, access_mode::read);
+
+    ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::overwrite);
+
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // index + 1 of a violated and of an incomplete constraint
+    std::atomic<unsigned int> violated(0);
+    std::atomic<unsigned int> incomplete(0);
+
+    auto fill_range = [&](unsigned int first, unsigned int last)
+        {
+        for (unsigned int n = first; n < last; ++n)
+            {
+            const ConstraintData::members_t constraint = h_members.data[n];
+            assert(constraint.tag[0] <= m_pdata->getMaximumTag());
+            assert(constraint.tag[1] <= m_pdata->getMaximumTag());
+
+            unsigned int idx_a = h_rtag.data[constraint.tag[0]];
+            unsigned int idx_b = h_rtag.data[constraint.tag[1]];
+
+            if (idx_a >= max_local || idx_b >= max_local)
+                {
+                incomplete = n+1;
+                continue;
+                }
+
+            vec3<Scalar> ra(h_pos.data[idx_a]);
+            vec3<Scalar> rb(h_pos.data[idx_b]);
+            vec3<Scalar> rn(ra-rb);
+
+            // apply minimum image
+            rn = box.minImage(rn);
+
+            vec3<Scalar> va(h_vel.data[idx_a]);
+            Scalar ma(h_vel.data[idx_a].w);
+            vec3<Scalar> vb(h_vel.data[idx_b]);
+            Scalar mb(h_vel.data[idx_b].w);
+
+            vec3<Scalar> rndot(va-vb);
+            vec3<Scalar> qn(rn+rndot*m_deltaT);
+
+            m_rn[n] = rn;
+            m_qn[n] = qn;
+            m_inv_mass[n] = make_scalar2(Scalar(1.0)/ma, Scalar(1.0)/mb);
+
+            // get constraint distance
+            Scalar d = h_typeval.data[n].val;
+
+            // check distance violation
+            if (fast::sqrt(dot(rn,rn))-d >= m_rel_tol*d || std::isnan(dot(rn,rn)))
+                {
+                violated = n+1;
+                }
+
+            // fill vector component
+            h_cvec.data[n] = (dot(qn,qn)-d*d)/m_deltaT/m_deltaT;
+            h_cvec.data[n] += double(2.0)*dot(qn,vec3<Scalar>(h_netforce.data[idx_a])/ma
+                  -vec3<Scalar>(h_netforce.data[idx_b])/mb);
+            }
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_constraint),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            fill_range(r.begin(), r.end());
+            });
+        }
+    else
+    #endif
+        {
+        fill_range(0, n_constraint);
+        }
+
+    if (incomplete)
+        {
+        const ConstraintData::members_t constraint = h_members.data[incomplete-1];
+        this->m_exec_conf->msg->error() << "constrain.distance(): constraint " <<
+            constraint.tag[0] << " " << constraint.tag[1] << " incomplete." << std::endl << std::endl;
+        throw std::runtime_error("Error in constraint calculation");
+        }
+
+    if (violated)
+        {
+        m_constraint_violated.resetFlags(violated);
+        }
+    }
+
+/*! Each molecule's matrix is assembled from its BlockTopology and solved independently, either by a dense LU
+    decomposition, or by Gauss-Seidel iteration. Molecules that do not converge within the maximum number of
+    sweeps, or whose iteration produces a non-finite multiplier, are solved directly instead.
+*/
+void ForceDistanceConstraint::solveBlocks(unsigned int timestep)
+    {
+    typedef Matrix<double, Dynamic, Dynamic, ColMajor> matrix_t;
+    typedef Matrix<double, Dynamic, 1> vec_t;
+
+    unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
+
+    // skip if zero constraints
+    if (n_constraint == 0) return;
+
+    if (m_prof)
+        m_prof->push("solve");
+
+    // the previous multipliers are a good initial guess, unless the constraints have been reordered
+    const bool warm_start = m_lagrange_valid && m_lagrange.size() == n_constraint;
+
+    // reallocate array of constraint forces
+    m_lagrange.resize(n_constraint);
+
+    ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
+    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::readwrite);
+
+    const unsigned int n_blocks = m_block_topology.size();
+    std::atomic<unsigned int> n_singular(0);
+    std::atomic<unsigned int> n_fallback(0);
+
+    auto solve_range = [&](unsigned int first, unsigned int last)
+        {
+        matrix_t A;
+        vec_t b;
+        vec_t x;
+        std::vector<double> val;
+
+        for (unsigned int block = first; block < last; ++block)
+            {
+            const unsigned int *constraints = m_block_constraints.data() + m_block_offset[block];
+            const unsigned int n_block = m_block_offset[block+1] - m_block_offset[block];
+            const BlockTopology& topology = m_topologies[m_block_topology[block]];
+
+            // values of the non-zero elements
+            val.resize(topology.couplings.size());
+            for (unsigned int c = 0; c < topology.couplings.size(); ++c)
+                {
+                const BlockCoupling& coupling = topology.couplings[c];
+                const unsigned int n = constraints[coupling.row];
+                const unsigned int m = constraints[coupling.col];
+                val[c] = double(4.0)*dot(m_qn[n],m_rn[m])
+                    *(coupling.sign_a*m_inv_mass[n].x + coupling.sign_b*m_inv_mass[n].y);
+                }
+
+            bool converged = false;
+            if (m_solver == iterative)
+                {
+                if (!warm_start)
+                    {
+                    for (unsigned int row = 0; row < n_block; ++row)
+                        h_lagrange.data[constraints[row]] = 0.0;
+                    }
+
+                bool finite = true;
+                for (unsigned int iter = 0; iter < m_max_iter && !converged && finite; ++iter)
+                    {
+                    double max_delta(0.0);
+                    double max_lagrange(0.0);
+                    for (unsigned int row = 0; row < n_block; ++row)
+                        {
+                        double diag(0.0);
+                        double rhs = h_cvec.data[constraints[row]];
+                        for (unsigned int c = topology.row_offset[row]; c < topology.row_offset[row+1]; ++c)
+                            {
+                            const unsigned int col = topology.couplings[c].col;
+                            if (col == row)
+                                diag = val[c];
+                            else
+                                rhs -= val[c]*h_lagrange.data[constraints[col]];
+                            }
+
+                        double& lagrange = h_lagrange.data[constraints[row]];
+                        const double lagrange_new = rhs/diag;
+
+                        // a zero diagonal gives inf or NaN, and std::max below silently skips a NaN
+                        if (!std::isfinite(lagrange_new))
+                            {
+                            finite = false;
+                            break;
+                            }
+
+                        max_delta = std::max(max_delta, std::abs(lagrange_new - lagrange));
+                        max_lagrange = std::max(max_lagrange, std::abs(lagrange_new));
+                        lagrange = lagrange_new;
+                        }
+
+                    converged = finite && max_delta <= m_iter_tol*max_lagrange;
+                    }
+
+                if (!converged)
+                    ++n_fallback;
+                }
+
+            if (!converged)
+                {
+                A.setZero(n_block, n_block);
+                b.resize(n_block);
+                for (unsigned int c = 0; c < topology.couplings.size(); ++c)
+                    {
+                    A(topology.couplings[c].row, topology.couplings[c].col) = val[c];
+                    }
+                for (unsigned int row = 0; row < n_block; ++row)
+                    {
+                    b(row) = h_cvec.data[constraints[row]];
+                    }
+
+                x = A.partialPivLu().solve(b);
+
+                for (unsigned int row = 0; row < n_block; ++row)
+                    {
+                    if (!std::isfinite(x(row)))
+                        ++n_singular;
+                    h_lagrange.data[constraints[row]] = x(row);
+                    }
+                }
+            }
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_blocks),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            solve_range(r.begin(), r.end());
+            });
+        }
+    else
+    #endif
+        {
+        solve_range(0, n_blocks);
+        }
+
+    if (n_singular)
+        {
+        m_exec_conf->msg->error() << "Could not solve linear system of constraint equations." << std::endl;
+        throw std::runtime_error("Error evaluating constraint forces.\n");
+        }
+
+    if (n_fallback)
+        {
+        m_exec_conf->msg->notice(6) << "ForceDistanceConstraint: iteration did not converge for " << n_fallback
+            << " molecules, solved directly" << std::endl;
+        }
+
+    m_lagrange_valid = true;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 void ForceDistanceConstraint::computeConstraintForces(unsigned int timestep)
     {
     ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::read);
@@ -476,7 +883,8 @@ CommFlags ForceDistanceConstraint::getRequestedCommFlags(unsigned int timestep)
 
 //! Return maximum extent of molecule
 Scalar ForceDistanceConstraint::dfs(unsigned int iconstraint, unsigned int molecule, std::vector<int>& visited,
-    unsigned int *label, std::vector<ConstraintData::members_t>& groups, std::vector<Scalar>& length)
+    unsigned int *label, std::vector<ConstraintData::members_t>& groups, std::vector<Scalar>& length,
+    const std::vector<unsigned int>& ptl_offset, const std::vector<unsigned int>& ptl_constraints)
     {
     assert(iconstraint < groups.size());
 
@@ -497,21 +905,21 @@ Scalar ForceDistanceConstraint::dfs(unsigned int iconstraint, unsigned int molec
     label[constraint.tag[0]] = molecule;
     label[constraint.tag[1]] = molecule;
 
-    // NOTE: this loop could be optimized with a reverse-lookup table ptl idx -> constraint
     assert(iconstraint < length.size());
     Scalar dmax = length[iconstraint];
 
-    for (unsigned int jconstraint = 0; jconstraint < groups.size(); ++jconstraint)
+    // loop over the constraints sharing a particle with this one, using the reverse-lookup table ptl tag -> constraint
+    for (unsigned int i = 0; i < 2; ++i)
         {
-        ConstraintData::members_t tags_j = groups[jconstraint];
+        const unsigned int tag = constraint.tag[i];
+        for (unsigned int k = ptl_offset[tag]; k < ptl_offset[tag+1]; ++k)
+            {
+            unsigned int jconstraint = ptl_constraints[k];
 
-        if (iconstraint == jconstraint) continue;
+            if (iconstraint == jconstraint) continue;
 
-        if (tags_j.tag[0] == constraint.tag[0] || tags_j.tag[1] == constraint.tag[0] ||
-            tags_j.tag[0] == constraint.tag[1] || tags_j.tag[1] == constraint.tag[1])
-            {
             // recursively mark connected constraint with current label
-            dmax += dfs(jconstraint, molecule, visited, label, groups, length);
+            dmax += dfs(jconstraint, molecule, visited, label, groups, length, ptl_offset, ptl_constraints);
             }
         }
 
@@ -551,7 +959,8 @@ void ForceDistanceConstraint::assignMoleculeTags()
 
     // walk through the global constraints and connect molecules
 
-    unsigned int nconstraint_global = snap.size;
+    // (the snapshot is only populated on the root rank, so use the broadcast list)
+    unsigned int nconstraint_global = groups.size();
     std::vector<int> visited(nconstraint_global,0);
 
     // label per ptl (-1 == no label)
@@ -566,6 +975,27 @@ void ForceDistanceConstraint::assignMoleculeTags()
         h_molecule_tag.data[i] = NO_MOLECULE;
         }
 
+    // reverse-lookup table ptl tag -> constraints (in compressed row format)
+    std::vector<unsigned int> ptl_offset(nptl+1, 0);
+    for (unsigned int iconstraint = 0; iconstraint < nconstraint_global; ++iconstraint)
+        {
+        ++ptl_offset[groups[iconstraint].tag[0]+1];
+        ++ptl_offset[groups[iconstraint].tag[1]+1];
+        }
+    for (unsigned int i = 0; i < nptl; ++i)
+        {
+        ptl_offset[i+1] += ptl_offset[i];
+        }
+    std::vector<unsigned int> ptl_constraints(ptl_offset[nptl]);
+        {
+        std::vector<unsigned int> ptl_count(ptl_offset.begin(), ptl_offset.end()-1);
+        for (unsigned int iconstraint = 0; iconstraint < nconstraint_global; ++iconstraint)
+            {
+            ptl_constraints[ptl_count[groups[iconstraint].tag[0]]++] = iconstraint;
+            ptl_constraints[ptl_count[groups[iconstraint].tag[1]]++] = iconstraint;
+            }
+        }
+
     int molecule = 0;
 
     // maximum molecule diameter
@@ -578,7 +1008,8 @@ void ForceDistanceConstraint::assignMoleculeTags()
             if (! visited[iconstraint])
                 {
                 // depth first search
-                Scalar d = dfs(iconstraint, molecule++, visited, h_molecule_tag.data, groups, length);
+                Scalar d = dfs(iconstraint, molecule++, visited, h_molecule_tag.data, groups, length,
+                    ptl_offset, ptl_constraints);
                 if (d > m_d_max)
                     {
                     m_d_max = d;
@@ -593,8 +1024,18 @@ void ForceDistanceConstraint::assignMoleculeTags()
 
 void export_ForceDistanceConstraint(py::module& m)
     {
-    py::class_< ForceDistanceConstraint, std::shared_ptr<ForceDistanceConstraint> >(m, "ForceDistanceConstraint", py::base<MolecularForceCompute>())
-        .def(py::init< std::shared_ptr<SystemDefinition> >())
+    py::class_< ForceDistanceConstraint, std::shared_ptr<ForceDistanceConstraint> > constraint(m, "ForceDistanceConstraint", py::base<MolecularForceCompute>());
+    constraint.def(py::init< std::shared_ptr<SystemDefinition> >())
         .def("setRelativeTolerance", &ForceDistanceConstraint::setRelativeTolerance)
+        .def("setSolver", &ForceDistanceConstraint::setSolver)
+        .def("getSolver", &ForceDistanceConstraint::getSolver)
+        .def("setIterativeParams", &ForceDistanceConstraint::setIterativeParams)
+    ;
+
+    py::enum_<ForceDistanceConstraint::solverMode>(constraint, "solverMode")
+        .value("sparse", ForceDistanceConstraint::solverMode::sparse)
+        .value("block", ForceDistanceConstraint::solverMode::block)
+        .value("iterative", ForceDistanceConstraint::solverMode::iterative)
+        .export_values()
     ;
     }
@@ -25,12 +25,25 @@
 #include "hoomd/extern/Eigen/Eigen/Dense"
 #include "hoomd/extern/Eigen/Eigen/SparseLU"
 
+#include <map>
+#include <vector>
+
 /*! Implements a pairwise distance constraint using the algorithm of
 
     [1] M. Yoneya, H. J. C. Berendsen, and K. Hirasawa, “A Non-Iterative Matrix Method for Constraint Molecular Dynamics Simulations,” Mol. Simul., vol. 13, no. 6, pp. 395–405, 1994.
     [2] M. Yoneya, “A Generalized Non-iterative Matrix Method for Constraint Molecular Dynamics Simulations,” J. Comput. Phys., vol. 172, no. 1, pp. 188–197, Sep. 2001.
 
     See Integrator for detailed documentation on constraint force implementation.
+
+    Constraints only couple if they share a particle, so the constraint matrix is block diagonal with one block
+    per molecule (as labeled by assignMoleculeTags()). On the CPU, the constraint equation is by default solved
+    molecule by molecule (solverMode::block), and molecules are processed in parallel when TBB is enabled. The
+    non-zero pattern of a block only depends on the topology of the molecule, so it is computed once for each
+    distinct topology and shared by all molecules with that topology. For large molecules, the blocks may instead
+    be solved by Gauss-Seidel iteration (solverMode::iterative), which is warm started from the multipliers of the
+    previous step and falls back to the direct solution if it does not converge. solverMode::sparse solves the
+    whole system with one sparse LU decomposition, and is always used by the GPU implementation.
+
     \ingroup computes
 */
 class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
@@ -48,12 +61,43 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
             return m_cdata->getNGlobal();
             }
 
+        //! Methods to solve the constraint equation
+        enum solverMode
+            {
+            sparse,     //!< Sparse LU decomposition of the full constraint matrix
+            block,      //!< Dense LU decomposition of the matrix of each molecule
+            iterative   //!< Gauss-Seidel iteration on the matrix of each molecule
+            };
+
         //! Set the relative tolerance for constraint warnings
         void setRelativeTolerance(Scalar rel_tol)
             {
             m_rel_tol = rel_tol;
             }
 
+        //! Set the method used to solve the constraint equation
+        void setSolver(solverMode solver)
+            {
+            m_solver = solver;
+            m_lagrange_valid = false;
+            }
+
+        //! Get the method used to solve the constraint equation
+        solverMode getSolver() const
+            {
+            return m_solver;
+            }
+
+        //! Set the convergence criteria for the iterative solver
+        /*! \param tol Relative tolerance on the change of the Lagrange multipliers in one sweep
+            \param max_iter Maximum number of sweeps before falling back to the direct solution
+        */
+        void setIterativeParams(Scalar tol, unsigned int max_iter)
+            {
+            m_iter_tol = tol;
+            m_max_iter = max_iter;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
@@ -83,6 +127,37 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
 
         Scalar m_d_max;                    //!< Maximum constraint extension
 
+        solverMode m_solver;               //!< Method to solve the constraint equation
+        Scalar m_iter_tol;                 //!< Relative tolerance of the iterative solver
+        unsigned int m_max_iter;           //!< Maximum number of sweeps of the iterative solver
+
+        //! Non-zero element of the constraint matrix of a molecule
+        struct BlockCoupling
+            {
+            unsigned int row;   //!< Constraint in the molecule giving the row
+            unsigned int col;   //!< Constraint in the molecule giving the column
+            int sign_a;         //!< Sign of the term for the first particle of the row constraint
+            int sign_b;         //!< Sign of the term for the second particle of the row constraint
+            };
+
+        //! Non-zero pattern of the constraint matrix of a molecule
+        struct BlockTopology
+            {
+            std::vector<unsigned int> row_offset;   //!< Offset of the couplings of each row
+            std::vector<BlockCoupling> couplings;   //!< Non-zero elements, sorted by row
+            };
+
+        std::vector<BlockTopology> m_topologies;    //!< Distinct molecule topologies
+        std::map< std::vector<unsigned int>, unsigned int > m_topology_map; //!< Members of a molecule -> topology
+        std::vector<unsigned int> m_block_offset;      //!< Offset of the constraints of each molecule
+        std::vector<unsigned int> m_block_constraints; //!< Constraint indices, grouped by molecule
+        std::vector<unsigned int> m_block_topology;    //!< Topology of each molecule
+        std::vector< vec3<Scalar> > m_rn;              //!< Separation of the particles in each constraint
+        std::vector< vec3<Scalar> > m_qn;              //!< Extrapolated separation in each constraint
+        std::vector<Scalar2> m_inv_mass;               //!< Inverse masses of the particles in each constraint
+        bool m_blocks_dirty;               //!< True if the constraints need to be regrouped by molecule
+        bool m_lagrange_valid;             //!< True if m_lagrange holds the last solution in the current order
+
         //! Compute the forces
         virtual void computeForces(unsigned int timestep);
 
@@ -98,16 +173,29 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         //! Solve the linear matrix-vector equation
         virtual void computeConstraintForces(unsigned int timestep);
 
+        //! Group the constraints by molecule
+        void buildBlocks();
+
+        //! Populate the terms of the constraint-force equation needed by the block solvers
+        void fillBlockVector(unsigned int timestep);
+
+        //! Solve the constraint equation molecule by molecule
+        void solveBlocks(unsigned int timestep);
+
         //! Method called when constraint order changes
         virtual void slotConstraintReorder()
             {
             m_constraint_reorder = true;
+            m_blocks_dirty = true;
+            m_lagrange_valid = false;
             }
 
         //! Method called when constraint order changes
         virtual void slotConstraintsAddedRemoved()
             {
             m_constraints_added_removed = true;
+            m_blocks_dirty = true;
+            m_lagrange_valid = false;
             }
 
         //! Returns the requested ghost layer width for all types
@@ -134,7 +222,8 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     private:
         //! Helper function to perform a depth-first search
         Scalar dfs(unsigned int iconstraint, unsigned int molecule, std::vector<int>& visited,
-            unsigned int *label, std::vector<ConstraintData::members_t>& groups, std::vector<Scalar>& length);
+            unsigned int *label, std::vector<ConstraintData::members_t>& groups, std::vector<Scalar>& length,
+            const std::vector<unsigned int>& ptl_offset, const std::vector<unsigned int>& ptl_constraints);
 
         #ifdef ENABLE_MPI
         bool m_comm_ghost_layer_connected = false; //!< Track if we have already connected to ghost layer width requests
@@ -32,6 +32,9 @@ ForceDistanceConstraintGPU::ForceDistanceConstraintGPU(std::shared_ptr<SystemDef
     m_tuner_fill.reset(new Autotuner(32, 1024, 32, 5, 100000, "dist_constraint_fill_matrix_vec", this->m_exec_conf));
     m_tuner_force.reset(new Autotuner(32, 1024, 32, 5, 100000, "dist_constraint_force", this->m_exec_conf));
 
+    // the GPU implementation always solves the full sparse system
+    m_solver = sparse;
+
     #ifdef CUSOLVER_AVAILABLE
     // initialize cuSPARSE
     cusparseCreate(&m_cusparse_handle);
@@ -7,6 +7,7 @@
 
 
 #include "HarmonicImproperForceCompute.h"
+#include "BondedForceLoop.h"
 
 #include <iostream>
 #include <sstream>
@@ -118,7 +119,6 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
@@ -128,7 +128,6 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
 
     // Zero data for force calculation.
     memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
@@ -137,37 +136,14 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
-    // for each of the impropers
-    const unsigned int size = (unsigned int)m_improper_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // evaluate a single improper, each member receives 1/4 of the energy and virial
+    auto eval_improper = [&](const unsigned int *idx, unsigned int improper_type,
+                             Scalar4 *force, Scalar *improper_virial)
         {
-        // lookup the tag of each of the particles participating in the improper
-        const ImproperData::members_t& improper = m_improper_data->getMembersByIndex(i);
-        assert(improper.tag[0] <= m_pdata->getMaximumTag());
-        assert(improper.tag[1] <= m_pdata->getMaximumTag());
-        assert(improper.tag[2] <= m_pdata->getMaximumTag());
-        assert(improper.tag[3] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indices into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[improper.tag[0]];
-        unsigned int idx_b = h_rtag.data[improper.tag[1]];
-        unsigned int idx_c = h_rtag.data[improper.tag[2]];
-        unsigned int idx_d = h_rtag.data[improper.tag[3]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "improper.harmonic: improper " <<
-                improper.tag[0] << " " << improper.tag[1] << " " << improper.tag[2] << " " << improper.tag[3]
-                << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in improper calculation");
-            }
-
-        assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_d < m_pdata->getN() + m_pdata->getNGhosts());
+        unsigned int idx_a = idx[0];
+        unsigned int idx_b = idx[1];
+        unsigned int idx_c = idx[2];
+        unsigned int idx_d = idx[3];
 
         // calculate d\vec{r}
         Scalar3 dab;
@@ -220,7 +196,6 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
         Scalar s = sqrt(1.0 - c*c);
         if (s < SMALL) s = SMALL;
 
-        unsigned int improper_type = m_improper_data->getTypeByIndex(i);
         Scalar domega = acos(c) - m_chi[improper_type];
         Scalar a = m_K[improper_type] * domega;
 
@@ -263,7 +238,6 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
 
         // and calculate the virial (upper triangular version)
         // compute 1/4 of the virial, 1/4 for each atom in the improper
-        Scalar improper_virial[6];
         improper_virial[0] = (1./4.)*(dab.x*ffax + dcb.x*ffcx + (ddc.x+dcb.x)*ffdx);
         improper_virial[1] = (1./4.)*(dab.y*ffax + dcb.y*ffcx + (ddc.y+dcb.y)*ffdx);
         improper_virial[2] = (1./4.)*(dab.z*ffax + dcb.z*ffcx + (ddc.z+dcb.z)*ffdx);
@@ -271,47 +245,14 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
         improper_virial[4] = (1./4.)*(dab.z*ffay + dcb.z*ffcy + (ddc.z+dcb.z)*ffdy);
         improper_virial[5] = (1./4.)*(dab.z*ffaz + dcb.z*ffcz + (ddc.z+dcb.z)*ffdz);
 
-        if (idx_a < m_pdata->getN())
-            {
-            // accumulate the forces
-            h_force.data[idx_a].x += ffax;
-            h_force.data[idx_a].y += ffay;
-            h_force.data[idx_a].z += ffaz;
-            h_force.data[idx_a].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_a]  += improper_virial[k];
-            }
-
-        if (idx_b < m_pdata->getN())
-            {
-            h_force.data[idx_b].x += ffbx;
-            h_force.data[idx_b].y += ffby;
-            h_force.data[idx_b].z += ffbz;
-            h_force.data[idx_b].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_b]  += improper_virial[k];
-            }
-
-        if (idx_c < m_pdata->getN())
-            {
-            h_force.data[idx_c].x += ffcx;
-            h_force.data[idx_c].y += ffcy;
-            h_force.data[idx_c].z += ffcz;
-            h_force.data[idx_c].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_c]  += improper_virial[k];
-            }
-
-        if (idx_d < m_pdata->getN())
-            {
-            h_force.data[idx_d].x += ffdx;
-            h_force.data[idx_d].y += ffdy;
-            h_force.data[idx_d].z += ffdz;
-            h_force.data[idx_d].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_d]  += improper_virial[k];
-            }
-        }
+        force[0] = make_scalar4(ffax, ffay, ffaz, improper_eng);
+        force[1] = make_scalar4(ffbx, ffby, ffbz, improper_eng);
+        force[2] = make_scalar4(ffcx, ffcy, ffcz, improper_eng);
+        force[3] = make_scalar4(ffdx, ffdy, ffdz, improper_eng);
+        };
+
+    compute_bonded_forces(m_exec_conf, m_pdata, m_improper_data, h_force.data, h_virial.data, virial_pitch,
+        "improper.harmonic", eval_improper);
 
     if (m_prof) m_prof->pop();
     }
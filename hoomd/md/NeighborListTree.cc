@@ -11,6 +11,12 @@
 #include "NeighborListTree.h"
 #include "hoomd/SystemDefinition.h"
 
+#include <atomic>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 namespace py = pybind11;
 
 #ifdef ENABLE_MPI
@@ -24,7 +30,7 @@ NeighborListTree::NeighborListTree(std::shared_ptr<SystemDefinition> sysdef,
                                        Scalar r_cut,
                                        Scalar r_buff)
     : NeighborList(sysdef, r_cut, r_buff), m_box_changed(true), m_max_num_changed(true), m_remap_particles(true),
-      m_type_changed(true), m_n_images(0)
+      m_type_changed(true), m_tree_valid(false), m_n_images(0), m_last_build_n(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing NeighborListTree" << endl;
 
@@ -61,6 +67,7 @@ void NeighborListTree::setupTree()
         {
         m_aabbs.resize(m_pdata->getMaxN());
         m_map_pid_tree.resize(m_pdata->getMaxN());
+        m_last_build_pos.resize(m_pdata->getMaxN());
 
         m_max_num_changed = false;
         }
@@ -188,12 +195,48 @@ void NeighborListTree::updateImageVectors()
         }
     }
 
+/*!
+ * The trees can be refit when they were built from the same particles in the same order, and no particle has moved
+ * by more than the buffer distance since. Positions are compared without wrapping, so a particle crossing the
+ * boundary forces a rebuild. In MPI simulations, the ghost particles change with every exchange, so the trees are
+ * always rebuilt.
+ *
+ * \returns True if the trees can be refit to the current positions
+ */
+bool NeighborListTree::canRefitTree()
+    {
+    if (!m_tree_valid)
+        return false;
+
+    #ifdef ENABLE_MPI
+    if (m_comm)
+        return false;
+    #endif
+
+    unsigned int n_local = m_pdata->getN() + m_pdata->getNGhosts();
+    if (n_local != m_last_build_n)
+        return false;
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    const Scalar rbuffsq = m_r_buff*m_r_buff;
+    for (unsigned int i=0; i < n_local; ++i)
+        {
+        vec3<Scalar> dr = vec3<Scalar>(h_postype.data[i]) - m_last_build_pos[i];
+        if (dot(dr,dr) >= rbuffsq)
+            return false;
+        }
+
+    return true;
+    }
+
 /*!
  * \note AABBTree implements its own build routine, so this is a wrapper to call this for multiple tree types.
  */
 void NeighborListTree::buildTree()
     {
-    if (this->m_prof) this->m_prof->push("Build");
+    bool refit = canRefitTree();
+
+    if (this->m_prof) this->m_prof->push(refit ? "Refit" : "Build");
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<AABB> h_aabbs(m_aabbs, access_location::host, access_mode::readwrite);
 
@@ -212,7 +255,9 @@ void NeighborListTree::buildTree()
         }
 
     // construct a point AABB for each particle owned by this rank, and push it into the right spot in the AABB list
-    for (unsigned int i=0; i < m_pdata->getN()+m_pdata->getNGhosts(); ++i)
+    unsigned int n_local = m_pdata->getN() + m_pdata->getNGhosts();
+    std::atomic<unsigned int> out_of_bounds(n_local);
+    auto make_aabb = [&](unsigned int i)
         {
         // make a point particle AABB
         vec3<Scalar> my_pos(h_postype.data[i]);
@@ -227,17 +272,33 @@ void NeighborListTree::buildTree()
             (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001)) ||
             (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001))) && i < m_pdata->getN())
             {
-            ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
-            m_exec_conf->msg->errorAllRanks() << "nlist.tree(): Particle " << h_tag.data[i] << " is out of bounds "
-                                              << "(x: " << my_pos.x << ", y: " << my_pos.y << ", z: " << my_pos.z
-                                              << ", fx: "<< f.x <<", fy: "<<f.y<<", fz:"<<f.z<<")"<<endl;
-            throw runtime_error("Error updating neighborlist");
+            // report after the loop, so that the error is not raised from a worker thread
+            out_of_bounds = i;
             return;
             }
 
         unsigned int my_type = __scalar_as_int(h_postype.data[i].w);
         unsigned int my_aabb_idx = m_type_head[my_type] + m_map_pid_tree[i];
         h_aabbs.data[my_aabb_idx] = AABB(my_pos,i);
+        };
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, n_local, make_aabb);
+    #else
+    for (unsigned int i=0; i < n_local; ++i)
+        make_aabb(i);
+    #endif
+
+    if (out_of_bounds < n_local)
+        {
+        unsigned int i = out_of_bounds;
+        vec3<Scalar> my_pos(h_postype.data[i]);
+        Scalar3 f = box.makeFraction(vec_to_scalar3(my_pos),ghost_width);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        m_exec_conf->msg->errorAllRanks() << "nlist.tree(): Particle " << h_tag.data[i] << " is out of bounds "
+                                          << "(x: " << my_pos.x << ", y: " << my_pos.y << ", z: " << my_pos.z
+                                          << ", fx: "<< f.x <<", fy: "<<f.y<<", fz:"<<f.z<<")"<<endl;
+        throw runtime_error("Error updating neighborlist");
         }
 
     // call the tree build routine, one tree per type
@@ -245,9 +306,23 @@ void NeighborListTree::buildTree()
         {
         if (m_num_per_type[i] > 0)
             {
-            m_aabb_trees[i].buildTree(&(h_aabbs.data[0]) + m_type_head[i], m_num_per_type[i]);
+            if (refit)
+                m_aabb_trees[i].refit(&(h_aabbs.data[0]) + m_type_head[i]);
+            else
+                m_aabb_trees[i].buildTreeLBVH(&(h_aabbs.data[0]) + m_type_head[i], m_num_per_type[i]);
             }
         }
+
+    if (!refit)
+        {
+        // remember where the particles were when the trees were built
+        for (unsigned int i=0; i < n_local; ++i)
+            m_last_build_pos[i] = vec3<Scalar>(h_postype.data[i]);
+
+        m_last_build_n = n_local;
+        m_tree_valid = true;
+        }
+
     if (this->m_prof) this->m_prof->pop();
     }
 
@@ -275,8 +350,8 @@ void NeighborListTree::traverseTree()
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
-    // Loop over all particles
-    for (unsigned int i=0; i < m_pdata->getN(); ++i)
+    // process all particles, each one writes only to its own part of the neighbor list
+    auto process_particle = [&](unsigned int i)
         {
         // read in the current position and orientation
         const Scalar4 postype_i = h_postype.data[i];
@@ -362,8 +437,6 @@ void NeighborListTree::traverseTree()
                                             {
                                             if (n_neigh_i < Nmax_i)
                                                 h_nlist.data[nlist_head_i + n_neigh_i] = j;
-                                            else
-                                                h_conditions.data[type_i] = max(h_conditions.data[type_i], n_neigh_i+1);
 
                                             ++n_neigh_i;
                                             }
@@ -381,7 +454,22 @@ void NeighborListTree::traverseTree()
                 } // end loop over images
             } // end loop over pair types
             h_n_neigh.data[i] = n_neigh_i;
-        } // end loop over particles
+        }; // end process_particle
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, m_pdata->getN(), process_particle);
+    #else
+    for (unsigned int i=0; i < m_pdata->getN(); ++i)
+        process_particle(i);
+    #endif
+
+    // flag any overflowing particles after the parallel loop to avoid races on the conditions
+    for (unsigned int i=0; i < m_pdata->getN(); ++i)
+        {
+        const unsigned int type_i = __scalar_as_int(h_postype.data[i].w);
+        if (h_n_neigh.data[i] > h_Nmax.data[type_i])
+            h_conditions.data[type_i] = max(h_conditions.data[type_i], h_n_neigh.data[i]);
+        }
 
     if (this->m_prof) this->m_prof->pop();
     }
@@ -25,11 +25,15 @@
 /*!
  * A bounding volume hierarchy (BVH) tree is a binary search tree. It is constructed from axis-aligned bounding boxes
  * (AABBs). The AABB for a node in the tree encloses all child AABBs. A leaf AABB holds multiple particles. The tree
- * is constructed in a balanced way using a heuristic to minimize AABB volume. We build one tree per particle type,
+ * is constructed from the Morton order of the particles. We build one tree per particle type,
  * and use point AABBs for the particles. The neighbor list is built by traversing down the tree with an AABB
  * that encloses the pairwise cutoff for the particle. Periodic boundaries are treated by translating the query AABB
  * by all possible image vectors, many of which are trivially rejected for not intersecting the root node.
  *
+ * The trees are built as linear BVHs from Morton codes, which is parallelized with TBB. When the particles have moved
+ * less than the buffer distance since the last build and the set of particles is unchanged, the trees are only
+ * refit to the new positions instead of being rebuilt. The traversal is parallelized over particles.
+ *
  * Because one tree is built per type, complications can arise if particles change type "on the fly" during a
  * a simulation. At present, there is no signal for the types of particles changing (only the total number of types).
  * Any class directly modifying the types of particles \b must signal this change to NeighborListTree using
@@ -57,30 +61,35 @@ class PYBIND11_EXPORT NeighborListTree : public NeighborList
         void slotBoxChanged()
             {
             m_box_changed = true;
+            m_tree_valid = false;
             }
 
         //! Notification of a max number of particle change
         void slotMaxNumChanged()
             {
             m_max_num_changed = true;
+            m_tree_valid = false;
             }
 
         //! Notification of a particle sort
         void slotRemapParticles()
             {
             m_remap_particles = true;
+            m_tree_valid = false;
             }
 
         //! Notification of a number of types change
         void slotNumTypesChanged()
             {
             m_type_changed = true;
+            m_tree_valid = false;
             }
 
         bool m_box_changed;                                 //!< Flag if box size has changed
         bool m_max_num_changed;                             //!< Flag if the particle arrays need to be resized
         bool m_remap_particles;                             //!< Flag if the particles need to remapped (triggered by sort)
         bool m_type_changed;                                //!< Flag if the number of types has changed
+        bool m_tree_valid;                                  //!< Flag if the trees hold the current particles
 
         // we use stl vectors here because these tree data structures should *never* be
         // accessed on the GPU, they were optimized for the CPU with SIMD support
@@ -93,6 +102,9 @@ class PYBIND11_EXPORT NeighborListTree : public NeighborList
         std::vector< vec3<Scalar> > m_image_list;    //!< List of translation vectors
         unsigned int m_n_images;                //!< The number of image vectors to check
 
+        std::vector< vec3<Scalar> > m_last_build_pos;   //!< Particle positions at the last full tree build
+        unsigned int m_last_build_n;                    //!< Number of particles (with ghosts) at the last full build
+
         //! Driver for tree configuration
         void setupTree();
 
@@ -105,6 +117,9 @@ class PYBIND11_EXPORT NeighborListTree : public NeighborList
         //! Driver to build AABB trees
         void buildTree();
 
+        //! Checks if the trees can be refit instead of rebuilt
+        bool canRefitTree();
+
         //! Traverses AABB trees to compute neighbors
         void traverseTree();
     };
@@ -7,6 +7,7 @@
 
 
 #include "OPLSDihedralForceCompute.h"
+#include "BondedForceLoop.h"
 
 namespace py = pybind11;
 
@@ -109,7 +110,6 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     // access the force and virial tensor arrays
     ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
@@ -126,54 +126,29 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
 
     unsigned int virial_pitch = m_virial.getPitch();
 
-    // From LAMMPS OPLS dihedral implementation
-    unsigned int i1,i2,i3,i4,n,dihedral_type;
-    Scalar3 vb1,vb2,vb3,vb2m;
-    Scalar4 f1,f2,f3,f4;
-    Scalar ax,ay,az,bx,by,bz,rasq,rbsq,rgsq,rg,rginv,ra2inv,rb2inv,rabinv;
-    Scalar df,df1,ddf1,fg,hg,fga,hgb,gaa,gbb;
-    Scalar dtfx,dtfy,dtfz,dtgx,dtgy,dtgz,dthx,dthy,dthz;
-    Scalar c,s,p,sx2,sy2,sz2,cos_term,e_dihedral;
-    Scalar k1,k2,k3,k4;
-    Scalar dihedral_virial[6];
-
     // get a local copy of the simulation box
     const BoxDim& box = m_pdata->getBox();
 
-    // iterate through each dihedral
-    const unsigned int numDihedrals = (unsigned int)m_dihedral_data->getN();
-    for (n = 0; n < numDihedrals; n++)
+    // evaluate a single dihedral, each member receives 1/4 of the energy and virial
+    auto eval_dihedral = [&](const unsigned int *idx, unsigned int dihedral_type,
+                             Scalar4 *force, Scalar *dihedral_virial)
         {
-        // lookup the tag of each of the particles participating in the dihedral
-        const ImproperData::members_t& dihedral = m_dihedral_data->getMembersByIndex(n);
-        assert(dihedral.tag[0] < m_pdata->getNGlobal());
-        assert(dihedral.tag[1] < m_pdata->getNGlobal());
-        assert(dihedral.tag[2] < m_pdata->getNGlobal());
-        assert(dihedral.tag[3] < m_pdata->getNGlobal());
-
-        // i1 to i4 are the tags
-        i1 = h_rtag.data[dihedral.tag[0]];
-        i2 = h_rtag.data[dihedral.tag[1]];
-        i3 = h_rtag.data[dihedral.tag[2]];
-        i4 = h_rtag.data[dihedral.tag[3]];
-
-        // throw an error if this angle is incomplete
-        if (i1 == NOT_LOCAL|| i2 == NOT_LOCAL || i3 == NOT_LOCAL || i4 == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "dihedral.opls: dihedral " <<
-                dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
-                << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in dihedral calculation");
-            }
-
-        assert(i1 < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(i2 < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(i3 < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(i4 < m_pdata->getN() + m_pdata->getNGhosts());
+        unsigned int i1 = idx[0];
+        unsigned int i2 = idx[1];
+        unsigned int i3 = idx[2];
+        unsigned int i4 = idx[3];
+
+        // From LAMMPS OPLS dihedral implementation
+        Scalar3 vb1,vb2,vb3,vb2m;
+        Scalar4 f1,f2,f3,f4;
+        Scalar ax,ay,az,bx,by,bz,rasq,rbsq,rgsq,rg,rginv,ra2inv,rb2inv,rabinv;
+        Scalar df,df1,ddf1,fg,hg,fga,hgb,gaa,gbb;
+        Scalar dtfx,dtfy,dtfz,dtgx,dtgy,dtgz,dthx,dthy,dthz;
+        Scalar c,s,p,sx2,sy2,sz2,cos_term,e_dihedral;
+        Scalar k1,k2,k3,k4;
 
         // 1st bond
 
@@ -231,7 +206,6 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
 
         // get values for k1/2 through k4/2
         // ----- The 1/2 factor is already stored in the parameters --------
-        dihedral_type = m_dihedral_data->getTypeByIndex(n);
         k1 = h_params.data[dihedral_type].x;
         k2 = h_params.data[dihedral_type].y;
         k3 = h_params.data[dihedral_type].z;
@@ -316,24 +290,6 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
         f3.z = -sz2 - f4.z;
         f3.w = e_dihedral;
 
-        // Apply force to each of the 4 atoms
-        h_force.data[i1].x += f1.x;
-        h_force.data[i1].y += f1.y;
-        h_force.data[i1].z += f1.z;
-        h_force.data[i1].w += f1.w;
-        h_force.data[i2].x += f2.x;
-        h_force.data[i2].y += f2.y;
-        h_force.data[i2].z += f2.z;
-        h_force.data[i2].w += f2.w;
-        h_force.data[i3].x += f3.x;
-        h_force.data[i3].y += f3.y;
-        h_force.data[i3].z += f3.z;
-        h_force.data[i3].w += f3.w;
-        h_force.data[i4].x += f4.x;
-        h_force.data[i4].y += f4.y;
-        h_force.data[i4].z += f4.z;
-        h_force.data[i4].w += f4.w;
-
         // Compute 1/4 of the virial, 1/4 for each atom in the dihedral
         // upper triangular version of virial tensor
         dihedral_virial[0] = 0.25*(vb1.x*f1.x + vb2.x*f3.x + (vb3.x+vb2.x)*f4.x);
@@ -343,14 +299,15 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
         dihedral_virial[4] = 0.25*(vb1.z*f1.y + vb2.z*f3.y + (vb3.z+vb2.z)*f4.y);
         dihedral_virial[5] = 0.25*(vb1.z*f1.z + vb2.z*f3.z + (vb3.z+vb2.z)*f4.z);
 
-        for (int k = 0; k < 6; k++)
-            {
-            h_virial.data[virial_pitch*k+i1]  += dihedral_virial[k];
-            h_virial.data[virial_pitch*k+i2]  += dihedral_virial[k];
-            h_virial.data[virial_pitch*k+i3]  += dihedral_virial[k];
-            h_virial.data[virial_pitch*k+i4]  += dihedral_virial[k];
-            }
-        }
+        // Apply force to each of the 4 atoms
+        force[0] = f1;
+        force[1] = f2;
+        force[2] = f3;
+        force[3] = f4;
+        };
+
+    compute_bonded_forces(m_exec_conf, m_pdata, m_dihedral_data, h_force.data, h_virial.data, virial_pitch,
+        "dihedral.opls", eval_dihedral);
 
     if (m_prof) m_prof->pop();
     }
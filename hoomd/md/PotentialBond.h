@@ -4,6 +4,7 @@
 #include <memory>
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
+#include "BondedForceLoop.h"
 
 #include <vector>
 
@@ -149,7 +150,6 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
 
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
@@ -178,36 +178,11 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
-    Scalar bond_virial[6];
-    for (unsigned int i = 0; i< 6; i++)
-        bond_virial[i]=Scalar(0.0);
-
-    ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(), access_location::host, access_mode::read);
-    ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(), access_location::host, access_mode::read);
-
-    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
-
-    // for each of the bonds
-    const unsigned int size = (unsigned int)m_bond_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // evaluate a single bond, each member receives half of the energy and virial
+    auto eval_bond = [&](const unsigned int *idx, unsigned int type, Scalar4 *force, Scalar *bond_virial)
         {
-        // lookup the tag of each of the particles participating in the bond
-        const typename BondData::members_t& bond = h_bonds.data[i];
-        assert(bond.tag[0] < m_pdata->getMaximumTag()+1);
-        assert(bond.tag[1] < m_pdata->getMaximumTag()+1);
-
-        // transform a and b into indices into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[bond.tag[0]];
-        unsigned int idx_b = h_rtag.data[bond.tag[1]];
-
-        // throw an error if this bond is incomplete
-        if (idx_a >= max_local || idx_b >= max_local)
-            {
-            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond " <<
-                bond.tag[0] << " " << bond.tag[1] << " incomplete." << std::endl << std::endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
+        unsigned int idx_a = idx[0];
+        unsigned int idx_b = idx[1];
 
         // calculate d\vec{r}
         // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
@@ -241,7 +216,7 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
         Scalar rsq = dot(dx,dx);
 
         // get parameters for this bond type
-        param_type param = h_params.data[h_typeval.data[i].type];
+        param_type param = h_params.data[type];
 
         // compute the force and potential energy
         Scalar force_divr = Scalar(0.0);
@@ -254,52 +229,30 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
 
         bool evaluated = eval.evalForceAndEnergy(force_divr, bond_eng);
 
-        // Bond energy must be halved
-        bond_eng *= Scalar(0.5);
-
-        if (evaluated)
-            {
-            // calculate virial
-            if (compute_virial)
-                {
-                Scalar force_div2r = Scalar(1.0/2.0)*force_divr;
-                bond_virial[0] = dx.x * dx.x * force_div2r; // xx
-                bond_virial[1] = dx.x * dx.y * force_div2r; // xy
-                bond_virial[2] = dx.x * dx.z * force_div2r; // xz
-                bond_virial[3] = dx.y * dx.y * force_div2r; // yy
-                bond_virial[4] = dx.y * dx.z * force_div2r; // yz
-                bond_virial[5] = dx.z * dx.z * force_div2r; // zz
-                }
-
-            // add the force to the particles (only for non-ghost particles)
-            if (idx_b < m_pdata->getN())
-                {
-                h_force.data[idx_b].x += force_divr * dx.x;
-                h_force.data[idx_b].y += force_divr * dx.y;
-                h_force.data[idx_b].z += force_divr * dx.z;
-                h_force.data[idx_b].w += bond_eng;
-                if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i*m_virial_pitch+idx_b]  += bond_virial[i];
-                }
-
-            if (idx_a < m_pdata->getN())
-                {
-                h_force.data[idx_a].x -= force_divr * dx.x;
-                h_force.data[idx_a].y -= force_divr * dx.y;
-                h_force.data[idx_a].z -= force_divr * dx.z;
-                h_force.data[idx_a].w += bond_eng;
-                if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i*m_virial_pitch+idx_a]  += bond_virial[i];
-                }
-            }
-        else
+        if (!evaluated)
             {
             this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl << std::endl;
             throw std::runtime_error("Error in bond calculation");
             }
-        }
+
+        // Bond energy must be halved
+        bond_eng *= Scalar(0.5);
+
+        // calculate virial
+        Scalar force_div2r = compute_virial ? Scalar(1.0/2.0)*force_divr : Scalar(0.0);
+        bond_virial[0] = dx.x * dx.x * force_div2r; // xx
+        bond_virial[1] = dx.x * dx.y * force_div2r; // xy
+        bond_virial[2] = dx.x * dx.z * force_div2r; // xz
+        bond_virial[3] = dx.y * dx.y * force_div2r; // yy
+        bond_virial[4] = dx.y * dx.z * force_div2r; // yz
+        bond_virial[5] = dx.z * dx.z * force_div2r; // zz
+
+        force[0] = make_scalar4(-force_divr * dx.x, -force_divr * dx.y, -force_divr * dx.z, bond_eng);
+        force[1] = make_scalar4(force_divr * dx.x, force_divr * dx.y, force_divr * dx.z, bond_eng);
+        };
+
+    compute_bonded_forces(m_exec_conf, m_pdata, m_bond_data, h_force.data, h_virial.data, m_virial_pitch,
+        std::string("bond.") + evaluator::getName(), eval_bond);
 
     if (m_prof) m_prof->pop();
     }
@@ -0,0 +1,130 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/bench/bench_utils.h"
+
+#include "hoomd/md/AllPairPotentials.h"
+#include "hoomd/md/NeighborListBinned.h"
+#include "hoomd/md/NeighborListStencil.h"
+#include "hoomd/md/NeighborListTree.h"
+
+#ifdef ENABLE_CUDA
+#include "hoomd/md/NeighborListGPUBinned.h"
+#include "hoomd/md/NeighborListGPUStencil.h"
+#include "hoomd/md/NeighborListGPUTree.h"
+#endif
+
+/*! \file bench_md.cc
+    \brief Microbenchmarks for the kernels of the md library
+    \details Times NeighborList::buildNlist() of every neighbor list variant and PotentialPair::computeForces() for
+    a range of pair evaluators on a Lennard-Jones like synthetic system.
+*/
+
+using namespace std;
+
+//! Cutoff radius of the benchmarked neighbor lists and pair potentials
+const Scalar bench_r_cut = Scalar(3.0);
+//! Buffer radius of the benchmarked neighbor lists
+const Scalar bench_r_buff = Scalar(0.4);
+
+//! Total number of neighbors in a neighbor list
+static double count_neighbors(std::shared_ptr<NeighborList> nlist, unsigned int N)
+    {
+    ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(), access_location::host, access_mode::read);
+
+    double n_neigh = 0;
+    for (unsigned int i = 0; i < N; ++i)
+        n_neigh += h_n_neigh.data[i];
+    return n_neigh;
+    }
+
+//! Benchmark the construction of a neighbor list
+template<class NL>
+void bench_nlist(const BenchmarkOptions& options, const std::string& name)
+    {
+    if (!options.enabled(name))
+        return;
+
+    std::shared_ptr<ExecutionConfiguration> exec_conf = create_benchmark_exec_conf(options);
+    std::shared_ptr<SystemDefinition> sysdef = create_benchmark_system(exec_conf, options);
+
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, bench_r_cut, bench_r_buff));
+    nlist->setStorageMode(NeighborList::full);
+
+    double ms = nlist->benchmark(options.num_iters);
+
+    // read the positions, write the neighbor counts and the neighbor list
+    double bytes = double(options.N)*(sizeof(Scalar4) + sizeof(unsigned int))
+        + count_neighbors(nlist, options.N)*sizeof(unsigned int);
+    report_benchmark(name, options.N, ms, bytes);
+    }
+
+//! Benchmark the force evaluation of a pair potential
+/*! \param param Parameters for every type pair
+*/
+template<class Pair, class NL>
+void bench_pair(const BenchmarkOptions& options, const std::string& name, const typename Pair::param_type& param)
+    {
+    if (!options.enabled(name))
+        return;
+
+    std::shared_ptr<ExecutionConfiguration> exec_conf = create_benchmark_exec_conf(options);
+    std::shared_ptr<SystemDefinition> sysdef = create_benchmark_system(exec_conf, options);
+
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, bench_r_cut, bench_r_buff));
+    nlist->setStorageMode(NeighborList::half);
+
+    std::shared_ptr<Pair> pair(new Pair(sysdef, nlist));
+    pair->setParams(0, 0, param);
+    pair->setRcut(0, 0, bench_r_cut);
+
+    // the neighbor list is built during the warm up run only
+    double ms = pair->benchmark(options.num_iters);
+
+    // read the positions and the neighbor list, write the forces and virials
+    double bytes = double(options.N)*(2*sizeof(Scalar4) + sizeof(unsigned int) + 6*sizeof(Scalar))
+        + count_neighbors(nlist, options.N)*sizeof(unsigned int);
+    report_benchmark(name, options.N, ms, bytes);
+    }
+
+//! Benchmark all pair potentials with a given neighbor list
+template<class NL, class LJ, class Gauss, class Yukawa, class Morse, class Mie, class FSLJ>
+void bench_pairs(const BenchmarkOptions& options, const std::string& suffix)
+    {
+    bench_pair<LJ, NL>(options, "PotentialPairLJ" + suffix, make_scalar2(4.0, 4.0));
+    bench_pair<Gauss, NL>(options, "PotentialPairGauss" + suffix, make_scalar2(1.0, 1.0));
+    bench_pair<Yukawa, NL>(options, "PotentialPairYukawa" + suffix, make_scalar2(1.0, 1.0));
+    bench_pair<Morse, NL>(options, "PotentialPairMorse" + suffix, make_scalar4(1.0, 3.0, 1.0, 0.0));
+    bench_pair<Mie, NL>(options, "PotentialPairMie" + suffix, make_scalar4(4.0, 4.0, 12.0, 6.0));
+    bench_pair<FSLJ, NL>(options, "PotentialPairForceShiftedLJ" + suffix, make_scalar2(4.0, 4.0));
+    }
+
+int main(int argc, char **argv)
+    {
+    return run_benchmarks(argc, argv, [](const BenchmarkOptions& options)
+        {
+        #ifdef ENABLE_CUDA
+        if (options.gpu)
+            {
+            bench_nlist<NeighborListGPUBinned>(options, "NeighborListGPUBinned");
+            bench_nlist<NeighborListGPUStencil>(options, "NeighborListGPUStencil");
+            bench_nlist<NeighborListGPUTree>(options, "NeighborListGPUTree");
+
+            bench_pairs<NeighborListGPUBinned, PotentialPairLJGPU, PotentialPairGaussGPU, PotentialPairYukawaGPU,
+                PotentialPairMorseGPU, PotentialPairMieGPU, PotentialPairForceShiftedLJGPU>(options, "GPU");
+            return;
+            }
+        #endif
+
+        bench_nlist<NeighborListBinned>(options, "NeighborListBinned");
+        bench_nlist<NeighborListStencil>(options, "NeighborListStencil");
+        bench_nlist<NeighborListTree>(options, "NeighborListTree");
+
+        bench_pairs<NeighborListBinned, PotentialPairLJ, PotentialPairGauss, PotentialPairYukawa,
+            PotentialPairMorse, PotentialPairMie, PotentialPairForceShiftedLJ>(options, "");
+        });
+    }
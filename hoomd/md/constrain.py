@@ -212,6 +212,10 @@ class distance(_constraint_force):
     Verlet scheme, i.e. within :math:`\Delta t^2`. The corresponding linear system of equations is solved.
     Because constraints are satisfied at :math:`t + 2 \Delta t`, the scheme is self-correcting and drifts are avoided.
 
+    Constraints only couple within a molecule (a set of particles connected by constraints). On the CPU, the linear
+    system is by default solved separately for each molecule, in parallel when HOOMD-blue is built with TBB support.
+    See :py:meth:`set_params` for the available solvers.
+
     Warning:
         In MPI simulations, all particles connected through constraints will be communicated between processors as ghost particles.
         Therefore, it is an error when molecules defined by constraints extend over more than half the local domain size.
@@ -238,20 +242,59 @@ class distance(_constraint_force):
 
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
-    def set_params(self,rel_tol=None):
+        # default parameters of the iterative solver
+        self._iter_tol = 1e-8
+        self._max_iter = 100
+
+    def set_params(self,rel_tol=None,solver=None,iter_tol=None,max_iter=None):
         R""" Set parameters for constraint computation.
 
         Args:
             rel_tol (float): The relative tolerance with which constraint violations are detected (**optional**).
+            solver (str): Method used to solve for the constraint forces (**optional**).
+            iter_tol (float): Relative tolerance for the *iterative* solver (**optional**).
+            max_iter (int): Maximum number of sweeps for the *iterative* solver (**optional**).
+
+        The available solvers are:
+
+        - *block* (default on the CPU): a dense LU decomposition of the linear system of each molecule.
+        - *iterative*: Gauss-Seidel iteration on the linear system of each molecule, starting from the solution of
+          the previous step. It stops once the largest change of a Lagrange multiplier in one sweep is less than
+          *iter_tol* times the largest multiplier (default 1e-8). Molecules that do not converge within *max_iter*
+          sweeps (default 100) are solved with the *block* method. This method is faster for large molecules.
+        - *sparse*: a sparse LU decomposition of the linear system of all constraints. This is the only method
+          available on the GPU.
 
         Example::
 
             dist = constrain.distance()
             dist.set_params(rel_tol=0.0001)
+            dist.set_params(solver='iterative', iter_tol=1e-10)
         """
         if rel_tol is not None:
             self.cpp_force.setRelativeTolerance(float(rel_tol))
 
+        if solver is not None:
+            solvers = {'block': _md.ForceDistanceConstraint.solverMode.block,
+                       'iterative': _md.ForceDistanceConstraint.solverMode.iterative,
+                       'sparse': _md.ForceDistanceConstraint.solverMode.sparse}
+            if solver not in solvers:
+                hoomd.context.msg.error("constrain.distance: unknown solver " + str(solver) + "\n")
+                raise ValueError("Unknown constraint solver")
+            if hoomd.context.exec_conf.isCUDAEnabled() and solver != 'sparse':
+                hoomd.context.msg.error("constrain.distance: only the sparse solver is supported on the GPU\n")
+                raise RuntimeError("Error setting constraint solver")
+            self.cpp_force.setSolver(solvers[solver])
+
+        if iter_tol is not None or max_iter is not None:
+            if iter_tol is None:
+                iter_tol = self._iter_tol
+            if max_iter is None:
+                max_iter = self._max_iter
+            self.cpp_force.setIterativeParams(float(iter_tol), int(max_iter))
+            self._iter_tol = iter_tol
+            self._max_iter = max_iter
+
 class rigid(_constraint_force):
     R""" Constrain particles in rigid bodies.
 
@@ -84,6 +84,67 @@ class constrain_distance_tests (unittest.TestCase):
         constraint = md.constrain.distance()
         constraint.set_params(rel_tol=0.01)
 
+        constraint.set_params(solver='sparse')
+        self.assertEqual(constraint.cpp_force.getSolver(), md._md.ForceDistanceConstraint.solverMode.sparse)
+        if not context.exec_conf.isCUDAEnabled():
+            constraint.set_params(solver='iterative', iter_tol=1e-10, max_iter=50)
+            self.assertEqual(constraint.cpp_force.getSolver(), md._md.ForceDistanceConstraint.solverMode.iterative)
+            constraint.set_params(max_iter=20)
+            constraint.set_params(solver='block')
+            self.assertEqual(constraint.cpp_force.getSolver(), md._md.ForceDistanceConstraint.solverMode.block)
+        else:
+            self.assertRaises(RuntimeError, constraint.set_params, solver='block')
+
+        self.assertRaises(ValueError, constraint.set_params, solver='invalid')
+
+    # test that all solvers maintain the constraints
+    def test_solvers(self):
+        solvers = ['sparse']
+        if not context.exec_conf.isCUDAEnabled():
+            solvers += ['block', 'iterative']
+
+        box = self.system.box
+        snap = self.system.take_snapshot()
+        constraint = md.constrain.distance()
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+        lj = md.pair.lj(r_cut=2.5, nlist = self.nl)
+        lj.pair_coeff.set('A','A',epsilon=1.0,sigma=1.0)
+
+        for solver in solvers:
+            self.system.restore_snapshot(snap)
+            constraint.set_params(solver=solver)
+            run(100)
+
+            pos0 = self.system.particles[0].position
+            pos1 = self.system.particles[1].position
+            pos2 = self.system.particles[2].position
+
+            pos01 = box.min_image((pos0[0]-pos1[0], pos0[1]-pos1[1], pos0[2]-pos1[2]))
+            pos02 = box.min_image((pos0[0]-pos2[0], pos0[1]-pos2[1], pos0[2]-pos2[2]))
+            pos12 = box.min_image((pos2[0]-pos1[0], pos2[1]-pos1[1], pos2[2]-pos1[2]))
+
+            self.assertAlmostEqual(pos01[0]*pos01[0]+pos01[1]*pos01[1]+pos01[2]*pos01[2],1.5*1.5,4)
+            self.assertAlmostEqual(pos02[0]*pos02[0]+pos02[1]*pos02[1]+pos02[2]*pos02[2],1.5*1.5,4)
+            self.assertAlmostEqual(pos12[0]*pos12[0]+pos12[1]*pos12[1]+pos12[2]*pos12[2],2.0*1.5*1.5,4)
+
+    # test that the iterative solver reports a degenerate constraint instead of treating it as converged
+    def test_degenerate(self):
+        if context.exec_conf.isCUDAEnabled() or comm.get_num_ranks() > 1:
+            # only the sparse solver is supported on the GPU, and we cannot catch an MPI_Abort
+            return
+
+        # a zero-length constraint vector gives a zero diagonal element
+        self.system.particles[3].position = (0,0,0)
+        self.system.constraints.add(0,3,1.0)
+
+        constraint = md.constrain.distance()
+        constraint.set_params(solver='iterative')
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+
+        self.assertRaises(RuntimeError, run, 1)
+
     # test remove particle fails
     def test_constraint_fail(self):
         constraint =  md.constrain.distance();
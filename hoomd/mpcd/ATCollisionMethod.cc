@@ -64,7 +64,7 @@ void mpcd::ATCollisionMethod::drawVelocities(unsigned int timestep)
     {
     // mpcd particle data
     ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(), access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_alt_vel(m_mpcd_pdata->getAltVelocities(), access_location::host, access_mode::overwrite);
+    ArrayHandle<MPCDReal4> h_alt_vel(m_mpcd_pdata->getAltVelocities(), access_location::host, access_mode::overwrite);
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     unsigned int N_tot = N_mpcd;
 
@@ -111,7 +111,7 @@ void mpcd::ATCollisionMethod::drawVelocities(unsigned int timestep)
         // save out velocities
         if (idx < N_mpcd)
             {
-            h_alt_vel.data[pidx] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
+            h_alt_vel.data[pidx] = make_mpcd_real4(vel.x, vel.y, vel.z, __int_as_mpcd_real(mpcd::detail::NO_CELL));
             }
         else
             {
@@ -123,8 +123,8 @@ void mpcd::ATCollisionMethod::drawVelocities(unsigned int timestep)
 void mpcd::ATCollisionMethod::applyVelocities()
     {
     // mpcd particle data
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar4> h_vel_alt(m_mpcd_pdata->getAltVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<MPCDReal4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> h_vel_alt(m_mpcd_pdata->getAltVelocities(), access_location::host, access_mode::read);
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     unsigned int N_tot = N_mpcd;
 
@@ -152,9 +152,10 @@ void mpcd::ATCollisionMethod::applyVelocities()
         if (idx < N_mpcd)
             {
             pidx = idx;
-            const Scalar4 vel_cell = h_vel.data[idx];
-            cell = __scalar_as_int(vel_cell.w);
-            vel_rand = h_vel_alt.data[idx];
+            const MPCDReal4 vel_cell = h_vel.data[idx];
+            cell = __mpcd_real_as_int(vel_cell.w);
+            const MPCDReal4 vel_alt = h_vel_alt.data[idx];
+            vel_rand = make_scalar4(vel_alt.x, vel_alt.y, vel_alt.z, vel_alt.w);
             }
         else
             {
@@ -174,7 +175,7 @@ void mpcd::ATCollisionMethod::applyVelocities()
 
         if (idx < N_mpcd)
             {
-            h_vel.data[pidx] = make_scalar4(vnew.x, vnew.y, vnew.z, __int_as_scalar(cell));
+            h_vel.data[pidx] = make_mpcd_real4(vnew.x, vnew.y, vnew.z, __int_as_mpcd_real(cell));
             }
         else
             {
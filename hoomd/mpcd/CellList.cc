@@ -10,6 +10,10 @@
 #include "hoomd/Communicator.h"
 #endif // ENABLE_MPI
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif // ENABLE_TBB
+
 /*!
  * \file mpcd/CellList.cc
  * \brief Definition of mpcd::CellList
@@ -506,8 +510,8 @@ void mpcd::CellList::buildCellList()
 
     uint3 conditions = make_uint3(0,0,0);
 
-    ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<MPCDReal4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
     unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     unsigned int N_tot = N_mpcd;
 
@@ -534,71 +538,118 @@ void mpcd::CellList::buildCellList()
 
     const Scalar3 global_lo = m_pdata->getGlobalBox().getLo();
 
-    for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+    /*
+     * The cell list is built in two passes. First, every particle is binned independently (in parallel), and its cell
+     * is stashed into the velocity array. Then, the particles are appended to their cells in order, so that the
+     * cell list is identical to a serial build.
+     */
+    auto bin_particle = [&](unsigned int cur_p)
         {
-        Scalar4 postype_i;
+        Scalar3 pos_i;
         if (cur_p < N_mpcd)
             {
-            postype_i = h_pos.data[cur_p];
+            const MPCDReal4 postype_i = h_pos.data[cur_p];
+            pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
             }
         else
             {
-            postype_i = h_pos_embed->data[h_embed_member_idx->data[cur_p - N_mpcd]];
+            const Scalar4 postype_i = h_pos_embed->data[h_embed_member_idx->data[cur_p - N_mpcd]];
+            pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
             }
-        Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
 
-        if (std::isnan(pos_i.x) || std::isnan(pos_i.y) || std::isnan(pos_i.z))
+        // invalid particles are flagged with NO_CELL and diagnosed in the second pass
+        unsigned int bin_idx = mpcd::detail::NO_CELL;
+        if (!(std::isnan(pos_i.x) || std::isnan(pos_i.y) || std::isnan(pos_i.z)))
             {
-            conditions.y = cur_p + 1;
-            continue;
-            }
+            // bin particle assuming orthorhombic box (already validated)
+            const Scalar3 delta = (pos_i - m_grid_shift) - global_lo;
+            int3 global_bin = make_int3(std::floor(delta.x / m_cell_size),
+                                        std::floor(delta.y / m_cell_size),
+                                        std::floor(delta.z / m_cell_size));
+
+            // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
+            // this is done using periodic from the "local" box, since this will be periodic
+            // only when there is one rank along the dimension
+            if (periodic.x)
+                {
+                if (global_bin.x == (int)n_global_cells.x)
+                    global_bin.x = 0;
+                else if (global_bin.x == -1)
+                    global_bin.x = n_global_cells.x - 1;
+                }
+            if (periodic.y)
+                {
+                if (global_bin.y == (int)n_global_cells.y)
+                    global_bin.y = 0;
+                else if (global_bin.y == -1)
+                    global_bin.y = n_global_cells.y - 1;
+                }
+            if (periodic.z)
+                {
+                if (global_bin.z == (int)n_global_cells.z)
+                    global_bin.z = 0;
+                else if (global_bin.z == -1)
+                    global_bin.z = n_global_cells.z - 1;
+                }
 
-        // bin particle assuming orthorhombic box (already validated)
-        const Scalar3 delta = (pos_i - m_grid_shift) - global_lo;
-        int3 global_bin = make_int3(std::floor(delta.x / m_cell_size),
-                                    std::floor(delta.y / m_cell_size),
-                                    std::floor(delta.z / m_cell_size));
+            // compute the local cell
+            int3 bin = make_int3(global_bin.x - m_origin_idx.x,
+                                 global_bin.y - m_origin_idx.y,
+                                 global_bin.z - m_origin_idx.z);
 
-        // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
-        // this is done using periodic from the "local" box, since this will be periodic
-        // only when there is one rank along the dimension
-        if (periodic.x)
-            {
-            if (global_bin.x == (int)n_global_cells.x)
-                global_bin.x = 0;
-            else if (global_bin.x == -1)
-                global_bin.x = n_global_cells.x - 1;
+            // make sure no particles blew out of the box
+            if ((bin.x >= 0 && bin.x < (int)m_cell_dim.x) &&
+                (bin.y >= 0 && bin.y < (int)m_cell_dim.y) &&
+                (bin.z >= 0 && bin.z < (int)m_cell_dim.z))
+                {
+                bin_idx = m_cell_indexer(bin.x, bin.y, bin.z);
+                }
             }
-        if (periodic.y)
+
+        // stash the current particle bin into the velocity array
+        if (cur_p < N_mpcd)
             {
-            if (global_bin.y == (int)n_global_cells.y)
-                global_bin.y = 0;
-            else if (global_bin.y == -1)
-                global_bin.y = n_global_cells.y - 1;
+            h_vel.data[cur_p].w = __int_as_mpcd_real(bin_idx);
             }
-        if (periodic.z)
+        else
             {
-            if (global_bin.z == (int)n_global_cells.z)
-                global_bin.z = 0;
-            else if (global_bin.z == -1)
-                global_bin.z = n_global_cells.z - 1;
+            h_embed_cell_ids->data[cur_p - N_mpcd] = bin_idx;
             }
+        };
 
-        // compute the local cell
-        int3 bin = make_int3(global_bin.x - m_origin_idx.x,
-                             global_bin.y - m_origin_idx.y,
-                             global_bin.z - m_origin_idx.z);
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, N_tot, bin_particle);
+    #else
+    for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+        bin_particle(cur_p);
+    #endif // ENABLE_TBB
 
-        // validate and make sure no particles blew out of the box
-        if ((bin.x < 0 || bin.x >= (int)m_cell_dim.x) ||
-            (bin.y < 0 || bin.y >= (int)m_cell_dim.y) ||
-            (bin.z < 0 || bin.z >= (int)m_cell_dim.z))
+    for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+        {
+        const unsigned int bin_idx = (cur_p < N_mpcd) ? __mpcd_real_as_int(h_vel.data[cur_p].w)
+                                                      : h_embed_cell_ids->data[cur_p - N_mpcd];
+
+        // validate the particle, distinguishing a nan position from a particle outside the box
+        if (bin_idx == mpcd::detail::NO_CELL)
             {
-            conditions.z = cur_p + 1;
+            Scalar3 pos_i;
+            if (cur_p < N_mpcd)
+                {
+                const MPCDReal4 postype_i = h_pos.data[cur_p];
+                pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
+                }
+            else
+                {
+                const Scalar4 postype_i = h_pos_embed->data[h_embed_member_idx->data[cur_p - N_mpcd]];
+                pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
+                }
+            if (std::isnan(pos_i.x) || std::isnan(pos_i.y) || std::isnan(pos_i.z))
+                conditions.y = cur_p + 1;
+            else
+                conditions.z = cur_p + 1;
             continue;
             }
 
-        unsigned int bin_idx = m_cell_indexer(bin.x, bin.y, bin.z);
         unsigned int offset = h_cell_np.data[bin_idx];
         if (offset < m_cell_np_max)
             {
@@ -610,16 +661,6 @@ void mpcd::CellList::buildCellList()
             conditions.x = std::max(conditions.x, offset+1);
             }
 
-        // stash the current particle bin into the velocity array
-        if (cur_p < N_mpcd)
-            {
-            h_vel.data[cur_p].w = __int_as_scalar(bin_idx);
-            }
-        else
-            {
-            h_embed_cell_ids->data[cur_p - N_mpcd] = bin_idx;
-            }
-
         // increment the counter always
         ++h_cell_np.data[bin_idx];
         }
@@ -745,8 +786,9 @@ bool mpcd::CellList::checkConditions()
         Scalar4 pos_empty_i;
         if (n < m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual())
             {
-            ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
-            pos_empty_i = h_pos.data[n];
+            ArrayHandle<MPCDReal4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
+            const MPCDReal4 postype = h_pos.data[n];
+            pos_empty_i = make_scalar4(postype.x, postype.y, postype.z, postype.w);
             if (n < m_mpcd_pdata->getN())
                 m_exec_conf->msg->errorAllRanks() << "MPCD particle is no longer in the simulation box"<<std::endl;
             else
@@ -860,5 +902,8 @@ void mpcd::detail::export_CellList(pybind11::module& m)
         .def_property("cell_size", &mpcd::CellList::getCellSize, &mpcd::CellList::setCellSize)
         .def("setEmbeddedGroup", &mpcd::CellList::setEmbeddedGroup)
         .def("removeEmbeddedGroup", &mpcd::CellList::removeEmbeddedGroup)
+        #ifdef ENABLE_MPI
+        .def_property("num_extra", &mpcd::CellList::getNExtraCells, &mpcd::CellList::setNExtraCells)
+        #endif // ENABLE_MPI
         ;
     }
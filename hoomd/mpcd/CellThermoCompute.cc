@@ -11,6 +11,10 @@
 #include "CellThermoCompute.h"
 #include "ReductionOperators.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif // ENABLE_TBB
+
 /*!
  * \param sysdata MPCD system data
  * \param suffix Suffix for logged quantities
@@ -149,7 +153,7 @@ struct CellPropertySum
     CellPropertySum(const unsigned int *cell_list_,
                     const unsigned int *cell_np_,
                     const Index2D& cli_,
-                    const Scalar4 *vel_,
+                    const MPCDReal4 *vel_,
                     const Scalar mass_,
                     const Scalar4 *embed_vel_,
                     const unsigned int *embed_idx_,
@@ -180,13 +184,13 @@ struct CellPropertySum
             double mass_i;
             if (cur_p < N_mpcd)
                 {
-                Scalar4 vel_cell = vel[cur_p];
+                const MPCDReal4 vel_cell = vel[cur_p];
                 vel_i = make_double3(vel_cell.x, vel_cell.y, vel_cell.z);
                 mass_i = mass;
                 }
             else
                 {
-                Scalar4 vel_m = embed_vel[embed_idx[cur_p - N_mpcd]];
+                const Scalar4 vel_m = embed_vel[embed_idx[cur_p - N_mpcd]];
                 vel_i = make_double3(vel_m.x, vel_m.y, vel_m.z);
                 mass_i = vel_m.w;
                 }
@@ -207,7 +211,7 @@ struct CellPropertySum
     const unsigned int *cell_np;    //!< Number of particles per cell
     const Index2D cli;              //!< Cell list indexer
 
-    const Scalar4 *vel;             //!< MPCD particle velocities
+    const MPCDReal4 *vel;           //!< MPCD particle velocities
     const Scalar mass;              //!< MPCD particle mass
     const Scalar4 *embed_vel;       //!< Embedded particle velocities
     const unsigned int *embed_idx;  //!< Embedded particle indexes
@@ -225,7 +229,7 @@ void mpcd::CellThermoCompute::beginOuterCellProperties()
     const Index2D& cli = m_cl->getCellListIndexer();
 
     // MPCD particle data
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<MPCDReal4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::read);
     const Scalar mpcd_mass = m_mpcd_pdata->getMass();
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
 
@@ -253,7 +257,7 @@ void mpcd::CellThermoCompute::beginOuterCellProperties()
 
     // Loop over all outer cells and compute total momentum, mass, energy
     const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
-    for (unsigned int idx=0; idx < m_vel_comm->getNCells(); ++idx)
+    auto sum_cell = [&](unsigned int idx)
         {
         const unsigned int cur_cell = h_cells.data[idx];
 
@@ -264,7 +268,14 @@ void mpcd::CellThermoCompute::beginOuterCellProperties()
         h_cell_vel.data[cur_cell] = make_double4(momentum.x, momentum.y, momentum.z, momentum.w);
         if (need_energy)
             h_cell_energy.data[cur_cell] = make_double3(ke, 0.0, __int_as_double(np));
-        }
+        };
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, m_vel_comm->getNCells(), sum_cell);
+    #else
+    for (unsigned int idx=0; idx < m_vel_comm->getNCells(); ++idx)
+        sum_cell(idx);
+    #endif // ENABLE_TBB
     }
 
 void mpcd::CellThermoCompute::finishOuterCellProperties()
@@ -319,7 +330,7 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
     // MPCD particle data
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     const Scalar mpcd_mass = m_mpcd_pdata->getMass();
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<MPCDReal4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::read);
 
     // Embedded particle data
     std::unique_ptr< ArrayHandle<Scalar4> > h_embed_vel;
@@ -364,42 +375,47 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
         }
 
     // iterate over all of the inner cells and compute average velocity, energy, temperature
+    // each cell only gathers from its own particles, so the cells can be processed in parallel
     const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
-    for (unsigned int k=lo.z; k < hi.z; ++k)
+    const unsigned int ndim = m_sysdef->getNDimensions();
+    const Index3D inner_ci(hi.x - lo.x, hi.y - lo.y, hi.z - lo.z);
+    auto process_cell = [&](unsigned int inner_idx)
         {
-        for (unsigned int j=lo.y; j < hi.y; ++j)
-            {
-            for (unsigned int i=lo.x; i < hi.x; ++i)
-                {
-                const unsigned int cur_cell = ci(i,j,k);
+        const uint3 cell = inner_ci.getTriple(inner_idx);
+        const unsigned int cur_cell = ci(lo.x + cell.x, lo.y + cell.y, lo.z + cell.z);
 
-                // compute the cell properties
-                double4 momentum; double ke(0.0); unsigned int np(0);
-                summer.compute(momentum, ke, np, cur_cell, need_energy);
+        // compute the cell properties
+        double4 momentum; double ke(0.0); unsigned int np(0);
+        summer.compute(momentum, ke, np, cur_cell, need_energy);
 
-                const double mass = momentum.w;
-                double3 vel_cm = make_double3(0.0,0.0,0.0);
-                if (mass > 0.)
-                    {
-                    vel_cm.x = momentum.x / mass;
-                    vel_cm.y = momentum.y / mass;
-                    vel_cm.z = momentum.z / mass;
-                    }
+        const double mass = momentum.w;
+        double3 vel_cm = make_double3(0.0,0.0,0.0);
+        if (mass > 0.)
+            {
+            vel_cm.x = momentum.x / mass;
+            vel_cm.y = momentum.y / mass;
+            vel_cm.z = momentum.z / mass;
+            }
 
-                h_cell_vel.data[cur_cell] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
-                if (need_energy)
-                    {
-                    double temp(0.0);
-                    if (np > 1)
-                        {
-                        const double ke_cm = 0.5 * mass * (vel_cm.x*vel_cm.x + vel_cm.y*vel_cm.y + vel_cm.z*vel_cm.z);
-                        temp = 2. * (ke - ke_cm) / (m_sysdef->getNDimensions() * (np-1));
-                        }
-                    h_cell_energy.data[cur_cell] = make_double3(ke, temp, __int_as_double(np));
-                    }
-                } // i
-            } //j
-        } // k
+        h_cell_vel.data[cur_cell] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
+        if (need_energy)
+            {
+            double temp(0.0);
+            if (np > 1)
+                {
+                const double ke_cm = 0.5 * mass * (vel_cm.x*vel_cm.x + vel_cm.y*vel_cm.y + vel_cm.z*vel_cm.z);
+                temp = 2. * (ke - ke_cm) / (ndim * (np-1));
+                }
+            h_cell_energy.data[cur_cell] = make_double3(ke, temp, __int_as_double(np));
+            }
+        };
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, inner_ci.getNumElements(), process_cell);
+    #else
+    for (unsigned int inner_idx=0; inner_idx < inner_ci.getNumElements(); ++inner_idx)
+        process_cell(inner_idx);
+    #endif // ENABLE_TBB
     }
 
 void mpcd::CellThermoCompute::computeNetProperties()
@@ -40,7 +40,8 @@ mpcd::Communicator::Communicator(std::shared_ptr<mpcd::SystemData> system_data)
             m_n_unique_neigh(0),
             m_sendbuf(m_exec_conf),
             m_recvbuf(m_exec_conf),
-            m_force_migrate(false)
+            m_force_migrate(false),
+            m_lazy_migrate(false)
     {
     // initialize array of neighbor processor ids
     assert(m_mpi_comm);
@@ -65,7 +66,11 @@ mpcd::Communicator::Communicator(std::shared_ptr<mpcd::SystemData> system_data)
     // create new data type for the pdata_element
     const int nitems = 4;
     int blocklengths[nitems] = {4,4,1,1};
+    #ifdef ENABLE_MPCD_MIXED_PRECISION
+    MPI_Datatype types[nitems] = {MPI_FLOAT, MPI_FLOAT, MPI_UNSIGNED, MPI_UNSIGNED};
+    #else
     MPI_Datatype types[nitems] = {MPI_HOOMD_SCALAR, MPI_HOOMD_SCALAR, MPI_UNSIGNED, MPI_UNSIGNED};
+    #endif // ENABLE_MPCD_MIXED_PRECISION
     MPI_Aint offsets[nitems];
     offsets[0] = offsetof(mpcd::detail::pdata_element, pos);
     offsets[1] = offsetof(mpcd::detail::pdata_element, vel);
@@ -212,6 +217,10 @@ void mpcd::Communicator::communicate(unsigned int timestep)
     if (!migrate)
         {
         m_migrate_requests.emit_accumulate([&](bool r){ migrate = migrate || r; }, timestep);
+
+        // in lazy mode, skip the exchange while every particle can still be binned locally
+        if (migrate && m_lazy_migrate)
+            migrate = needsMigrate();
         }
     if (migrate)
         {
@@ -394,10 +403,13 @@ void mpcd::Communicator::migrateParticles(unsigned int timestep)
         for (unsigned int idx = 0; idx < n_recv; ++idx)
             {
             mpcd::detail::pdata_element& p = h_recvbuf.data[idx];
-            Scalar4& postype = p.pos;
+            Scalar3 pos = make_scalar3(p.pos.x, p.pos.y, p.pos.z);
             int3 image = make_int3(0,0,0);
 
-            wrap_box.wrap(postype,image);
+            wrap_box.wrap(pos,image);
+            p.pos.x = pos.x;
+            p.pos.y = pos.y;
+            p.pos.z = pos.z;
             }
         }
 
@@ -419,7 +431,7 @@ void mpcd::Communicator::setCommFlags(const BoxDim& box)
     if (m_prof) m_prof->push("comm flags");
     // mark all particles which have left the box for sending
     unsigned int N = m_mpcd_pdata->getN();
-    ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<MPCDReal4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_comm_flag(m_mpcd_pdata->getCommFlags(), access_location::host, access_mode::overwrite);
 
     // since box is orthorhombic, just use branching to compute comm flags
@@ -427,7 +439,7 @@ void mpcd::Communicator::setCommFlags(const BoxDim& box)
     const Scalar3 hi = box.getHi();
     for (unsigned int idx = 0; idx < N; ++idx)
         {
-        const Scalar4& postype = h_pos.data[idx];
+        const MPCDReal4& postype = h_pos.data[idx];
         const Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
 
         unsigned int flags = 0;
@@ -446,6 +458,42 @@ void mpcd::Communicator::setCommFlags(const BoxDim& box)
     if (m_prof) m_prof->pop();
     }
 
+/*!
+ * \returns True if any particle on any rank lies outside the coverage box of its rank
+ *
+ * This is a collective call that must be made on all ranks.
+ */
+bool mpcd::Communicator::needsMigrate()
+    {
+    if (m_prof) m_prof->push("check");
+    const BoxDim& box = m_mpcd_sys->getCellList()->getCoverageBox();
+    const Scalar3 lo = box.getLo();
+    const Scalar3 hi = box.getHi();
+
+    ArrayHandle<MPCDReal4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::read);
+    const unsigned int N = m_mpcd_pdata->getN();
+
+    char migrate = 0;
+    for (unsigned int idx = 0; idx < N && !migrate; ++idx)
+        {
+        const MPCDReal4 postype = h_pos.data[idx];
+        const Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+
+        if (pos.x >= hi.x || pos.x < lo.x ||
+            pos.y >= hi.y || pos.y < lo.y ||
+            pos.z >= hi.z || pos.z < lo.z)
+            {
+            migrate = 1;
+            }
+        }
+
+    // reduce across all ranks
+    MPI_Allreduce(MPI_IN_PLACE, &migrate, 1, MPI_CHAR, MPI_MAX, m_mpi_comm);
+    if (m_prof) m_prof->pop();
+
+    return static_cast<bool>(migrate);
+    }
+
 /*!
  * Checks that the simulation box is not overdecomposed so that communication can
  * be achieved using the assumed single step. This is a collective call that
@@ -614,6 +662,8 @@ BoxDim mpcd::Communicator::getWrapBox(const BoxDim& box)
 void mpcd::detail::export_Communicator(py::module& m)
     {
     py::class_<mpcd::Communicator, std::shared_ptr<mpcd::Communicator> >(m,"Communicator")
-    .def(py::init<std::shared_ptr<mpcd::SystemData> >());
+    .def(py::init<std::shared_ptr<mpcd::SystemData> >())
+    .def("setLazyMigrate", &mpcd::Communicator::setLazyMigrate)
+    .def("getLazyMigrate", &mpcd::Communicator::getLazyMigrate);
     }
 #endif // ENABLE_MPI
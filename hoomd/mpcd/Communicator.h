@@ -140,12 +140,34 @@ class PYBIND11_EXPORT Communicator
             {
             m_force_migrate = true;
             }
+
+        //! Set lazy migration
+        /*!
+         * \param lazy If true, a requested migration is only performed if a particle has left the coverage box
+         *
+         * Particles are allowed to reside in the padding of the cell list coverage box outside the local domain,
+         * because the cells there are already reduced with the neighboring ranks. In lazy mode, a cheap check for
+         * particles outside the coverage box replaces the full migration exchange until this buffer is exhausted.
+         */
+        void setLazyMigrate(bool lazy)
+            {
+            m_lazy_migrate = lazy;
+            }
+
+        //! Get whether lazy migration is enabled
+        bool getLazyMigrate() const
+            {
+            return m_lazy_migrate;
+            }
         //@}
 
     protected:
         //! Set the communication flags for the particle data
         virtual void setCommFlags(const BoxDim& box);
 
+        //! Check if any particle needs to be migrated
+        virtual bool needsMigrate();
+
         //! Checks for overdecomposition
         void checkDecomposition();
 
@@ -207,6 +229,7 @@ class PYBIND11_EXPORT Communicator
 
         MigrateSignal m_migrate_requests;   //!< Signal to request migration
         bool m_force_migrate;               //!< If true, force particle migration
+        bool m_lazy_migrate;                //!< If true, only migrate when a particle leaves the coverage box
     };
 
 
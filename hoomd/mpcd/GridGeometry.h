@@ -0,0 +1,396 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+/*!
+ * \file mpcd/GridGeometry.h
+ * \brief Definition of the MPCD signed-distance grid geometry
+ */
+
+#ifndef MPCD_GRID_GEOMETRY_H_
+#define MPCD_GRID_GEOMETRY_H_
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "BoundaryCondition.h"
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/BoxDim.h"
+#include "hoomd/Index1D.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace mpcd
+{
+namespace detail
+{
+
+//! Arbitrary geometry defined by a signed-distance grid
+/*!
+ * The geometry is described by a signed distance \f$\phi\f$ sampled on a regular, periodic grid of nodes
+ * spanning the global simulation box. The nodes are located at \f$\mathbf{r}_{ijk} = \mathbf{r}_{\rm lo} +
+ * (i h_x, j h_y, k h_z)\f$, where \f$\mathbf{r}_{\rm lo}\f$ is the lower corner of the box and \f$h\f$ is the grid
+ * spacing along each axis. Between nodes, \f$\phi\f$ is trilinearly interpolated. The fluid lies where
+ * \f$\phi \ge 0\f$ and the solid where \f$\phi < 0\f$, so the surface is the zero level set.
+ *
+ * Each voxel of the grid (the cube between 8 neighboring nodes) is classified once when the geometry is
+ * constructed. Because trilinear interpolation is bounded by the corner values, a voxel with all corners in
+ * the fluid cannot contain any of the surface. Collision detection for a particle that ends its streaming
+ * step in such a voxel is skipped entirely, so the cost of streaming through the bulk of the fluid is one
+ * lookup per particle. Only particles ending in a voxel that is sliced by the surface interpolate \f$\phi\f$,
+ * and only those that have actually crossed into the solid search for the point of contact.
+ *
+ * As for the analytic geometries, a collision is detected from the end point of the streaming step. The point
+ * of contact is located by bisection along the trajectory, and the surface normal is the normalized gradient
+ * of the interpolated \f$\phi\f$ at that point.
+ *
+ * The grid is held on the host, so this geometry is only supported by the CPU streaming method.
+ */
+class __attribute__((visibility("default"))) GridGeometry
+    {
+    public:
+        //! Classification of a voxel of the grid
+        enum struct voxel : unsigned char
+            {
+            fluid=0,    //!< All corners lie in the fluid
+            surface,    //!< Voxel is sliced by the surface
+            solid       //!< All corners lie in the solid
+            };
+
+        //! Constructor
+        /*!
+         * \param L Edge lengths of the (orthorhombic) global simulation box
+         * \param dim Number of grid nodes along each axis
+         * \param sdf Signed distance at each node, indexed with x varying fastest
+         * \param bc Boundary condition at the surface (slip or no-slip)
+         */
+        GridGeometry(const Scalar3& L, const uint3& dim, const std::vector<Scalar>& sdf, boundary bc)
+            : m_L(L), m_lo(Scalar(-0.5)*L), m_dim(dim), m_indexer(dim.x, dim.y, dim.z), m_sdf(sdf), m_bc(bc)
+            {
+            if (m_dim.x == 0 || m_dim.y == 0 || m_dim.z == 0)
+                throw std::runtime_error("MPCD grid geometry must have at least one node along each axis");
+            if (m_sdf.size() != m_indexer.getNumElements())
+                throw std::runtime_error("MPCD grid geometry signed distance does not match grid dimensions");
+            if (!(m_L.x > Scalar(0) && m_L.y > Scalar(0) && m_L.z > Scalar(0)))
+                throw std::runtime_error("MPCD grid geometry box lengths must be positive");
+
+            m_h = make_scalar3(m_L.x/m_dim.x, m_L.y/m_dim.y, m_L.z/m_dim.z);
+            m_inv_h = make_scalar3(Scalar(1.0)/m_h.x, Scalar(1.0)/m_h.y, Scalar(1.0)/m_h.z);
+
+            // classify each voxel from its corners
+            m_voxels.resize(m_indexer.getNumElements());
+            for (unsigned int k=0; k < m_dim.z; ++k)
+                {
+                for (unsigned int j=0; j < m_dim.y; ++j)
+                    {
+                    for (unsigned int i=0; i < m_dim.x; ++i)
+                        {
+                        const Scalar2 bounds = getVoxelBounds(i,j,k);
+                        voxel type = voxel::surface;
+                        if (bounds.x >= Scalar(0))
+                            type = voxel::fluid;
+                        else if (bounds.y < Scalar(0))
+                            type = voxel::solid;
+                        m_voxels[m_indexer(i,j,k)] = type;
+                        }
+                    }
+                }
+            }
+
+        //! Detect collision between the particle and the boundary
+        /*!
+         * \param pos Proposed particle position
+         * \param vel Proposed particle velocity
+         * \param dt Integration time remaining (inout).
+         *
+         * \returns True if a collision occurred, and false otherwise
+         *
+         * \post The particle position \a pos is moved to the point of reflection, the velocity \a vel is updated
+         *       according to the appropriate bounce back rule, and the integration time \a dt is decreased to the
+         *       amount of time remaining.
+         *
+         * The passed value of \a dt must be the time taken to arrive at pos. The returned value of \a dt will be
+         * less than this time.
+         */
+        bool detectCollision(Scalar3& pos, Scalar3& vel, Scalar& dt) const
+            {
+            uint3 ijk; Scalar3 f;
+            locate(pos, ijk, f);
+
+            // exit early if the particle ended anywhere that cannot be in the solid
+            if (m_voxels[m_indexer(ijk.x, ijk.y, ijk.z)] == voxel::fluid ||
+                interpolate(ijk, f) >= Scalar(0))
+                {
+                dt = Scalar(0);
+                return false;
+                }
+
+            // the starting point must be in the fluid to bracket the point of contact, otherwise there is no
+            // well-defined collision (the particle was already inside the solid)
+            if (getSignedDistance(pos - dt*vel) < Scalar(0))
+                {
+                dt = Scalar(0);
+                return false;
+                }
+
+            // bisect for the time before the end of the step that the surface was crossed
+            // t_solid always lies in the solid, and t_fluid always lies in the fluid
+            Scalar t_solid(0), t_fluid(dt);
+            for (unsigned int it=0; it < MAX_BISECT; ++it)
+                {
+                const Scalar t = Scalar(0.5)*(t_solid + t_fluid);
+                if (getSignedDistance(pos - t*vel) < Scalar(0))
+                    t_solid = t;
+                else
+                    t_fluid = t;
+                }
+
+            // backtrack the particle to the fluid side of the point of contact
+            dt = t_fluid;
+            pos -= vel*dt;
+
+            // surface normal points into the fluid along the gradient
+            Scalar3 n = getGradient(pos);
+            const Scalar nsq = dot(n,n);
+            if (nsq > Scalar(0))
+                {
+                n *= fast::rsqrt(nsq);
+                }
+            else
+                {
+                // degenerate gradient (e.g., at a cusp), so reflect straight back
+                const Scalar vsq = dot(vel,vel);
+                n = (vsq > Scalar(0)) ? -vel * fast::rsqrt(vsq) : make_scalar3(0,0,0);
+                }
+
+            // update velocity according to boundary conditions
+            // no-slip requires reflection of the tangential components
+            const Scalar3 vn = dot(n,vel)*n;
+            if (m_bc == boundary::no_slip)
+                {
+                const Scalar3 vt = vel - vn;
+                vel += Scalar(-2) * vt;
+                }
+            // always reflect normal component for no-penetration
+            vel += Scalar(-2) * vn;
+
+            return true;
+            }
+
+        //! Check if a particle is out of bounds
+        /*!
+         * \param pos Current particle position
+         * \returns True if particle is out of bounds, and false otherwise
+         */
+        bool isOutside(const Scalar3& pos) const
+            {
+            return (getSignedDistance(pos) < Scalar(0));
+            }
+
+        //! Validate that the simulation box is consistent with the grid
+        /*!
+         * \param box Global simulation box
+         * \param cell_size Size of MPCD cell
+         *
+         * The grid is periodic, so the box only needs to be the orthorhombic box the grid was made for.
+         */
+        bool validateBox(const BoxDim& box, Scalar cell_size) const
+            {
+            const Scalar3 L = box.getL();
+            const Scalar tol(1e-5);
+            return (box.getTiltFactorXY() == Scalar(0) &&
+                    box.getTiltFactorXZ() == Scalar(0) &&
+                    box.getTiltFactorYZ() == Scalar(0) &&
+                    std::abs(L.x - m_L.x) <= tol*m_L.x &&
+                    std::abs(L.y - m_L.y) <= tol*m_L.y &&
+                    std::abs(L.z - m_L.z) <= tol*m_L.z);
+            }
+
+        //! Interpolate the signed distance
+        /*!
+         * \param pos Position to evaluate
+         * \returns Signed distance at \a pos, which is negative in the solid
+         */
+        Scalar getSignedDistance(const Scalar3& pos) const
+            {
+            uint3 ijk; Scalar3 f;
+            locate(pos, ijk, f);
+            return interpolate(ijk, f);
+            }
+
+        //! Interpolate the gradient of the signed distance
+        /*!
+         * \param pos Position to evaluate
+         * \returns Gradient of the trilinearly interpolated signed distance at \a pos
+         */
+        Scalar3 getGradient(const Scalar3& pos) const
+            {
+            uint3 ijk; Scalar3 f;
+            locate(pos, ijk, f);
+            Scalar c[8];
+            getCorners(ijk, c);
+
+            const Scalar3 g = make_scalar3(Scalar(1)-f.x, Scalar(1)-f.y, Scalar(1)-f.z);
+            Scalar3 grad;
+            grad.x = (g.y*g.z*(c[1]-c[0]) + f.y*g.z*(c[3]-c[2]) + g.y*f.z*(c[5]-c[4]) + f.y*f.z*(c[7]-c[6]));
+            grad.y = (g.x*g.z*(c[2]-c[0]) + f.x*g.z*(c[3]-c[1]) + g.x*f.z*(c[6]-c[4]) + f.x*f.z*(c[7]-c[5]));
+            grad.z = (g.x*g.y*(c[4]-c[0]) + f.x*g.y*(c[5]-c[1]) + g.x*f.y*(c[6]-c[2]) + f.x*f.y*(c[7]-c[3]));
+            grad.x *= m_inv_h.x;
+            grad.y *= m_inv_h.y;
+            grad.z *= m_inv_h.z;
+            return grad;
+            }
+
+        //! Get the classification of a voxel
+        /*!
+         * \param i Voxel index along x
+         * \param j Voxel index along y
+         * \param k Voxel index along z
+         * \returns Classification of voxel (\a i, \a j, \a k)
+         */
+        voxel getVoxel(unsigned int i, unsigned int j, unsigned int k) const
+            {
+            return m_voxels[m_indexer(i,j,k)];
+            }
+
+        //! Get the minimum and maximum signed distance at the corners of a voxel
+        /*!
+         * \param i Voxel index along x
+         * \param j Voxel index along y
+         * \param k Voxel index along z
+         * \returns Bounds on the signed distance in the voxel (min, max)
+         */
+        Scalar2 getVoxelBounds(unsigned int i, unsigned int j, unsigned int k) const
+            {
+            Scalar c[8];
+            getCorners(make_uint3(i,j,k), c);
+            Scalar2 bounds = make_scalar2(c[0], c[0]);
+            for (unsigned int m=1; m < 8; ++m)
+                {
+                bounds.x = std::min(bounds.x, c[m]);
+                bounds.y = std::max(bounds.y, c[m]);
+                }
+            return bounds;
+            }
+
+        //! Get the box edge lengths the grid spans
+        Scalar3 getL() const
+            {
+            return m_L;
+            }
+
+        //! Get the number of grid nodes along each axis
+        uint3 getDimensions() const
+            {
+            return m_dim;
+            }
+
+        //! Get the grid spacing along each axis
+        Scalar3 getSpacing() const
+            {
+            return m_h;
+            }
+
+        //! Get the signed distance at the grid nodes
+        const std::vector<Scalar>& getSDF() const
+            {
+            return m_sdf;
+            }
+
+        //! Get the wall boundary condition
+        /*!
+         * \returns Boundary condition at wall
+         */
+        boundary getBoundaryCondition() const
+            {
+            return m_bc;
+            }
+
+        //! Get the unique name of this geometry
+        static std::string getName()
+            {
+            return std::string("Grid");
+            }
+
+    private:
+        const Scalar3 m_L;                  //!< Box edge lengths
+        const Scalar3 m_lo;                 //!< Lower corner of the box (first grid node)
+        const uint3 m_dim;                  //!< Number of grid nodes
+        const Index3D m_indexer;            //!< Indexer into the grid
+        const std::vector<Scalar> m_sdf;    //!< Signed distance at nodes
+        const boundary m_bc;                //!< Boundary condition
+        Scalar3 m_h;                        //!< Grid spacing
+        Scalar3 m_inv_h;                    //!< Inverse grid spacing
+        std::vector<voxel> m_voxels;        //!< Classification of voxels
+
+        static const unsigned int MAX_BISECT = 24;  //!< Number of bisection steps to locate the surface
+
+        //! Find the voxel containing a point and the fractional position within it
+        /*!
+         * \param pos Position (may lie outside the box, and is wrapped back into the periodic grid)
+         * \param ijk Voxel index (output)
+         * \param f Fractional coordinates within the voxel (output)
+         */
+        void locate(const Scalar3& pos, uint3& ijk, Scalar3& f) const
+            {
+            const Scalar3 x = make_scalar3((pos.x-m_lo.x)*m_inv_h.x,
+                                           (pos.y-m_lo.y)*m_inv_h.y,
+                                           (pos.z-m_lo.z)*m_inv_h.z);
+            const Scalar3 fl = make_scalar3(std::floor(x.x), std::floor(x.y), std::floor(x.z));
+            f = x - fl;
+            ijk = make_uint3(wrap((int)fl.x, m_dim.x), wrap((int)fl.y, m_dim.y), wrap((int)fl.z, m_dim.z));
+            }
+
+        //! Wrap an index into the periodic grid
+        static unsigned int wrap(int i, unsigned int n)
+            {
+            int w = i % (int)n;
+            if (w < 0) w += n;
+            return w;
+            }
+
+        //! Gather the signed distance at the 8 corners of a voxel
+        /*!
+         * \param ijk Voxel index
+         * \param c Corner values (output), ordered with x varying fastest
+         */
+        void getCorners(const uint3& ijk, Scalar* c) const
+            {
+            const unsigned int i1 = (ijk.x+1 == m_dim.x) ? 0 : ijk.x+1;
+            const unsigned int j1 = (ijk.y+1 == m_dim.y) ? 0 : ijk.y+1;
+            const unsigned int k1 = (ijk.z+1 == m_dim.z) ? 0 : ijk.z+1;
+            c[0] = m_sdf[m_indexer(ijk.x, ijk.y, ijk.z)];
+            c[1] = m_sdf[m_indexer(i1,    ijk.y, ijk.z)];
+            c[2] = m_sdf[m_indexer(ijk.x, j1,    ijk.z)];
+            c[3] = m_sdf[m_indexer(i1,    j1,    ijk.z)];
+            c[4] = m_sdf[m_indexer(ijk.x, ijk.y, k1)];
+            c[5] = m_sdf[m_indexer(i1,    ijk.y, k1)];
+            c[6] = m_sdf[m_indexer(ijk.x, j1,    k1)];
+            c[7] = m_sdf[m_indexer(i1,    j1,    k1)];
+            }
+
+        //! Trilinearly interpolate the signed distance within a voxel
+        Scalar interpolate(const uint3& ijk, const Scalar3& f) const
+            {
+            Scalar c[8];
+            getCorners(ijk, c);
+            const Scalar c00 = c[0] + f.x*(c[1]-c[0]);
+            const Scalar c10 = c[2] + f.x*(c[3]-c[2]);
+            const Scalar c01 = c[4] + f.x*(c[5]-c[4]);
+            const Scalar c11 = c[6] + f.x*(c[7]-c[6]);
+            const Scalar c0 = c00 + f.y*(c10-c00);
+            const Scalar c1 = c01 + f.y*(c11-c01);
+            return c0 + f.z*(c1-c0);
+            }
+    };
+
+} // end namespace detail
+} // end namespace mpcd
+
+#endif // MPCD_GRID_GEOMETRY_H_
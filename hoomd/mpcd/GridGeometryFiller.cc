@@ -0,0 +1,278 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+/*!
+ * \file mpcd/GridGeometryFiller.cc
+ * \brief Definition of mpcd::GridGeometryFiller
+ */
+
+#include "GridGeometryFiller.h"
+#include "hoomd/RandomNumbers.h"
+#include "hoomd/RNGIdentifiers.h"
+
+mpcd::GridGeometryFiller::GridGeometryFiller(std::shared_ptr<mpcd::SystemData> sysdata,
+                                             Scalar density,
+                                             unsigned int type,
+                                             std::shared_ptr<::Variant> T,
+                                             unsigned int seed,
+                                             std::shared_ptr<const mpcd::detail::GridGeometry> geom)
+    : mpcd::VirtualParticleFiller(sysdata, density, type, T, seed),
+      m_num_voxels(0), m_lo(m_exec_conf), m_hi(m_exec_conf), m_ranges(m_exec_conf), m_thickness(0),
+      m_warned_rejections(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing MPCD GridGeometryFiller" << std::endl;
+
+    setGeometry(geom);
+
+    // unphysical values in cache to always force recompute
+    m_needs_recompute = true;
+    m_recompute_cache = make_scalar2(-1,-1);
+    m_pdata->getBoxChangeSignal().connect<mpcd::GridGeometryFiller, &mpcd::GridGeometryFiller::notifyRecompute>(this);
+    }
+
+mpcd::GridGeometryFiller::~GridGeometryFiller()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying MPCD GridGeometryFiller" << std::endl;
+    m_pdata->getBoxChangeSignal().disconnect<mpcd::GridGeometryFiller, &mpcd::GridGeometryFiller::notifyRecompute>(this);
+    }
+
+void mpcd::GridGeometryFiller::computeNumFill()
+    {
+    const Scalar cell_size = m_cl->getCellSize();
+
+    // check if fill-relevant variables have changed (can't use signal because cell list build may not have triggered yet)
+    m_needs_recompute |= (m_recompute_cache.x != cell_size || m_recompute_cache.y != m_density);
+
+    // only recompute if needed
+    if (!m_needs_recompute) return;
+
+    // as a precaution, validate the global box with the current cell list
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    if (!m_geom->validateBox(global_box, cell_size))
+        {
+        m_exec_conf->msg->error() << "Invalid grid geometry for global box, cannot fill virtual particles." << std::endl;
+        throw std::runtime_error("Invalid grid geometry for global box");
+        }
+
+    // any point in a cell that is partially in the fluid lies within the cell diagonal of the fluid
+    m_thickness = fast::sqrt(Scalar(3.0)) * cell_size;
+
+    // range of voxels overlapping the local domain
+    const BoxDim& box = m_pdata->getBox();
+    const Scalar3 lo = box.getLo();
+    const Scalar3 hi = box.getHi();
+    const Scalar3 global_lo = global_box.getLo();
+    const Scalar3 h = m_geom->getSpacing();
+    const uint3 dim = m_geom->getDimensions();
+    const uint3 first = make_uint3(std::max(0, (int)std::floor((lo.x-global_lo.x)/h.x)),
+                                   std::max(0, (int)std::floor((lo.y-global_lo.y)/h.y)),
+                                   std::max(0, (int)std::floor((lo.z-global_lo.z)/h.z)));
+    const uint3 last = make_uint3(std::min(dim.x, (unsigned int)std::ceil((hi.x-global_lo.x)/h.x)),
+                                  std::min(dim.y, (unsigned int)std::ceil((hi.y-global_lo.y)/h.y)),
+                                  std::min(dim.z, (unsigned int)std::ceil((hi.z-global_lo.z)/h.z)));
+    const unsigned int max_voxels = (last.x-first.x)*(last.y-first.y)*(last.z-first.z);
+    if (max_voxels > m_ranges.size())
+        {
+        m_lo.resize(max_voxels);
+        m_hi.resize(max_voxels);
+        m_ranges.resize(max_voxels);
+        }
+
+    ArrayHandle<Scalar3> h_lo(m_lo, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar3> h_hi(m_hi, access_location::host, access_mode::overwrite);
+    ArrayHandle<uint2> h_ranges(m_ranges, access_location::host, access_mode::overwrite);
+    m_num_voxels = 0;
+    m_N_fill = 0;
+
+    /*
+     * The expected number of particles is accumulated over the voxels, and the ranges are taken from the rounded
+     * running total. This way, the total is rounded only once, and the many small partial voxels along the surface
+     * are not systematically under- or over-filled.
+     */
+    const Scalar sample_frac = Scalar(1.0)/(NUM_SAMPLES*NUM_SAMPLES*NUM_SAMPLES);
+    Scalar N_total(0);
+    for (unsigned int k=first.z; k < last.z; ++k)
+        {
+        for (unsigned int j=first.y; j < last.y; ++j)
+            {
+            for (unsigned int i=first.x; i < last.x; ++i)
+                {
+                // voxels entirely in the fluid or deeper in the solid than the fill layer are skipped
+                if (m_geom->getVoxel(i,j,k) == mpcd::detail::GridGeometry::voxel::fluid) continue;
+                if (m_geom->getVoxelBounds(i,j,k).y < -m_thickness) continue;
+
+                // clamp the voxel to the local domain
+                const Scalar3 vlo = make_scalar3(std::max(global_lo.x + i*h.x, lo.x),
+                                                 std::max(global_lo.y + j*h.y, lo.y),
+                                                 std::max(global_lo.z + k*h.z, lo.z));
+                const Scalar3 vhi = make_scalar3(std::min(global_lo.x + (i+1)*h.x, hi.x),
+                                                 std::min(global_lo.y + (j+1)*h.y, hi.y),
+                                                 std::min(global_lo.z + (k+1)*h.z, hi.z));
+                const Scalar3 dr = vhi - vlo;
+                if (dr.x <= Scalar(0) || dr.y <= Scalar(0) || dr.z <= Scalar(0)) continue;
+
+                // estimate the fraction of the voxel in the fill volume by sampling at the midpoints of a subgrid
+                unsigned int N_in = 0;
+                for (unsigned int c=0; c < NUM_SAMPLES; ++c)
+                    {
+                    for (unsigned int b=0; b < NUM_SAMPLES; ++b)
+                        {
+                        for (unsigned int a=0; a < NUM_SAMPLES; ++a)
+                            {
+                            const Scalar3 r = make_scalar3(vlo.x + (a+Scalar(0.5))*dr.x/NUM_SAMPLES,
+                                                           vlo.y + (b+Scalar(0.5))*dr.y/NUM_SAMPLES,
+                                                           vlo.z + (c+Scalar(0.5))*dr.z/NUM_SAMPLES);
+                            const Scalar phi = m_geom->getSignedDistance(r);
+                            if (phi < Scalar(0) && phi >= -m_thickness) ++N_in;
+                            }
+                        }
+                    }
+                if (N_in == 0) continue;
+
+                N_total += m_density * dr.x * dr.y * dr.z * (N_in * sample_frac);
+                const unsigned int N_last = std::round(N_total);
+
+                // only add voxel if it isn't empty
+                if (N_last > m_N_fill)
+                    {
+                    h_lo.data[m_num_voxels] = vlo;
+                    h_hi.data[m_num_voxels] = vhi;
+                    h_ranges.data[m_num_voxels] = make_uint2(m_N_fill, N_last);
+                    ++m_num_voxels;
+
+                    m_N_fill = N_last;
+                    }
+                }
+            }
+        }
+
+    // size is now updated, cache the cell dimensions used
+    m_needs_recompute = false;
+    m_recompute_cache = make_scalar2(cell_size, m_density);
+    }
+
+/*!
+ * \param timestep Current timestep to draw particles
+ */
+void mpcd::GridGeometryFiller::drawParticles(unsigned int timestep)
+    {
+    // quit early if not filling to ensure we don't access any memory that hasn't been set
+    if (m_N_fill == 0) return;
+
+    ArrayHandle<MPCDReal4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(), access_location::host, access_mode::readwrite);
+    const Scalar vel_factor = fast::sqrt(m_T->getValue(timestep) / m_mpcd_pdata->getMass());
+
+    // voxels for filling
+    ArrayHandle<Scalar3> h_lo(m_lo, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_hi(m_hi, access_location::host, access_mode::read);
+    ArrayHandle<uint2> h_ranges(m_ranges, access_location::host, access_mode::read);
+    // set these counters so that they get filled on the first pass
+    int voxelid = -1;
+    unsigned int voxellast = 0;
+    Scalar3 lo = make_scalar3(0,0,0);
+    Scalar3 hi = make_scalar3(0,0,0);
+
+    // number of particles placed on the sampling subgrid after too many rejections
+    unsigned int N_fallback = 0;
+
+    // index to start filling from
+    const unsigned int first_idx = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual() - m_N_fill;
+    for (unsigned int i=0; i < m_N_fill; ++i)
+        {
+        const unsigned int tag = m_first_tag + i;
+        hoomd::RandomGenerator rng(hoomd::RNGIdentifier::GridGeometryFiller, m_seed, tag, timestep);
+
+        // advanced past end of this voxel range, take the next
+        if (i >= voxellast)
+            {
+            ++voxelid;
+            voxellast = h_ranges.data[voxelid].y;
+            lo = h_lo.data[voxelid];
+            hi = h_hi.data[voxelid];
+            }
+
+        // draw uniformly in the voxel until landing inside the fill layer
+        hoomd::UniformDistribution<Scalar> genx(lo.x,hi.x), geny(lo.y,hi.y), genz(lo.z,hi.z);
+        Scalar3 r;
+        bool inside = false;
+        for (unsigned int n=0; n < MAX_REJECTIONS && !inside; ++n)
+            {
+            r.x = genx(rng);
+            r.y = geny(rng);
+            r.z = genz(rng);
+            const Scalar phi = m_geom->getSignedDistance(r);
+            inside = (phi < Scalar(0) && phi >= -m_thickness);
+            }
+
+        // fall back to the sampling subgrid of computeNumFill, which has at least one point in the layer
+        if (!inside)
+            {
+            const unsigned int num_points = NUM_SAMPLES*NUM_SAMPLES*NUM_SAMPLES;
+            const unsigned int start = hoomd::UniformIntDistribution(num_points-1)(rng);
+            const Scalar3 dr = hi - lo;
+            for (unsigned int n=0; n < num_points && !inside; ++n)
+                {
+                const unsigned int p = (start + n) % num_points;
+                const unsigned int a = p % NUM_SAMPLES;
+                const unsigned int b = (p / NUM_SAMPLES) % NUM_SAMPLES;
+                const unsigned int c = p / (NUM_SAMPLES*NUM_SAMPLES);
+                r = make_scalar3(lo.x + (a+Scalar(0.5))*dr.x/NUM_SAMPLES,
+                                 lo.y + (b+Scalar(0.5))*dr.y/NUM_SAMPLES,
+                                 lo.z + (c+Scalar(0.5))*dr.z/NUM_SAMPLES);
+                const Scalar phi = m_geom->getSignedDistance(r);
+                inside = (phi < Scalar(0) && phi >= -m_thickness);
+                }
+
+            if (!inside)
+                {
+                m_exec_conf->msg->error() << "mpcd.fill: could not place virtual particle " << tag
+                                          << " in the fill layer." << std::endl;
+                throw std::runtime_error("Error filling virtual particles");
+                }
+            ++N_fallback;
+            }
+
+        const unsigned int pidx = first_idx + i;
+        h_pos.data[pidx] = make_mpcd_real4(r.x, r.y, r.z, __int_as_mpcd_real(m_type));
+
+        hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
+        Scalar3 vel;
+        gen(vel.x, vel.y, rng);
+        vel.z = gen(rng);
+        h_vel.data[pidx] = make_mpcd_real4(vel.x,
+                                           vel.y,
+                                           vel.z,
+                                           __int_as_mpcd_real(mpcd::detail::NO_CELL));
+        h_tag.data[pidx] = tag;
+        }
+
+    if (N_fallback > 0 && !m_warned_rejections)
+        {
+        m_exec_conf->msg->warning() << "mpcd.fill: " << N_fallback << " virtual particles were placed on the sampling"
+                                    << " grid after " << MAX_REJECTIONS << " rejected draws. The fill layer may be very"
+                                    << " thin in some voxels of the geometry." << std::endl;
+        m_warned_rejections = true;
+        }
+    }
+
+/*!
+ * \param m Python module to export to
+ */
+void mpcd::detail::export_GridGeometryFiller(pybind11::module& m)
+    {
+    namespace py = pybind11;
+    py::class_<mpcd::GridGeometryFiller, std::shared_ptr<mpcd::GridGeometryFiller>>
+        (m, "GridGeometryFiller", py::base<mpcd::VirtualParticleFiller>())
+        .def(py::init<std::shared_ptr<mpcd::SystemData>,
+                      Scalar,
+                      unsigned int,
+                      std::shared_ptr<::Variant>,
+                      unsigned int,
+                      std::shared_ptr<const mpcd::detail::GridGeometry>>())
+        .def("setGeometry", &mpcd::GridGeometryFiller::setGeometry)
+        ;
+    }
@@ -0,0 +1,90 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+/*!
+ * \file mpcd/GridGeometryFiller.h
+ * \brief Definition of virtual particle filler for mpcd::detail::GridGeometry.
+ */
+
+#ifndef MPCD_GRID_GEOMETRY_FILLER_H_
+#define MPCD_GRID_GEOMETRY_FILLER_H_
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "VirtualParticleFiller.h"
+#include "GridGeometry.h"
+#include "hoomd/GPUVector.h"
+
+#include "hoomd/extern/pybind/include/pybind11/pybind11.h"
+
+namespace mpcd
+{
+
+//! Adds virtual particles to the MPCD particle data for GridGeometry
+/*!
+ * Every point of a cell that is partially in the fluid lies within the cell diagonal \f$\sqrt{3} a\f$ of the
+ * fluid, regardless of the grid shift. Particles are added to the volume of the solid with \f$-\sqrt{3} a \le
+ * \phi < 0\f$, which covers all cells that could contain fluid.
+ *
+ * The fill volume is decomposed onto the voxels of the geometry grid that overlap the local domain. The fraction
+ * of each voxel in the fill volume is estimated once by sampling, and is only recomputed if the geometry, box,
+ * cell size, or density changes. Particles are then drawn voxel-by-voxel with rejection. A particle that is
+ * rejected too many times is placed on a point of the sampling subgrid that lies in the fill volume instead.
+ */
+class PYBIND11_EXPORT GridGeometryFiller : public mpcd::VirtualParticleFiller
+    {
+    public:
+        GridGeometryFiller(std::shared_ptr<mpcd::SystemData> sysdata,
+                           Scalar density,
+                           unsigned int type,
+                           std::shared_ptr<::Variant> T,
+                           unsigned int seed,
+                           std::shared_ptr<const mpcd::detail::GridGeometry> geom);
+
+        virtual ~GridGeometryFiller();
+
+        void setGeometry(std::shared_ptr<const mpcd::detail::GridGeometry> geom)
+            {
+            m_geom = geom;
+            notifyRecompute();
+            }
+
+    protected:
+        std::shared_ptr<const mpcd::detail::GridGeometry> m_geom;
+
+        unsigned int m_num_voxels;      //!< Number of voxels to use in filling
+        GPUVector<Scalar3> m_lo;        //!< Lower corner of voxels (clamped to the domain)
+        GPUVector<Scalar3> m_hi;        //!< Upper corner of voxels (clamped to the domain)
+        GPUVector<uint2> m_ranges;      //!< Particle tag ranges for filling
+        Scalar m_thickness;             //!< Thickness of the fill layer inside the solid
+        bool m_warned_rejections;       //!< True if the rejection fallback has been reported
+
+        const static unsigned int NUM_SAMPLES = 4;      //!< Samples per axis used to estimate voxel fill volume
+        const static unsigned int MAX_REJECTIONS = 1000;    //!< Maximum draws for one particle
+
+        //! Compute the total number of particles to fill
+        virtual void computeNumFill();
+
+        //! Draw particles within the fill volume
+        virtual void drawParticles(unsigned int timestep);
+
+    private:
+        bool m_needs_recompute;
+        Scalar2 m_recompute_cache;
+        void notifyRecompute()
+            {
+            m_needs_recompute = true;
+            }
+    };
+
+namespace detail
+{
+//! Export GridGeometryFiller to python
+void export_GridGeometryFiller(pybind11::module& m);
+} // end namespace detail
+} // end namespace mpcd
+#endif // MPCD_GRID_GEOMETRY_FILLER_H_
@@ -44,10 +44,13 @@ namespace mpcd
 /*!
  * MPCD particles are characterized by position, velocity, and mass. We assume all
  * particles have the same mass. The data is laid out as follows:
- * - position + type in array of Scalar4
- * - velocity + cell index in array of Scalar4
+ * - position + type in array of MPCDReal4
+ * - velocity + cell index in array of MPCDReal4
  * - tag in array of unsigned int
  *
+ * MPCDReal4 is Scalar4, unless HOOMD is built with ENABLE_MPCD_MIXED_PRECISION. Then, the positions and
+ * velocities are stored in single precision, which halves the memory and bandwidth needed for the solvent.
+ *
  * Unlike the standard ParticleData, a reverse tag mapping is not currently maintained
  * in order to save local memory. (That is, it is possible to read the tag of a local particle,
  * but it is not possible to efficiently find the local particle that has a given
@@ -159,13 +162,13 @@ class PYBIND11_EXPORT ParticleData
         std::string getNameByType(unsigned int type) const;
 
         //! Get array of MPCD particle positions
-        const GPUArray<Scalar4>& getPositions() const
+        const GPUArray<MPCDReal4>& getPositions() const
             {
             return m_pos;
             }
 
         //! Get array of MPCD particle velocities
-        const GPUArray<Scalar4>& getVelocities() const
+        const GPUArray<MPCDReal4>& getVelocities() const
             {
             return m_vel;
             }
@@ -230,7 +233,7 @@ class PYBIND11_EXPORT ParticleData
         //! \name swap methods
         //@{
         //! Get alternate array of MPCD particle positions
-        const GPUArray<Scalar4>& getAltPositions() const
+        const GPUArray<MPCDReal4>& getAltPositions() const
             {
             return m_pos_alt;
             }
@@ -242,7 +245,7 @@ class PYBIND11_EXPORT ParticleData
             }
 
         //! Get alternate array of MPCD particle velocities
-        const GPUArray<Scalar4>& getAltVelocities() const
+        const GPUArray<MPCDReal4>& getAltVelocities() const
             {
             return m_vel_alt;
             }
@@ -417,8 +420,8 @@ class PYBIND11_EXPORT ParticleData
         std::shared_ptr<DomainDecomposition> m_decomposition;       //!< Domain decomposition
         std::shared_ptr<Profiler> m_prof;                           //!< Profiler
 
-        GPUArray<Scalar4> m_pos;    //!< MPCD particle positions plus type
-        GPUArray<Scalar4> m_vel;    //!< MPCD particle velocities plus cell list id
+        GPUArray<MPCDReal4> m_pos;    //!< MPCD particle positions plus type
+        GPUArray<MPCDReal4> m_vel;    //!< MPCD particle velocities plus cell list id
         Scalar m_mass;              //!< MPCD particle mass
         GPUArray<unsigned int> m_tag;   //!< MPCD particle tags
         std::vector<std::string> m_type_mapping;  //!< Type name mapping
@@ -426,8 +429,8 @@ class PYBIND11_EXPORT ParticleData
         GPUArray<unsigned int> m_comm_flags;    //!< MPCD particle communication flags
         #endif // ENABLE_MPI
 
-        GPUArray<Scalar4> m_pos_alt;        //!< Alternate position array
-        GPUArray<Scalar4> m_vel_alt;        //!< Alternate velocity array
+        GPUArray<MPCDReal4> m_pos_alt;        //!< Alternate position array
+        GPUArray<MPCDReal4> m_vel_alt;        //!< Alternate velocity array
         GPUArray<unsigned int> m_tag_alt;   //!< Alternate tag array
         #ifdef ENABLE_MPI
         GPUArray<unsigned int> m_comm_flags_alt;    //!< Alternate communication flags
@@ -19,8 +19,61 @@
  */
 
 #include "hoomd/HOOMDMath.h"
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef NVCC
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
 namespace mpcd
 {
+// Storage precision of the MPCD particle positions and velocities.
+// Computations are still done in Scalar; only the stored values are rounded.
+#ifdef ENABLE_MPCD_MIXED_PRECISION
+//! Floating point type for MPCD particle storage (single precision)
+typedef float MPCDReal;
+//! Floating point type with x,y,z,w elements for MPCD particle storage (single precision)
+typedef float4 MPCDReal4;
+#else
+//! Floating point type for MPCD particle storage
+typedef Scalar MPCDReal;
+//! Floating point type with x,y,z,w elements for MPCD particle storage
+typedef Scalar4 MPCDReal4;
+#endif // ENABLE_MPCD_MIXED_PRECISION
+
+//! make an MPCDReal4 value
+HOSTDEVICE inline MPCDReal4 make_mpcd_real4(Scalar x, Scalar y, Scalar z, MPCDReal w)
+    {
+    MPCDReal4 retval;
+    retval.x = x;
+    retval.y = y;
+    retval.z = z;
+    retval.w = w;
+    return retval;
+    }
+
+//! Stuff an integer inside the w component of an MPCDReal4
+HOSTDEVICE inline MPCDReal __int_as_mpcd_real(int a)
+    {
+    #ifdef ENABLE_MPCD_MIXED_PRECISION
+    return __int_as_float(a);
+    #else
+    return __int_as_scalar(a);
+    #endif
+    }
+
+//! Extract an integer stuffed by __int_as_mpcd_real()
+HOSTDEVICE inline int __mpcd_real_as_int(MPCDReal b)
+    {
+    #ifdef ENABLE_MPCD_MIXED_PRECISION
+    return __float_as_int(b);
+    #else
+    return __scalar_as_int(b);
+    #endif
+    }
+
 namespace detail
 {
 //! Sentinel value to signify that this particle is not placed in a cell
@@ -36,8 +89,8 @@ const unsigned int NO_CELL = 0xffffffff;
  */
 struct pdata_element
     {
-    Scalar4 pos;            //!< Position
-    Scalar4 vel;            //!< Velocity
+    MPCDReal4 pos;          //!< Position
+    MPCDReal4 vel;          //!< Velocity
     unsigned int tag;       //!< Global tag
     unsigned int comm_flag; //!< Communication flag
     };
@@ -46,4 +99,5 @@ struct pdata_element
 } // end namespace detail
 } // end namespace mpcd
 
+#undef HOSTDEVICE
 #endif // MPCD_PARTICLE_DATA_UTILITIES_H_
@@ -12,6 +12,10 @@
 #include "hoomd/RandomNumbers.h"
 #include "hoomd/RNGIdentifiers.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif // ENABLE_TBB
+
 mpcd::SRDCollisionMethod::SRDCollisionMethod(std::shared_ptr<mpcd::SystemData> sysdata,
                                              unsigned int cur_timestep,
                                              unsigned int period,
@@ -73,56 +77,59 @@ void mpcd::SRDCollisionMethod::drawRotationVectors(unsigned int timestep)
         T_set = m_T->getValue(timestep);
         }
 
-    for (unsigned int k=0; k < ci.getD(); ++k)
+    // each cell has its own random number stream, so the cells can be drawn in parallel
+    const unsigned int ndim = m_sysdef->getNDimensions();
+    auto draw_cell = [&](unsigned int idx)
         {
-        for (unsigned int j=0; j < ci.getH(); ++j)
+        const uint3 cell = ci.getTriple(idx);
+        const int3 global_cell = m_cl->getGlobalCell(make_int3(cell.x, cell.y, cell.z));
+        const unsigned int global_idx = global_ci(global_cell.x, global_cell.y, global_cell.z);
+
+        // Initialize the PRNG using the current cell index, timestep, and seed for the hash
+        hoomd::RandomGenerator rng(hoomd::RNGIdentifier::SRDCollisionMethod, m_seed, global_idx, timestep);
+
+        // draw rotation vector off the surface of the sphere
+        double3 rotvec;
+        hoomd::SpherePointGenerator<double> sphgen;
+        sphgen(rng, rotvec);
+        h_rotvec.data[idx] = rotvec;
+
+        if (use_thermostat)
             {
-            for (unsigned int i=0; i < ci.getW(); ++i)
+            const double3 cell_energy = h_cell_energy->data[idx];
+            const unsigned int np = __double_as_int(cell_energy.z);
+            double factor = 1.0;
+            if (np > 1)
                 {
-                const int3 global_cell = m_cl->getGlobalCell(make_int3(i,j,k));
-                const unsigned int global_idx = global_ci(global_cell.x, global_cell.y, global_cell.z);
-                const unsigned int idx = ci(i,j,k);
-
-                // Initialize the PRNG using the current cell index, timestep, and seed for the hash
-                hoomd::RandomGenerator rng(hoomd::RNGIdentifier::SRDCollisionMethod, m_seed, global_idx, timestep);
-
-                // draw rotation vector off the surface of the sphere
-                double3 rotvec;
-                hoomd::SpherePointGenerator<double> sphgen;
-                sphgen(rng, rotvec);
-                h_rotvec.data[idx] = rotvec;
-
-                if (use_thermostat)
-                    {
-                    const double3 cell_energy = h_cell_energy->data[idx];
-                    const unsigned int np = __double_as_int(cell_energy.z);
-                    double factor = 1.0;
-                    if (np > 1)
-                        {
-                        // the total number of degrees of freedom in the cell divided by 2
-                        const double alpha = m_sysdef->getNDimensions()*(np-1)/(double)2.;
-
-                        // draw a random kinetic energy for the cell at the set temperature
-                        hoomd::GammaDistribution<double> gamma_gen(alpha,T_set);
-                        const double rand_ke = gamma_gen(rng);
-
-                        // generate the scale factor from the current temperature
-                        // (don't use the kinetic energy of this cell, since this
-                        // is total not relative to COM)
-                        const double cur_ke = alpha * cell_energy.y;
-                        factor = (cur_ke > 0.) ? fast::sqrt(rand_ke/cur_ke) : 1.;
-                        }
-                    h_factors->data[idx] = factor;
-                    }
+                // the total number of degrees of freedom in the cell divided by 2
+                const double alpha = ndim*(np-1)/(double)2.;
+
+                // draw a random kinetic energy for the cell at the set temperature
+                hoomd::GammaDistribution<double> gamma_gen(alpha,T_set);
+                const double rand_ke = gamma_gen(rng);
+
+                // generate the scale factor from the current temperature
+                // (don't use the kinetic energy of this cell, since this
+                // is total not relative to COM)
+                const double cur_ke = alpha * cell_energy.y;
+                factor = (cur_ke > 0.) ? fast::sqrt(rand_ke/cur_ke) : 1.;
                 }
+            h_factors->data[idx] = factor;
             }
-        }
+        };
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, ci.getNumElements(), draw_cell);
+    #else
+    for (unsigned int idx=0; idx < ci.getNumElements(); ++idx)
+        draw_cell(idx);
+    #endif // ENABLE_TBB
     }
 
 void mpcd::SRDCollisionMethod::rotate(unsigned int timestep)
     {
     // acquire MPCD particle data
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<MPCDReal4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     unsigned int N_tot = N_mpcd;
     // acquire additionally embedded particle data
@@ -154,7 +161,8 @@ void mpcd::SRDCollisionMethod::rotate(unsigned int timestep)
         h_factors.reset(new ArrayHandle<double>(m_factors, access_location::host, access_mode::read));
         }
 
-    for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+    // every particle is rotated independently using the cell it was binned into
+    auto rotate_particle = [&](unsigned int cur_p)
         {
         double3 vel;
         unsigned int cell;
@@ -162,9 +170,9 @@ void mpcd::SRDCollisionMethod::rotate(unsigned int timestep)
         unsigned int idx(0); double mass(0);
         if (cur_p < N_mpcd)
             {
-            const Scalar4 vel_cell = h_vel.data[cur_p];
+            const MPCDReal4 vel_cell = h_vel.data[cur_p];
             vel = make_double3(vel_cell.x, vel_cell.y, vel_cell.z);
-            cell = __scalar_as_int(vel_cell.w);
+            cell = __mpcd_real_as_int(vel_cell.w);
             }
         else
             {
@@ -215,13 +223,20 @@ void mpcd::SRDCollisionMethod::rotate(unsigned int timestep)
         // set the new velocity
         if (cur_p < N_mpcd)
             {
-            h_vel.data[cur_p] = make_scalar4(new_vel.x, new_vel.y, new_vel.z, __int_as_scalar(cell));
+            h_vel.data[cur_p] = make_mpcd_real4(new_vel.x, new_vel.y, new_vel.z, __int_as_mpcd_real(cell));
             }
         else
             {
             h_vel_embed->data[idx] = make_scalar4(new_vel.x, new_vel.y, new_vel.z, mass);
             }
-        }
+        };
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, N_tot, rotate_particle);
+    #else
+    for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+        rotate_particle(cur_p);
+    #endif // ENABLE_TBB
     }
 
 /*!
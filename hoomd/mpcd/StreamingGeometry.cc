@@ -9,6 +9,7 @@
  */
 
 #include "StreamingGeometry.h"
+#include "hoomd/extern/pybind/include/pybind11/stl.h"
 
 namespace mpcd
 {
@@ -50,5 +51,18 @@ void export_SlitPoreGeometry(pybind11::module& m)
         .def("getBoundaryCondition", &SlitPoreGeometry::getBoundaryCondition);
     }
 
+void export_GridGeometry(pybind11::module& m)
+    {
+    namespace py = pybind11;
+    py::class_<GridGeometry, std::shared_ptr<GridGeometry> >(m, "GridGeometry")
+        .def(py::init<const Scalar3&, const uint3&, const std::vector<Scalar>&, boundary>())
+        .def("getL", &GridGeometry::getL)
+        .def("getDimensions", &GridGeometry::getDimensions)
+        .def("getSDF", &GridGeometry::getSDF)
+        .def("getSignedDistance", &GridGeometry::getSignedDistance)
+        .def("isOutside", &GridGeometry::isOutside)
+        .def("getBoundaryCondition", &GridGeometry::getBoundaryCondition);
+    }
+
 } // end namespace detail
 } // end namespace mpcd
@@ -242,11 +242,15 @@ class system(hoomd.meta._metadata):
 
         self.data.initializeFromSnapshot(snapshot.sys_snap)
 
-    def set_params(self, cell=None):
+    def set_params(self, cell=None, lazy_migrate=None, extra_cells=None):
         R""" Set parameters of the MPCD system
 
         Args:
             cell (float): Edge length of an MPCD cell.
+            lazy_migrate (bool): If True, only migrate MPCD particles between
+                ranks once a particle has left the buffer region of its domain.
+            extra_cells (int): Number of extra layers of cells used to pad
+                each domain in MPI simulations.
 
         Every MPCD system is given a cell list for binning particles (see
         :py:mod:`.mpcd.collide`). The size of the cell list sets the length
@@ -256,10 +260,37 @@ class system(hoomd.meta._metadata):
         has a different fundamental unit of length, you can adjust the
         cell size, but be aware that this will also change the fluid properties.
 
+        In MPI simulations, the cells of each domain are padded so that cells
+        overlapping the domain boundary, up to the maximum grid shift, are
+        shared with the neighboring ranks. MPCD particles lying in this buffer
+        region can be collided by either rank. By default, the particles are
+        migrated to their owning rank before every collision. With
+        *lazy_migrate*, migration is skipped until some particle has left the
+        buffer region, which reduces the number of MPI messages for slowly
+        flowing solvents. The buffer can be widened by *extra_cells* at the
+        cost of communicating more cell data during each collision.
+        Both options are ignored in simulations on a single rank.
+
+        Examples::
+
+            mpcd_sys.set_params(cell=1.0)
+            mpcd_sys.set_params(lazy_migrate=True, extra_cells=1)
+
         """
         if cell is not None:
             self.cell.cell_size = cell
 
+        if lazy_migrate is not None and self.comm is not None:
+            self.comm.setLazyMigrate(bool(lazy_migrate))
+
+        if extra_cells is not None:
+            extra_cells = int(extra_cells)
+            if extra_cells < 0:
+                hoomd.context.msg.error("mpcd: number of extra cells must be non-negative\n")
+                raise ValueError("Number of extra cells must be non-negative")
+            if self.comm is not None:
+                self.cell.num_extra = extra_cells
+
     def take_snapshot(self, particles=True):
         R""" Takes a snapshot of the current state of the MPCD system
 
@@ -51,6 +51,7 @@
 #include "VirtualParticleFiller.h"
 #include "SlitGeometryFiller.h"
 #include "SlitPoreGeometryFiller.h"
+#include "GridGeometryFiller.h"
 #ifdef ENABLE_CUDA
 #include "SlitGeometryFillerGPU.h"
 #include "SlitPoreGeometryFillerGPU.h"
@@ -139,12 +140,14 @@ PYBIND11_MODULE(_mpcd, m)
     mpcd::detail::export_BulkGeometry(m);
     mpcd::detail::export_SlitGeometry(m);
     mpcd::detail::export_SlitPoreGeometry(m);
+    mpcd::detail::export_GridGeometry(m);
 
     mpcd::detail::export_StreamingMethod(m);
     mpcd::detail::export_ExternalFieldPolymorph(m);
     mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::BulkGeometry>(m);
     mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::SlitGeometry>(m);
     mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::SlitPoreGeometry>(m);
+    mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::GridGeometry>(m);
     #ifdef ENABLE_CUDA
     mpcd::detail::export_ConfinedStreamingMethodGPU<mpcd::detail::BulkGeometry>(m);
     mpcd::detail::export_ConfinedStreamingMethodGPU<mpcd::detail::SlitGeometry>(m);
@@ -161,6 +164,7 @@ PYBIND11_MODULE(_mpcd, m)
     mpcd::detail::export_VirtualParticleFiller(m);
     mpcd::detail::export_SlitGeometryFiller(m);
     mpcd::detail::export_SlitPoreGeometryFiller(m);
+    mpcd::detail::export_GridGeometryFiller(m);
     #ifdef ENABLE_CUDA
     mpcd::detail::export_SlitGeometryFillerGPU(m);
     mpcd::detail::export_SlitPoreGeometryFillerGPU(m);
@@ -50,6 +50,7 @@ a few important caveats:
 
 import hoomd
 from hoomd import _hoomd
+import numpy as np
 
 from . import _mpcd
 
@@ -567,3 +568,172 @@ class slit_pore(_streaming_method):
         self._cpp.geometry = _mpcd.SlitPoreGeometry(self.H,self.L,bc)
         if self._filler is not None:
             self._filler.setGeometry(self._cpp.geometry)
+
+class grid(_streaming_method):
+    r""" Arbitrary streaming geometry from a signed-distance grid.
+
+    Args:
+        sdf (array): signed distance on a grid of nodes spanning the box
+        boundary (str): boundary condition at surface ("slip" or "no_slip"")
+        period (int): Number of integration steps between collisions
+
+    The grid geometry represents an arbitrary solid surface, such as a porous
+    medium or a microfluidic channel, that is given by its signed distance
+    :math:`\phi`. The fluid is where :math:`\phi \ge 0`, and the solid is where
+    :math:`\phi < 0`. *sdf* is a 3d array with shape :math:`(n_x, n_y, n_z)`
+    that samples :math:`\phi` on a regular grid spanning the periodic simulation
+    box. Element ``sdf[i,j,k]`` is the value at the node
+    :math:`\mathbf{r}_{\rm lo} + (i L_x/n_x, j L_y/n_y, k L_z/n_z)`, where
+    :math:`\mathbf{r}_{\rm lo}` is the lower corner of the box. Between nodes,
+    :math:`\phi` is trilinearly interpolated.
+
+    The voxels of the grid are classified when the geometry is created.
+    Collision detection is skipped for particles that end a streaming step in a
+    voxel whose nodes all lie in the fluid, so streaming through the bulk of the
+    fluid costs roughly the same as :py:class:`bulk`. The grid spacing should be
+    comparable to or smaller than the MPCD cell size.
+
+    The "inside" of the :py:class:`grid` is the space where :math:`\phi \ge 0`.
+
+    The grid is tied to the simulation box when the geometry is created, and it
+    is an error to run with a box of a different size. This geometry is only
+    supported on the CPU.
+
+    Examples::
+
+        # cylindrical channel of radius 4 along x
+        x = np.arange(40)*box.Lx/40 - box.Lx/2
+        X,Y,Z = np.meshgrid(x,x,x,indexing='ij')
+        stream.grid(sdf=4.0-np.sqrt(Y**2+Z**2))
+
+    .. versionadded:: 2.10
+
+    """
+    def __init__(self, sdf, boundary="no_slip", period=1):
+        hoomd.util.print_status_line()
+
+        _streaming_method.__init__(self, period)
+
+        if hoomd.context.exec_conf.isCUDAEnabled():
+            hoomd.context.msg.error('mpcd.stream.grid: grid geometry is not supported on the GPU.\n')
+            raise RuntimeError('Grid geometry not supported on GPU')
+
+        self.metadata_fields += ['boundary']
+        self.boundary = boundary
+
+        # create the base streaming class
+        self._cpp = _mpcd.ConfinedStreamingMethodGrid(hoomd.context.current.mpcd.data,
+                                                      hoomd.context.current.system.getCurrentTimeStep(),
+                                                      self.period,
+                                                      0,
+                                                      self._make_geometry(sdf, boundary))
+
+    def set_filler(self, density, kT, seed, type='A'):
+        r""" Add virtual particles to the solid.
+
+        Args:
+            density (float): Density of virtual particles.
+            kT (float): Temperature of virtual particles.
+            seed (int): Seed to pseudo-random number generator for virtual particles.
+            type (str): Type of the MPCD particles to fill with.
+
+        The virtual particle filler draws particles within the layer of the
+        solid that could be overlapped by any cell that is partially in the
+        fluid, which is where :math:`-\sqrt{3} a \le \phi < 0` for cell size
+        *a*. The particles are drawn from the velocity distribution consistent
+        with *kT* and with the given *density*. The mean of the distribution is
+        zero in *x*, *y*, and *z*. Typically, the virtual particle density and
+        temperature are set to the same conditions as the solvent. For the fill
+        layer to be correct, *sdf* should be the distance to the surface at least
+        this far into the solid.
+
+        The virtual particles will act as a weak thermostat on the fluid, and so energy
+        is no longer conserved. Momentum will also be sunk into the walls.
+
+        Example::
+
+            grid.set_filler(density=5.0, kT=1.0, seed=42)
+
+        """
+        hoomd.util.print_status_line()
+
+        type_id = hoomd.context.current.mpcd.particles.getTypeByName(type)
+        T = hoomd.variant._setup_variant_input(kT)
+
+        if self._filler is None:
+            self._filler = _mpcd.GridGeometryFiller(hoomd.context.current.mpcd.data,
+                                                    density,
+                                                    type_id,
+                                                    T.cpp_variant,
+                                                    seed,
+                                                    self._cpp.geometry)
+        else:
+            self._filler.setDensity(density)
+            self._filler.setType(type_id)
+            self._filler.setTemperature(T.cpp_variant)
+            self._filler.setSeed(seed)
+
+    def remove_filler(self):
+        """ Remove the virtual particle filler.
+
+        Example::
+
+            grid.remove_filler()
+
+        """
+        hoomd.util.print_status_line()
+
+        self._filler = None
+
+    def set_params(self, sdf=None, boundary=None):
+        """ Set parameters for the grid geometry.
+
+        Args:
+            sdf (array): signed distance on a grid of nodes spanning the box
+            boundary (str): boundary condition at surface ("slip" or "no_slip"")
+
+        Changing any of these parameters will require the geometry to be
+        constructed and validated, so do not change these too often. The grid
+        is tied to the current simulation box.
+
+        Examples::
+
+            grid.set_params(boundary="slip")
+
+        """
+        hoomd.util.print_status_line()
+
+        if boundary is not None:
+            self.boundary = boundary
+
+        if sdf is None:
+            sdf = self._sdf
+
+        self._cpp.geometry = self._make_geometry(sdf, self.boundary)
+        if self._filler is not None:
+            self._filler.setGeometry(self._cpp.geometry)
+
+    def _make_geometry(self, sdf, boundary):
+        """ Construct the C++ geometry for a signed-distance grid.
+
+        Args:
+            sdf (array): signed distance on a grid of nodes spanning the box
+            boundary (str): boundary condition at surface
+
+        The signed distance is flattened with *x* varying fastest, which is the
+        grid ordering used by the geometry.
+
+        """
+        bc = self._process_boundary(boundary)
+
+        sdf = np.asarray(sdf, dtype=np.float64)
+        if sdf.ndim != 3:
+            hoomd.context.msg.error('mpcd.stream.grid: signed distance must be a 3d array.\n')
+            raise ValueError('Signed distance must be a 3d array')
+        self._sdf = sdf
+
+        L = hoomd.context.current.system_definition.getParticleData().getGlobalBox().getL()
+        return _mpcd.GridGeometry(_hoomd.make_scalar3(L.x, L.y, L.z),
+                                  _hoomd.make_uint3(*sdf.shape),
+                                  sdf.flatten(order='F').tolist(),
+                                  bc)
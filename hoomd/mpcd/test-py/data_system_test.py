@@ -18,6 +18,22 @@ class mpcd_snapshot(unittest.TestCase):
 
         s.set_params(cell=1.5)
 
+    def test_set_params_migrate(self):
+        s = mpcd.init.make_random(N=3, kT=1.0, seed=7)
+
+        s.set_params(lazy_migrate=True, extra_cells=1)
+        if s.comm is not None:
+            self.assertTrue(s.comm.getLazyMigrate())
+            self.assertEqual(s.cell.num_extra, 1)
+
+        s.set_params(lazy_migrate=False, extra_cells=0)
+        if s.comm is not None:
+            self.assertFalse(s.comm.getLazyMigrate())
+            self.assertEqual(s.cell.num_extra, 0)
+
+        with self.assertRaises(ValueError):
+            s.set_params(extra_cells=-1)
+
     def test_snapshot(self):
         s = mpcd.init.make_random(N=3, kT=1.0, seed=7)
         snap = s.take_snapshot()
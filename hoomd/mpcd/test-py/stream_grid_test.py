@@ -0,0 +1,202 @@
+# Copyright (c) 2009-2019 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+# Maintainer: mphoward
+
+import unittest
+import numpy as np
+import hoomd
+from hoomd import md
+from hoomd import mpcd
+
+# unit tests for mpcd grid streaming geometry
+class mpcd_stream_grid_test(unittest.TestCase):
+    def setUp(self):
+        # establish the simulation context
+        hoomd.context.initialize()
+
+        # the grid geometry is only supported on the cpu
+        if hoomd.context.exec_conf.isCUDAEnabled():
+            self.skipTest('grid geometry is not supported on the GPU')
+
+        # set the decomposition in z for mpi builds
+        if hoomd.comm.get_num_ranks() > 1:
+            hoomd.comm.decomposition(nz=2)
+
+        # default testing configuration
+        hoomd.init.read_snapshot(hoomd.data.make_snapshot(N=0, box=hoomd.data.boxdim(L=10.)))
+
+        # initialize the system from the starting snapshot
+        snap = mpcd.data.make_snapshot(N=2)
+        snap.particles.position[:] = [[4.95,-4.95,3.85],[0.,0.,-3.8]]
+        snap.particles.velocity[:] = [[1.,-1.,1.],[-1.,-1.,-1.]]
+        self.s = mpcd.init.read_snapshot(snap)
+
+        mpcd.integrator(dt=0.1)
+
+    # signed distance for a slit of half width H sampled with unit spacing in the box
+    def make_slit(self, H):
+        z = np.arange(10) - 5.
+        return np.tile(H - np.abs(z), (10,10,1))
+
+    # test creation can happen (with all parameters set)
+    def test_create(self):
+        mpcd.stream.grid(sdf=self.make_slit(4.), boundary="no_slip", period=2)
+
+    # test for setting parameters
+    def test_set_params(self):
+        grid = mpcd.stream.grid(sdf=self.make_slit(4.))
+        self.assertEqual(grid.boundary, "no_slip")
+        self.assertEqual(grid._cpp.geometry.getBoundaryCondition(), mpcd._mpcd.boundary.no_slip)
+        dim = grid._cpp.geometry.getDimensions()
+        self.assertEqual((dim.x, dim.y, dim.z), (10,10,10))
+        self.assertAlmostEqual(grid._cpp.geometry.getSignedDistance(hoomd._hoomd.make_scalar3(0.,0.,3.5)), 0.5)
+
+        # change sdf and also ensure other parameters stay the same
+        grid.set_params(sdf=self.make_slit(3.))
+        self.assertEqual(grid.boundary, "no_slip")
+        self.assertAlmostEqual(grid._cpp.geometry.getSignedDistance(hoomd._hoomd.make_scalar3(0.,0.,3.5)), -0.5)
+
+        # change BCs
+        grid.set_params(boundary="slip")
+        self.assertEqual(grid.boundary, "slip")
+        self.assertEqual(grid._cpp.geometry.getBoundaryCondition(), mpcd._mpcd.boundary.slip)
+        self.assertAlmostEqual(grid._cpp.geometry.getSignedDistance(hoomd._hoomd.make_scalar3(0.,0.,3.5)), -0.5)
+
+        # sdf must be 3d
+        with self.assertRaises(ValueError):
+            grid.set_params(sdf=np.zeros((10,10)))
+
+    # test for invalid boundary conditions being set
+    def test_bad_boundary(self):
+        grid = mpcd.stream.grid(sdf=self.make_slit(4.))
+        grid.set_params(boundary="no_slip")
+        grid.set_params(boundary="slip")
+
+        with self.assertRaises(ValueError):
+            grid.set_params(boundary="invalid")
+
+    # test basic stepping behavior with no slip boundary conditions
+    def test_step_noslip(self):
+        mpcd.stream.grid(sdf=self.make_slit(4.))
+
+        # take one step
+        hoomd.run(1)
+        snap = self.s.take_snapshot()
+        if hoomd.comm.get_rank() == 0:
+            np.testing.assert_array_almost_equal(snap.particles.position[0], [-4.95,4.95,3.95])
+            np.testing.assert_array_almost_equal(snap.particles.velocity[0], [1.,-1.,1.])
+            np.testing.assert_array_almost_equal(snap.particles.position[1], [-0.1,-0.1,-3.9])
+            np.testing.assert_array_almost_equal(snap.particles.velocity[1], [-1.,-1.,-1.])
+
+        # take another step where one particle will now hit the wall
+        hoomd.run(1)
+        snap = self.s.take_snapshot()
+        if hoomd.comm.get_rank() == 0:
+            np.testing.assert_array_almost_equal(snap.particles.position[0], [-4.95,4.95,3.95])
+            np.testing.assert_array_almost_equal(snap.particles.velocity[0], [-1.,1.,-1.])
+            np.testing.assert_array_almost_equal(snap.particles.position[1], [-0.2,-0.2,-4.0])
+            np.testing.assert_array_almost_equal(snap.particles.velocity[1], [-1.,-1.,-1.])
+
+        # take another step, wrapping the second particle through the boundary
+        hoomd.run(1)
+        snap = self.s.take_snapshot()
+        if hoomd.comm.get_rank() == 0:
+            np.testing.assert_array_almost_equal(snap.particles.position[0], [4.95,-4.95,3.85])
+            np.testing.assert_array_almost_equal(snap.particles.velocity[0], [-1.,1.,-1.])
+            np.testing.assert_array_almost_equal(snap.particles.position[1], [-0.1,-0.1,-3.9])
+            np.testing.assert_array_almost_equal(snap.particles.velocity[1], [1.,1.,1.])
+
+    # test basic stepping behavior with slip boundary conditions
+    def test_step_slip(self):
+        mpcd.stream.grid(sdf=self.make_slit(4.), boundary="slip")
+
+        # take one step
+        hoomd.run(1)
+        snap = self.s.take_snapshot()
+        if hoomd.comm.get_rank() == 0:
+            np.testing.assert_array_almost_equal(snap.particles.position[0], [-4.95,4.95,3.95])
+            np.testing.assert_array_almost_equal(snap.particles.velocity[0], [1.,-1.,1.])
+            np.testing.assert_array_almost_equal(snap.particles.position[1], [-0.1,-0.1,-3.9])
+            np.testing.assert_array_almost_equal(snap.particles.velocity[1], [-1.,-1.,-1.])
+
+        # take another step where one particle will now hit the wall
+        hoomd.run(1)
+        snap = self.s.take_snapshot()
+        if hoomd.comm.get_rank() == 0:
+            np.testing.assert_array_almost_equal(snap.particles.position[0], [-4.85,4.85,3.95])
+            np.testing.assert_array_almost_equal(snap.particles.velocity[0], [1.,-1.,-1.])
+            np.testing.assert_array_almost_equal(snap.particles.position[1], [-0.2,-0.2,-4.0])
+            np.testing.assert_array_almost_equal(snap.particles.velocity[1], [-1.,-1.,-1.])
+
+    # test that a grid for the wrong box raises an error
+    def test_validate_box(self):
+        # zero velocities to stop particles moving during testing
+        snap = self.s.take_snapshot()
+        if hoomd.comm.get_rank() == 0:
+            snap.particles.velocity[:] = 0.
+        self.s.restore_snapshot(snap)
+
+        grid = mpcd.stream.grid(sdf=self.make_slit(4.))
+        hoomd.run(1)
+
+        # a grid made for a different box is invalid
+        sdf = self.make_slit(4.)
+        grid._cpp.geometry = mpcd._mpcd.GridGeometry(hoomd._hoomd.make_scalar3(12.,12.,12.),
+                                                     hoomd._hoomd.make_uint3(*sdf.shape),
+                                                     sdf.flatten(order='F').tolist(),
+                                                     mpcd._mpcd.boundary.no_slip)
+        with self.assertRaises(RuntimeError):
+            hoomd.run(1)
+
+        # making the grid again from the box fixes it
+        grid.set_params(sdf=sdf)
+        hoomd.run(1)
+
+    # test that particles out of bounds can be caught
+    def test_out_of_bounds(self):
+        grid = mpcd.stream.grid(sdf=self.make_slit(3.8))
+        with self.assertRaises(RuntimeError):
+            hoomd.run(1)
+
+        grid.set_params(sdf=self.make_slit(4.))
+        hoomd.run(1)
+
+    # test that virtual particle filler can be attached, removed, and updated
+    def test_filler(self):
+        # initialization of a filler
+        grid = mpcd.stream.grid(sdf=self.make_slit(4.))
+        grid.set_filler(density=5., kT=1.0, seed=42, type='A')
+        self.assertTrue(grid._filler is not None)
+
+        # run should be able to setup the filler, although this all happens silently
+        hoomd.run(1)
+
+        # changing the geometry should still be OK with a run
+        grid.set_params(boundary="slip")
+        hoomd.run(1)
+
+        # changing filler should be allowed
+        grid.set_filler(density=10., kT=1.5, seed=7)
+        self.assertTrue(grid._filler is not None)
+        hoomd.run(1)
+
+        # assert an error is raised if we set a bad particle type
+        with self.assertRaises(RuntimeError):
+            grid.set_filler(density=5., kT=1.0, seed=42, type='B')
+
+        # assert an error is raised if we set a bad density
+        with self.assertRaises(RuntimeError):
+            grid.set_filler(density=-1.0, kT=1.0, seed=42)
+
+        # removing the filler should still allow a run
+        grid.remove_filler()
+        self.assertTrue(grid._filler is None)
+        hoomd.run(1)
+
+    def tearDown(self):
+        if hasattr(self, 's'):
+            del self.s
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -148,23 +148,23 @@ void celllist_small_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
         CHECK_EQUAL_UINT( h_cell_list.data[cli(0, ci(1,1,0))], 3 );
         CHECK_EQUAL_UINT( h_cell_list.data[cli(0, ci(1,1,1))], 7 );
 
-        ArrayHandle<Scalar4> h_vel(pdata_9->getVelocities(), access_location::host, access_mode::read);
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[0].w), ci(0,0,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[1].w), ci(1,0,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[2].w), ci(0,1,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[3].w), ci(1,1,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[4].w), ci(0,0,1) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[5].w), ci(1,0,1) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[6].w), ci(0,1,1) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[7].w), ci(1,1,1) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[8].w), ci(0,0,0) );
+        ArrayHandle<mpcd::MPCDReal4> h_vel(pdata_9->getVelocities(), access_location::host, access_mode::read);
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[0].w), ci(0,0,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[1].w), ci(1,0,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[2].w), ci(0,1,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[3].w), ci(1,1,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[4].w), ci(0,0,1) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[5].w), ci(1,0,1) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[6].w), ci(0,1,1) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[7].w), ci(1,1,1) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[8].w), ci(0,0,0) );
         }
 
     // condense particles into two bins
         {
-        ArrayHandle<Scalar4> h_pos(pdata_9->getPositions(), access_location::host, access_mode::overwrite);
-        h_pos.data[0] = make_scalar4(-0.3, -0.3, -0.3, 0.0);
-        h_pos.data[1] = make_scalar4( 0.3,  0.3,  0.3, 0.0);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata_9->getPositions(), access_location::host, access_mode::overwrite);
+        h_pos.data[0] = mpcd::make_mpcd_real4(-0.3, -0.3, -0.3, 0.0);
+        h_pos.data[1] = mpcd::make_mpcd_real4( 0.3,  0.3,  0.3, 0.0);
         h_pos.data[2] = h_pos.data[0];
         h_pos.data[3] = h_pos.data[1];
         h_pos.data[4] = h_pos.data[0];
@@ -218,8 +218,8 @@ void celllist_small_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
 
     // bring all particles into one box, which triggers a resize, and check that all particles are in this bin
         {
-        ArrayHandle<Scalar4> h_pos(pdata_9->getPositions(), access_location::host, access_mode::overwrite);
-        h_pos.data[0] = make_scalar4(0.9, -0.4, 0.0, 0.0);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata_9->getPositions(), access_location::host, access_mode::overwrite);
+        h_pos.data[0] = mpcd::make_mpcd_real4(0.9, -0.4, 0.0, 0.0);
         for (unsigned int i=1; i < 9; ++i)
             h_pos.data[i] = h_pos.data[0];
         }
@@ -241,14 +241,14 @@ void celllist_small_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
 
     // send a particle out of bounds and check that an exception is raised
         {
-        ArrayHandle<Scalar4> h_pos(pdata_9->getPositions(), access_location::host, access_mode::overwrite);
-        h_pos.data[0] = make_scalar4(2.1, 2.1, 2.1, __int_as_scalar(0));
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata_9->getPositions(), access_location::host, access_mode::overwrite);
+        h_pos.data[0] = mpcd::make_mpcd_real4(2.1, 2.1, 2.1, mpcd::__int_as_mpcd_real(0));
         }
     UP_ASSERT_EXCEPTION(std::runtime_error, [&]{ cl->compute(3); });
     // check the other side as well
         {
-        ArrayHandle<Scalar4> h_pos(pdata_9->getPositions(), access_location::host, access_mode::overwrite);
-        h_pos.data[0] = make_scalar4(-2.1, -2.1, -2.1, __int_as_scalar(0));
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata_9->getPositions(), access_location::host, access_mode::overwrite);
+        h_pos.data[0] = mpcd::make_mpcd_real4(-2.1, -2.1, -2.1, mpcd::__int_as_mpcd_real(0));
         }
     UP_ASSERT_EXCEPTION(std::runtime_error, [&]{ cl->compute(4); });
     }
@@ -288,8 +288,8 @@ void celllist_grid_shift_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
 
     // move to the other side and retry
         {
-        ArrayHandle<Scalar4> h_pos(pdata_1->getPositions(), access_location::host, access_mode::overwrite);
-        h_pos.data[0] = make_scalar4(-0.1, -0.1, -0.1, 0.0);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata_1->getPositions(), access_location::host, access_mode::overwrite);
+        h_pos.data[0] = mpcd::make_mpcd_real4(-0.1, -0.1, -0.1, 0.0);
         }
     cl->setGridShift(make_scalar3(-0.5,-0.5,-0.5));
     cl->compute(2);
@@ -301,8 +301,8 @@ void celllist_grid_shift_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
 
     // check for cell periodic wrapping by putting particles near the box boundary
         {
-        ArrayHandle<Scalar4> h_pos(pdata_1->getPositions(), access_location::host, access_mode::overwrite);
-        h_pos.data[0] = make_scalar4(-2.9, -2.9, -2.9, 0.0);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata_1->getPositions(), access_location::host, access_mode::overwrite);
+        h_pos.data[0] = mpcd::make_mpcd_real4(-2.9, -2.9, -2.9, 0.0);
         }
     cl->setGridShift(make_scalar3(0.5,0.5,0.5));
     cl->compute(3);
@@ -314,8 +314,8 @@ void celllist_grid_shift_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
 
     // and the other way
         {
-        ArrayHandle<Scalar4> h_pos(pdata_1->getPositions(), access_location::host, access_mode::overwrite);
-        h_pos.data[0] = make_scalar4(2.9, 2.9, 2.9, 0.0);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata_1->getPositions(), access_location::host, access_mode::overwrite);
+        h_pos.data[0] = mpcd::make_mpcd_real4(2.9, 2.9, 2.9, 0.0);
         }
     cl->setGridShift(make_scalar3(-0.5,-0.5,-0.5));
     cl->compute(4);
@@ -406,15 +406,15 @@ void celllist_embed_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
         CHECK_EQUAL_UINT( h_cell_list.data[cli(0, ci(1,1,0))], 3 );
         CHECK_EQUAL_UINT( h_cell_list.data[cli(0, ci(1,1,1))], 7 );
 
-        ArrayHandle<Scalar4> h_vel(pdata_8->getVelocities(), access_location::host, access_mode::read);
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[0].w), ci(0,0,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[1].w), ci(1,0,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[2].w), ci(0,1,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[3].w), ci(1,1,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[4].w), ci(0,0,1) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[5].w), ci(1,0,1) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[6].w), ci(0,1,1) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[7].w), ci(1,1,1) );
+        ArrayHandle<mpcd::MPCDReal4> h_vel(pdata_8->getVelocities(), access_location::host, access_mode::read);
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[0].w), ci(0,0,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[1].w), ci(1,0,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[2].w), ci(0,1,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[3].w), ci(1,1,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[4].w), ci(0,0,1) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[5].w), ci(1,0,1) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[6].w), ci(0,1,1) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[7].w), ci(1,1,1) );
         }
 
     // now we include the half embedded group
@@ -480,15 +480,15 @@ void celllist_embed_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
             UP_ASSERT_EQUAL(result, std::vector<unsigned int>{7,11});
             }
 
-        ArrayHandle<Scalar4> h_vel(pdata_8->getVelocities(), access_location::host, access_mode::read);
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[0].w), ci(0,0,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[1].w), ci(1,0,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[2].w), ci(0,1,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[3].w), ci(1,1,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[4].w), ci(0,0,1) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[5].w), ci(1,0,1) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[6].w), ci(0,1,1) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[7].w), ci(1,1,1) );
+        ArrayHandle<mpcd::MPCDReal4> h_vel(pdata_8->getVelocities(), access_location::host, access_mode::read);
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[0].w), ci(0,0,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[1].w), ci(1,0,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[2].w), ci(0,1,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[3].w), ci(1,1,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[4].w), ci(0,0,1) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[5].w), ci(1,0,1) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[6].w), ci(0,1,1) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[7].w), ci(1,1,1) );
 
         ArrayHandle<unsigned int> h_embed_cell_ids(cl->getEmbeddedGroupCellIds(), access_location::host, access_mode::read);
         CHECK_EQUAL_UINT(h_embed_cell_ids.data[0], ci(1,0,0));
@@ -563,15 +563,15 @@ void celllist_embed_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
             UP_ASSERT_EQUAL(result, std::vector<unsigned int>{7,11});
             }
 
-        ArrayHandle<Scalar4> h_vel(pdata_8->getVelocities(), access_location::host, access_mode::read);
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[0].w), ci(0,0,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[1].w), ci(1,0,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[2].w), ci(0,1,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[3].w), ci(1,1,0) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[4].w), ci(0,0,1) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[5].w), ci(1,0,1) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[6].w), ci(0,1,1) );
-        CHECK_EQUAL_UINT( __scalar_as_int(h_vel.data[7].w), ci(1,1,1) );
+        ArrayHandle<mpcd::MPCDReal4> h_vel(pdata_8->getVelocities(), access_location::host, access_mode::read);
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[0].w), ci(0,0,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[1].w), ci(1,0,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[2].w), ci(0,1,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[3].w), ci(1,1,0) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[4].w), ci(0,0,1) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[5].w), ci(1,0,1) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[6].w), ci(0,1,1) );
+        CHECK_EQUAL_UINT( mpcd::__mpcd_real_as_int(h_vel.data[7].w), ci(1,1,1) );
 
         ArrayHandle<unsigned int> h_embed_cell_ids(cl->getEmbeddedGroupCellIds(), access_location::host, access_mode::read);
         CHECK_EQUAL_UINT(h_embed_cell_ids.data[0], ci(1,1,0));
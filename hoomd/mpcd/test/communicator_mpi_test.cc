@@ -227,7 +227,7 @@ void test_communicator_migrate(communicator_creator comm_creator, std::shared_pt
 
     // move particles to new ranks
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
 
         Scalar3 new_pos;
         switch(my_rank)
@@ -334,7 +334,7 @@ void test_communicator_migrate(communicator_creator comm_creator, std::shared_pt
 
     // move particles through the global boundary
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
 
         Scalar3 new_pos;
         switch(my_rank)
@@ -593,7 +593,7 @@ void test_communicator_migrate_ortho(communicator_creator comm_creator, std::sha
 
     // move particles to new ranks
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
 
         Scalar3 new_pos;
         switch(exec_conf->getRank())
@@ -645,7 +645,7 @@ void test_communicator_migrate_ortho(communicator_creator comm_creator, std::sha
     // move all particles onto domains 5 and 6
     const unsigned int rank = exec_conf->getRank();
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
 
         // just get them all in the same place
         // this first set will put tags 7, 0, 3, and 4 on rank 5
@@ -676,7 +676,7 @@ void test_communicator_migrate_ortho(communicator_creator comm_creator, std::sha
 
     // now send multiple particles out from each rank in different directions
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
         if (rank == 5)
             {
             // send one particle to rank 6, rank 4, and rank 0
@@ -770,6 +770,110 @@ void test_communicator_overdecompose(std::shared_ptr<ExecutionConfiguration> exe
     }
 
 
+//! Test lazy particle migration of Communicator
+void test_communicator_lazy(communicator_creator comm_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size,8);
+
+    // default initialize an empty snapshot in the reference box
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap( new SnapshotSystemData<Scalar>() );
+    snap->global_box = BoxDim(2.0);
+    snap->particle_data.type_mapping.push_back("A");
+    // initialize a 2x2x2 domain decomposition on processor with rank 0
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, snap->global_box.getL(),2,2,2));
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf, decomposition));
+
+    // place one mpcd particle in the middle of every domain
+    auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
+        {
+        auto mpcd_snap = mpcd_sys_snap->particles;
+        mpcd_snap->type_mapping.push_back("A");
+        mpcd_snap->resize(8);
+        mpcd_snap->position[0] = vec3<Scalar>(-0.5,-0.5,-0.5);
+        mpcd_snap->position[1] = vec3<Scalar>( 0.5,-0.5,-0.5);
+        mpcd_snap->position[2] = vec3<Scalar>(-0.5, 0.5,-0.5);
+        mpcd_snap->position[3] = vec3<Scalar>( 0.5, 0.5,-0.5);
+        mpcd_snap->position[4] = vec3<Scalar>(-0.5,-0.5, 0.5);
+        mpcd_snap->position[5] = vec3<Scalar>( 0.5,-0.5, 0.5);
+        mpcd_snap->position[6] = vec3<Scalar>(-0.5, 0.5, 0.5);
+        mpcd_snap->position[7] = vec3<Scalar>( 0.5, 0.5, 0.5);
+        }
+    auto mpcd_sys = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+    // with this cell size, the coverage box extends 0.025 past each domain boundary
+    mpcd_sys->getCellList()->setCellSize(0.05);
+
+    std::shared_ptr<mpcd::Communicator> comm = comm_creator(mpcd_sys, 3);
+    MigrateSelectOp migrate_op(comm);
+    comm->setLazyMigrate(true);
+    UP_ASSERT(comm->getLazyMigrate());
+
+    std::shared_ptr<mpcd::ParticleData> pdata = mpcd_sys->getParticleData();
+    const unsigned int rank = exec_conf->getRank();
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+    UP_ASSERT_EQUAL(pdata->getTag(0), rank);
+
+    // move particle 0 into the buffer of domain 0, which should not trigger a migration
+    if (rank == 0)
+        {
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        h_pos.data[0].x = Scalar(0.01);
+        }
+    comm->communicate(0);
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+    UP_ASSERT_EQUAL(pdata->getTag(0), rank);
+
+    // move particle 0 past the buffer, which should migrate it to domain 1
+    if (rank == 0)
+        {
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        h_pos.data[0].x = Scalar(0.1);
+        }
+    comm->communicate(2);
+    if (rank == 0)
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 0);
+        }
+    else if (rank == 1)
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 2);
+        }
+    else
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 1);
+        }
+
+    // pad with an extra cell, and move particle 0 back into the (wider) buffer of domain 1
+    mpcd_sys->getCellList()->setNExtraCells(1);
+    if (rank == 1)
+        {
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        for (unsigned int i=0; i < pdata->getN(); ++i)
+            {
+            if (h_tag.data[i] == 0)
+                h_pos.data[i].x = Scalar(-0.05);
+            }
+        }
+    comm->communicate(4);
+    if (rank == 0)
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 0);
+        }
+    else if (rank == 1)
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 2);
+        }
+
+    // forcing a migration always sends the particle back to its owner
+    comm->forceMigrate(); comm->communicate(5);
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+    UP_ASSERT_EQUAL(pdata->getTag(0), rank);
+    }
+
+
 //! Communicator creator for unit tests
 /*!
  * \a nstages is ignored because it is meaningless for the CPU base class
@@ -799,6 +903,14 @@ UP_TEST( mpcd_communicator_migrate_ortho_test )
     test_communicator_migrate_ortho(communicator_creator_base, exec_conf, 3);
     }
 
+UP_TEST( mpcd_communicator_lazy_test )
+    {
+    auto exec_conf = std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    test_communicator_lazy(communicator_creator_base, exec_conf);
+    }
+
 UP_TEST( mpcd_communicator_overdecompose_test )
     {
     // two ranks in any direction
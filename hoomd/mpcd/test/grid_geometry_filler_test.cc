@@ -0,0 +1,202 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+#include "hoomd/mpcd/GridGeometryFiller.h"
+
+#include "hoomd/SnapshotSystemData.h"
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN()
+
+//! Make a grid geometry for a slit of half width 5 in a box of edge length 20, with nodes spaced by 1
+std::shared_ptr<const mpcd::detail::GridGeometry> make_slit_grid(mpcd::detail::boundary bc)
+    {
+    const uint3 dim = make_uint3(20,20,20);
+    Index3D indexer(dim.x, dim.y, dim.z);
+    std::vector<Scalar> sdf(indexer.getNumElements());
+    for (unsigned int k=0; k < dim.z; ++k)
+        {
+        const Scalar z = Scalar(-10.0) + k;
+        for (unsigned int j=0; j < dim.y; ++j)
+            {
+            for (unsigned int i=0; i < dim.x; ++i)
+                {
+                sdf[indexer(i,j,k)] = Scalar(5.0) - std::abs(z);
+                }
+            }
+        }
+    return std::make_shared<const mpcd::detail::GridGeometry>(make_scalar3(20,20,20), dim, sdf, bc);
+    }
+
+//! Test the collision rules and voxel classification of the grid geometry
+UP_TEST( grid_geometry_basic )
+    {
+    auto geom = make_slit_grid(mpcd::detail::boundary::no_slip);
+
+    // voxels are classified from their corners
+    UP_ASSERT(geom->getVoxel(10,10,10) == mpcd::detail::GridGeometry::voxel::fluid);
+    UP_ASSERT(geom->getVoxel(10,10,14) == mpcd::detail::GridGeometry::voxel::fluid);
+    UP_ASSERT(geom->getVoxel(10,10,15) == mpcd::detail::GridGeometry::voxel::surface);
+    UP_ASSERT(geom->getVoxel(10,10,4) == mpcd::detail::GridGeometry::voxel::surface);
+    UP_ASSERT(geom->getVoxel(10,10,16) == mpcd::detail::GridGeometry::voxel::solid);
+    UP_ASSERT(geom->getVoxel(10,10,0) == mpcd::detail::GridGeometry::voxel::solid);
+
+    // interpolation, including through the periodic boundary
+    CHECK_CLOSE(geom->getSignedDistance(make_scalar3(0.3,-0.2,4.5)), 0.5, tol_small);
+    CHECK_CLOSE(geom->getSignedDistance(make_scalar3(0.3,-0.2,-5.25)), -0.25, tol_small);
+    CHECK_CLOSE(geom->getSignedDistance(make_scalar3(0.3,-0.2,9.5)), -4.5, tol_small);
+    CHECK_CLOSE(geom->getSignedDistance(make_scalar3(20.3,-20.2,4.5)), 0.5, tol_small);
+    UP_ASSERT(!geom->isOutside(make_scalar3(1,2,4.9)));
+    UP_ASSERT(geom->isOutside(make_scalar3(1,2,5.1)));
+    UP_ASSERT(geom->isOutside(make_scalar3(1,2,-5.1)));
+
+    // box must match the grid
+    UP_ASSERT(geom->validateBox(BoxDim(20.0), 1.0));
+    UP_ASSERT(!geom->validateBox(BoxDim(22.0), 1.0));
+
+    // particle in the fluid does not collide
+        {
+        Scalar3 pos = make_scalar3(0.1, 0.2, 0.3);
+        Scalar3 vel = make_scalar3(1.0, 1.0, 1.0);
+        Scalar dt = 0.1;
+        UP_ASSERT(!geom->detectCollision(pos, vel, dt));
+        CHECK_SMALL(dt, tol_small);
+        CHECK_CLOSE(pos.z, 0.3, tol_small);
+        CHECK_CLOSE(vel.z, 1.0, tol_small);
+        }
+
+    // particle crossing the upper wall is reflected back with no-slip
+        {
+        Scalar3 pos = make_scalar3(0.1, 0.0, 5.05);
+        Scalar3 vel = make_scalar3(1.0, 0.0, 1.0);
+        Scalar dt = 0.1;
+        UP_ASSERT(geom->detectCollision(pos, vel, dt));
+        CHECK_CLOSE(dt, 0.05, tol_small);
+        CHECK_CLOSE(pos.x, 0.05, tol_small);
+        CHECK_CLOSE(pos.z, 5.0, tol_small);
+        CHECK_CLOSE(vel.x, -1.0, tol_small);
+        CHECK_SMALL(vel.y, tol_small);
+        CHECK_CLOSE(vel.z, -1.0, tol_small);
+        }
+
+    // particle crossing the lower wall is reflected back with slip
+    auto slip = make_slit_grid(mpcd::detail::boundary::slip);
+        {
+        Scalar3 pos = make_scalar3(0.1, 0.0, -5.05);
+        Scalar3 vel = make_scalar3(1.0, 0.0, -1.0);
+        Scalar dt = 0.1;
+        UP_ASSERT(slip->detectCollision(pos, vel, dt));
+        CHECK_CLOSE(dt, 0.05, tol_small);
+        CHECK_CLOSE(pos.x, 0.05, tol_small);
+        CHECK_CLOSE(pos.z, -5.0, tol_small);
+        CHECK_CLOSE(vel.x, 1.0, tol_small);
+        CHECK_SMALL(vel.y, tol_small);
+        CHECK_CLOSE(vel.z, 1.0, tol_small);
+        }
+    }
+
+//! Test filling the solid layer of the grid geometry
+UP_TEST( grid_fill_basic )
+    {
+    auto exec_conf = std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU);
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap( new SnapshotSystemData<Scalar>() );
+    snap->global_box = BoxDim(20.0);
+    snap->particle_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
+        {
+        std::shared_ptr<mpcd::ParticleDataSnapshot> mpcd_snap = mpcd_sys_snap->particles;
+        mpcd_snap->resize(1);
+
+        mpcd_snap->position[0] = vec3<Scalar>(1,-2,3);
+        mpcd_snap->velocity[0] = vec3<Scalar>(123, 456, 789);
+        }
+    auto mpcd_sys = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+    auto pdata = mpcd_sys->getParticleData();
+    mpcd_sys->getCellList()->setCellSize(1.0);
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), 0);
+
+    auto geom = make_slit_grid(mpcd::detail::boundary::no_slip);
+    std::shared_ptr<::Variant> kT = std::make_shared<::VariantConst>(1.5);
+    auto filler = std::make_shared<mpcd::GridGeometryFiller>(mpcd_sys, 2.0, 1, kT, 42, geom);
+
+    /*
+     * The fill layer is 5 < |z| < 5 + sqrt(3). Each side is split onto two layers of voxels: one fully
+     * in the layer, and one that is sampled to be 3/4 in it. So the expected number per side is
+     * 2 * 20 * 20 * (1 + 3/4) = 1400.
+     */
+    filler->fill(0);
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), 2800);
+        {
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::MPCDReal4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+
+        // ensure first particle did not get overwritten
+        CHECK_CLOSE(h_pos.data[0].x,  1, tol_small);
+        CHECK_CLOSE(h_pos.data[0].y, -2, tol_small);
+        CHECK_CLOSE(h_pos.data[0].z,  3, tol_small);
+        CHECK_CLOSE(h_vel.data[0].x, 123, tol_small);
+        UP_ASSERT_EQUAL(h_tag.data[0], 0);
+
+        unsigned int N_lo(0), N_hi(0);
+        const Scalar z_max = Scalar(5.0) + fast::sqrt(Scalar(3.0));
+        for (unsigned int i=pdata->getN(); i < pdata->getN() + pdata->getNVirtual(); ++i)
+            {
+            // tag should equal index on one rank with one filler
+            UP_ASSERT_EQUAL(h_tag.data[i], i);
+            // type should be set
+            UP_ASSERT_EQUAL(mpcd::__mpcd_real_as_int(h_pos.data[i].w), 1);
+
+            const mpcd::MPCDReal4 r = h_pos.data[i];
+            if (r.z < Scalar(-5.0) && r.z >= -z_max)
+                ++N_lo;
+            else if (r.z > Scalar(5.0) && r.z <= z_max)
+                ++N_hi;
+            }
+        UP_ASSERT_EQUAL(N_lo, 1400);
+        UP_ASSERT_EQUAL(N_hi, 1400);
+        }
+
+    /*
+     * Doubling the density doubles the number of particles added
+     */
+    pdata->removeVirtualParticles();
+    filler->setDensity(4.0);
+    filler->fill(1);
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), 5600);
+
+    /*
+     * Test the average fill properties of the virtual particles.
+     */
+    filler->setDensity(2.0);
+    unsigned int N_avg(0);
+    Scalar3 v_avg = make_scalar3(0,0,0);
+    Scalar T_avg(0);
+    for (unsigned int t=0; t < 200; ++t)
+        {
+        pdata->removeVirtualParticles();
+        filler->fill(2+t);
+
+        ArrayHandle<mpcd::MPCDReal4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        for (unsigned int i=pdata->getN(); i < pdata->getN() + pdata->getNVirtual(); ++i)
+            {
+            const mpcd::MPCDReal4 vel_cell = h_vel.data[i];
+            const Scalar3 vel = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
+
+            ++N_avg;
+            v_avg += vel;
+            T_avg += dot(vel,vel);
+            }
+        }
+    // make averages
+    v_avg /= N_avg; T_avg /= (3*(N_avg-1));
+
+    CHECK_SMALL(v_avg.x, tol);
+    CHECK_SMALL(v_avg.y, tol);
+    CHECK_SMALL(v_avg.z, tol);
+    CHECK_CLOSE(T_avg, 1.5, tol);
+    }
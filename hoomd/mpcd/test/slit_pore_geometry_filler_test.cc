@@ -51,8 +51,8 @@ void slit_pore_fill_basic_test(std::shared_ptr<ExecutionConfiguration> exec_conf
     UP_ASSERT_EQUAL(pdata->getNVirtual(), 2*2*(1*3+2*16+1*3)*20);
     // count that particles have been placed on the right sides, and in right spaces
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::MPCDReal4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
 
         // ensure first particle did not get overwritten
@@ -70,9 +70,9 @@ void slit_pore_fill_basic_test(std::shared_ptr<ExecutionConfiguration> exec_conf
             // tag should equal index on one rank with one filler
             UP_ASSERT_EQUAL(h_tag.data[i], i);
             // type should be set
-            UP_ASSERT_EQUAL(__scalar_as_int(h_pos.data[i].w), 1);
+            UP_ASSERT_EQUAL(mpcd::__mpcd_real_as_int(h_pos.data[i].w), 1);
 
-            const Scalar4 r = h_pos.data[i];
+            const mpcd::MPCDReal4 r = h_pos.data[i];
             if (r.x >= Scalar(-8.0) && r.x <= Scalar(8.0))
                 {
                 if (r.z < Scalar(-5.0))
@@ -93,8 +93,8 @@ void slit_pore_fill_basic_test(std::shared_ptr<ExecutionConfiguration> exec_conf
     UP_ASSERT_EQUAL(pdata->getNVirtual(), 6*2*(1*3+2*16+1*3)*20);
     // count that particles have been placed on the right sides
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::MPCDReal4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
 
         unsigned int N_lo(0), N_hi(0);
@@ -103,7 +103,7 @@ void slit_pore_fill_basic_test(std::shared_ptr<ExecutionConfiguration> exec_conf
             // tag should equal index on one rank with one filler
             UP_ASSERT_EQUAL(h_tag.data[i], i);
 
-            const Scalar4 r = h_pos.data[i];
+            const mpcd::MPCDReal4 r = h_pos.data[i];
             if (r.x >= Scalar(-8.0) && r.x <= Scalar(8.0))
                 {
                 if (r.z < Scalar(-5.0))
@@ -127,11 +127,11 @@ void slit_pore_fill_basic_test(std::shared_ptr<ExecutionConfiguration> exec_conf
     UP_ASSERT_EQUAL(pdata->getNVirtual(), (unsigned int)(4*2*(0.5*4.5+0.5*16+0.5*4.5)*20));
     // count that particles have been placed on the right sides
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
         unsigned int N_lo(0), N_hi(0);
         for (unsigned int i=pdata->getN(); i < pdata->getN() + pdata->getNVirtual(); ++i)
             {
-            const Scalar4 r = h_pos.data[i];
+            const mpcd::MPCDReal4 r = h_pos.data[i];
             if (r.x >= Scalar(-8.0) && r.x <= Scalar(8.0))
                 {
                 if (r.z < Scalar(-5.0))
@@ -157,10 +157,10 @@ void slit_pore_fill_basic_test(std::shared_ptr<ExecutionConfiguration> exec_conf
         pdata->removeVirtualParticles();
         filler->fill(3+t);
 
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::MPCDReal4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
         for (unsigned int i=pdata->getN(); i < pdata->getN() + pdata->getNVirtual(); ++i)
             {
-            const Scalar4 vel_cell = h_vel.data[i];
+            const mpcd::MPCDReal4 vel_cell = h_vel.data[i];
             const Scalar3 vel = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
 
             ++N_avg;
@@ -50,7 +50,7 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
     stream->stream(2);
     std::shared_ptr<mpcd::ParticleData> pdata_2 = mpcd_sys->getParticleData();
         {
-        ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
         CHECK_CLOSE(h_pos.data[0].x, 1.0, tol);
         CHECK_CLOSE(h_pos.data[0].y, 4.85, tol);
         CHECK_CLOSE(h_pos.data[0].z, 3.0, tol);
@@ -64,7 +64,7 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
     UP_ASSERT(stream->peekStream(3));
     stream->stream(3);
         {
-        ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
         CHECK_CLOSE(h_pos.data[0].x, 1.1, tol);
         CHECK_CLOSE(h_pos.data[0].y, 4.95, tol);
         CHECK_CLOSE(h_pos.data[0].z, 3.1, tol);
@@ -80,7 +80,7 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
     UP_ASSERT(stream->peekStream(5));
     stream->stream(5);
         {
-        ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
         CHECK_CLOSE(h_pos.data[0].x, 1.2, tol);
         CHECK_CLOSE(h_pos.data[0].y, -4.95, tol);
         CHECK_CLOSE(h_pos.data[0].z, 3.2, tol);
@@ -94,7 +94,7 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
     stream->setDeltaT(0.1);
     stream->stream(7);
         {
-        ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::MPCDReal4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::read);
         CHECK_CLOSE(h_pos.data[0].x, 1.4, tol);
         CHECK_CLOSE(h_pos.data[0].y, -4.75, tol);
         CHECK_CLOSE(h_pos.data[0].z, 3.4, tol);
@@ -44,6 +44,9 @@ class options:
         self.autotuner_period = 100000;
         self.single_mpi = False;
         self.nthreads = None;
+        self.pin_threads = None;
+        self.numa_first_touch = None;
+        self.array_handle_stats = False;
 
     def __repr__(self):
         tmp = dict(mode=self.mode,
@@ -62,7 +65,10 @@ class options:
                    linear=self.linear,
                    onelevel=self.onelevel,
                    single_mpi=self.single_mpi,
-                   nthreads=self.nthreads)
+                   nthreads=self.nthreads,
+                   pin_threads=self.pin_threads,
+                   numa_first_touch=self.numa_first_touch,
+                   array_handle_stats=self.array_handle_stats)
         return str(tmp);
 
 ## Parses command line options
@@ -88,6 +94,9 @@ def _parse_command_line(arg_string=None):
     parser.add_option("--single-mpi", dest="single_mpi", action="store_true", help="Allow single-threaded HOOMD builds in MPI jobs");
     parser.add_option("--user", dest="user", help="User options");
     parser.add_option("--nthreads", dest="nthreads", help="Number of TBB threads");
+    parser.add_option("--pin-threads", dest="pin_threads", action="store_true", help="Pin each TBB thread to a CPU");
+    parser.add_option("--numa-first-touch", dest="numa_first_touch", action="store_true", help="Clear new arrays in parallel so that they are spread over the NUMA nodes");
+    parser.add_option("--array-handle-stats", dest="array_handle_stats", action="store_true", default=False, help="Count array accesses and host<->device copies per step");
 
     input_args = None;
     if arg_string is not None:
@@ -162,6 +171,10 @@ def _parse_command_line(arg_string=None):
        except ValueError:
             parser.error('--nthreads must be an integer')
 
+    if (cmd_options.pin_threads or cmd_options.numa_first_touch) and not _hoomd.is_TBB_available():
+        parser.error("The --pin-threads and --numa-first-touch options are only available in TBB-enabled builds.\n");
+        raise RuntimeError('Error setting option');
+
 
     # copy command line options over to global options
     hoomd.context.options.mode = cmd_options.mode;
@@ -177,6 +190,9 @@ def _parse_command_line(arg_string=None):
     hoomd.context.options.onelevel = cmd_options.onelevel
     hoomd.context.options.single_mpi = cmd_options.single_mpi
     hoomd.context.options.nthreads = cmd_options.nthreads
+    hoomd.context.options.pin_threads = cmd_options.pin_threads
+    hoomd.context.options.numa_first_touch = cmd_options.numa_first_touch
+    hoomd.context.options.array_handle_stats = cmd_options.array_handle_stats
 
     hoomd.context.options.notice_level = cmd_options.notice_level;
     hoomd.context.options.msg_file = cmd_options.msg_file;
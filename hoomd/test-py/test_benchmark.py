@@ -0,0 +1,63 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+from hoomd import *
+import hoomd;
+context.initialize()
+import unittest
+import os
+import json
+import tempfile
+
+# tests for the benchmark suite
+class benchmark_suite_tests (unittest.TestCase):
+    def setUp(self):
+        if comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.json');
+            self.tmp_file = tmp[1];
+        else:
+            self.tmp_file = "invalid";
+
+    # run a small workload and check the report
+    def test_suite(self):
+        report = benchmark.suite(names=['lj_liquid'], sizes=[125], warmup=10, steps=20, repeat=2, output=self.tmp_file);
+        self.assertEqual(len(report['regressions']), 0);
+
+        # the workload is skipped in builds without the md component
+        for r in report['results']:
+            self.assertEqual(r['workload'], 'lj_liquid');
+            self.assertEqual(r['N'], 125);
+            self.assertEqual(len(r['tps_list']), 2);
+            self.assertGreater(r['tps'], 0);
+            self.assertIn('Simulation', r['ms_per_step']);
+
+        if comm.get_rank() == 0:
+            with open(self.tmp_file) as f:
+                data = json.load(f);
+            self.assertEqual(len(data['results']), len(report['results']));
+
+    # compare results against a baseline
+    def test_compare(self):
+        baseline = {'results': [{'workload': 'a', 'N': 100, 'tps': 100.0},
+                                {'workload': 'b', 'N': 100, 'tps': 100.0}]};
+        results = [{'workload': 'a', 'N': 100, 'tps': 95.0},
+                   {'workload': 'b', 'N': 100, 'tps': 80.0},
+                   {'workload': 'c', 'N': 100, 'tps': 1.0}];
+
+        regressions = benchmark.compare(results, baseline, tolerance=0.1);
+        self.assertEqual(len(regressions), 1);
+        self.assertEqual(regressions[0]['workload'], 'b');
+        self.assertAlmostEqual(regressions[0]['ratio'], 0.8);
+
+    # unknown workloads are an error
+    def test_unknown(self):
+        self.assertRaises(ValueError, benchmark.suite, names=['not_a_workload']);
+
+    def tearDown(self):
+        if comm.get_rank() == 0:
+            os.remove(self.tmp_file);
+
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
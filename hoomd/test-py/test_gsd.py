@@ -445,6 +445,24 @@ class gsd_read_tests (unittest.TestCase):
 
         init.read_gsd(filename=self.tmp_file, frame=-1);
 
+    # tests init.read_gsd with all ranks reading the file
+    def test_read_gsd_distributed(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=None, overwrite=True);
+        context.initialize();
+
+        s = init.read_gsd(filename=self.tmp_file, distributed=True);
+        snap = s.take_snapshot(all=True);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+            self.assertEqual(snap.particles.types, self.snapshot.particles.types);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, self.snapshot.particles.mass);
+            numpy.testing.assert_array_equal(snap.particles.image, self.snapshot.particles.image);
+            numpy.testing.assert_array_equal(snap.bonds.group, self.snapshot.bonds.group);
+            numpy.testing.assert_array_equal(snap.angles.group, self.snapshot.angles.group);
+
     def tearDown(self):
         if comm.get_rank() == 0:
             os.remove(self.tmp_file);
@@ -164,5 +164,84 @@ class lattice_unitcell_test (unittest.TestCase):
     def tearDown(self):
         context.initialize();
 
+# unit tests for replication at initialization
+class lattice_replicate_test (unittest.TestCase):
+    def test_replicate(self):
+        uc = lattice.bcc(a=2.0);
+        sysdef = init.create_lattice(unitcell=uc, n=[4,3,2]);
+        snap = sysdef.take_snapshot();
+
+        # the same system replicated on the root rank
+        ref = uc.get_snapshot();
+        ref.replicate(4,3,2);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, 2*4*3*2);
+            numpy.testing.assert_allclose(snap.box.Lx, ref.box.Lx);
+            numpy.testing.assert_allclose(snap.box.Ly, ref.box.Ly);
+            numpy.testing.assert_allclose(snap.box.Lz, ref.box.Lz);
+            numpy.testing.assert_allclose(snap.particles.position, ref.particles.position, atol=1e-6);
+            numpy.testing.assert_array_equal(snap.particles.image, ref.particles.image);
+
+    def test_replicate_bonds(self):
+        # a unit cell with a bond between its two particles
+        class bonded_bcc(lattice.unitcell):
+            def get_snapshot(self):
+                snap = lattice.unitcell.get_snapshot(self);
+                if comm.get_rank() == 0:
+                    snap.bonds.types = ['bondA'];
+                    snap.bonds.resize(1);
+                    snap.bonds.group[0] = [0, 1];
+                    snap.bonds.typeid[0] = 0;
+                return snap;
+
+        bcc = lattice.bcc(a=2.0);
+        uc = bonded_bcc(N=bcc.N, a1=bcc.a1, a2=bcc.a2, a3=bcc.a3, position=bcc.position, type_name=bcc.type_name);
+        sysdef = init.create_lattice(unitcell=uc, n=[4,3,2]);
+        snap = sysdef.take_snapshot(bonds=True);
+
+        ref = uc.get_snapshot();
+        ref.replicate(4,3,2);
+
+        # particles are looked up by tag, whichever rank owns them
+        pos = [sysdef.particles[tag].position for tag in [0, 1, 17, 47]];
+
+        self.assertEqual(len(sysdef.bonds), 4*3*2);
+        if comm.get_rank() == 0:
+            numpy.testing.assert_allclose(pos, ref.particles.position[[0, 1, 17, 47]], atol=1e-6);
+            numpy.testing.assert_allclose(snap.particles.position, ref.particles.position, atol=1e-6);
+            self.assertEqual(snap.bonds.N, ref.bonds.N);
+            self.assertEqual(snap.bonds.types, ['bondA']);
+            numpy.testing.assert_array_equal(snap.bonds.group, ref.bonds.group);
+            numpy.testing.assert_array_equal(snap.bonds.typeid, ref.bonds.typeid);
+
+    def test_replicate_invalid_bonds(self):
+        # invalid unit cell topologies are rejected with and without domain decomposition
+        class bonded_bcc(lattice.unitcell):
+            def get_snapshot(self):
+                snap = lattice.unitcell.get_snapshot(self);
+                if comm.get_rank() == 0:
+                    snap.bonds.types = ['bondA'];
+                    snap.bonds.resize(1);
+                    snap.bonds.group[0] = self.bond_group;
+                    snap.bonds.typeid[0] = self.bond_typeid;
+                return snap;
+
+        bcc = lattice.bcc(a=2.0);
+        uc = bonded_bcc(N=bcc.N, a1=bcc.a1, a2=bcc.a2, a3=bcc.a3, position=bcc.position, type_name=bcc.type_name);
+
+        # invalid bond type
+        uc.bond_group = [0, 1];
+        uc.bond_typeid = 1;
+        self.assertRaises(RuntimeError, init.create_lattice, unitcell=uc, n=[4,3,2]);
+        context.initialize();
+
+        # repeated member
+        uc.bond_group = [1, 1];
+        uc.bond_typeid = 0;
+        self.assertRaises(RuntimeError, init.create_lattice, unitcell=uc, n=[4,3,2]);
+
+    def tearDown(self):
+        context.initialize();
+
 if __name__ == '__main__':
     unittest.main(argv = ['test.py', '-v'])
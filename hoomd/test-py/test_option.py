@@ -3,7 +3,7 @@
 
 from hoomd import *
 import hoomd;
-context.initialize()
+context.initialize("--array-handle-stats")
 import unittest
 import os
 
@@ -22,6 +22,22 @@ class option_tests (unittest.TestCase):
 
         self.assertRaises(RuntimeError, option.set_notice_level, 'foo');
 
+    # tests that array accesses are counted
+    def test_array_handle_stats(self):
+        self.assertTrue(hoomd.context.options.array_handle_stats);
+        counters = hoomd.context.exec_conf.getArrayHandleCounters();
+
+        system = init.create_lattice(unitcell=lattice.sc(a=1.5), n=5);
+        run(10);
+        system.take_snapshot();
+        self.assertGreater(counters.getHostAcquires(), 0);
+
+        # on the CPU, the data never leaves the host
+        if not hoomd.context.exec_conf.isCUDAEnabled():
+            self.assertEqual(counters.getDeviceAcquires(), 0);
+            self.assertEqual(counters.getHostToDeviceCopies(), 0);
+            self.assertEqual(counters.getDeviceToHostCopies(), 0);
+
     def tearDown(self):
         pass;
 
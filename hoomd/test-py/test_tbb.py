@@ -7,7 +7,7 @@ import hoomd;
 from hoomd import _hoomd
 if _hoomd.is_TBB_available():
     # test the command line option
-    context.initialize("--nthreads=4")
+    context.initialize("--nthreads=4 --pin-threads --numa-first-touch")
 
     import unittest
     import os
@@ -23,6 +23,16 @@ if _hoomd.is_TBB_available():
             option.set_num_threads(2)
             self.assertEqual(hoomd.context.ExecutionContext().num_threads, 2);
 
+        # tests that the thread pinning and NUMA options are passed on
+        def test_numa(self):
+            self.assertTrue(hoomd.context.exec_conf.getThreadAffinity());
+            self.assertTrue(hoomd.context.exec_conf.getNUMAFirstTouch());
+
+            # arrays cleared in parallel start out zero
+            system = init.create_lattice(unitcell=lattice.sc(a=1.5), n=20);
+            self.assertEqual(system.particles[7999].net_force, (0,0,0));
+            self.assertEqual(system.particles[7999].image, (0,0,0));
+
         def tearDown(self):
             pass;
 
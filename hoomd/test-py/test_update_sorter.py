@@ -18,6 +18,40 @@ class update_sorter_tests (unittest.TestCase):
 
         context.current.sorter.set_params(grid=20);
 
+    # test adaptive sorting
+    def test_adaptive(self):
+        context.current.sorter.set_params(adaptive=True, threshold=2.0);
+        context.current.sorter.set_period(1);
+        run(2);
+        # the lattice is in sorted order, so the metric is of order one
+        metric = context.current.sorter.cpp_updater.getLocalityMetric();
+        self.assertGreater(metric, 0.0);
+        self.assertLess(metric, 2.0);
+
+    # test that adaptive sorting skips sorts while the particles do not move
+    def test_adaptive_skip(self):
+        sorter = context.current.sorter;
+        sorter.set_params(adaptive=True, threshold=2.0);
+        sorter.set_period(1);
+
+        # the first sort always happens
+        run(1);
+        nsorts = sorter.cpp_updater.getNumSorts();
+        self.assertGreater(nsorts, 0);
+
+        # without an integrator, the particle order cannot degrade
+        run(10);
+        self.assertEqual(sorter.cpp_updater.getNumSorts(), nsorts);
+
+        # without adaptive sorting, every step sorts
+        sorter.set_params(adaptive=False);
+        run(10);
+        self.assertGreaterEqual(sorter.cpp_updater.getNumSorts(), nsorts + 10);
+
+    # test that invalid thresholds are rejected
+    def test_adaptive_threshold(self):
+        self.assertRaises(RuntimeError, context.current.sorter.set_params, threshold=0.5);
+
     def tearDown(self):
         context.initialize();
 
@@ -89,6 +89,44 @@ UP_TEST( GPUArray_basic_tests )
 
     }
 
+//! test case for counting handle acquisitions of data that stays on the host
+UP_TEST( GPUArray_counter_tests )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    UP_ASSERT(exec_conf->getArrayHandleCounters() == NULL);
+
+    exec_conf->setArrayHandleCounting(true);
+    ArrayHandleCounters *counters = exec_conf->getArrayHandleCounters();
+    UP_ASSERT(counters != NULL);
+
+    GPUArray<int> gpu_array(100, exec_conf);
+    for (unsigned int i = 0; i < 3; i++)
+        {
+        ArrayHandle<int> h_handle(gpu_array, access_location::host, access_mode::readwrite);
+        UP_ASSERT(h_handle.data != NULL);
+        h_handle.data[i] = i;
+        }
+
+    // the host-only path returns NULL for a NULL array
+    GPUArray<int> null_array(0, exec_conf);
+        {
+        ArrayHandle<int> h_handle(null_array, access_location::host, access_mode::read);
+        UP_ASSERT(h_handle.data == NULL);
+        }
+
+    // data on the host is never copied
+    UP_ASSERT_EQUAL(counters->getHostAcquires(), 4ull);
+    UP_ASSERT_EQUAL(counters->getDeviceAcquires(), 0ull);
+    UP_ASSERT_EQUAL(counters->getHostToDeviceCopies(), 0ull);
+    UP_ASSERT_EQUAL(counters->getDeviceToHostCopies(), 0ull);
+
+    counters->reset();
+    UP_ASSERT_EQUAL(counters->getHostAcquires(), 0ull);
+
+    exec_conf->setArrayHandleCounting(false);
+    UP_ASSERT(exec_conf->getArrayHandleCounters() == NULL);
+    }
+
 #ifdef ENABLE_CUDA
 //! test case for testing device to/from host transfers
 UP_TEST( GPUArray_transfer_tests )
@@ -204,6 +242,44 @@ UP_TEST( GPUArray_transfer_tests )
         }
     }
 
+//! test case for counting the copies between host and device
+UP_TEST( GPUArray_transfer_counter_tests )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::GPU));
+    exec_conf->setArrayHandleCounting(true);
+    ArrayHandleCounters *counters = exec_conf->getArrayHandleCounters();
+
+    GPUArray<int> gpu_array(100, exec_conf);
+
+    // data on the host, copied once to the device
+        {
+        ArrayHandle<int> d_handle(gpu_array, access_location::device, access_mode::read);
+        }
+        {
+        ArrayHandle<int> h_handle(gpu_array, access_location::host, access_mode::read);
+        }
+    UP_ASSERT_EQUAL(counters->getHostToDeviceCopies(), 1ull);
+    UP_ASSERT_EQUAL(counters->getHostToDeviceBytes(), 400ull);
+    UP_ASSERT_EQUAL(counters->getDeviceToHostCopies(), 0ull);
+
+    // modified on the device, copied back once
+        {
+        ArrayHandle<int> d_handle(gpu_array, access_location::device, access_mode::readwrite);
+        }
+        {
+        ArrayHandle<int> h_handle(gpu_array, access_location::host, access_mode::read);
+        }
+        {
+        ArrayHandle<int> h_handle(gpu_array, access_location::host, access_mode::read);
+        }
+    UP_ASSERT_EQUAL(counters->getHostToDeviceCopies(), 1ull);
+    UP_ASSERT_EQUAL(counters->getDeviceToHostCopies(), 1ull);
+    UP_ASSERT_EQUAL(counters->getDeviceToHostBytes(), 400ull);
+
+    UP_ASSERT_EQUAL(counters->getHostAcquires(), 3ull);
+    UP_ASSERT_EQUAL(counters->getDeviceAcquires(), 2ull);
+    }
+
 //! Tests operations on NULL GPUArrays
 UP_TEST( GPUArray_null_tests )
     {
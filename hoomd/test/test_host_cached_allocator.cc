@@ -0,0 +1,107 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <iostream>
+#include <string.h>
+
+#include "upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+
+#include "hoomd/HostCachedAllocator.h"
+
+using namespace std;
+
+/*! \file test_host_cached_allocator.cc
+    \brief Implements unit tests for HostCachedAllocator
+    \ingroup unit_tests
+*/
+
+//! test that released blocks are reused for requests of the same size class
+UP_TEST( HostCachedAllocator_reuse )
+    {
+    HostCachedAllocator alloc;
+
+    void *a = alloc.allocate(1000);
+    UP_ASSERT(a != NULL);
+    UP_ASSERT_EQUAL((size_t)a % 64, (size_t)0);
+    UP_ASSERT_EQUAL(alloc.getNumMisses(), (unsigned long long)1);
+
+    // write to the whole size class
+    memset(a, 0xff, 1024);
+    alloc.deallocate(a, 1000);
+    UP_ASSERT_EQUAL(alloc.getCachedBytes(), (size_t)1024);
+
+    // 1000 and 1010 bytes fall into the same class
+    void *b = alloc.allocate(1010);
+    UP_ASSERT(a == b);
+    UP_ASSERT_EQUAL(alloc.getNumHits(), (unsigned long long)1);
+    UP_ASSERT_EQUAL(alloc.getCachedBytes(), (size_t)0);
+
+    // a request of a different class gets a new block
+    void *c = alloc.allocate(2000);
+    UP_ASSERT(c != b);
+    UP_ASSERT_EQUAL(alloc.getNumMisses(), (unsigned long long)2);
+
+    alloc.deallocate(b, 1010);
+    alloc.deallocate(c, 2000);
+    UP_ASSERT_EQUAL(alloc.getCachedBytes(), (size_t)(1024+2048));
+
+    alloc.release();
+    UP_ASSERT_EQUAL(alloc.getCachedBytes(), (size_t)0);
+
+    // zero sized requests
+    UP_ASSERT(alloc.allocate(0) == NULL);
+    alloc.deallocate(NULL, 0);
+    }
+
+//! test that the free lists do not exceed the maximum cache size
+UP_TEST( HostCachedAllocator_max_cached_bytes )
+    {
+    HostCachedAllocator alloc(4096);
+    UP_ASSERT_EQUAL(alloc.getMaxCachedBytes(), (size_t)4096);
+
+    void *a = alloc.allocate(4096);
+    void *b = alloc.allocate(4096);
+    alloc.deallocate(a, 4096);
+    alloc.deallocate(b, 4096);
+
+    // only one of the two blocks is kept
+    UP_ASSERT_EQUAL(alloc.getCachedBytes(), (size_t)4096);
+
+    alloc.setMaxCachedBytes(0);
+    void *c = alloc.allocate(16);
+    alloc.deallocate(c, 16);
+    UP_ASSERT_EQUAL(alloc.getCachedBytes(), (size_t)4096);
+    }
+
+//! test the STL adapter
+UP_TEST( HostCachedAllocator_vector )
+    {
+    HostCachedAllocator alloc;
+
+    const float *first;
+        {
+        cached_host_vector<float> data(1000, 1.0f, alloc);
+        first = &data[0];
+        for (unsigned int i = 0; i < data.size(); i++)
+            UP_ASSERT_EQUAL(data[i], 1.0f);
+
+        // grow the vector, the old storage goes back to the pool
+        data.resize(5000, 2.0f);
+        UP_ASSERT_EQUAL(data[999], 1.0f);
+        UP_ASSERT_EQUAL(data[4999], 2.0f);
+        }
+
+    UP_ASSERT_EQUAL(alloc.getCachedBytes(), (size_t)(4096+32768));
+
+    // a vector of the same size reuses the first block
+    cached_host_vector<float> data(1000, 0.0f, host_cached_allocator<float>(alloc));
+    UP_ASSERT(&data[0] == first);
+    UP_ASSERT(data.get_allocator() == host_cached_allocator<int>(alloc));
+    }
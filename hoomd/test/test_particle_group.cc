@@ -223,6 +223,113 @@ UP_TEST( ParticleGroup_sort_test )
     }
     }
 
+//! Checks that ParticleGroup updates its index list incrementally when the particle permutation is known
+UP_TEST( ParticleGroup_reorder_test )
+    {
+    std::shared_ptr<SystemDefinition> sysdef = create_sysdef();
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<ParticleSelector> selector_type0(new ParticleSelectorType(sysdef, 0, 0));
+    ParticleGroup type0(sysdef, selector_type0);
+    // a second group with the same members, sharing the per-tag flags
+    std::shared_ptr<ParticleSelector> selector_type0_copy(new ParticleSelectorType(sysdef, 0, 0));
+    ParticleGroup type0_copy(sysdef, selector_type0_copy);
+
+    // type 0 particles are tags 0, 2, 5, 8
+    CHECK_EQUAL_UINT(type0.getNumMembers(), 4);
+    CHECK_EQUAL_UINT(type0_copy.getNumMembers(), 4);
+
+    // rotate the particles by three positions
+    std::vector<unsigned int> old_to_new(pdata->getN());
+    {
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(pdata->getRTags(), access_location::host, access_mode::readwrite);
+
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        old_to_new[i] = (i + 3) % pdata->getN();
+        h_tag.data[old_to_new[i]] = i;
+        h_rtag.data[i] = old_to_new[i];
+        }
+    }
+
+    pdata->notifyParticleReorder(&old_to_new[0], pdata->getN(), pdata->getN());
+
+    // verify that both groups have been updated and the indices are in sorted order
+    unsigned int expected_idx[] = {1, 3, 5, 8};
+    CHECK_EQUAL_UINT(type0.getNumMembers(), 4);
+    CHECK_EQUAL_UINT(type0_copy.getNumMembers(), 4);
+    for (unsigned int i = 0; i < 4; i++)
+        {
+        CHECK_EQUAL_UINT(type0.getMemberIndex(i), expected_idx[i]);
+        CHECK_EQUAL_UINT(type0_copy.getMemberIndex(i), expected_idx[i]);
+        }
+
+    {
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        unsigned int tag = h_tag.data[i];
+        bool is_type0 = (tag == 0 || tag == 2 || tag == 5 || tag == 8);
+        UP_ASSERT_EQUAL(type0.isMember(i), is_type0);
+        UP_ASSERT_EQUAL(type0_copy.isMember(i), is_type0);
+        }
+    }
+    }
+
+#ifdef ENABLE_MPI
+//! Checks that ParticleGroup follows particles that migrate out of and into the local domain
+UP_TEST( ParticleGroup_migrate_test )
+    {
+    std::shared_ptr<SystemDefinition> sysdef = create_sysdef();
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<ParticleSelector> selector_type0(new ParticleSelectorType(sysdef, 0, 0));
+    ParticleGroup type0(sysdef, selector_type0);
+
+    // type 0 particles are tags 0, 2, 5, 8
+    CHECK_EQUAL_UINT(type0.getNumMembers(), 4);
+
+    // tags 2 (a member) and 3 (not a member) leave the domain
+    {
+    ArrayHandle<unsigned int> h_comm_flags(pdata->getCommFlags(), access_location::host, access_mode::readwrite);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        h_comm_flags.data[i] = (i == 2 || i == 3) ? 1 : 0;
+    }
+
+    std::vector<pdata_element> out;
+    std::vector<unsigned int> comm_flags;
+    pdata->removeParticles(out, comm_flags);
+    CHECK_EQUAL_UINT(pdata->getN(), 8);
+    CHECK_EQUAL_UINT(out.size(), 2);
+
+    // the remaining particles keep their order, tags 5 and 8 moved to indices 3 and 6
+    unsigned int expected_idx_removed[] = {0, 3, 6};
+    CHECK_EQUAL_UINT(type0.getNumMembers(), 3);
+    for (unsigned int i = 0; i < 3; i++)
+        CHECK_EQUAL_UINT(type0.getMemberIndex(i), expected_idx_removed[i]);
+
+    // the particles migrate back and are appended
+    pdata->addParticles(out);
+    CHECK_EQUAL_UINT(pdata->getN(), 10);
+
+    unsigned int expected_idx_added[] = {0, 3, 6, 8};
+    CHECK_EQUAL_UINT(type0.getNumMembers(), 4);
+    for (unsigned int i = 0; i < 4; i++)
+        CHECK_EQUAL_UINT(type0.getMemberIndex(i), expected_idx_added[i]);
+
+    {
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        unsigned int tag = h_tag.data[i];
+        bool is_type0 = (tag == 0 || tag == 2 || tag == 5 || tag == 8);
+        UP_ASSERT_EQUAL(type0.isMember(i), is_type0);
+        }
+    }
+    }
+#endif
+
 //! Checks that ParticleGroup can initialize by particle type
 UP_TEST( ParticleGroup_type_test )
     {
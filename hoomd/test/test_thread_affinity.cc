@@ -0,0 +1,118 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+#ifdef ENABLE_MPI
+
+// this has to be included after naming the test module
+#include "upp11_config.h"
+HOOMD_UP_MAIN();
+
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/HOOMDMPI.h"
+
+#include <memory>
+#include <algorithm>
+#include <iterator>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+using namespace std;
+
+/*! \file test_thread_affinity.cc
+    \brief Implements unit tests for pinning TBB threads in MPI runs
+    \ingroup unit_tests
+*/
+
+#ifdef __linux__
+//! Get the CPUs in the affinity mask of the process
+static vector<int> get_affinity()
+    {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    sched_getaffinity(0, sizeof(cpu_set_t), &cpuset);
+
+    vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &cpuset))
+            cpus.push_back(cpu);
+    return cpus;
+    }
+
+//! Test that ranks on the same node with the same affinity mask pin their threads to disjoint CPUs
+UP_TEST( ThreadAffinity_shared_mask )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    MPI_Comm mpi_comm = exec_conf->getMPICommunicator();
+    unsigned int rank = exec_conf->getRank();
+
+    char procname[MPI_MAX_PROCESSOR_NAME];
+    int len;
+    MPI_Get_processor_name(procname, &len);
+    string node(procname, len);
+
+    vector<string> nodes;
+    all_gather_v(node, nodes, mpi_comm);
+
+    // emulate a launcher that does not bind, all ranks on a node get the union of their masks
+    vector< vector<int> > masks;
+    all_gather_v(get_affinity(), masks, mpi_comm);
+
+    vector<int> node_mask;
+    unsigned int n_node_ranks = 0;
+    for (unsigned int r = 0; r < nodes.size(); ++r)
+        {
+        if (nodes[r] != node)
+            continue;
+        vector<int> merged;
+        set_union(node_mask.begin(), node_mask.end(), masks[r].begin(), masks[r].end(), back_inserter(merged));
+        node_mask.swap(merged);
+        n_node_ranks++;
+        }
+
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (unsigned int i = 0; i < node_mask.size(); ++i)
+        CPU_SET(node_mask[i], &cpuset);
+    UP_ASSERT_EQUAL(sched_setaffinity(0, sizeof(cpu_set_t), &cpuset), 0);
+
+    exec_conf->setNumThreads(1);
+    exec_conf->setThreadAffinity(true);
+
+    vector<int> pinned = exec_conf->getPinnedCPUs();
+    vector< vector<int> > all_pinned;
+    all_gather_v(pinned, all_pinned, mpi_comm);
+
+    if (n_node_ranks > node_mask.size())
+        {
+        // not enough CPUs to give every rank its own
+        UP_ASSERT(!exec_conf->getThreadAffinity());
+        UP_ASSERT(pinned.empty());
+        return;
+        }
+
+    UP_ASSERT(exec_conf->getThreadAffinity());
+    UP_ASSERT(pinned.size() >= node_mask.size()/n_node_ranks);
+    UP_ASSERT(pinned.size() <= (node_mask.size() + n_node_ranks - 1)/n_node_ranks);
+    UP_ASSERT(includes(node_mask.begin(), node_mask.end(), pinned.begin(), pinned.end()));
+
+    // no CPU is shared with another rank on the same node
+    for (unsigned int r = 0; r < nodes.size(); ++r)
+        {
+        if (r == rank || nodes[r] != node)
+            continue;
+        vector<int> common;
+        set_intersection(pinned.begin(), pinned.end(), all_pinned[r].begin(), all_pinned[r].end(),
+            back_inserter(common));
+        UP_ASSERT(common.empty());
+        }
+
+    exec_conf->setThreadAffinity(false);
+    UP_ASSERT(!exec_conf->getThreadAffinity());
+    UP_ASSERT(exec_conf->getPinnedCPUs().empty());
+    }
+#endif
+
+#endif //ENABLE_MPI
@@ -262,14 +262,25 @@ class sort(_updater):
 
         self.setupUpdater(default_period);
 
-    def set_params(self, grid=None):
+        self.adaptive = False;
+        self.threshold = 1.5;
+
+    def set_params(self, grid=None, adaptive=None, threshold=None):
         R""" Change sorter parameters.
 
         Args:
             grid (int): New grid dimension (if set)
+            adaptive (bool): When True, skip sorts while the particles are still well ordered (if set)
+            threshold (float): Sort only when the locality metric has grown by this factor since the last sort (if set)
+
+        In adaptive mode, the sorter evaluates a locality metric every *period* time steps: the mean distance
+        between particles that are adjacent in memory, in units of the mean interparticle spacing. The particles
+        are sorted only when this metric exceeds *threshold* times its value right after the previous sort.
+        Adaptive sorting is disabled by default and *threshold* defaults to 1.5.
 
         Examples::
             sorter.set_params(grid=128)
+            sorter.set_params(adaptive=True, threshold=2.0)
         """
 
         hoomd.util.print_status_line();
@@ -278,6 +289,13 @@ class sort(_updater):
         if grid is not None:
             self.cpp_updater.setGrid(grid);
 
+        if adaptive is not None or threshold is not None:
+            if adaptive is not None:
+                self.adaptive = adaptive;
+            if threshold is not None:
+                self.threshold = threshold;
+            self.cpp_updater.setAdaptive(self.adaptive, float(self.threshold));
+
 class box_resize(_updater):
     R""" Rescale the system box size.
 